@@ -63,7 +63,7 @@ bool none_of(InputIter first, InputIter last, UnaryPredicate unary_pred) {
 // 对[first,
 // last)区间内的元素与给定值进行比较，缺省使用operator==，返回元素相等的个数
 template <typename InputIter, typename T>
-size_t count(InputIter first, InputIter last, const T& value) {
+size_t count_simd(InputIter first, InputIter last, const T& value, m_false_type /*unused*/) {
   size_t n = 0;
   for (; first != last; ++first) {
     if (*first == value) {
@@ -73,6 +73,30 @@ size_t count(InputIter first, InputIter last, const T& value) {
   return n;
 }
 
+#if MYSTL_SIMD_X86
+// 指向算术类型的指针，用 SIMD 一次比较一个向量
+// 与 *first == value 一样按通常的算术转换比较：value 转换成元素类型后的 v 与 value 不相等时
+// （如 unsigned char 与 signed char(-1)），没有元素与 value 相等；否则元素与 value 相等当且仅当
+// 它与 v 相等。浮点数 value 超出元素类型的范围或者是 NaN 时不能转换，退回逐个元素的循环
+template <typename U, typename T>
+size_t count_simd(U* first, U* last, const T& value, m_true_type /*unused*/) {
+  using lane = typename std::remove_const<U>::type;
+  if (!mystl::simd_lane_holds<lane>(value)) {
+    return count_simd(first, last, value, m_false_type());
+  }
+  const lane v = static_cast<lane>(value);
+  if (!(v == value)) {
+    return 0;
+  }
+  return mystl::simd_count<lane>(first, last, v);
+}
+#endif  // MYSTL_SIMD_X86
+
+template <typename InputIter, typename T>
+size_t count(InputIter first, InputIter last, const T& value) {
+  return count_simd(first, last, value, IsSimdFindable<InputIter, T>());
+}
+
 // count_if
 // 对[first, last)区间内的每个元素都进行一元unary_pred操作，返回结果为true的个数
 template <typename InputIter, typename UnaryPredicate>
@@ -89,13 +113,66 @@ size_t count_if(InputIter first, InputIter last, UnaryPredicate unary_pred) {
 // find
 // 在[first, last)区间内找到等于value的元素，返回指向该元素的迭代器
 template <typename InputIter, typename T>
-InputIter find(InputIter first, InputIter last, const T& value) {
+InputIter find(InputIter first, InputIter last, const T& value);
+
+template <typename InputIter, typename T>
+InputIter find_simd(InputIter first, InputIter last, const T& value, m_false_type /*unused*/) {
   while (first != last && *first != value) {
     ++first;
   }
   return first;
 }
 
+#if MYSTL_SIMD_X86
+// 指向算术类型的指针，用 SIMD 一次比较一个向量，比较方式与 count_simd 相同
+template <typename U, typename T>
+U* find_simd(U* first, U* last, const T& value, m_true_type /*unused*/) {
+  using lane = typename std::remove_const<U>::type;
+  if (!mystl::simd_lane_holds<lane>(value)) {
+    return find_simd(first, last, value, m_false_type());
+  }
+  const lane v = static_cast<lane>(value);
+  if (!(v == value)) {
+    return last;
+  }
+  return first + (mystl::simd_find<lane>(first, last, v) - first);
+}
+#endif  // MYSTL_SIMD_X86
+
+template <typename InputIter, typename T>
+InputIter find_seg(InputIter first, InputIter last, const T& value, m_false_type /*unused*/) {
+  return find_simd(first, last, value, IsSimdFindable<InputIter, T>());
+}
+
+// 分段迭代器逐段查找，每段是一对指针
+template <typename SegIter, typename T>
+SegIter find_seg(SegIter first, SegIter last, const T& value, m_true_type /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  auto sfirst = traits::segment(first);
+  const auto slast = traits::segment(last);
+  if (sfirst == slast) {
+    auto pos = mystl::find(traits::local(first), traits::local(last), value);
+    return pos == traits::local(last) ? last : traits::compose(sfirst, pos);
+  }
+  auto pos = mystl::find(traits::local(first), traits::end(sfirst), value);
+  if (pos != traits::end(sfirst)) {
+    return traits::compose(sfirst, pos);
+  }
+  for (++sfirst; sfirst != slast; ++sfirst) {
+    pos = mystl::find(traits::begin(sfirst), traits::end(sfirst), value);
+    if (pos != traits::end(sfirst)) {
+      return traits::compose(sfirst, pos);
+    }
+  }
+  pos = mystl::find(traits::begin(slast), traits::local(last), value);
+  return pos == traits::local(last) ? last : traits::compose(slast, pos);
+}
+
+template <typename InputIter, typename T>
+InputIter find(InputIter first, InputIter last, const T& value) {
+  return find_seg(first, last, value, IsSegmentedIterator<InputIter>());
+}
+
 // find_if
 // 在[first,
 // last)区间内找到第一个另一元操作unary_pred为true的元素，返回指向该元素的迭代器
@@ -396,13 +473,44 @@ InputIter find_first_of(InputIter first1, InputIter last1, ForwardIter first2,
 // last)区间内的每个元素执行一个operator()操作，但不能改变元素内容
 // f()可返回一个值，但该值会被忽略
 template <typename InputIter, typename Function>
-Function for_each(InputIter first, InputIter last, Function f) {
+Function for_each_seg(
+    InputIter first, InputIter last, Function f, m_false_type /*unused*/) {
   for (; first != last; ++first) {
     f(*first);
   }
   return f;
 }
 
+// 分段迭代器逐段调用，每段是一对指针
+template <typename LocalIter, typename Function>
+void for_each_local(LocalIter first, LocalIter last, Function& f) {
+  for (; first != last; ++first) {
+    f(*first);
+  }
+}
+
+template <typename SegIter, typename Function>
+Function for_each_seg(SegIter first, SegIter last, Function f, m_true_type /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  auto sfirst = traits::segment(first);
+  const auto slast = traits::segment(last);
+  if (sfirst == slast) {
+    for_each_local(traits::local(first), traits::local(last), f);
+    return f;
+  }
+  for_each_local(traits::local(first), traits::end(sfirst), f);
+  for (++sfirst; sfirst != slast; ++sfirst) {
+    for_each_local(traits::begin(sfirst), traits::end(sfirst), f);
+  }
+  for_each_local(traits::begin(slast), traits::local(last), f);
+  return f;
+}
+
+template <typename InputIter, typename Function>
+Function for_each(InputIter first, InputIter last, Function f) {
+  return for_each_seg(first, last, f, IsSegmentedIterator<InputIter>());
+}
+
 // adjacent_find
 // 找出第一对匹配的相邻元素，缺省使用operator==比较，如果找到返回一个迭代器，指向这对元素的第一个元素
 template <typename ForwardIter>
@@ -944,7 +1052,7 @@ const T& median(const T& left, const T& mid, const T& right, Compared comp) {
 // max_element
 // 返回一个迭代器，指向序列中最大的元素
 template <typename ForwardIter>
-ForwardIter max_element(ForwardIter first, ForwardIter last) {
+ForwardIter max_element_simd(ForwardIter first, ForwardIter last, m_false_type /*unused*/) {
   if (first == last) {
     return first;
   }
@@ -957,6 +1065,20 @@ ForwardIter max_element(ForwardIter first, ForwardIter last) {
   return result;
 }
 
+#if MYSTL_SIMD_X86
+// 指向算术类型的指针，先用 SIMD 求出最值，再找到它第一次出现的位置
+template <typename U>
+U* max_element_simd(U* first, U* last, m_true_type /*unused*/) {
+  using lane = typename std::remove_const<U>::type;
+  return first + (mystl::simd_max_element<lane>(first, last) - first);
+}
+#endif  // MYSTL_SIMD_X86
+
+template <typename ForwardIter>
+ForwardIter max_element(ForwardIter first, ForwardIter last) {
+  return max_element_simd(first, last, IsSimdMinMaxIterator<ForwardIter>());
+}
+
 // 重载comp
 template <typename ForwardIter, typename Compared>
 ForwardIter max_element(ForwardIter first, ForwardIter last, Compared comp) {
@@ -975,7 +1097,7 @@ ForwardIter max_element(ForwardIter first, ForwardIter last, Compared comp) {
 // min_element
 // 返回一个迭代器，指向序列中最大的元素
 template <typename ForwardIter>
-ForwardIter min_element(ForwardIter first, ForwardIter last) {
+ForwardIter min_element_simd(ForwardIter first, ForwardIter last, m_false_type /*unused*/) {
   if (first == last) {
     return first;
   }
@@ -988,6 +1110,20 @@ ForwardIter min_element(ForwardIter first, ForwardIter last) {
   return result;
 }
 
+#if MYSTL_SIMD_X86
+// 指向算术类型的指针，先用 SIMD 求出最值，再找到它第一次出现的位置
+template <typename U>
+U* min_element_simd(U* first, U* last, m_true_type /*unused*/) {
+  using lane = typename std::remove_const<U>::type;
+  return first + (mystl::simd_min_element<lane>(first, last) - first);
+}
+#endif  // MYSTL_SIMD_X86
+
+template <typename ForwardIter>
+ForwardIter min_element(ForwardIter first, ForwardIter last) {
+  return min_element_simd(first, last, IsSimdMinMaxIterator<ForwardIter>());
+}
+
 // 重载comp
 template <typename ForwardIter, typename Compared>
 ForwardIter min_element(ForwardIter first, ForwardIter last, Compared comp) {
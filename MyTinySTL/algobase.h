@@ -7,6 +7,7 @@
 #include <cstring>
 
 #include "iterator.h"
+#include "simd.h"
 #include "util.h"
 
 namespace mystl {
@@ -80,11 +81,6 @@ OutputIter unchecked_copy_cat(
   return result;
 }
 
-template <typename InputIter, typename OutputIter>
-OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result) {
-  return unchecked_copy_cat(first, last, result, iterator_category(first));
-}
-
 // 为trivially_copy_assignable类型提供特化版本
 template <typename Tp, typename Up>
 typename std::enable_if<
@@ -99,6 +95,88 @@ unchecked_copy(Tp* first, Tp* last, Up* result) {
   return result + n;
 }
 
+template <typename InputIter, typename OutputIter>
+OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result);
+
+// 输入为分段迭代器：逐段拷贝，每段是一对指针
+template <typename SegIter, typename OutputIter, typename OutSegmented>
+OutputIter unchecked_copy_seg(
+    SegIter first,
+    SegIter last,
+    OutputIter result,
+    m_true_type /*unused*/,
+    OutSegmented /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  auto sfirst = traits::segment(first);
+  const auto slast = traits::segment(last);
+  if (sfirst == slast) {
+    return mystl::unchecked_copy(traits::local(first), traits::local(last), result);
+  }
+  result = mystl::unchecked_copy(traits::local(first), traits::end(sfirst), result);
+  for (++sfirst; sfirst != slast; ++sfirst) {
+    result = mystl::unchecked_copy(traits::begin(sfirst), traits::end(sfirst), result);
+  }
+  return mystl::unchecked_copy(traits::begin(slast), traits::local(last), result);
+}
+
+// 只有输出为分段迭代器：输入可随机访问时，按输出的段切分
+template <typename RandomIter, typename SegIter>
+SegIter unchecked_copy_to_seg(
+    RandomIter first, RandomIter last, SegIter result, mystl::RandomAccessIteratorTag /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  auto n = last - first;
+  if (n <= 0) {
+    return result;
+  }
+  auto seg = traits::segment(result);
+  auto local = traits::local(result);
+  for (;;) {
+    const auto room = traits::end(seg) - local;
+    if (n < room) {
+      return traits::compose(seg, mystl::unchecked_copy(first, last, local));
+    }
+    mystl::unchecked_copy(first, first + room, local);
+    first += room;
+    n -= room;
+    local = traits::begin(++seg);
+    if (n == 0) {
+      return traits::compose(seg, local);
+    }
+  }
+}
+
+template <typename InputIter, typename SegIter>
+SegIter unchecked_copy_to_seg(
+    InputIter first, InputIter last, SegIter result, mystl::InputIteratorTag /*unused*/) {
+  return unchecked_copy_cat(first, last, result, mystl::InputIteratorTag());
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter unchecked_copy_seg(
+    InputIter first,
+    InputIter last,
+    OutputIter result,
+    m_false_type /*unused*/,
+    m_true_type /*unused*/) {
+  return unchecked_copy_to_seg(first, last, result, iterator_category(first));
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter unchecked_copy_seg(
+    InputIter first,
+    InputIter last,
+    OutputIter result,
+    m_false_type /*unused*/,
+    m_false_type /*unused*/) {
+  return unchecked_copy_cat(first, last, result, iterator_category(first));
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result) {
+  return unchecked_copy_seg(
+      first, last, result, IsSegmentedIterator<InputIter>(), IsSegmentedIterator<OutputIter>());
+}
+
 template <typename InputIter, typename OutputIter>
 OutputIter copy(InputIter first, InputIter last, OutputIter result) {
   return unchecked_copy(first, last, result);
@@ -133,12 +211,6 @@ BidirectionalIter2 unchecked_copy_backward_cat(
   return result;
 }
 
-template <typename BidirectionalIter1, typename BidirectionalIter2>
-BidirectionalIter2 unchecked_copy_backward(
-    BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
-  return unchecked_copy_backward_cat(first, last, result, iterator_category(first));
-}
-
 // 为trivially_copy_assignable类型提供特化版本
 template <typename Tp, typename Up>
 typename std::enable_if<
@@ -154,6 +226,94 @@ unchecked_copy_backward(Tp* first, Tp* last, Up* result) {
   return result;
 }
 
+template <typename BidirectionalIter1, typename BidirectionalIter2>
+BidirectionalIter2 unchecked_copy_backward(
+    BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result);
+
+// 输入为分段迭代器：从后往前逐段拷贝
+template <typename SegIter, typename BidirectionalIter, typename OutSegmented>
+BidirectionalIter unchecked_copy_backward_seg(
+    SegIter first,
+    SegIter last,
+    BidirectionalIter result,
+    m_true_type /*unused*/,
+    OutSegmented /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  const auto sfirst = traits::segment(first);
+  auto slast = traits::segment(last);
+  if (sfirst == slast) {
+    return mystl::unchecked_copy_backward(traits::local(first), traits::local(last), result);
+  }
+  result = mystl::unchecked_copy_backward(traits::begin(slast), traits::local(last), result);
+  for (--slast; slast != sfirst; --slast) {
+    result = mystl::unchecked_copy_backward(traits::begin(slast), traits::end(slast), result);
+  }
+  return mystl::unchecked_copy_backward(traits::local(first), traits::end(sfirst), result);
+}
+
+// 只有输出为分段迭代器：输入可随机访问时，按输出的段从后往前切分
+template <typename RandomIter, typename SegIter>
+SegIter unchecked_copy_backward_to_seg(
+    RandomIter first, RandomIter last, SegIter result, mystl::RandomAccessIteratorTag /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  auto n = last - first;
+  if (n <= 0) {
+    return result;
+  }
+  auto seg = traits::segment(result);
+  auto local = traits::local(result);
+  for (;;) {
+    const auto room = local - traits::begin(seg);
+    if (n <= room) {
+      return traits::compose(seg, mystl::unchecked_copy_backward(first, last, local));
+    }
+    mystl::unchecked_copy_backward(last - room, last, local);
+    last -= room;
+    n -= room;
+    local = traits::end(--seg);
+  }
+}
+
+template <typename BidirectionalIter1, typename SegIter>
+SegIter unchecked_copy_backward_to_seg(
+    BidirectionalIter1 first,
+    BidirectionalIter1 last,
+    SegIter result,
+    mystl::BidirectionalIteratorTag /*unused*/) {
+  return unchecked_copy_backward_cat(first, last, result, mystl::BidirectionalIteratorTag());
+}
+
+template <typename BidirectionalIter1, typename BidirectionalIter2>
+BidirectionalIter2 unchecked_copy_backward_seg(
+    BidirectionalIter1 first,
+    BidirectionalIter1 last,
+    BidirectionalIter2 result,
+    m_false_type /*unused*/,
+    m_true_type /*unused*/) {
+  return unchecked_copy_backward_to_seg(first, last, result, iterator_category(first));
+}
+
+template <typename BidirectionalIter1, typename BidirectionalIter2>
+BidirectionalIter2 unchecked_copy_backward_seg(
+    BidirectionalIter1 first,
+    BidirectionalIter1 last,
+    BidirectionalIter2 result,
+    m_false_type /*unused*/,
+    m_false_type /*unused*/) {
+  return unchecked_copy_backward_cat(first, last, result, iterator_category(first));
+}
+
+template <typename BidirectionalIter1, typename BidirectionalIter2>
+BidirectionalIter2 unchecked_copy_backward(
+    BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
+  return unchecked_copy_backward_seg(
+      first,
+      last,
+      result,
+      IsSegmentedIterator<BidirectionalIter1>(),
+      IsSegmentedIterator<BidirectionalIter2>());
+}
+
 template <typename BidirectionalIter1, typename BidirectionalIter2>
 BidirectionalIter2 copy_backward(
     BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
@@ -213,17 +373,12 @@ OutputIter unchecked_move_cat(
     RandomIter last,
     OutputIter result,
     mystl::RandomAccessIteratorTag /*unused*/) {
-  for (auto n = last - first; n >= 0; --n, ++first, ++result) {
+  for (auto n = last - first; n > 0; --n, ++first, ++result) {
     *result = mystl::move(*first);
   }
   return result;
 }
 
-template <typename InputIter, typename OutputIter>
-OutputIter unchecked_move(InputIter first, InputIter last, OutputIter result) {
-  return unchecked_move_cat(first, last, result, iterator_category(first));
-}
-
 // 为trivially_move_assignable类型提供特化版本
 template <typename Tp, typename Up>
 typename std::enable_if<
@@ -238,6 +393,88 @@ unchecked_move(Tp* first, Tp* last, Up* result) {
   return result + n;
 }
 
+template <typename InputIter, typename OutputIter>
+OutputIter unchecked_move(InputIter first, InputIter last, OutputIter result);
+
+// 输入为分段迭代器：逐段移动，每段是一对指针
+template <typename SegIter, typename OutputIter, typename OutSegmented>
+OutputIter unchecked_move_seg(
+    SegIter first,
+    SegIter last,
+    OutputIter result,
+    m_true_type /*unused*/,
+    OutSegmented /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  auto sfirst = traits::segment(first);
+  const auto slast = traits::segment(last);
+  if (sfirst == slast) {
+    return mystl::unchecked_move(traits::local(first), traits::local(last), result);
+  }
+  result = mystl::unchecked_move(traits::local(first), traits::end(sfirst), result);
+  for (++sfirst; sfirst != slast; ++sfirst) {
+    result = mystl::unchecked_move(traits::begin(sfirst), traits::end(sfirst), result);
+  }
+  return mystl::unchecked_move(traits::begin(slast), traits::local(last), result);
+}
+
+// 只有输出为分段迭代器：输入可随机访问时，按输出的段切分
+template <typename RandomIter, typename SegIter>
+SegIter unchecked_move_to_seg(
+    RandomIter first, RandomIter last, SegIter result, mystl::RandomAccessIteratorTag /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  auto n = last - first;
+  if (n <= 0) {
+    return result;
+  }
+  auto seg = traits::segment(result);
+  auto local = traits::local(result);
+  for (;;) {
+    const auto room = traits::end(seg) - local;
+    if (n < room) {
+      return traits::compose(seg, mystl::unchecked_move(first, last, local));
+    }
+    mystl::unchecked_move(first, first + room, local);
+    first += room;
+    n -= room;
+    local = traits::begin(++seg);
+    if (n == 0) {
+      return traits::compose(seg, local);
+    }
+  }
+}
+
+template <typename InputIter, typename SegIter>
+SegIter unchecked_move_to_seg(
+    InputIter first, InputIter last, SegIter result, mystl::InputIteratorTag /*unused*/) {
+  return unchecked_move_cat(first, last, result, mystl::InputIteratorTag());
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter unchecked_move_seg(
+    InputIter first,
+    InputIter last,
+    OutputIter result,
+    m_false_type /*unused*/,
+    m_true_type /*unused*/) {
+  return unchecked_move_to_seg(first, last, result, iterator_category(first));
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter unchecked_move_seg(
+    InputIter first,
+    InputIter last,
+    OutputIter result,
+    m_false_type /*unused*/,
+    m_false_type /*unused*/) {
+  return unchecked_move_cat(first, last, result, iterator_category(first));
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter unchecked_move(InputIter first, InputIter last, OutputIter result) {
+  return unchecked_move_seg(
+      first, last, result, IsSegmentedIterator<InputIter>(), IsSegmentedIterator<OutputIter>());
+}
+
 template <typename InputIter, typename OutputIter>
 OutputIter move(InputIter first, InputIter last, OutputIter result) {
   return unchecked_move(first, last, result);
@@ -272,13 +509,7 @@ RandomIter2 unchecked_move_backward_cat(
   return result;
 }
 
-template <typename BidirectionalIter1, typename BidirectionalIter2>
-BidirectionalIter2 unchecked_move_backward(
-    BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
-  return unchecked_copy_backward_cat(first, last, result, iterator_category(first));
-}
-
-// 为trivially_copy_assignable类型提供特化版本
+// 为trivially_move_assignable类型提供特化版本
 template <typename Tp, typename Up>
 typename std::enable_if<
     std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
@@ -293,16 +524,104 @@ unchecked_move_backward(Tp* first, Tp* last, Up* result) {
   return result;
 }
 
+template <typename BidirectionalIter1, typename BidirectionalIter2>
+BidirectionalIter2 unchecked_move_backward(
+    BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result);
+
+// 输入为分段迭代器：从后往前逐段移动
+template <typename SegIter, typename BidirectionalIter, typename OutSegmented>
+BidirectionalIter unchecked_move_backward_seg(
+    SegIter first,
+    SegIter last,
+    BidirectionalIter result,
+    m_true_type /*unused*/,
+    OutSegmented /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  const auto sfirst = traits::segment(first);
+  auto slast = traits::segment(last);
+  if (sfirst == slast) {
+    return mystl::unchecked_move_backward(traits::local(first), traits::local(last), result);
+  }
+  result = mystl::unchecked_move_backward(traits::begin(slast), traits::local(last), result);
+  for (--slast; slast != sfirst; --slast) {
+    result = mystl::unchecked_move_backward(traits::begin(slast), traits::end(slast), result);
+  }
+  return mystl::unchecked_move_backward(traits::local(first), traits::end(sfirst), result);
+}
+
+// 只有输出为分段迭代器：输入可随机访问时，按输出的段从后往前切分
+template <typename RandomIter, typename SegIter>
+SegIter unchecked_move_backward_to_seg(
+    RandomIter first, RandomIter last, SegIter result, mystl::RandomAccessIteratorTag /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  auto n = last - first;
+  if (n <= 0) {
+    return result;
+  }
+  auto seg = traits::segment(result);
+  auto local = traits::local(result);
+  for (;;) {
+    const auto room = local - traits::begin(seg);
+    if (n <= room) {
+      return traits::compose(seg, mystl::unchecked_move_backward(first, last, local));
+    }
+    mystl::unchecked_move_backward(last - room, last, local);
+    last -= room;
+    n -= room;
+    local = traits::end(--seg);
+  }
+}
+
+template <typename BidirectionalIter1, typename SegIter>
+SegIter unchecked_move_backward_to_seg(
+    BidirectionalIter1 first,
+    BidirectionalIter1 last,
+    SegIter result,
+    mystl::BidirectionalIteratorTag /*unused*/) {
+  return unchecked_move_backward_cat(first, last, result, mystl::BidirectionalIteratorTag());
+}
+
+template <typename BidirectionalIter1, typename BidirectionalIter2>
+BidirectionalIter2 unchecked_move_backward_seg(
+    BidirectionalIter1 first,
+    BidirectionalIter1 last,
+    BidirectionalIter2 result,
+    m_false_type /*unused*/,
+    m_true_type /*unused*/) {
+  return unchecked_move_backward_to_seg(first, last, result, iterator_category(first));
+}
+
+template <typename BidirectionalIter1, typename BidirectionalIter2>
+BidirectionalIter2 unchecked_move_backward_seg(
+    BidirectionalIter1 first,
+    BidirectionalIter1 last,
+    BidirectionalIter2 result,
+    m_false_type /*unused*/,
+    m_false_type /*unused*/) {
+  return unchecked_move_backward_cat(first, last, result, iterator_category(first));
+}
+
+template <typename BidirectionalIter1, typename BidirectionalIter2>
+BidirectionalIter2 unchecked_move_backward(
+    BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
+  return unchecked_move_backward_seg(
+      first,
+      last,
+      result,
+      IsSegmentedIterator<BidirectionalIter1>(),
+      IsSegmentedIterator<BidirectionalIter2>());
+}
+
 template <typename BidirectionalIter1, typename BidirectionalIter2>
 BidirectionalIter2 move_backward(
     BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
-  return unchecked_copy_backward(first, last, result);
+  return unchecked_move_backward(first, last, result);
 }
 
 // equal
 // 比较第一序列在[first, last)区间上的元素值是否和第二个序列相等
 template <typename InputIter1, typename InputIter2>
-bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+bool equal_simd(InputIter1 first1, InputIter1 last1, InputIter2 first2, m_false_type /*unused*/) {
   for (; first1 != last1; ++first1, ++first2) {
     if (*first1 != *first2) {
       return false;
@@ -311,6 +630,18 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
   return true;
 }
 
+// 指向同一种整数类型的指针，按字节比较
+template <typename T1, typename T2>
+bool equal_simd(T1* first1, T1* last1, T2* first2, m_true_type /*unused*/) {
+  const size_t n = static_cast<size_t>(last1 - first1);
+  return n == 0 || std::memcmp(first1, first2, n * sizeof(T1)) == 0;
+}
+
+template <typename InputIter1, typename InputIter2>
+bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+  return equal_simd(first1, last1, first2, IsSimdMismatchable<InputIter1, InputIter2>());
+}
+
 // 重载版本
 template <typename InputIter1, typename InputIter2, typename Compared>
 bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp) {
@@ -345,11 +676,46 @@ unchecked_fill_n(Tp* first, Size n, Up value) {
   return first + n;
 }
 
+// 为其它标量类型提供特化版本，先把值保存在局部变量中，写入*first不会改变它，循环可以向量化
+template <typename Tp, typename Size, typename Up>
+typename std::enable_if<
+    std::is_scalar<Tp>::value && !std::is_const<Tp>::value &&
+        std::is_convertible<Up, Tp>::value &&
+        !(std::is_integral<Tp>::value && sizeof(Tp) == 1 && !std::is_same<Tp, bool>::value &&
+          std::is_integral<Up>::value && sizeof(Up) == 1),
+    Tp*>::type
+unchecked_fill_n(Tp* first, Size n, Up value) {
+  const Tp tmp = value;
+  for (; n > 0; --n, ++first) {
+    *first = tmp;
+  }
+  return first;
+}
+
+template <typename ForwardIter, typename T>
+void fill(ForwardIter first, ForwardIter last, const T& value);
+
 template <typename OutputIter, typename Size, typename T>
-OutputIter fill_n(OutputIter first, Size n, const T& value) {
+OutputIter fill_n_seg(OutputIter first, Size n, const T& value, m_false_type /*unused*/) {
   return unchecked_fill_n(first, n, value);
 }
 
+// 分段迭代器先求出区间尾，再逐段填充
+template <typename SegIter, typename Size, typename T>
+SegIter fill_n_seg(SegIter first, Size n, const T& value, m_true_type /*unused*/) {
+  if (n <= 0) {
+    return first;
+  }
+  auto last = first + n;
+  mystl::fill(first, last, value);
+  return last;
+}
+
+template <typename OutputIter, typename Size, typename T>
+OutputIter fill_n(OutputIter first, Size n, const T& value) {
+  return fill_n_seg(first, n, value, IsSegmentedIterator<OutputIter>());
+}
+
 // fill
 // 为[first, last)区间内的所有元素填充新值
 template <typename ForwardIter, typename T>
@@ -363,13 +729,35 @@ void fill_cat(
 template <typename RandomIter, typename T>
 void fill_cat(
     RandomIter first, RandomIter last, const T& value, mystl::RandomAccessIteratorTag /*unused*/) {
-  fill_n(first, last - first, value);
+  mystl::fill_n(first, last - first, value);
 }
 
 template <typename ForwardIter, typename T>
-void fill(ForwardIter first, ForwardIter last, const T& value) {
+void fill_seg(ForwardIter first, ForwardIter last, const T& value, m_false_type /*unused*/) {
   fill_cat(first, last, value, iterator_category(first));
 }
+
+// 分段迭代器逐段填充，每段是一对指针
+template <typename SegIter, typename T>
+void fill_seg(SegIter first, SegIter last, const T& value, m_true_type /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  auto sfirst = traits::segment(first);
+  const auto slast = traits::segment(last);
+  if (sfirst == slast) {
+    mystl::fill(traits::local(first), traits::local(last), value);
+    return;
+  }
+  mystl::fill(traits::local(first), traits::end(sfirst), value);
+  for (++sfirst; sfirst != slast; ++sfirst) {
+    mystl::fill(traits::begin(sfirst), traits::end(sfirst), value);
+  }
+  mystl::fill(traits::begin(slast), traits::local(last), value);
+}
+
+template <typename ForwardIter, typename T>
+void fill(ForwardIter first, ForwardIter last, const T& value) {
+  fill_seg(first, last, value, IsSegmentedIterator<ForwardIter>());
+}
 // lexicographical_compare
 // 字典序比较
 template <typename InputIter1, typename InputIter2>
@@ -418,8 +806,8 @@ bool lexicographical_compare(
 // mismatch
 // 平行比较两个序列，找到第一处失配的元素，返回一对迭代器，分别指向两个序列中失配的元素
 template <typename InputIter1, typename InputIter2>
-mystl::pair<InputIter1, InputIter2> mismatch(
-    InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+mystl::pair<InputIter1, InputIter2> mismatch_simd(
+    InputIter1 first1, InputIter1 last1, InputIter2 first2, m_false_type /*unused*/) {
   while (first1 != last1 && *first1 == *first2) {
     ++first1;
     ++first2;
@@ -427,6 +815,22 @@ mystl::pair<InputIter1, InputIter2> mismatch(
   return mystl::pair<InputIter1, InputIter2>(first1, first2);
 }
 
+#if MYSTL_SIMD_X86
+// 指向同一种整数类型的指针，用 SIMD 按字节比较
+template <typename T1, typename T2>
+mystl::pair<T1*, T2*> mismatch_simd(T1* first1, T1* last1, T2* first2, m_true_type /*unused*/) {
+  const size_t n = mystl::simd_mismatch<typename std::remove_const<T1>::type>(
+      first1, last1, first2);
+  return mystl::pair<T1*, T2*>(first1 + n, first2 + n);
+}
+#endif  // MYSTL_SIMD_X86
+
+template <typename InputIter1, typename InputIter2>
+mystl::pair<InputIter1, InputIter2> mismatch(
+    InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+  return mismatch_simd(first1, last1, first2, IsSimdMismatchable<InputIter1, InputIter2>());
+}
+
 // 重载版本使用函数对象comp代替比较操作
 template <typename InputIter1, typename InputIter2, typename Compred>
 mystl::pair<InputIter1, InputIter2> mismatch(
@@ -1,13 +1,15 @@
 ﻿#ifndef MYTINYSTL_ALGORITHM_H_
 #define MYTINYSTL_ALGORITHM_H_
 
-// 这个头文件包含了 mystl 的所有算法，包括基本算法，数值算法，heap 算法，set 算法和其他算法
+// 这个头文件包含了 mystl 的所有算法，包括基本算法，数值算法，heap 算法，set 算法和其他算法，
+// 以及部分算法以执行策略为第一个参数的并行版本
 
 #include "algobase.h"
 #include "algo.h"
 #include "set_algo.h"
 #include "heap_algo.h"
 #include "numeric.h"
+#include "parallel_algo.h"
 
 namespace mystl
 {
@@ -3,6 +3,10 @@
 
 // 用于管理内存的分配、释放，对象的构造、析构
 // 对应书2.1节
+// PoolAllocator 对应书2.2.6节的第二级配置器，用于结点式容器频繁分配、释放单个结点的场合
+
+#include <mutex>
+#include <type_traits>
 
 #include "construct.h"
 #include "util.h"
@@ -97,6 +101,194 @@ void Allocator<T>::destroy(T* first, T* last) {
   mystl::destroy(first, last);
 }
 
+// 结点池分配器，接口与Allocator相同
+// 单个对象从按类型划分的空闲链表中分配，空闲链表为空时一次申请一块内存切分为kChunkSlots个槽位，
+// 释放的对象挂回空闲链表而不归还系统；一次分配多个对象时直接使用::operator new，
+// 此时必须用deallocate(ptr, n)释放
+// 每个线程有自己的空闲链表，分配、释放都不加锁；一个线程分配的对象可以交给另一个线程释放，
+// 此时挂到后者的空闲链表上
+// 线程的空闲链表达到2 * kChunkSlots个槽位时，把其中kChunkSlots个交给所有线程共享的空闲链表
+// （加锁），空闲链表为空时先取走共享链表中的全部槽位，共享链表也为空才向系统申请新的内存块，
+// 因此生产者/消费者模式下消费者的空闲链表不会无限增长，生产者会重用消费者释放的槽位；
+// 线程退出时它的空闲槽位全部交给共享链表。申请的内存块直到程序结束都不归还系统
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+
+ private:
+  union Slot {
+    Slot* next;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+ public:
+  // 每次向系统申请的槽位个数，一块大约4KB，至少16个
+  static constexpr size_type kChunkSlots = 4096 / sizeof(Slot) < 16 ? 16 : 4096 / sizeof(Slot);
+
+  static T* allocate();
+  static T* allocate(size_type n);
+
+  static void deallocate(T* ptr);
+  static void deallocate(T* ptr, size_type n);
+
+  static void construct(T* ptr) { mystl::construct(ptr); }
+  static void construct(T* ptr, const T& value) { mystl::construct(ptr, value); }
+  static void construct(T* ptr, T&& value) { mystl::construct(ptr, mystl::move(value)); }
+
+  template <typename... Args>
+  static void construct(T* ptr, Args&&... args) {
+    mystl::construct(ptr, mystl::forward<Args>(args)...);
+  }
+
+  static void destroy(T* ptr) { mystl::destroy(ptr); }
+  static void destroy(T* first, T* last) { mystl::destroy(first, last); }
+
+ private:
+  // 线程自己的空闲链表，count为其中的槽位个数，线程退出时把槽位交给共享链表
+  struct LocalList {
+    Slot* head;
+    size_type count;
+
+    LocalList() noexcept : head(nullptr), count(0) {}
+    ~LocalList() {
+      if (head != nullptr) {
+        Slot* last = head;
+        while (last->next != nullptr) {
+          last = last->next;
+        }
+        PoolAllocator::give_back(head, last, count);
+        head = nullptr;
+        count = 0;
+      }
+    }
+  };
+
+  // 所有线程共享的空闲链表，由mutex保护；对象永不析构，其他静态对象析构时仍然可以释放结点
+  struct SharedList {
+    std::mutex mutex;
+    Slot* head;
+    size_type count;
+  };
+
+  static LocalList& local_list() {
+    static thread_local LocalList list;
+    return list;
+  }
+
+  static SharedList& shared_list() {
+    static SharedList* list = new SharedList();
+    return *list;
+  }
+
+  static Slot* refill();
+  static void give_back(Slot* first, Slot* last, size_type n);
+};
+
+template <typename T>
+constexpr typename PoolAllocator<T>::size_type PoolAllocator<T>::kChunkSlots;
+
+// 空闲链表为空时先取走共享链表中的全部槽位，共享链表也为空时申请一块新的内存，
+// 返回第一个槽位，其余槽位挂到当前线程的空闲链表上
+template <typename T>
+typename PoolAllocator<T>::Slot* PoolAllocator<T>::refill() {
+  LocalList& local = local_list();
+  {
+    SharedList& shared = shared_list();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    if (shared.head != nullptr) {
+      Slot* slot = shared.head;
+      local.head = slot->next;
+      local.count = shared.count - 1;
+      shared.head = nullptr;
+      shared.count = 0;
+      return slot;
+    }
+  }
+  Slot* chunk = static_cast<Slot*>(::operator new(kChunkSlots * sizeof(Slot)));
+  for (size_type i = 1; i + 1 < kChunkSlots; ++i) {
+    chunk[i].next = &chunk[i + 1];
+  }
+  chunk[kChunkSlots - 1].next = nullptr;
+  local.head = &chunk[1];
+  local.count = kChunkSlots - 1;
+  return chunk;
+}
+
+// 把以first开头、以last结尾的n个槽位挂到共享链表上
+template <typename T>
+void PoolAllocator<T>::give_back(Slot* first, Slot* last, size_type n) {
+  SharedList& shared = shared_list();
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  last->next = shared.head;
+  shared.head = first;
+  shared.count += n;
+}
+
+template <typename T>
+T* PoolAllocator<T>::allocate() {
+  LocalList& local = local_list();
+  Slot* slot = local.head;
+  if (slot == nullptr) {
+    return reinterpret_cast<T*>(refill());
+  }
+  local.head = slot->next;
+  --local.count;
+  return reinterpret_cast<T*>(slot);
+}
+
+template <typename T>
+T* PoolAllocator<T>::allocate(size_type n) {
+  if (n == 0) {
+    return nullptr;
+  }
+  if (n == 1) {
+    return allocate();
+  }
+  return static_cast<T*>(::operator new(n * sizeof(T)));
+}
+
+template <typename T>
+void PoolAllocator<T>::deallocate(T* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  Slot* slot = reinterpret_cast<Slot*>(ptr);
+  LocalList& local = local_list();
+  slot->next = local.head;
+  local.head = slot;
+  if (++local.count >= 2 * kChunkSlots) {
+    // 把最近释放的kChunkSlots个槽位留在本线程，其余的交给共享链表
+    Slot* last = local.head;
+    for (size_type i = 1; i < kChunkSlots; ++i) {
+      last = last->next;
+    }
+    Slot* rest = last->next;
+    last->next = nullptr;
+    Slot* rest_last = rest;
+    while (rest_last->next != nullptr) {
+      rest_last = rest_last->next;
+    }
+    give_back(rest, rest_last, local.count - kChunkSlots);
+    local.count = kChunkSlots;
+  }
+}
+
+template <typename T>
+void PoolAllocator<T>::deallocate(T* ptr, size_type n) {
+  if (n > 1) {
+    ::operator delete(ptr);
+  } else {
+    deallocate(ptr);
+  }
+}
+
 }  // namespace mystl
 
 #endif  // !MYTINYSTL_ALLOCATOR_H_
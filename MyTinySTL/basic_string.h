@@ -1893,6 +1893,79 @@ bool operator>=(const BasicString<CharType, CharTraits>& lhs,
   return lhs.compare(rhs) >= 0;
 }
 
+// 与字符串字面量比较，避免构造临时的basic_string
+template <typename CharType, typename CharTraits>
+bool operator==(const BasicString<CharType, CharTraits>& lhs,
+                const CharType* rhs) {
+  return lhs.compare(rhs) == 0;
+}
+
+template <typename CharType, typename CharTraits>
+bool operator!=(const BasicString<CharType, CharTraits>& lhs,
+                const CharType* rhs) {
+  return lhs.compare(rhs) != 0;
+}
+
+template <typename CharType, typename CharTraits>
+bool operator<(const BasicString<CharType, CharTraits>& lhs,
+               const CharType* rhs) {
+  return lhs.compare(rhs) < 0;
+}
+
+template <typename CharType, typename CharTraits>
+bool operator<=(const BasicString<CharType, CharTraits>& lhs,
+                const CharType* rhs) {
+  return lhs.compare(rhs) <= 0;
+}
+
+template <typename CharType, typename CharTraits>
+bool operator>(const BasicString<CharType, CharTraits>& lhs,
+               const CharType* rhs) {
+  return lhs.compare(rhs) > 0;
+}
+
+template <typename CharType, typename CharTraits>
+bool operator>=(const BasicString<CharType, CharTraits>& lhs,
+                const CharType* rhs) {
+  return lhs.compare(rhs) >= 0;
+}
+
+template <typename CharType, typename CharTraits>
+bool operator==(const CharType* lhs,
+                const BasicString<CharType, CharTraits>& rhs) {
+  return rhs.compare(lhs) == 0;
+}
+
+template <typename CharType, typename CharTraits>
+bool operator!=(const CharType* lhs,
+                const BasicString<CharType, CharTraits>& rhs) {
+  return rhs.compare(lhs) != 0;
+}
+
+template <typename CharType, typename CharTraits>
+bool operator<(const CharType* lhs,
+               const BasicString<CharType, CharTraits>& rhs) {
+  return rhs.compare(lhs) > 0;
+}
+
+template <typename CharType, typename CharTraits>
+bool operator<=(const CharType* lhs,
+                const BasicString<CharType, CharTraits>& rhs) {
+  return rhs.compare(lhs) >= 0;
+}
+
+template <typename CharType, typename CharTraits>
+bool operator>(const CharType* lhs,
+               const BasicString<CharType, CharTraits>& rhs) {
+  return rhs.compare(lhs) < 0;
+}
+
+template <typename CharType, typename CharTraits>
+bool operator>=(const CharType* lhs,
+                const BasicString<CharType, CharTraits>& rhs) {
+  return rhs.compare(lhs) <= 0;
+}
+
 // 重载mystl的swap
 template <typename CharType, typename CharTraits>
 void swap(const BasicString<CharType, CharTraits>& lhs,
@@ -1903,12 +1976,28 @@ void swap(const BasicString<CharType, CharTraits>& lhs,
 // 特化mystl::Hash
 template <typename CharType, typename CharTraits>
 struct Hash<BasicString<CharType, CharTraits>> {
-  size_t operator()(const BasicString<CharType, CharTraits>& str) {
+  size_t operator()(const BasicString<CharType, CharTraits>& str) const {
     return bitwise_hash((const unsigned char*)str.c_str(),
                         str.size() * sizeof(CharType));
   }
 };
 
+// 透明的字符串哈希函数，对basic_string和C风格字符串得到相同的哈希值，
+// 与mystl::EqualTo<>搭配使用时，unordered容器可以直接用字面量查找
+template <typename CharType, typename CharTraits = mystl::CharTraits<CharType>>
+struct StringHash {
+  using is_transparent = void;
+
+  size_t operator()(const BasicString<CharType, CharTraits>& str) const {
+    return bitwise_hash((const unsigned char*)str.data(),
+                        str.size() * sizeof(CharType));
+  }
+  size_t operator()(const CharType* str) const {
+    return bitwise_hash((const unsigned char*)str,
+                        CharTraits::length(str) * sizeof(CharType));
+  }
+};
+
 }  // namespace mystl
 
 #endif  // !MYTINYSTL_BASIC_STRING_H_
@@ -0,0 +1,562 @@
+#ifndef MYTINYSTL_CIRCULAR_BUFFER_H_
+#define MYTINYSTL_CIRCULAR_BUFFER_H_
+
+// 这个头文件包含一个模板类 CircularBuffer
+// CircularBuffer : 环形缓冲区，元素保存在一块容量为2的幂的连续空间中，首尾相接
+
+// notes:
+//
+// 可以作为 mystl::Queue / mystl::Stack 的底层容器，例如
+//   mystl::Queue<int, mystl::CircularBuffer<int>>
+// 先用 reserve 预留足够的容量，之后的 push / pop 都不会再分配内存
+//
+// 模板参数 Overwrite 决定容量已满时的行为：
+//   * false（缺省）：像 vector 一样按两倍扩容
+//   * true        ：容量固定，push_back 覆盖最旧的元素（头部），push_front 覆盖尾部的元素
+// 容量为0时第一次插入会分配 CIRCULAR_BUFFER_INIT_SIZE 个元素的空间
+//
+// array_one() / array_two() 以两段连续空间的形式返回全部元素，
+// 元素的顺序为 array_one 在前，array_two 在后，没有回绕时 array_two 为空
+//
+// 异常保证：
+// mystl::CircularBuffer<T> 满足基本异常保证，部分函数无异常保证
+// 扩容时元素的移动构造可能抛出异常则改为复制，扩容失败时原来的元素保持不变
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace mystl {
+
+// 容量为0时第一次插入分配的元素个数
+#ifndef CIRCULAR_BUFFER_INIT_SIZE
+#define CIRCULAR_BUFFER_INIT_SIZE 16
+#endif
+
+// 迭代器
+// pos为元素在环上的绝对位置，取值范围为[0, 2 * capacity)，解引用时与mask做按位与
+template <typename T, typename Ref, typename Ptr>
+struct CircularBufferIterator : public Iterator<RandomAccessIteratorTag, T> {
+  using iterator = CircularBufferIterator<T, T&, T*>;
+  using const_iterator = CircularBufferIterator<T, const T&, const T*>;
+  using self = CircularBufferIterator;
+
+  using value_type = T;
+  using pointer = Ptr;
+  using reference = Ref;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+
+  T* buf;       // 缓冲区的头部
+  size_t mask;  // 容量减一
+  size_t pos;   // 在环上的绝对位置
+
+  CircularBufferIterator() noexcept : buf(nullptr), mask(0), pos(0) {}
+  CircularBufferIterator(T* b, size_t m, size_t p) noexcept : buf(b), mask(m), pos(p) {}
+  CircularBufferIterator(const iterator& rhs) noexcept
+      : buf(rhs.buf), mask(rhs.mask), pos(rhs.pos) {}
+  self& operator=(const self&) = default;
+
+  reference operator*() const { return buf[pos & mask]; }
+  pointer operator->() const { return &(operator*()); }
+
+  difference_type operator-(const self& x) const {
+    return static_cast<difference_type>(pos - x.pos);
+  }
+
+  self& operator++() {
+    ++pos;
+    return *this;
+  }
+  self operator++(int) {
+    self tmp = *this;
+    ++pos;
+    return tmp;
+  }
+  self& operator--() {
+    --pos;
+    return *this;
+  }
+  self operator--(int) {
+    self tmp = *this;
+    --pos;
+    return tmp;
+  }
+
+  self& operator+=(difference_type n) {
+    pos += n;
+    return *this;
+  }
+  self operator+(difference_type n) const { return self(buf, mask, pos + n); }
+  self& operator-=(difference_type n) {
+    pos -= n;
+    return *this;
+  }
+  self operator-(difference_type n) const { return self(buf, mask, pos - n); }
+
+  reference operator[](difference_type n) const { return buf[(pos + n) & mask]; }
+
+  // 重载比较操作符
+  bool operator==(const self& rhs) const { return pos == rhs.pos; }
+  bool operator!=(const self& rhs) const { return pos != rhs.pos; }
+  bool operator<(const self& rhs) const { return pos < rhs.pos; }
+  bool operator>(const self& rhs) const { return rhs < *this; }
+  bool operator<=(const self& rhs) const { return !(rhs < *this); }
+  bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+// 模板类CircularBuffer
+// 参数一代表数据类型，参数二代表容量已满时是否覆盖旧元素
+template <typename T, bool Overwrite = false>
+class CircularBuffer {
+ public:
+  static constexpr bool kOverwrite = Overwrite;
+
+  using allocator_type = mystl::Allocator<T>;
+  using data_allocator = mystl::Allocator<T>;
+
+  using value_type = typename allocator_type::value_type;
+  using pointer = typename allocator_type::pointer;
+  using const_pointer = typename allocator_type::const_pointer;
+  using reference = typename allocator_type::reference;
+  using const_reference = typename allocator_type::const_reference;
+  using size_type = typename allocator_type::size_type;
+  using difference_type = typename allocator_type::difference_type;
+
+  using iterator = CircularBufferIterator<T, T&, T*>;
+  using const_iterator = CircularBufferIterator<T, const T&, const T*>;
+  using reverse_iterator = mystl::ReverseIterator<iterator>;
+  using const_reverse_iterator = mystl::ReverseIterator<const_iterator>;
+
+  // 一段连续空间，first为首地址，second为元素个数
+  using array_range = mystl::pair<pointer, size_type>;
+  using const_array_range = mystl::pair<const_pointer, size_type>;
+
+  allocator_type get_allocator() { return allocator_type(); }
+
+ private:
+  pointer buffer_;  // 缓冲区
+  size_type cap_;   // 容量，为0或者2的幂
+  size_type mask_;  // 容量减一，容量为0时为0
+  size_type head_;  // 第一个元素在缓冲区中的下标
+  size_type size_;  // 元素个数
+
+ public:
+  // 构造、复制、移动、析构函数
+  CircularBuffer() noexcept : buffer_(nullptr), cap_(0), mask_(0), head_(0), size_(0) {}
+
+  explicit CircularBuffer(size_type n) : CircularBuffer() { fill_init(n, value_type()); }
+
+  CircularBuffer(size_type n, const value_type& value) : CircularBuffer() { fill_init(n, value); }
+
+  template <
+      typename IIter,
+      typename std::enable_if<mystl::IsInputIterator<IIter>::kValue, int>::type = 0>
+  CircularBuffer(IIter first, IIter last) : CircularBuffer() {
+    copy_init(first, last, iterator_category(first));
+  }
+
+  CircularBuffer(std::initializer_list<value_type> ilist) : CircularBuffer() {
+    copy_init(ilist.begin(), ilist.end(), mystl::ForwardIteratorTag());
+  }
+
+  // 复制时保留rhs的容量
+  CircularBuffer(const CircularBuffer& rhs) : CircularBuffer() {
+    init_space(rhs.cap_);
+    mystl::uninitialized_copy(rhs.begin(), rhs.end(), buffer_);
+    size_ = rhs.size_;
+  }
+
+  CircularBuffer(CircularBuffer&& rhs) noexcept
+      : buffer_(rhs.buffer_),
+        cap_(rhs.cap_),
+        mask_(rhs.mask_),
+        head_(rhs.head_),
+        size_(rhs.size_) {
+    rhs.buffer_ = nullptr;
+    rhs.cap_ = 0;
+    rhs.mask_ = 0;
+    rhs.head_ = 0;
+    rhs.size_ = 0;
+  }
+
+  CircularBuffer& operator=(const CircularBuffer& rhs) {
+    if (this != &rhs) {
+      CircularBuffer tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  CircularBuffer& operator=(CircularBuffer&& rhs) noexcept {
+    CircularBuffer tmp(mystl::move(rhs));
+    swap(tmp);
+    return *this;
+  }
+
+  CircularBuffer& operator=(std::initializer_list<value_type> ilist) {
+    assign(ilist);
+    return *this;
+  }
+
+  ~CircularBuffer() {
+    clear();
+    data_allocator::deallocate(buffer_, cap_);
+    buffer_ = nullptr;
+    cap_ = 0;
+    mask_ = 0;
+  }
+
+  // 迭代器相关操作
+  iterator begin() noexcept { return iterator(buffer_, mask_, head_); }
+  const_iterator begin() const noexcept { return const_iterator(buffer_, mask_, head_); }
+  iterator end() noexcept { return iterator(buffer_, mask_, head_ + size_); }
+  const_iterator end() const noexcept { return const_iterator(buffer_, mask_, head_ + size_); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  // 容量相关操作
+  bool empty() const noexcept { return size_ == 0; }
+  bool full() const noexcept { return size_ == cap_; }
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return cap_; }
+  size_type max_size() const noexcept { return (static_cast<size_type>(-1) / sizeof(T) + 1) / 2; }
+  void reserve(size_type n);
+
+  // 访问元素相关操作
+  reference operator[](size_type n) {
+    MYSTL_DEBUG(n < size_);
+    return buffer_[(head_ + n) & mask_];
+  }
+  const_reference operator[](size_type n) const {
+    MYSTL_DEBUG(n < size_);
+    return buffer_[(head_ + n) & mask_];
+  }
+  reference at(size_type n) {
+    THROW_OUT_OF_RANGE_IF(!(n < size_), "CircularBuffer<T>::at() subscript out of range");
+    return (*this)[n];
+  }
+  const_reference at(size_type n) const {
+    THROW_OUT_OF_RANGE_IF(!(n < size_), "CircularBuffer<T>::at() subscript out of range");
+    return (*this)[n];
+  }
+
+  reference front() {
+    MYSTL_DEBUG(!empty());
+    return buffer_[head_];
+  }
+  const_reference front() const {
+    MYSTL_DEBUG(!empty());
+    return buffer_[head_];
+  }
+  reference back() {
+    MYSTL_DEBUG(!empty());
+    return buffer_[(head_ + size_ - 1) & mask_];
+  }
+  const_reference back() const {
+    MYSTL_DEBUG(!empty());
+    return buffer_[(head_ + size_ - 1) & mask_];
+  }
+
+  // 以两段连续空间的形式访问元素
+  array_range array_one() noexcept { return array_range(buffer_ + head_, first_part()); }
+  const_array_range array_one() const noexcept {
+    return const_array_range(buffer_ + head_, first_part());
+  }
+  array_range array_two() noexcept { return array_range(buffer_, size_ - first_part()); }
+  const_array_range array_two() const noexcept {
+    return const_array_range(buffer_, size_ - first_part());
+  }
+
+  // 修改容器相关操作
+  // assign
+  void assign(size_type n, const value_type& value);
+
+  template <
+      typename IIter,
+      typename std::enable_if<mystl::IsInputIterator<IIter>::kValue, int>::type = 0>
+  void assign(IIter first, IIter last) {
+    clear();
+    copy_init(first, last, iterator_category(first));
+  }
+
+  void assign(std::initializer_list<value_type> ilist) { assign(ilist.begin(), ilist.end()); }
+
+  // emplace_front / emplace_back
+  template <typename... Args>
+  void emplace_front(Args&&... args);
+
+  template <typename... Args>
+  void emplace_back(Args&&... args);
+
+  // push_front / push_back
+  void push_front(const value_type& value) { emplace_front(value); }
+  void push_front(value_type&& value) { emplace_front(mystl::move(value)); }
+  void push_back(const value_type& value) { emplace_back(value); }
+  void push_back(value_type&& value) { emplace_back(mystl::move(value)); }
+
+  // pop_front / pop_back
+  void pop_front() {
+    MYSTL_DEBUG(!empty());
+    data_allocator::destroy(buffer_ + head_);
+    head_ = (head_ + 1) & mask_;
+    --size_;
+  }
+
+  void pop_back() {
+    MYSTL_DEBUG(!empty());
+    data_allocator::destroy(buffer_ + ((head_ + size_ - 1) & mask_));
+    --size_;
+  }
+
+  void clear() noexcept;
+  void swap(CircularBuffer& rhs) noexcept;
+
+ private:
+  // helper functions
+  size_type first_part() const noexcept { return mystl::min(size_, cap_ - head_); }
+  static size_type round_up(size_type n) noexcept;
+
+  void init_space(size_type n);
+  void fill_init(size_type n, const value_type& value);
+  template <typename IIter>
+  void copy_init(IIter first, IIter last, mystl::InputIteratorTag /*unused*/);
+  template <typename FIter>
+  void copy_init(FIter first, FIter last, mystl::ForwardIteratorTag /*unused*/);
+
+  void reallocate(size_type new_cap);
+  void make_room_front();
+  void make_room_back();
+};
+
+/*****************************************************************************************/
+
+// 返回不小于n的最小的2的幂
+template <typename T, bool Overwrite>
+typename CircularBuffer<T, Overwrite>::size_type CircularBuffer<T, Overwrite>::round_up(
+    size_type n) noexcept {
+  size_type cap = 1;
+  while (cap < n) {
+    cap <<= 1;
+  }
+  return cap;
+}
+
+// 预留至少能容纳n个元素的空间
+template <typename T, bool Overwrite>
+void CircularBuffer<T, Overwrite>::reserve(size_type n) {
+  if (n > cap_) {
+    THROW_LENGTH_ERROR_IF(
+        n > max_size(), "n can not larger than max_size() in CircularBuffer<T>::reserve(n)");
+    reallocate(round_up(n));
+  }
+}
+
+// 把容器的内容设为n个value，容量不足时扩大容量
+template <typename T, bool Overwrite>
+void CircularBuffer<T, Overwrite>::assign(size_type n, const value_type& value) {
+  clear();
+  reserve(n);
+  mystl::uninitialized_fill_n(buffer_, n, value);
+  size_ = n;
+}
+
+// 在头部就地构建元素
+template <typename T, bool Overwrite>
+template <typename... Args>
+void CircularBuffer<T, Overwrite>::emplace_front(Args&&... args) {
+  if (full()) {
+    // args可能引用容器中的元素，先构造出新元素，再腾出位置
+    value_type tmp(mystl::forward<Args>(args)...);
+    make_room_front();
+    head_ = (head_ - 1) & mask_;
+    data_allocator::construct(buffer_ + head_, mystl::move(tmp));
+  } else {
+    const size_type pos = (head_ - 1) & mask_;
+    data_allocator::construct(buffer_ + pos, mystl::forward<Args>(args)...);
+    head_ = pos;
+  }
+  ++size_;
+}
+
+// 在尾部就地构建元素
+template <typename T, bool Overwrite>
+template <typename... Args>
+void CircularBuffer<T, Overwrite>::emplace_back(Args&&... args) {
+  if (full()) {
+    value_type tmp(mystl::forward<Args>(args)...);
+    make_room_back();
+    data_allocator::construct(buffer_ + ((head_ + size_) & mask_), mystl::move(tmp));
+  } else {
+    data_allocator::construct(buffer_ + ((head_ + size_) & mask_), mystl::forward<Args>(args)...);
+  }
+  ++size_;
+}
+
+// 清空容器，保留容量
+template <typename T, bool Overwrite>
+void CircularBuffer<T, Overwrite>::clear() noexcept {
+  const array_range one = array_one();
+  const array_range two = array_two();
+  mystl::destroy(one.first, one.first + one.second);
+  mystl::destroy(two.first, two.first + two.second);
+  head_ = 0;
+  size_ = 0;
+}
+
+// 交换两个CircularBuffer
+template <typename T, bool Overwrite>
+void CircularBuffer<T, Overwrite>::swap(CircularBuffer& rhs) noexcept {
+  if (this != &rhs) {
+    mystl::swap(buffer_, rhs.buffer_);
+    mystl::swap(cap_, rhs.cap_);
+    mystl::swap(mask_, rhs.mask_);
+    mystl::swap(head_, rhs.head_);
+    mystl::swap(size_, rhs.size_);
+  }
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 分配容量为n的空间，n会被调整为2的幂
+template <typename T, bool Overwrite>
+void CircularBuffer<T, Overwrite>::init_space(size_type n) {
+  if (n != 0) {
+    THROW_LENGTH_ERROR_IF(n > max_size(), "CircularBuffer<T>'s size too big");
+    cap_ = round_up(n);
+    mask_ = cap_ - 1;
+    buffer_ = data_allocator::allocate(cap_);
+  }
+  head_ = 0;
+  size_ = 0;
+}
+
+template <typename T, bool Overwrite>
+void CircularBuffer<T, Overwrite>::fill_init(size_type n, const value_type& value) {
+  init_space(n);
+  mystl::uninitialized_fill_n(buffer_, n, value);
+  size_ = n;
+}
+
+// 输入迭代器无法预知元素个数，逐个插入到尾部
+template <typename T, bool Overwrite>
+template <typename IIter>
+void CircularBuffer<T, Overwrite>::copy_init(
+    IIter first, IIter last, mystl::InputIteratorTag /*unused*/) {
+  for (; first != last; ++first) {
+    emplace_back(*first);
+  }
+}
+
+// 前向迭代器先预留空间，容量不足时即使 Overwrite 为 true 也会扩大容量
+template <typename T, bool Overwrite>
+template <typename FIter>
+void CircularBuffer<T, Overwrite>::copy_init(
+    FIter first, FIter last, mystl::ForwardIteratorTag /*unused*/) {
+  const size_type n = mystl::distance(first, last);
+  reserve(n);
+  mystl::uninitialized_copy(first, last, buffer_);
+  head_ = 0;
+  size_ = n;
+}
+
+// 把元素按顺序移动到容量为new_cap的新空间中，新空间中的元素从下标0开始
+// 移动构造可能抛出异常时改为复制，失败时销毁已构造的元素并释放新空间，原来的元素保持不变
+template <typename T, bool Overwrite>
+void CircularBuffer<T, Overwrite>::reallocate(size_type new_cap) {
+  pointer new_buffer = data_allocator::allocate(new_cap);
+  const array_range one = array_one();
+  const array_range two = array_two();
+  pointer cur = new_buffer;
+  try {
+    cur = mystl::uninitialized_move_if_noexcept(one.first, one.first + one.second, new_buffer);
+    mystl::uninitialized_move_if_noexcept(two.first, two.first + two.second, cur);
+  } catch (...) {
+    mystl::destroy(new_buffer, cur);
+    data_allocator::deallocate(new_buffer, new_cap);
+    throw;
+  }
+  mystl::destroy(one.first, one.first + one.second);
+  mystl::destroy(two.first, two.first + two.second);
+  data_allocator::deallocate(buffer_, cap_);
+  buffer_ = new_buffer;
+  cap_ = new_cap;
+  mask_ = new_cap - 1;
+  head_ = 0;
+}
+
+// 容量已满时在头部腾出一个位置：Overwrite 为 true 时丢弃尾部的元素，否则扩大容量
+template <typename T, bool Overwrite>
+void CircularBuffer<T, Overwrite>::make_room_front() {
+  if (Overwrite && cap_ != 0) {
+    pop_back();
+  } else {
+    reallocate(cap_ == 0 ? CIRCULAR_BUFFER_INIT_SIZE : cap_ * 2);
+  }
+}
+
+// 容量已满时在尾部腾出一个位置：Overwrite 为 true 时丢弃头部的元素，否则扩大容量
+template <typename T, bool Overwrite>
+void CircularBuffer<T, Overwrite>::make_room_back() {
+  if (Overwrite && cap_ != 0) {
+    pop_front();
+  } else {
+    reallocate(cap_ == 0 ? CIRCULAR_BUFFER_INIT_SIZE : cap_ * 2);
+  }
+}
+
+// 重载比较操作符
+template <typename T, bool Overwrite>
+bool operator==(const CircularBuffer<T, Overwrite>& lhs, const CircularBuffer<T, Overwrite>& rhs) {
+  return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, bool Overwrite>
+bool operator<(const CircularBuffer<T, Overwrite>& lhs, const CircularBuffer<T, Overwrite>& rhs) {
+  return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, bool Overwrite>
+bool operator!=(const CircularBuffer<T, Overwrite>& lhs, const CircularBuffer<T, Overwrite>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename T, bool Overwrite>
+bool operator>(const CircularBuffer<T, Overwrite>& lhs, const CircularBuffer<T, Overwrite>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename T, bool Overwrite>
+bool operator<=(const CircularBuffer<T, Overwrite>& lhs, const CircularBuffer<T, Overwrite>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename T, bool Overwrite>
+bool operator>=(const CircularBuffer<T, Overwrite>& lhs, const CircularBuffer<T, Overwrite>& rhs) {
+  return !(lhs < rhs);
+}
+
+// 重载mystl的swap
+template <typename T, bool Overwrite>
+void swap(CircularBuffer<T, Overwrite>& lhs, CircularBuffer<T, Overwrite>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_CIRCULAR_BUFFER_H_
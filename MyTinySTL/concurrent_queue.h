@@ -0,0 +1,512 @@
+#ifndef MYTINYSTL_CONCURRENT_QUEUE_H_
+#define MYTINYSTL_CONCURRENT_QUEUE_H_
+
+// 这个头文件包含用于线程间传递数据的有界队列
+// SpscQueue : 单生产者单消费者的无锁环形队列
+// MpmcQueue : 多生产者多消费者的无锁环形队列
+
+// notes:
+//
+// SpscQueue 的容量在构造时确定并调整为2的幂，之后不再分配内存
+// head_ 与 tail_ 是只增不减的计数，下标为计数与 mask_ 按位与的结果，tail_ - head_ 为元素个数
+// 生产者只写 tail_，消费者只写 head_，二者分别放在不同的缓存行中，避免伪共享；
+// 各自还缓存一份对方的计数，只有缓存的值显示空位（或元素）不够时才去读取对方的缓存行
+//
+// try_ 开头的函数不会等待，失败时返回 false（批量版本返回实际处理的元素个数）；
+// 其余版本在队列已满（或已空）时自旋等待，并调用 std::this_thread::yield 让出处理器
+//
+// 线程安全：同一时刻最多只能有一个线程调用 push 一类的函数，最多只能有一个线程调用 pop 一类的函数
+//
+// MpmcQueue 采用 Dmitry Vyukov 的有界队列算法：每个槽位带有一个序号，
+// 序号等于入队计数时槽位可写，等于入队计数加一时槽位可读，
+// 生产者（消费者）之间只在 enqueue_pos_（dequeue_pos_）上做一次 CAS 来抢占槽位
+// 接口与 mystl::Queue 一致：push / emplace 放入元素，pop(value) 取出队首元素，
+// 由于 front 与 pop 分开调用在并发时没有意义，取出的元素通过参数返回
+// 抢到槽位后构造元素不能失败，否则槽位永远不会被发布，因此：
+//   * 能够 noexcept 构造时直接在槽位中构造
+//   * 否则先在槽位外构造一个临时对象，再移动进去，此时要求 T 的移动构造函数不抛出异常
+
+#include <atomic>
+#include <thread>
+#include <type_traits>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "util.h"
+
+namespace mystl {
+
+// 缓存行的大小，用于隔开被不同线程频繁写入的数据
+#ifndef MYSTL_CACHE_LINE_SIZE
+#define MYSTL_CACHE_LINE_SIZE 64
+#endif
+
+// 模板类SpscQueue
+// 参数一代表数据类型
+template <typename T>
+class SpscQueue {
+ public:
+  using allocator_type = mystl::Allocator<T>;
+  using data_allocator = mystl::Allocator<T>;
+
+  using value_type = T;
+  using pointer = T*;
+  using reference = T&;
+  using size_type = size_t;
+
+ private:
+  // 构造后只读的数据
+  alignas(MYSTL_CACHE_LINE_SIZE) pointer buffer_;
+  size_type mask_;
+
+  // 消费者写入的数据
+  alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<size_type> head_;
+  size_type cached_tail_;  // 消费者最近一次读到的 tail_
+
+  // 生产者写入的数据
+  alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<size_type> tail_;
+  size_type cached_head_;  // 生产者最近一次读到的 head_
+
+ public:
+  // 构造、析构函数，容量会被调整为不小于capacity的2的幂
+  explicit SpscQueue(size_type capacity);
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  ~SpscQueue();
+
+  // 容量相关操作，在并发修改时 size / empty 只是一个近似值
+  size_type capacity() const noexcept { return mask_ + 1; }
+  size_type size() const noexcept {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+  // 生产者使用的函数
+  template <typename... Args>
+  bool try_emplace(Args&&... args);
+
+  bool try_push(const value_type& value) { return try_emplace(value); }
+  bool try_push(value_type&& value) { return try_emplace(mystl::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    wait_for_room();
+    try_emplace(mystl::forward<Args>(args)...);
+  }
+
+  void push(const value_type& value) { emplace(value); }
+  void push(value_type&& value) { emplace(mystl::move(value)); }
+
+  // 从first开始尽量放入n个元素，只发布一次 tail_，返回放入的个数
+  template <typename ForwardIter>
+  size_type try_push_n(ForwardIter first, size_type n);
+
+  // 放入[first, first + n)的全部元素
+  template <typename ForwardIter>
+  void push_n(ForwardIter first, size_type n);
+
+  // 消费者使用的函数
+  bool try_pop(value_type& value);
+
+  void pop(value_type& value) {
+    while (!try_pop(value)) {
+      std::this_thread::yield();
+    }
+  }
+
+  // 尽量取出n个元素依次写入result，只发布一次 head_，返回取出的个数
+  template <typename ForwardIter>
+  size_type try_pop_n(ForwardIter result, size_type n);
+
+  // 取出n个元素依次写入result
+  template <typename ForwardIter>
+  void pop_n(ForwardIter result, size_type n);
+
+ private:
+  // helper functions
+  size_type free_slots(size_type tail, size_type want);
+  size_type ready_slots(size_type head, size_type want);
+
+  void wait_for_room() {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    while (free_slots(tail, 1) == 0) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+/*****************************************************************************************/
+
+template <typename T>
+SpscQueue<T>::SpscQueue(size_type capacity)
+    : head_(0), cached_tail_(0), tail_(0), cached_head_(0) {
+  THROW_LENGTH_ERROR_IF(
+      capacity > static_cast<size_type>(-1) / sizeof(T) / 2, "SpscQueue<T>'s capacity too big");
+  size_type cap = 1;
+  while (cap < capacity) {
+    cap <<= 1;
+  }
+  buffer_ = data_allocator::allocate(cap);
+  mask_ = cap - 1;
+}
+
+template <typename T>
+SpscQueue<T>::~SpscQueue() {
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  for (size_type head = head_.load(std::memory_order_relaxed); head != tail; ++head) {
+    data_allocator::destroy(buffer_ + (head & mask_));
+  }
+  data_allocator::deallocate(buffer_, mask_ + 1);
+}
+
+// 在尾部就地构建元素，队列已满时返回false
+template <typename T>
+template <typename... Args>
+bool SpscQueue<T>::try_emplace(Args&&... args) {
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  if (free_slots(tail, 1) == 0) {
+    return false;
+  }
+  data_allocator::construct(buffer_ + (tail & mask_), mystl::forward<Args>(args)...);
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+template <typename ForwardIter>
+typename SpscQueue<T>::size_type SpscQueue<T>::try_push_n(ForwardIter first, size_type n) {
+  const size_type tail = tail_.load(std::memory_order_relaxed);
+  const size_type count = mystl::min(n, free_slots(tail, n));
+  size_type i = 0;
+  try {
+    for (; i < count; ++i, ++first) {
+      data_allocator::construct(buffer_ + ((tail + i) & mask_), *first);
+    }
+  } catch (...) {
+    // 已经构造好的元素照常发布
+    tail_.store(tail + i, std::memory_order_release);
+    throw;
+  }
+  tail_.store(tail + count, std::memory_order_release);
+  return count;
+}
+
+template <typename T>
+template <typename ForwardIter>
+void SpscQueue<T>::push_n(ForwardIter first, size_type n) {
+  while (n != 0) {
+    const size_type count = try_push_n(first, n);
+    if (count == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    mystl::advance(first, count);
+    n -= count;
+  }
+}
+
+// 从头部取出一个元素，队列为空时返回false
+template <typename T>
+bool SpscQueue<T>::try_pop(value_type& value) {
+  const size_type head = head_.load(std::memory_order_relaxed);
+  if (ready_slots(head, 1) == 0) {
+    return false;
+  }
+  pointer p = buffer_ + (head & mask_);
+  value = mystl::move(*p);
+  data_allocator::destroy(p);
+  head_.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+template <typename ForwardIter>
+typename SpscQueue<T>::size_type SpscQueue<T>::try_pop_n(ForwardIter result, size_type n) {
+  const size_type head = head_.load(std::memory_order_relaxed);
+  const size_type count = mystl::min(n, ready_slots(head, n));
+  size_type i = 0;
+  try {
+    for (; i < count; ++i, ++result) {
+      pointer p = buffer_ + ((head + i) & mask_);
+      *result = mystl::move(*p);
+      data_allocator::destroy(p);
+    }
+  } catch (...) {
+    // 已经取出的元素照常归还空间
+    head_.store(head + i, std::memory_order_release);
+    throw;
+  }
+  head_.store(head + count, std::memory_order_release);
+  return count;
+}
+
+template <typename T>
+template <typename ForwardIter>
+void SpscQueue<T>::pop_n(ForwardIter result, size_type n) {
+  while (n != 0) {
+    const size_type count = try_pop_n(result, n);
+    if (count == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    mystl::advance(result, count);
+    n -= count;
+  }
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 生产者可用的空位数，先看缓存的 head_，不足want个时再读取消费者的缓存行
+template <typename T>
+typename SpscQueue<T>::size_type SpscQueue<T>::free_slots(size_type tail, size_type want) {
+  size_type free = capacity() - (tail - cached_head_);
+  if (free < want) {
+    cached_head_ = head_.load(std::memory_order_acquire);
+    free = capacity() - (tail - cached_head_);
+  }
+  return free;
+}
+
+// 消费者可取的元素个数，先看缓存的 tail_，不足want个时再读取生产者的缓存行
+template <typename T>
+typename SpscQueue<T>::size_type SpscQueue<T>::ready_slots(size_type head, size_type want) {
+  size_type ready = cached_tail_ - head;
+  if (ready < want) {
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    ready = cached_tail_ - head;
+  }
+  return ready;
+}
+
+/*****************************************************************************************/
+
+// MpmcQueue的槽位
+template <typename T>
+struct MpmcQueueCell {
+  std::atomic<size_t> sequence;
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+  T* value() noexcept { return reinterpret_cast<T*>(&storage); }
+};
+
+// 模板类MpmcQueue
+// 参数一代表数据类型
+template <typename T>
+class MpmcQueue {
+ public:
+  using cell_type = MpmcQueueCell<T>;
+  using allocator_type = mystl::Allocator<T>;
+  using data_allocator = mystl::Allocator<T>;
+  using cell_allocator = mystl::Allocator<cell_type>;
+
+  using value_type = T;
+  using pointer = T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+
+ private:
+  // 构造后只读的数据
+  alignas(MYSTL_CACHE_LINE_SIZE) cell_type* buffer_;
+  size_type mask_;
+
+  // 生产者共享的入队计数
+  alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<size_type> enqueue_pos_;
+
+  // 消费者共享的出队计数
+  alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<size_type> dequeue_pos_;
+
+ public:
+  // 构造、析构函数，容量会被调整为不小于capacity的2的幂，至少为2
+  explicit MpmcQueue(size_type capacity);
+
+  MpmcQueue(const MpmcQueue&) = delete;
+  MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+  ~MpmcQueue();
+
+  // 容量相关操作，在并发修改时 size / empty 只是一个近似值
+  size_type capacity() const noexcept { return mask_ + 1; }
+  size_type size() const noexcept {
+    const size_type head = dequeue_pos_.load(std::memory_order_acquire);
+    const size_type tail = enqueue_pos_.load(std::memory_order_acquire);
+    return tail > head ? mystl::min(tail - head, capacity()) : 0;
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+  // 放入元素，try_ 版本在队列已满时返回false
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    return try_emplace_aux(std::is_nothrow_constructible<T, Args&&...>(),
+                           mystl::forward<Args>(args)...);
+  }
+
+  bool try_push(const value_type& value) { return try_emplace(value); }
+  bool try_push(value_type&& value) { return try_emplace(mystl::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    emplace_aux(std::is_nothrow_constructible<T, Args&&...>(), mystl::forward<Args>(args)...);
+  }
+
+  void push(const value_type& value) { emplace(value); }
+  void push(value_type&& value) { emplace(mystl::move(value)); }
+
+  // 取出队首元素，try_ 版本在队列为空时返回false
+  bool try_pop(value_type& value);
+
+  void pop(value_type& value) {
+    while (!try_pop(value)) {
+      std::this_thread::yield();
+    }
+  }
+
+ private:
+  // helper functions
+  cell_type* claim_enqueue(size_type& pos);
+
+  template <typename... Args>
+  bool try_emplace_aux(std::true_type, Args&&... args);
+  template <typename... Args>
+  bool try_emplace_aux(std::false_type, Args&&... args);
+  template <typename... Args>
+  void emplace_aux(std::true_type, Args&&... args);
+  template <typename... Args>
+  void emplace_aux(std::false_type, Args&&... args);
+};
+
+/*****************************************************************************************/
+
+template <typename T>
+MpmcQueue<T>::MpmcQueue(size_type capacity) : enqueue_pos_(0), dequeue_pos_(0) {
+  THROW_LENGTH_ERROR_IF(capacity > static_cast<size_type>(-1) / sizeof(cell_type) / 2,
+                        "MpmcQueue<T>'s capacity too big");
+  size_type cap = 2;
+  while (cap < capacity) {
+    cap <<= 1;
+  }
+  buffer_ = cell_allocator::allocate(cap);
+  for (size_type i = 0; i < cap; ++i) {
+    ::new (static_cast<void*>(&buffer_[i].sequence)) std::atomic<size_type>(i);
+  }
+  mask_ = cap - 1;
+}
+
+template <typename T>
+MpmcQueue<T>::~MpmcQueue() {
+  const size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+  for (size_type pos = dequeue_pos_.load(std::memory_order_relaxed); pos != tail; ++pos) {
+    data_allocator::destroy(buffer_[pos & mask_].value());
+  }
+  cell_allocator::deallocate(buffer_, mask_ + 1);
+}
+
+// 取出队首元素，队列为空时返回false
+template <typename T>
+bool MpmcQueue<T>::try_pop(value_type& value) {
+  size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+  cell_type* cell;
+  for (;;) {
+    cell = &buffer_[pos & mask_];
+    const size_type seq = cell->sequence.load(std::memory_order_acquire);
+    const auto dif = static_cast<ptrdiff_t>(seq - (pos + 1));
+    if (dif == 0) {
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (dif < 0) {
+      return false;
+    } else {
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  // 移动赋值失败时元素丢失，但槽位仍要归还，否则队列会卡住
+  try {
+    value = mystl::move(*cell->value());
+  } catch (...) {
+    data_allocator::destroy(cell->value());
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    throw;
+  }
+  data_allocator::destroy(cell->value());
+  cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+  return true;
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 抢占一个可写的槽位，队列已满时返回nullptr
+template <typename T>
+typename MpmcQueue<T>::cell_type* MpmcQueue<T>::claim_enqueue(size_type& pos) {
+  pos = enqueue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    cell_type* cell = &buffer_[pos & mask_];
+    const size_type seq = cell->sequence.load(std::memory_order_acquire);
+    const auto dif = static_cast<ptrdiff_t>(seq - pos);
+    if (dif == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        return cell;
+      }
+    } else if (dif < 0) {
+      return nullptr;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+// 构造不会抛出异常：抢到槽位后直接在其中构造
+template <typename T>
+template <typename... Args>
+bool MpmcQueue<T>::try_emplace_aux(std::true_type, Args&&... args) {
+  size_type pos;
+  cell_type* cell = claim_enqueue(pos);
+  if (cell == nullptr) {
+    return false;
+  }
+  data_allocator::construct(cell->value(), mystl::forward<Args>(args)...);
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+// 构造可能抛出异常：先在槽位外构造，再移动进去
+template <typename T>
+template <typename... Args>
+bool MpmcQueue<T>::try_emplace_aux(std::false_type, Args&&... args) {
+  static_assert(std::is_nothrow_move_constructible<T>::value,
+                "MpmcQueue<T> requires T to be nothrow move constructible");
+  value_type tmp(mystl::forward<Args>(args)...);
+  return try_emplace_aux(std::true_type(), mystl::move(tmp));
+}
+
+// 队列已满时自旋等待，构造不会抛出异常：等到槽位后直接在其中构造
+template <typename T>
+template <typename... Args>
+void MpmcQueue<T>::emplace_aux(std::true_type, Args&&... args) {
+  size_type pos;
+  cell_type* cell;
+  while ((cell = claim_enqueue(pos)) == nullptr) {
+    std::this_thread::yield();
+  }
+  data_allocator::construct(cell->value(), mystl::forward<Args>(args)...);
+  cell->sequence.store(pos + 1, std::memory_order_release);
+}
+
+// 构造可能抛出异常：只在槽位外构造一次，等到槽位后再移动进去
+template <typename T>
+template <typename... Args>
+void MpmcQueue<T>::emplace_aux(std::false_type, Args&&... args) {
+  static_assert(std::is_nothrow_move_constructible<T>::value,
+                "MpmcQueue<T> requires T to be nothrow move constructible");
+  value_type tmp(mystl::forward<Args>(args)...);
+  emplace_aux(std::true_type(), mystl::move(tmp));
+}
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_CONCURRENT_QUEUE_H_
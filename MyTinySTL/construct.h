@@ -51,7 +51,7 @@ void destroy_cat(ForwardIter /*unused*/, ForwardIter /*unused*/, std::true_type
 template <typename ForwardIter>
 void destroy_cat(ForwardIter first, ForwardIter last, std::false_type /*unused*/) {
   for (; first != last; ++first) {
-    destroy(&*first);
+    mystl::destroy_one(&*first, std::false_type{});
   }
 }
 
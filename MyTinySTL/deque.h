@@ -39,16 +39,47 @@ namespace mystl {
 #define DEQUE_MAP_INIT_SIZE 8
 #endif
 
-template <typename T>
+// deque缺省缓存的空闲缓冲区个数
+#ifndef DEQUE_BUFFER_CACHE_SIZE
+#define DEQUE_BUFFER_CACHE_SIZE 2
+#endif
+
+// 缓冲区的大小，BufSize为0时使用缺省值：元素小于256字节时缓冲区为4096字节，否则为16个元素
+template <typename T, size_t BufSize = 0>
 struct DequeBufSize {
-  static constexpr size_t kValue = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+  static constexpr size_t kValue =
+      BufSize != 0 ? BufSize : (sizeof(T) < 256 ? 4096 / sizeof(T) : 16);
+};
+
+// 最近释放的至多Depth个缓冲区，分配缓冲区时优先复用，避免在缓冲区边界附近反复分配、释放
+template <typename T, size_t Depth>
+struct DequeBufferCache {
+  T* buffers[Depth];
+  size_t count = 0;
+
+  T* pop() noexcept { return count == 0 ? nullptr : buffers[--count]; }
+
+  bool push(T* p) noexcept {
+    if (count == Depth) {
+      return false;
+    }
+    buffers[count++] = p;
+    return true;
+  }
+};
+
+template <typename T>
+struct DequeBufferCache<T, 0> {
+  T* pop() noexcept { return nullptr; }
+  bool push(T*) noexcept { return false; }
 };
 
 // deque迭代器设计
-template <typename T, typename Ref, typename Ptr>
+// 参数四为缓冲区的元素个数
+template <typename T, typename Ref, typename Ptr, size_t BufSize = DequeBufSize<T>::kValue>
 struct DequeIterator : public Iterator<RandomAccessIteratorTag, T> {
-  using iterator = DequeIterator<T, T&, T*>;
-  using const_iterator = DequeIterator<T, const T&, const T*>;
+  using iterator = DequeIterator<T, T&, T*, BufSize>;
+  using const_iterator = DequeIterator<T, const T&, const T*, BufSize>;
   using self = DequeIterator;
 
   using value_type = T;
@@ -59,7 +90,7 @@ struct DequeIterator : public Iterator<RandomAccessIteratorTag, T> {
   using value_pointer = T*;
   using map_pointer = T**;
 
-  static const size_type kBufferSize = DequeBufSize<T>::kValue;
+  static const size_type kBufferSize = BufSize;
 
   // 迭代器所含成员数据
   value_pointer cur;    // 指向所在缓冲区的当前元素
@@ -87,7 +118,7 @@ struct DequeIterator : public Iterator<RandomAccessIteratorTag, T> {
   DequeIterator(const const_iterator& rhs)
       : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node) {}
 
-  self& operator=(const iterator& rhs) {
+  self& operator=(const self& rhs) {
     if (this != &rhs) {
       cur = rhs.cur;
       first = rhs.first;
@@ -184,11 +215,32 @@ struct DequeIterator : public Iterator<RandomAccessIteratorTag, T> {
   bool operator>=(const self& rhs) const { return !(*this < rhs); }
 };
 
+// deque迭代器是分段迭代器，每个缓冲区是一段，copy、fill、find 等算法可以逐段走指针版本
+template <typename T, typename Ref, typename Ptr, size_t BufSize>
+struct SegmentedIteratorTraits<DequeIterator<T, Ref, Ptr, BufSize>> : public m_true_type {
+  using iterator = DequeIterator<T, Ref, Ptr, BufSize>;
+  using segment_iterator = typename iterator::map_pointer;
+  using local_iterator = Ptr;
+
+  static segment_iterator segment(const iterator& it) { return it.node; }
+  static local_iterator local(const iterator& it) { return it.cur; }
+  static local_iterator begin(segment_iterator seg) { return *seg; }
+  static local_iterator end(segment_iterator seg) { return *seg + BufSize; }
+
+  static iterator compose(segment_iterator seg, local_iterator local) {
+    return iterator(const_cast<T*>(local), seg);
+  }
+};
+
 // 模板类deque
-// 模板参数代表数据类型
-template <typename T>
+// 参数一代表数据类型，参数二代表每个缓冲区的元素个数，为0时使用缺省值，
+// 参数三代表最多缓存多少个空闲缓冲区，为0时不缓存
+template <typename T, size_t BufSize = 0, size_t CacheDepth = DEQUE_BUFFER_CACHE_SIZE>
 class Deque {
  public:
+  static const size_t kBufferSize = DequeBufSize<T, BufSize>::kValue;
+  static const size_t kCacheDepth = CacheDepth;
+
   using allocator_type = mystl::Allocator<T>;
   using data_allocator = mystl::Allocator<T>;
   using map_allocator = mystl::Allocator<T*>;
@@ -203,20 +255,19 @@ class Deque {
   using map_pointer = pointer*;
   using const_map_pointer = const_pointer*;
 
-  using iterator = DequeIterator<T, T&, T*>;
-  using const_iterator = DequeIterator<T, const T&, const T*>;
+  using iterator = DequeIterator<T, T&, T*, kBufferSize>;
+  using const_iterator = DequeIterator<T, const T&, const T*, kBufferSize>;
   using reverse_iterator = mystl::ReverseIterator<iterator>;
   using const_reverse_iterator = mystl::ReverseIterator<const_iterator>;
 
   allocator_type get_allocator() { return allocator_type(); }
 
-  static const size_type kBufferSize = DequeBufSize<T>::kValue;
-
  private:
   iterator begin_;  // 指向第一个结点
   iterator end_;    // 指向最后一个结点
   map_pointer map_;  // 指向一块map，map中的每个元素都是一个指针，指向一个缓冲区
   size_type map_size_;  // map内指针的数目
+  DequeBufferCache<T, CacheDepth> cache_;  // 空闲缓冲区
 
  public:
   Deque() { fill_init(0, value_type()); }
@@ -264,6 +315,7 @@ class Deque {
       map_allocator::deallocate(map_, map_size_);
       map_ = nullptr;
     }
+    release_cache();
   }
 
  public:
@@ -391,6 +443,9 @@ class Deque {
 
   // create node / destroy node
   map_pointer create_map(size_type size);
+  pointer allocate_buffer();
+  void deallocate_buffer(pointer p) noexcept;
+  void release_cache() noexcept;
   void create_buffer(map_pointer nstart, map_pointer nfinish);
   void destroy_buffer(map_pointer nstart, map_pointer nfinish);
 
@@ -424,11 +479,12 @@ class Deque {
   void require_capacity(size_type n, bool front);
   void reallocate_map_at_front(size_type need);
   void reallocate_map_at_back(size_type need);
+  void move_map_nodes(map_pointer dest) noexcept;
 };
 
 // 复制赋值运算符
-template <typename T>
-Deque<T>& Deque<T>::operator=(const Deque& rhs) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+Deque<T, BufSize, CacheDepth>& Deque<T, BufSize, CacheDepth>::operator=(const Deque& rhs) {
   if (this != &rhs) {
     const auto len = size();
     if (len >= rhs.size()) {
@@ -443,21 +499,17 @@ Deque<T>& Deque<T>::operator=(const Deque& rhs) {
 }
 
 // 移动赋值运算符
-template <typename T>
-Deque<T>& Deque<T>::operator=(Deque&& rhs) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+Deque<T, BufSize, CacheDepth>& Deque<T, BufSize, CacheDepth>::operator=(Deque&& rhs) {
+  // 原有的map与头部缓冲区交给rhs释放
   clear();
-  begin_ = mystl::move(rhs.begin_);
-  end_ = mystl::move(rhs.end_);
-  map_ = rhs.map_;
-  map_size_ = rhs.map_size_;
-  rhs.map_ = nullptr;
-  rhs.map_size_ = 0;
+  swap(rhs);
   return *this;
 }
 
 // 重置容器大小
-template <typename T>
-void Deque<T>::resize(size_type new_size, const value_type& value) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::resize(size_type new_size, const value_type& value) {
   const auto len = size();
   if (new_size < len) {
     erase(begin_ + new_size, end_);
@@ -466,9 +518,10 @@ void Deque<T>::resize(size_type new_size, const value_type& value) {
   }
 }
 
-// 减小容器容量
-template <typename T>
-void Deque<T>::shrink_to_fit() noexcept {
+// 减小容器容量，同时释放缓存的空闲缓冲区
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::shrink_to_fit() noexcept {
+  release_cache();
   // 至少会留下头部缓冲区
   for (auto cur = map_; cur < begin_.node; ++cur) {
     data_allocator::deallocate(*cur, kBufferSize);
@@ -481,9 +534,9 @@ void Deque<T>::shrink_to_fit() noexcept {
 }
 
 // 在头部就地构建元素
-template <typename T>
+template <typename T, size_t BufSize, size_t CacheDepth>
 template <typename... Args>
-void Deque<T>::emplace_front(Args&&... args) {
+void Deque<T, BufSize, CacheDepth>::emplace_front(Args&&... args) {
   if (begin_.cur != begin_.first) {
     data_allocator::construct(begin_.cur - 1, mystl::forward<Args>(args)...);
     --begin_.cur;
@@ -500,9 +553,9 @@ void Deque<T>::emplace_front(Args&&... args) {
 }
 
 // 在尾部就地构建元素
-template <typename T>
+template <typename T, size_t BufSize, size_t CacheDepth>
 template <typename... Args>
-void Deque<T>::emplace_back(Args&&... args) {
+void Deque<T, BufSize, CacheDepth>::emplace_back(Args&&... args) {
   if (end_.cur != end_.last - 1) {
     data_allocator::construct(end_.cur, mystl::forward<Args>(args)...);
     ++end_.cur;
@@ -514,9 +567,10 @@ void Deque<T>::emplace_back(Args&&... args) {
 }
 
 // 在pos位置就地构建元素
-template <typename T>
+template <typename T, size_t BufSize, size_t CacheDepth>
 template <typename... Args>
-typename Deque<T>::iterator Deque<T>::emplace(iterator pos, Args&&... args) {
+typename Deque<T, BufSize, CacheDepth>::iterator Deque<T, BufSize, CacheDepth>::emplace(
+    iterator pos, Args&&... args) {
   if (pos.cur == begin_.cur) {
     emplace_front(mystl::forward<Args>(args)...);
     return begin_;
@@ -529,8 +583,8 @@ typename Deque<T>::iterator Deque<T>::emplace(iterator pos, Args&&... args) {
 }
 
 // 在头部插入元素
-template <typename T>
-void Deque<T>::push_front(const value_type& value) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::push_front(const value_type& value) {
   if (begin_.cur != begin_.first) {
     data_allocator::construct(begin_.cur - 1, value);
     --begin_.cur;
@@ -547,8 +601,8 @@ void Deque<T>::push_front(const value_type& value) {
 }
 
 // 在尾部插入元素
-template <typename T>
-void Deque<T>::push_back(const value_type& value) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::push_back(const value_type& value) {
   if (end_.cur != end_.last - 1) {
     data_allocator::construct(end_.cur, value);
     ++end_.cur;
@@ -560,8 +614,8 @@ void Deque<T>::push_back(const value_type& value) {
 }
 
 // 弹出头部元素
-template <typename T>
-void Deque<T>::pop_front() {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::pop_front() {
   MYSTL_DEBUG(!empty());
   if (begin_.cur != begin_.last - 1) {
     data_allocator::destroy(begin_.cur);
@@ -574,8 +628,8 @@ void Deque<T>::pop_front() {
 }
 
 // 弹出尾部元素
-template <typename T>
-void Deque<T>::pop_back() {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::pop_back() {
   MYSTL_DEBUG(!empty());
   if (end_.cur != end_.first) {
     --end_.cur;
@@ -588,8 +642,9 @@ void Deque<T>::pop_back() {
 }
 
 // 在position处插入元素
-template <typename T>
-typename Deque<T>::iterator Deque<T>::insert(iterator position, const value_type& value) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+typename Deque<T, BufSize, CacheDepth>::iterator Deque<T, BufSize, CacheDepth>::insert(
+    iterator position, const value_type& value) {
   if (position.cur == begin_.cur) {
     push_front(value);
     return begin_;
@@ -603,8 +658,9 @@ typename Deque<T>::iterator Deque<T>::insert(iterator position, const value_type
   return insert_aux(position, value);
 }
 
-template <typename T>
-typename Deque<T>::iterator Deque<T>::insert(iterator position, value_type&& value) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+typename Deque<T, BufSize, CacheDepth>::iterator Deque<T, BufSize, CacheDepth>::insert(
+    iterator position, value_type&& value) {
   if (position.cur == begin_.cur) {
     emplace_front(mystl::move(value));
     return begin_;
@@ -619,8 +675,9 @@ typename Deque<T>::iterator Deque<T>::insert(iterator position, value_type&& val
 }
 
 // 在position位置插入n个元素
-template <typename T>
-void Deque<T>::insert(iterator position, size_type n, const value_type& value) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::insert(
+    iterator position, size_type n, const value_type& value) {
   if (position.cur == begin_.cur) {
     require_capacity(n, true);
     auto new_begin = begin_ - n;
@@ -637,8 +694,9 @@ void Deque<T>::insert(iterator position, size_type n, const value_type& value) {
 }
 
 // 删除position处的元素
-template <typename T>
-typename Deque<T>::iterator Deque<T>::erase(iterator position) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+typename Deque<T, BufSize, CacheDepth>::iterator Deque<T, BufSize, CacheDepth>::erase(
+    iterator position) {
   auto next = position;
   ++next;
   const size_type elems_before = position - begin_;
@@ -653,8 +711,9 @@ typename Deque<T>::iterator Deque<T>::erase(iterator position) {
 }
 
 // 删除[first, last)上的元素
-template <typename T>
-typename Deque<T>::iterator Deque<T>::erase(iterator first, iterator last) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+typename Deque<T, BufSize, CacheDepth>::iterator Deque<T, BufSize, CacheDepth>::erase(
+    iterator first, iterator last) {
   if (first == begin_ && last == end_) {
     clear();
     return end_;
@@ -664,20 +723,26 @@ typename Deque<T>::iterator Deque<T>::erase(iterator first, iterator last) {
   if (elems_before < ((size() - len) / 2)) {
     mystl::copy_backward(begin_, first, last);
     auto new_begin = begin_ + len;
-    data_allocator::destroy(begin_.cur, new_begin.cur);
+    mystl::destroy(begin_, new_begin);
+    if (new_begin.node != begin_.node) {
+      destroy_buffer(begin_.node, new_begin.node - 1);
+    }
     begin_ = new_begin;
   } else {
     mystl::copy(last, end_, first);
     auto new_end = end_ - len;
-    data_allocator::destroy(new_end.cur, end_.cur);
+    mystl::destroy(new_end, end_);
+    if (new_end.node != end_.node) {
+      destroy_buffer(new_end.node + 1, end_.node);
+    }
     end_ = new_end;
   }
   return begin_ + elems_before;
 }
 
 // 清空Deque
-template <typename T>
-void Deque<T>::clear() {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::clear() {
   // clear会保留头部的缓冲区
   for (map_pointer cur = begin_.node + 1; cur < end_.node; ++cur) {
     data_allocator::destroy(*cur, *cur + kBufferSize);
@@ -689,13 +754,14 @@ void Deque<T>::clear() {
   } else {
     mystl::destroy(begin_.cur, end_.cur);
   }
-  shrink_to_fit();
+  // 先收缩到头部缓冲区，再由shrink_to_fit释放其余的缓冲区
   end_ = begin_;
+  shrink_to_fit();
 }
 
 // 交换两个Deque
-template <typename T>
-void Deque<T>::swap(Deque& rhs) noexcept {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::swap(Deque& rhs) noexcept {
   if (this != &rhs) {
     mystl::swap(begin_, rhs.begin_);
     mystl::swap(end_, rhs.end_);
@@ -706,8 +772,9 @@ void Deque<T>::swap(Deque& rhs) noexcept {
 
 // helper function
 
-template <typename T>
-typename Deque<T>::map_pointer Deque<T>::create_map(size_type size) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+typename Deque<T, BufSize, CacheDepth>::map_pointer Deque<T, BufSize, CacheDepth>::create_map(
+    size_type size) {
   map_pointer mp = nullptr;
   mp = map_allocator::allocate(size);
   for (size_type i = 0; i < size; ++i) {
@@ -717,17 +784,17 @@ typename Deque<T>::map_pointer Deque<T>::create_map(size_type size) {
 }
 
 // create_buffer函数
-template <typename T>
-void Deque<T>::create_buffer(map_pointer nstart, map_pointer nfinish) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::create_buffer(map_pointer nstart, map_pointer nfinish) {
   map_pointer cur;
   try {
     for (cur = nstart; cur <= nfinish; ++cur) {
-      *cur = data_allocator::allocate(kBufferSize);
+      *cur = allocate_buffer();
     }
   } catch (...) {
     while (cur != nstart) {
       --cur;
-      data_allocator::deallocate(*cur, kBufferSize);
+      deallocate_buffer(*cur);
       *cur = nullptr;
     }
     throw;
@@ -735,17 +802,40 @@ void Deque<T>::create_buffer(map_pointer nstart, map_pointer nfinish) {
 }
 
 // destroy_buffer函数
-template <typename T>
-void Deque<T>::destroy_buffer(map_pointer nstart, map_pointer nfinish) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::destroy_buffer(map_pointer nstart, map_pointer nfinish) {
   for (map_pointer n = nstart; n <= nfinish; ++n) {
-    data_allocator::deallocate(*n, kBufferSize);
+    deallocate_buffer(*n);
     *n = nullptr;
   }
 }
 
+// 分配一个缓冲区，优先使用缓存的空闲缓冲区
+template <typename T, size_t BufSize, size_t CacheDepth>
+typename Deque<T, BufSize, CacheDepth>::pointer Deque<T, BufSize, CacheDepth>::allocate_buffer() {
+  pointer p = cache_.pop();
+  return p != nullptr ? p : data_allocator::allocate(kBufferSize);
+}
+
+// 释放一个缓冲区，缓存未满时留待之后复用
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::deallocate_buffer(pointer p) noexcept {
+  if (!cache_.push(p)) {
+    data_allocator::deallocate(p, kBufferSize);
+  }
+}
+
+// 把缓存的空闲缓冲区全部归还
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::release_cache() noexcept {
+  for (pointer p = cache_.pop(); p != nullptr; p = cache_.pop()) {
+    data_allocator::deallocate(p, kBufferSize);
+  }
+}
+
 // map_init函数
-template <typename T>
-void Deque<T>::map_init(size_type nElem) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::map_init(size_type nElem) {
   const size_type nNode = nElem / kBufferSize + 1;
   map_size_ = mystl::max(static_cast<size_type>(DEQUE_MAP_INIT_SIZE), nNode + 2);
   try {
@@ -774,24 +864,22 @@ void Deque<T>::map_init(size_type nElem) {
 }
 
 // fill_init函数
-template <typename T>
-void Deque<T>::fill_init(size_type n, const value_type& value) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::fill_init(size_type n, const value_type& value) {
   map_init(n);
   if (n != 0) {
-    map_init(n);
-    if (n != 0) {
-      for (auto cur = begin_.node; cur < end_.node; ++cur) {
-        mystl::uninitialized_fill(*cur, *cur + kBufferSize, value);
-      }
-      mystl::uninitialized_fill(end_.first, end_.cur, value);
+    for (auto cur = begin_.node; cur < end_.node; ++cur) {
+      mystl::uninitialized_fill(*cur, *cur + kBufferSize, value);
     }
+    mystl::uninitialized_fill(end_.first, end_.cur, value);
   }
 }
 
 // copy_init函数
-template <typename T>
+template <typename T, size_t BufSize, size_t CacheDepth>
 template <typename IIter>
-void Deque<T>::copy_init(IIter first, IIter last, InputIteratorTag /*unused*/) {
+void Deque<T, BufSize, CacheDepth>::copy_init(
+    IIter first, IIter last, InputIteratorTag /*unused*/) {
   const size_type n = mystl::distance(first, last);
   map_init(n);
   for (; first != last; ++first) {
@@ -799,9 +887,10 @@ void Deque<T>::copy_init(IIter first, IIter last, InputIteratorTag /*unused*/) {
   }
 }
 
-template <typename T>
+template <typename T, size_t BufSize, size_t CacheDepth>
 template <typename FIter>
-void Deque<T>::copy_init(FIter first, FIter last, ForwardIteratorTag /*unused*/) {
+void Deque<T, BufSize, CacheDepth>::copy_init(
+    FIter first, FIter last, ForwardIteratorTag /*unused*/) {
   const size_type n = mystl::distance(first, last);
   map_init(n);
   for (auto cur = begin_.node; cur < end_.node; ++cur) {
@@ -814,8 +903,8 @@ void Deque<T>::copy_init(FIter first, FIter last, ForwardIteratorTag /*unused*/)
 }
 
 // fill_assign函数
-template <typename T>
-void Deque<T>::fill_assign(size_type n, const value_type& value) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::fill_assign(size_type n, const value_type& value) {
   if (n > size()) {
     mystl::fill(begin(), end(), value);
     insert(end(), n - size(), value);
@@ -826,9 +915,10 @@ void Deque<T>::fill_assign(size_type n, const value_type& value) {
 }
 
 // copy_assign函数
-template <typename T>
+template <typename T, size_t BufSize, size_t CacheDepth>
 template <typename IIter>
-void Deque<T>::copy_assign(IIter first, IIter last, InputIteratorTag /*unused*/) {
+void Deque<T, BufSize, CacheDepth>::copy_assign(
+    IIter first, IIter last, InputIteratorTag /*unused*/) {
   auto first1 = begin();
   auto last1 = end();
   for (; first != last && first1 != last1; ++first, ++first1) {
@@ -841,9 +931,10 @@ void Deque<T>::copy_assign(IIter first, IIter last, InputIteratorTag /*unused*/)
   }
 }
 
-template <typename T>
+template <typename T, size_t BufSize, size_t CacheDepth>
 template <typename FIter>
-void Deque<T>::copy_assign(FIter first, FIter last, ForwardIteratorTag /*unused*/) {
+void Deque<T, BufSize, CacheDepth>::copy_assign(
+    FIter first, FIter last, ForwardIteratorTag /*unused*/) {
   const size_type len1 = size();
   const size_type len2 = mystl::distance(first, last);
   if (len1 < len2) {
@@ -857,9 +948,10 @@ void Deque<T>::copy_assign(FIter first, FIter last, ForwardIteratorTag /*unused*
 }
 
 // insert_aux函数
-template <typename T>
+template <typename T, size_t BufSize, size_t CacheDepth>
 template <typename... Args>
-typename Deque<T>::iterator Deque<T>::insert_aux(iterator position, Args&&... args) {
+typename Deque<T, BufSize, CacheDepth>::iterator Deque<T, BufSize, CacheDepth>::insert_aux(
+    iterator position, Args&&... args) {
   const size_type elems_before = position - begin_;
   value_type value_copy = value_type(mystl::forward<Args>(args)...);
   if (elems_before < (size() / 2)) {
@@ -888,8 +980,9 @@ typename Deque<T>::iterator Deque<T>::insert_aux(iterator position, Args&&... ar
 }
 
 // fill_insert函数
-template <typename T>
-void Deque<T>::fill_insert(iterator position, size_type n, const value_type& value) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::fill_insert(
+    iterator position, size_type n, const value_type& value) {
   const size_type elems_before = position - begin_;
   const size_type len = size();
   auto value_copy = value;
@@ -908,7 +1001,7 @@ void Deque<T>::fill_insert(iterator position, size_type n, const value_type& val
         mystl::fill(position - n, position, value_copy);
       } else {
         mystl::uninitialized_fill(
-            mystl::unchecked_copy(begin_, position, new_begin), begin_, value_copy);
+            mystl::uninitialized_copy(begin_, position, new_begin), begin_, value_copy);
         begin_ = new_begin;
         mystl::fill(old_begin, position, value_copy);
       }
@@ -948,9 +1041,10 @@ void Deque<T>::fill_insert(iterator position, size_type n, const value_type& val
 }
 
 // copy_insert
-template <typename T>
+template <typename T, size_t BufSize, size_t CacheDepth>
 template <typename FIter>
-void Deque<T>::copy_insert(iterator position, FIter first, FIter last, size_type n) {
+void Deque<T, BufSize, CacheDepth>::copy_insert(
+    iterator position, FIter first, FIter last, size_type n) {
   const size_type elems_before = position - begin_;
   auto len = size();
   if (elems_before < (len / 2)) {
@@ -1011,9 +1105,9 @@ void Deque<T>::copy_insert(iterator position, FIter first, FIter last, size_type
 }
 
 // insert_dispatch函数
-template <typename T>
+template <typename T, size_t BufSize, size_t CacheDepth>
 template <typename IIter>
-void Deque<T>::insert_dispatch(
+void Deque<T, BufSize, CacheDepth>::insert_dispatch(
     iterator position, IIter first, IIter last, InputIteratorTag /*unused*/) {
   if (last <= first) {
     return;
@@ -1032,9 +1126,9 @@ void Deque<T>::insert_dispatch(
   }
 }
 
-template <typename T>
+template <typename T, size_t BufSize, size_t CacheDepth>
 template <typename FIter>
-void Deque<T>::insert_dispatch(
+void Deque<T, BufSize, CacheDepth>::insert_dispatch(
     iterator position, FIter first, FIter last, ForwardIteratorTag /*unused*/) {
   if (last <= first) {
     return;
@@ -1070,17 +1164,19 @@ void Deque<T>::insert_dispatch(
 }
 
 // require_capacity函数
-template <typename T>
-void Deque<T>::require_capacity(size_type n, bool front) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::require_capacity(size_type n, bool front) {
   if (front && (static_cast<size_type>(begin_.cur - begin_.first) < n)) {
-    const size_type need_buffer = (n - (begin_.cur - begin_.first)) / kBufferSize + 1;
+    // 恰好需要的缓冲区个数，多分配的缓冲区不在[begin_.node, end_.node]内，会被遗漏
+    const size_type need_buffer =
+        (n - (begin_.cur - begin_.first) + kBufferSize - 1) / kBufferSize;
     if (need_buffer > static_cast<size_type>(begin_.node - map_)) {
       reallocate_map_at_front(need_buffer);
       return;
     }
     create_buffer(begin_.node - need_buffer, begin_.node - 1);
   } else if (!front && (static_cast<size_type>(end_.last - end_.cur - 1) < n)) {
-    const size_type need_buffer = (n - (end_.last - end_.cur - 1)) / kBufferSize + 1;
+    const size_type need_buffer = (n - (end_.last - end_.cur - 1) + kBufferSize - 1) / kBufferSize;
     if (need_buffer > static_cast<size_type>((map_ + map_size_) - end_.node - 1)) {
       reallocate_map_at_back(need_buffer);
       return;
@@ -1090,13 +1186,20 @@ void Deque<T>::require_capacity(size_type n, bool front) {
 }
 
 // reallocate_map_at_front函数
-template <typename T>
-void Deque<T>::reallocate_map_at_front(size_type need_buffer) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::reallocate_map_at_front(size_type need_buffer) {
+  const size_type old_buffer = end_.node - begin_.node + 1;
+  const size_type new_buffer = old_buffer + need_buffer;
+  if (map_size_ > 2 * new_buffer) {
+    // map中的空位足够，只把已有的缓冲区移到中央，否则像队列那样一头进一头出时map会不断变大
+    auto begin = map_ + (map_size_ - new_buffer) / 2;
+    move_map_nodes(begin + need_buffer);
+    create_buffer(begin, begin_.node - 1);
+    return;
+  }
   const size_type new_map_size =
       mystl::max(map_size_ << 1, map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
   map_pointer new_map = create_map(new_map_size);
-  const size_type old_buffer = end_.node - begin_.node + 1;
-  const size_type new_buffer = old_buffer + need_buffer;
 
   // 另新的map中的指针指向原来的buffer，并开辟新的buffer
   auto begin = new_map + (new_map_size - new_buffer) / 2;
@@ -1116,13 +1219,19 @@ void Deque<T>::reallocate_map_at_front(size_type need_buffer) {
 }
 
 // reallocate_map_at_back函数
-template <typename T>
-void Deque<T>::reallocate_map_at_back(size_type need_buffer) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::reallocate_map_at_back(size_type need_buffer) {
+  const size_type old_buffer = end_.node - begin_.node + 1;
+  const size_type new_buffer = old_buffer + need_buffer;
+  if (map_size_ > 2 * new_buffer) {
+    // map中的空位足够，只把已有的缓冲区移到中央
+    move_map_nodes(map_ + (map_size_ - new_buffer) / 2);
+    create_buffer(end_.node + 1, end_.node + need_buffer);
+    return;
+  }
   const size_type new_map_size =
       mystl::max(map_size_ << 1, map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
   map_pointer new_map = create_map(new_map_size);
-  const size_type old_buffer = end_.node - begin_.node + 1;
-  const size_type new_buffer = old_buffer + need_buffer;
 
   // 另新的map中的指针指向原来的buffer，并开辟新的buffer
   auto begin = new_map + ((new_map_size - new_buffer) / 2);
@@ -1141,39 +1250,71 @@ void Deque<T>::reallocate_map_at_back(size_type need_buffer) {
   end_ = iterator(*(mid - 1) + (end_.cur - end_.first), mid - 1);
 }
 
+// 在map内把[begin_.node, end_.node]上的缓冲区指针移到以dest开头的位置，空出的位置置空，
+// 并更新begin_与end_
+template <typename T, size_t BufSize, size_t CacheDepth>
+void Deque<T, BufSize, CacheDepth>::move_map_nodes(map_pointer dest) noexcept {
+  const map_pointer first = begin_.node;
+  const map_pointer last = end_.node + 1;
+  const size_type n = last - first;
+  const auto begin_offset = begin_.cur - begin_.first;
+  const auto end_offset = end_.cur - end_.first;
+  if (dest < first) {
+    for (size_type i = 0; i < n; ++i) {
+      dest[i] = first[i];
+    }
+    for (map_pointer cur = mystl::max(first, dest + n); cur < last; ++cur) {
+      *cur = nullptr;
+    }
+  } else if (first < dest) {
+    for (size_type i = n; i > 0; --i) {
+      dest[i - 1] = first[i - 1];
+    }
+    for (map_pointer cur = first; cur < mystl::min(dest, last); ++cur) {
+      *cur = nullptr;
+    }
+  }
+  begin_ = iterator(*dest + begin_offset, dest);
+  end_ = iterator(*(dest + n - 1) + end_offset, dest + n - 1);
+}
+
 // 重载比较操作符
-template <typename T>
-bool operator==(const Deque<T>& lhs, const Deque<T>& rhs) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+bool operator==(
+    const Deque<T, BufSize, CacheDepth>& lhs, const Deque<T, BufSize, CacheDepth>& rhs) {
   return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <typename T>
-bool operator<(const Deque<T>& lhs, const Deque<T>& rhs) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+bool operator<(const Deque<T, BufSize, CacheDepth>& lhs, const Deque<T, BufSize, CacheDepth>& rhs) {
   return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T>
-bool operator!=(const Deque<T>& lhs, const Deque<T>& rhs) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+bool operator!=(
+    const Deque<T, BufSize, CacheDepth>& lhs, const Deque<T, BufSize, CacheDepth>& rhs) {
   return !(lhs == rhs);
 }
 
-template <typename T>
-bool operator>(const Deque<T>& lhs, const Deque<T>& rhs) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+bool operator>(const Deque<T, BufSize, CacheDepth>& lhs, const Deque<T, BufSize, CacheDepth>& rhs) {
   return rhs < lhs;
 }
 
-template <typename T>
-bool operator<=(const Deque<T>& lhs, const Deque<T>& rhs) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+bool operator<=(
+    const Deque<T, BufSize, CacheDepth>& lhs, const Deque<T, BufSize, CacheDepth>& rhs) {
   return !(rhs > lhs);
 }
 
-template <typename T>
-bool operator>=(const Deque<T>& lhs, const Deque<T>& rhs) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+bool operator>=(
+    const Deque<T, BufSize, CacheDepth>& lhs, const Deque<T, BufSize, CacheDepth>& rhs) {
   return !(lhs < rhs);
 }
 
-template <typename T>
-void swap(Deque<T>& lhs, Deque<T>& rhs) {
+template <typename T, size_t BufSize, size_t CacheDepth>
+void swap(Deque<T, BufSize, CacheDepth>& lhs, Deque<T, BufSize, CacheDepth>& rhs) {
   lhs.swap(rhs);
 }
 
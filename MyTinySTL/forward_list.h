@@ -0,0 +1,801 @@
+#ifndef MYTINYSTL_FORWARD_LIST_H_
+#define MYTINYSTL_FORWARD_LIST_H_
+
+// 这个头文件包含一个模板类 ForwardList
+// ForwardList : 单向链表，每个结点只保存next指针，头结点直接内嵌在容器中
+
+// notes:
+//
+// 与 list 相比，每个结点少一个 prev 指针，容器本身也不需要单独分配头结点，
+// 只能在给定位置之后插入、删除，因此接口为 insert_after / erase_after / splice_after
+//
+// 模板参数 StoreSize 为 false 时容器不记录元素个数，sizeof(ForwardList) 只有一个指针，
+// 适合大量的短链表，此时 size() 需要遍历整个链表
+// 模板参数 Alloc 决定结点的分配方式，可以使用 mystl::PoolAllocator 从结点池中分配结点
+//
+// 异常保证：
+// mystl::ForwardList<T> 满足基本异常保证，部分函数无异常保证，并对以下等函数做强异常安全保证：
+//   * emplace_front
+//   * emplace_after
+//   * push_front
+//   * insert_after
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+
+namespace mystl {
+
+// ForwardList的结点结构
+template <typename T>
+struct ForwardListNode;
+
+template <typename T>
+struct ForwardListNodeBase {
+  using base_ptr = ForwardListNodeBase<T>*;
+  using node_ptr = ForwardListNode<T>*;
+
+  base_ptr next;
+
+  node_ptr as_node() { return static_cast<node_ptr>(this); }
+};
+
+template <typename T>
+struct ForwardListNode : public ForwardListNodeBase<T> {
+  T value;
+};
+
+// 迭代器
+template <typename T, typename Ref, typename Ptr>
+struct ForwardListIterator : public mystl::Iterator<mystl::ForwardIteratorTag, T> {
+  using iterator = ForwardListIterator<T, T&, T*>;
+  using const_iterator = ForwardListIterator<T, const T&, const T*>;
+  using self = ForwardListIterator;
+
+  using value_type = T;
+  using pointer = Ptr;
+  using reference = Ref;
+  using base_ptr = typename ForwardListNodeBase<T>::base_ptr;
+
+  base_ptr node_;  // 指向当前结点，end()为nullptr
+
+  ForwardListIterator() noexcept : node_(nullptr) {}
+  explicit ForwardListIterator(base_ptr x) noexcept : node_(x) {}
+  ForwardListIterator(const iterator& rhs) noexcept : node_(rhs.node_) {}
+  self& operator=(const self&) = default;
+
+  reference operator*() const { return node_->as_node()->value; }
+  pointer operator->() const { return &(operator*()); }
+
+  self& operator++() {
+    MYSTL_DEBUG(node_ != nullptr);
+    node_ = node_->next;
+    return *this;
+  }
+
+  self operator++(int) {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+  bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+// 记录元素个数，StoreSize为false时是一个空类，不占用空间
+template <bool StoreSize>
+struct ForwardListCounter {
+  size_t count_ = 0;
+
+  size_t count() const noexcept { return count_; }
+  void add(size_t n) noexcept { count_ += n; }
+  void sub(size_t n) noexcept { count_ -= n; }
+  void reset() noexcept { count_ = 0; }
+  void swap_count(ForwardListCounter& rhs) noexcept { mystl::swap(count_, rhs.count_); }
+};
+
+template <>
+struct ForwardListCounter<false> {
+  size_t count() const noexcept { return 0; }
+  void add(size_t) noexcept {}
+  void sub(size_t) noexcept {}
+  void reset() noexcept {}
+  void swap_count(ForwardListCounter&) noexcept {}
+};
+
+// 模板类ForwardList
+// 参数一代表数据类型，参数二代表是否记录元素个数，参数三代表结点使用的分配器
+template <typename T, bool StoreSize = true, template <typename> class Alloc = mystl::Allocator>
+class ForwardList : private ForwardListCounter<StoreSize> {
+ public:
+  static constexpr bool kStoreSize = StoreSize;
+
+  using allocator_type = Alloc<T>;
+  using data_allocator = Alloc<T>;
+  using node_allocator = Alloc<ForwardListNode<T>>;
+
+  using value_type = typename allocator_type::value_type;
+  using pointer = typename allocator_type::pointer;
+  using const_pointer = typename allocator_type::const_pointer;
+  using reference = typename allocator_type::reference;
+  using const_reference = typename allocator_type::const_reference;
+  using size_type = typename allocator_type::size_type;
+  using difference_type = typename allocator_type::difference_type;
+
+  using iterator = ForwardListIterator<T, T&, T*>;
+  using const_iterator = ForwardListIterator<T, const T&, const T*>;
+
+  using base_type = ForwardListNodeBase<T>;
+  using base_ptr = typename base_type::base_ptr;
+  using node_ptr = typename base_type::node_ptr;
+
+  allocator_type get_allocator() { return allocator_type(); }
+
+ private:
+  using counter = ForwardListCounter<StoreSize>;
+
+  base_type head_;  // 头结点，head_.next为第一个结点
+
+ public:
+  // 构造、复制、移动、析构函数
+  ForwardList() noexcept { head_.next = nullptr; }
+
+  explicit ForwardList(size_type n) : ForwardList() {
+    fill_insert(before_begin(), n, value_type());
+  }
+
+  ForwardList(size_type n, const T& value) : ForwardList() {
+    fill_insert(before_begin(), n, value);
+  }
+
+  template <
+      typename Iter,
+      typename std::enable_if<mystl::IsInputIterator<Iter>::kValue, int>::type = 0>
+  ForwardList(Iter first, Iter last) : ForwardList() {
+    copy_insert(before_begin(), first, last);
+  }
+
+  ForwardList(std::initializer_list<T> ilist) : ForwardList() {
+    copy_insert(before_begin(), ilist.begin(), ilist.end());
+  }
+
+  ForwardList(const ForwardList& rhs) : ForwardList() {
+    copy_insert(before_begin(), rhs.begin(), rhs.end());
+  }
+
+  ForwardList(ForwardList&& rhs) noexcept : ForwardList() { swap(rhs); }
+
+  ForwardList& operator=(const ForwardList& rhs) {
+    if (this != &rhs) {
+      assign(rhs.begin(), rhs.end());
+    }
+    return *this;
+  }
+
+  ForwardList& operator=(ForwardList&& rhs) noexcept {
+    clear();
+    swap(rhs);
+    return *this;
+  }
+
+  ForwardList& operator=(std::initializer_list<T> ilist) {
+    assign(ilist.begin(), ilist.end());
+    return *this;
+  }
+
+  ~ForwardList() { clear(); }
+
+ public:
+  // 迭代器相关操作
+  iterator before_begin() noexcept { return iterator(&head_); }
+  const_iterator before_begin() const noexcept { return const_iterator(head_node()); }
+  iterator begin() noexcept { return iterator(head_.next); }
+  const_iterator begin() const noexcept { return const_iterator(head_.next); }
+  iterator end() noexcept { return iterator(); }
+  const_iterator end() const noexcept { return const_iterator(); }
+
+  const_iterator cbefore_begin() const noexcept { return before_begin(); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  // 容量相关操作
+  bool empty() const noexcept { return head_.next == nullptr; }
+
+  // 不记录元素个数时需要遍历整个链表
+  size_type size() const noexcept { return get_size(mystl::m_bool_constant<StoreSize>()); }
+
+  size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+
+  // 访问元素相关操作
+  reference front() {
+    MYSTL_DEBUG(!empty());
+    return *begin();
+  }
+
+  const_reference front() const {
+    MYSTL_DEBUG(!empty());
+    return *begin();
+  }
+
+  // 调整容器相关操作
+  // assign
+  void assign(size_type n, const value_type& value);
+
+  template <
+      typename Iter,
+      typename std::enable_if<mystl::IsInputIterator<Iter>::kValue, int>::type = 0>
+  void assign(Iter first, Iter last);
+
+  void assign(std::initializer_list<T> ilist) { assign(ilist.begin(), ilist.end()); }
+
+  // emplace_front / emplace_after
+  template <typename... Args>
+  void emplace_front(Args&&... args) {
+    emplace_after(cbefore_begin(), mystl::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  iterator emplace_after(const_iterator pos, Args&&... args) {
+    MYSTL_DEBUG(pos.node_ != nullptr);
+    base_ptr p = create_node(mystl::forward<Args>(args)...);
+    link_after(pos.node_, p, p);
+    counter::add(1);
+    return iterator(p);
+  }
+
+  // insert_after，返回指向最后一个插入元素的迭代器，没有插入元素时返回pos
+  iterator insert_after(const_iterator pos, const value_type& value) {
+    return emplace_after(pos, value);
+  }
+
+  iterator insert_after(const_iterator pos, value_type&& value) {
+    return emplace_after(pos, mystl::move(value));
+  }
+
+  iterator insert_after(const_iterator pos, size_type n, const value_type& value) {
+    return fill_insert(pos, n, value);
+  }
+
+  template <
+      typename Iter,
+      typename std::enable_if<mystl::IsInputIterator<Iter>::kValue, int>::type = 0>
+  iterator insert_after(const_iterator pos, Iter first, Iter last) {
+    return copy_insert(pos, first, last);
+  }
+
+  iterator insert_after(const_iterator pos, std::initializer_list<T> ilist) {
+    return copy_insert(pos, ilist.begin(), ilist.end());
+  }
+
+  // push_front / pop_front
+  void push_front(const value_type& value) { emplace_after(cbefore_begin(), value); }
+  void push_front(value_type&& value) { emplace_after(cbefore_begin(), mystl::move(value)); }
+
+  void pop_front() {
+    MYSTL_DEBUG(!empty());
+    erase_after(cbefore_begin());
+  }
+
+  // erase_after / clear
+  iterator erase_after(const_iterator pos);
+  iterator erase_after(const_iterator first, const_iterator last);
+
+  void clear() noexcept;
+
+  // resize
+  void resize(size_type new_size) { resize(new_size, value_type()); }
+  void resize(size_type new_size, const value_type& value);
+
+  void swap(ForwardList& rhs) noexcept {
+    mystl::swap(head_.next, rhs.head_.next);
+    counter::swap_count(rhs);
+  }
+
+  // ForwardList相关操作
+  // 将x的所有元素接合于pos之后，需要遍历x找到最后一个结点
+  void splice_after(const_iterator pos, ForwardList& x);
+  void splice_after(const_iterator pos, ForwardList&& x) { splice_after(pos, x); }
+  // 将x中it之后的一个元素接合于pos之后
+  void splice_after(const_iterator pos, ForwardList& x, const_iterator it);
+  // 将x中(first, last)之间的元素接合于pos之后
+  void splice_after(const_iterator pos, ForwardList& x, const_iterator first,
+                    const_iterator last);
+
+  void remove(const value_type& value) {
+    remove_if([&](const value_type& v) { return v == value; });
+  }
+
+  template <typename UnaryPredicate>
+  void remove_if(UnaryPredicate pred);
+
+  void unique() { unique(mystl::EqualTo<T>()); }
+  template <typename BinaryPredicate>
+  void unique(BinaryPredicate pred);
+
+  void merge(ForwardList& x) { merge(x, mystl::Less<T>()); }
+  template <typename Compare>
+  void merge(ForwardList& x, Compare comp);
+
+  void sort() { list_sort(mystl::Less<T>()); }
+  template <typename Compare>
+  void sort(Compare comp) {
+    list_sort(comp);
+  }
+
+  void reverse() noexcept;
+
+ private:
+  // helper functions
+  base_ptr head_node() const noexcept { return const_cast<base_ptr>(&head_); }
+
+  size_type get_size(mystl::m_true_type) const noexcept { return counter::count(); }
+  size_type get_size(mystl::m_false_type) const noexcept {
+    return static_cast<size_type>(mystl::distance(begin(), end()));
+  }
+
+  // create / destroy node
+  template <typename... Args>
+  base_ptr create_node(Args&&... args);
+  void destroy_node(base_ptr p) noexcept;
+
+  // link / unlink
+  static void link_after(base_ptr pos, base_ptr first, base_ptr last) noexcept {
+    last->next = pos->next;
+    pos->next = first;
+  }
+  size_type destroy_after(base_ptr pos, base_ptr last) noexcept;
+
+  // insert
+  iterator fill_insert(const_iterator pos, size_type n, const value_type& value);
+  template <typename Iter>
+  iterator copy_insert(const_iterator pos, Iter first, Iter last);
+
+  // sort
+  template <typename Compare>
+  static void merge_runs(base_ptr a, base_ptr& b, Compare& comp);
+  template <typename Compare>
+  void list_sort(Compare comp);
+};
+
+template <typename T, bool StoreSize, template <typename> class Alloc>
+constexpr bool ForwardList<T, StoreSize, Alloc>::kStoreSize;
+
+// 创建结点
+template <typename T, bool StoreSize, template <typename> class Alloc>
+template <typename... Args>
+typename ForwardList<T, StoreSize, Alloc>::base_ptr ForwardList<T, StoreSize, Alloc>::create_node(
+    Args&&... args) {
+  node_ptr p = node_allocator::allocate(1);
+  try {
+    data_allocator::construct(mystl::address_of(p->value), mystl::forward<Args>(args)...);
+    p->next = nullptr;
+  } catch (...) {
+    node_allocator::deallocate(p, 1);
+    throw;
+  }
+  return p;
+}
+
+// 销毁结点
+template <typename T, bool StoreSize, template <typename> class Alloc>
+void ForwardList<T, StoreSize, Alloc>::destroy_node(base_ptr p) noexcept {
+  node_ptr n = p->as_node();
+  data_allocator::destroy(mystl::address_of(n->value));
+  node_allocator::deallocate(n, 1);
+}
+
+// 销毁(pos, last)之间的结点，返回销毁的个数
+template <typename T, bool StoreSize, template <typename> class Alloc>
+typename ForwardList<T, StoreSize, Alloc>::size_type
+ForwardList<T, StoreSize, Alloc>::destroy_after(base_ptr pos, base_ptr last) noexcept {
+  size_type n = 0;
+  base_ptr cur = pos->next;
+  pos->next = last;
+  while (cur != last) {
+    base_ptr next = cur->next;
+    destroy_node(cur);
+    cur = next;
+    ++n;
+  }
+  return n;
+}
+
+// 在pos之后插入n个元素，先在链表外串好所有结点，全部构造成功后再接入
+template <typename T, bool StoreSize, template <typename> class Alloc>
+typename ForwardList<T, StoreSize, Alloc>::iterator ForwardList<T, StoreSize, Alloc>::fill_insert(
+    const_iterator pos, size_type n, const value_type& value) {
+  MYSTL_DEBUG(pos.node_ != nullptr);
+  if (n == 0) {
+    return iterator(pos.node_);
+  }
+  base_type chain;
+  chain.next = nullptr;
+  base_ptr last = &chain;
+  try {
+    for (size_type i = 0; i < n; ++i) {
+      last->next = create_node(value);
+      last = last->next;
+    }
+  } catch (...) {
+    destroy_after(&chain, nullptr);
+    throw;
+  }
+  link_after(pos.node_, chain.next, last);
+  counter::add(n);
+  return iterator(last);
+}
+
+// 在pos之后插入[first, last)内的元素，做法同fill_insert
+template <typename T, bool StoreSize, template <typename> class Alloc>
+template <typename Iter>
+typename ForwardList<T, StoreSize, Alloc>::iterator ForwardList<T, StoreSize, Alloc>::copy_insert(
+    const_iterator pos, Iter first, Iter last) {
+  MYSTL_DEBUG(pos.node_ != nullptr);
+  base_type chain;
+  chain.next = nullptr;
+  base_ptr tail = &chain;
+  size_type n = 0;
+  try {
+    for (; first != last; ++first, ++n) {
+      tail->next = create_node(*first);
+      tail = tail->next;
+    }
+  } catch (...) {
+    destroy_after(&chain, nullptr);
+    throw;
+  }
+  if (n == 0) {
+    return iterator(pos.node_);
+  }
+  link_after(pos.node_, chain.next, tail);
+  counter::add(n);
+  return iterator(tail);
+}
+
+// 用n个value重新赋值，尽量复用已有的结点
+template <typename T, bool StoreSize, template <typename> class Alloc>
+void ForwardList<T, StoreSize, Alloc>::assign(size_type n, const value_type& value) {
+  base_ptr prev = &head_;
+  for (; prev->next != nullptr && n > 0; --n) {
+    prev = prev->next;
+    prev->as_node()->value = value;
+  }
+  if (n > 0) {
+    fill_insert(const_iterator(prev), n, value);
+  } else {
+    counter::sub(destroy_after(prev, nullptr));
+  }
+}
+
+// 用[first, last)内的元素重新赋值，尽量复用已有的结点
+template <typename T, bool StoreSize, template <typename> class Alloc>
+template <typename Iter, typename std::enable_if<mystl::IsInputIterator<Iter>::kValue, int>::type>
+void ForwardList<T, StoreSize, Alloc>::assign(Iter first, Iter last) {
+  base_ptr prev = &head_;
+  for (; prev->next != nullptr && first != last; ++first) {
+    prev = prev->next;
+    prev->as_node()->value = *first;
+  }
+  if (first != last) {
+    copy_insert(const_iterator(prev), first, last);
+  } else {
+    counter::sub(destroy_after(prev, nullptr));
+  }
+}
+
+// 删除pos之后的一个元素，返回指向被删元素下一个元素的迭代器
+template <typename T, bool StoreSize, template <typename> class Alloc>
+typename ForwardList<T, StoreSize, Alloc>::iterator ForwardList<T, StoreSize, Alloc>::erase_after(
+    const_iterator pos) {
+  MYSTL_DEBUG(pos.node_ != nullptr && pos.node_->next != nullptr);
+  base_ptr p = pos.node_;
+  base_ptr n = p->next;
+  p->next = n->next;
+  destroy_node(n);
+  counter::sub(1);
+  return iterator(p->next);
+}
+
+// 删除(first, last)之间的元素，返回last
+template <typename T, bool StoreSize, template <typename> class Alloc>
+typename ForwardList<T, StoreSize, Alloc>::iterator ForwardList<T, StoreSize, Alloc>::erase_after(
+    const_iterator first, const_iterator last) {
+  MYSTL_DEBUG(first.node_ != nullptr);
+  counter::sub(destroy_after(first.node_, last.node_));
+  return iterator(last.node_);
+}
+
+// 清空ForwardList
+template <typename T, bool StoreSize, template <typename> class Alloc>
+void ForwardList<T, StoreSize, Alloc>::clear() noexcept {
+  destroy_after(&head_, nullptr);
+  counter::reset();
+}
+
+// 重置容器大小
+template <typename T, bool StoreSize, template <typename> class Alloc>
+void ForwardList<T, StoreSize, Alloc>::resize(size_type new_size, const value_type& value) {
+  base_ptr prev = &head_;
+  for (; prev->next != nullptr && new_size > 0; --new_size) {
+    prev = prev->next;
+  }
+  if (new_size > 0) {
+    fill_insert(const_iterator(prev), new_size, value);
+  } else {
+    counter::sub(destroy_after(prev, nullptr));
+  }
+}
+
+// 将x接合于pos之后
+template <typename T, bool StoreSize, template <typename> class Alloc>
+void ForwardList<T, StoreSize, Alloc>::splice_after(const_iterator pos, ForwardList& x) {
+  MYSTL_DEBUG(this != &x);
+  if (x.empty()) {
+    return;
+  }
+  base_ptr last = x.head_.next;
+  while (last->next != nullptr) {
+    last = last->next;
+  }
+  link_after(pos.node_, x.head_.next, last);
+  x.head_.next = nullptr;
+  counter::add(x.counter::count());
+  x.counter::reset();
+}
+
+// 将x中it之后的一个元素接合于pos之后
+template <typename T, bool StoreSize, template <typename> class Alloc>
+void ForwardList<T, StoreSize, Alloc>::splice_after(const_iterator pos, ForwardList& x,
+                                                    const_iterator it) {
+  base_ptr prev = it.node_;
+  base_ptr n = prev->next;
+  if (pos.node_ == prev || pos.node_ == n) {
+    return;
+  }
+  prev->next = n->next;
+  link_after(pos.node_, n, n);
+  x.counter::sub(1);
+  counter::add(1);
+}
+
+// 将x中(first, last)之间的元素接合于pos之后，pos不能位于(first, last)之间
+template <typename T, bool StoreSize, template <typename> class Alloc>
+void ForwardList<T, StoreSize, Alloc>::splice_after(const_iterator pos, ForwardList& x,
+                                                    const_iterator first, const_iterator last) {
+  base_ptr before = first.node_;
+  if (before->next == last.node_ || pos.node_ == before) {
+    return;
+  }
+  size_type n = 1;
+  base_ptr tail = before->next;
+  while (tail->next != last.node_) {
+    tail = tail->next;
+    ++n;
+  }
+  base_ptr head = before->next;
+  before->next = last.node_;
+  link_after(pos.node_, head, tail);
+  x.counter::sub(n);
+  counter::add(n);
+}
+
+// 将另一元操作pred为true的所有元素移除
+template <typename T, bool StoreSize, template <typename> class Alloc>
+template <typename UnaryPredicate>
+void ForwardList<T, StoreSize, Alloc>::remove_if(UnaryPredicate pred) {
+  base_ptr prev = &head_;
+  while (prev->next != nullptr) {
+    if (pred(prev->next->as_node()->value)) {
+      erase_after(const_iterator(prev));
+    } else {
+      prev = prev->next;
+    }
+  }
+}
+
+// 移除ForwardList中满足pred为true的相邻重复元素
+template <typename T, bool StoreSize, template <typename> class Alloc>
+template <typename BinaryPredicate>
+void ForwardList<T, StoreSize, Alloc>::unique(BinaryPredicate pred) {
+  base_ptr cur = head_.next;
+  if (cur == nullptr) {
+    return;
+  }
+  while (cur->next != nullptr) {
+    if (pred(cur->as_node()->value, cur->next->as_node()->value)) {
+      erase_after(const_iterator(cur));
+    } else {
+      cur = cur->next;
+    }
+  }
+}
+
+// 与另一个有序ForwardList合并，按照comp为true的顺序，相等时本链表的元素在前
+template <typename T, bool StoreSize, template <typename> class Alloc>
+template <typename Compare>
+void ForwardList<T, StoreSize, Alloc>::merge(ForwardList& x, Compare comp) {
+  if (this == &x || x.empty()) {
+    return;
+  }
+  // 先把x的结点全部转移过来，comp抛出异常时它们都留在本链表中
+  base_ptr run = head_.next;
+  head_.next = x.head_.next;
+  x.head_.next = nullptr;
+  counter::add(x.counter::count());
+  x.counter::reset();
+  if (run != nullptr) {
+    merge_runs(run, head_.next, comp);
+  }
+}
+
+// 将ForwardList反转
+template <typename T, bool StoreSize, template <typename> class Alloc>
+void ForwardList<T, StoreSize, Alloc>::reverse() noexcept {
+  base_ptr prev = nullptr;
+  base_ptr cur = head_.next;
+  while (cur != nullptr) {
+    base_ptr next = cur->next;
+    cur->next = prev;
+    prev = cur;
+    cur = next;
+  }
+  head_.next = prev;
+}
+
+// 把两段以nullptr结尾的有序结点序列合并到b中，a中的结点排在b之前，相等时a优先，保证稳定
+// comp抛出异常时，b保存两段序列的全部结点，次序未定
+template <typename T, bool StoreSize, template <typename> class Alloc>
+template <typename Compare>
+void ForwardList<T, StoreSize, Alloc>::merge_runs(base_ptr a, base_ptr& b, Compare& comp) {
+  base_ptr rest = b;
+  base_type head;
+  base_ptr tail = &head;
+  try {
+    while (a != nullptr && rest != nullptr) {
+      if (comp(rest->as_node()->value, a->as_node()->value)) {
+        tail->next = rest;
+        tail = rest;
+        rest = rest->next;
+      } else {
+        tail->next = a;
+        tail = a;
+        a = a->next;
+      }
+    }
+  } catch (...) {
+    tail->next = a;
+    while (tail->next != nullptr) {
+      tail = tail->next;
+    }
+    tail->next = rest;
+    b = head.next;
+    throw;
+  }
+  tail->next = a != nullptr ? a : rest;
+  b = head.next;
+}
+
+// 自底向上的归并排序，做法与List::sort相同：binary[i]为空或者保存一段长度为2^i的有序序列，
+// 每个结点依次并入binary[0]并向高位进位，最后把所有序列合并
+// comp抛出异常时的处理也与List::sort相同，修改时需要保持一致
+template <typename T, bool StoreSize, template <typename> class Alloc>
+template <typename Compare>
+void ForwardList<T, StoreSize, Alloc>::list_sort(Compare comp) {
+  if (head_.next == nullptr || head_.next->next == nullptr) {
+    return;
+  }
+  static constexpr size_t kMaxBins = sizeof(size_type) * 8;
+  base_ptr binary[kMaxBins] = {};
+  size_t fill = 0;  // binary中最高的非空位置加一
+
+  base_ptr cur = head_.next;
+  base_ptr carry = nullptr;  // 正在进位或合并的序列，不在binary中
+  try {
+    while (cur != nullptr) {
+      carry = cur;
+      cur = cur->next;
+      carry->next = nullptr;
+      size_t i = 0;
+      // binary[i]中的结点都在carry之前，先取出再合并，异常时结点只留在carry中
+      for (; i < fill && binary[i] != nullptr; ++i) {
+        base_ptr run = binary[i];
+        binary[i] = nullptr;
+        merge_runs(run, carry, comp);
+      }
+      binary[i] = carry;
+      carry = nullptr;
+      if (i == fill) {
+        ++fill;
+      }
+    }
+
+    // 位置越高的序列越早形成，合并时放在前面
+    for (size_t i = 0; i < fill; ++i) {
+      if (binary[i] != nullptr) {
+        base_ptr run = binary[i];
+        binary[i] = nullptr;
+        if (carry == nullptr) {
+          carry = run;
+        } else {
+          merge_runs(run, carry, comp);
+        }
+      }
+    }
+  } catch (...) {
+    // 把所有序列与尚未处理的结点依次接回头结点，空的序列不移动tail
+    base_ptr tail = &head_;
+    for (size_t i = 0; i < fill; ++i) {
+      tail->next = binary[i];
+      while (tail->next != nullptr) {
+        tail = tail->next;
+      }
+    }
+    tail->next = carry;
+    while (tail->next != nullptr) {
+      tail = tail->next;
+    }
+    tail->next = cur;
+    throw;
+  }
+  head_.next = carry;
+}
+
+// 重载比较操作符
+template <typename T, bool StoreSize, template <typename> class Alloc>
+bool operator==(const ForwardList<T, StoreSize, Alloc>& lhs,
+                const ForwardList<T, StoreSize, Alloc>& rhs) {
+  auto f1 = lhs.cbegin();
+  auto f2 = rhs.cbegin();
+  const auto l1 = lhs.cend();
+  const auto l2 = rhs.cend();
+  for (; f1 != l1 && f2 != l2 && *f1 == *f2; ++f1, ++f2) {
+  }
+  return f1 == l1 && f2 == l2;
+}
+
+template <typename T, bool StoreSize, template <typename> class Alloc>
+bool operator<(const ForwardList<T, StoreSize, Alloc>& lhs,
+               const ForwardList<T, StoreSize, Alloc>& rhs) {
+  return mystl::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename T, bool StoreSize, template <typename> class Alloc>
+bool operator!=(const ForwardList<T, StoreSize, Alloc>& lhs,
+                const ForwardList<T, StoreSize, Alloc>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename T, bool StoreSize, template <typename> class Alloc>
+bool operator>(const ForwardList<T, StoreSize, Alloc>& lhs,
+               const ForwardList<T, StoreSize, Alloc>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename T, bool StoreSize, template <typename> class Alloc>
+bool operator<=(const ForwardList<T, StoreSize, Alloc>& lhs,
+                const ForwardList<T, StoreSize, Alloc>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename T, bool StoreSize, template <typename> class Alloc>
+bool operator>=(const ForwardList<T, StoreSize, Alloc>& lhs,
+                const ForwardList<T, StoreSize, Alloc>& rhs) {
+  return !(lhs < rhs);
+}
+
+// 重载mystl的swap
+template <typename T, bool StoreSize, template <typename> class Alloc>
+void swap(ForwardList<T, StoreSize, Alloc>& lhs, ForwardList<T, StoreSize, Alloc>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_FORWARD_LIST_H_
@@ -71,11 +71,22 @@ T identify_element(Multiplies<T> /*unused*/) {
 }
 
 // 函数对象：等于
-template <typename T>
+template <typename T = void>
 struct EqualTo : public BinaryFunction<T, T, bool> {
   bool operator()(const T& x, const T& y) const { return x == y; }
 };
 
+// 透明版本：等于，可比较任意两个可比较的类型，用于异构查找
+template <>
+struct EqualTo<void> {
+  using is_transparent = void;
+
+  template <typename T, typename U>
+  bool operator()(const T& x, const U& y) const {
+    return x == y;
+  }
+};
+
 // 函数对象：不等于
 template <typename T>
 struct NotEqualTo : public BinaryFunction<T, T, bool> {
@@ -83,17 +94,39 @@ struct NotEqualTo : public BinaryFunction<T, T, bool> {
 };
 
 // 函数对象：大于
-template <typename T>
+template <typename T = void>
 struct Greater : public BinaryFunction<T, T, bool> {
   bool operator()(const T& x, const T& y) const { return x > y; }
 };
 
+// 透明版本：大于，可比较任意两个可比较的类型，用于异构查找
+template <>
+struct Greater<void> {
+  using is_transparent = void;
+
+  template <typename T, typename U>
+  bool operator()(const T& x, const U& y) const {
+    return x > y;
+  }
+};
+
 // 函数对象：小于
-template <typename T>
+template <typename T = void>
 struct Less : public BinaryFunction<T, T, bool> {
   bool operator()(const T& x, const T& y) const { return x < y; }
 };
 
+// 透明版本：小于，可比较任意两个可比较的类型，用于异构查找
+template <>
+struct Less<void> {
+  using is_transparent = void;
+
+  template <typename T, typename U>
+  bool operator()(const T& x, const U& y) const {
+    return x < y;
+  }
+};
+
 // 函数对象：大于等于
 template <typename T>
 struct GreaterEqual : public BinaryFunction<T, T, bool> {
@@ -224,21 +257,21 @@ inline size_t bitwise_hash(const unsigned char* first, size_t count) {
 
 template <>
 struct Hash<float> {
-  size_t operator()(const float& val) {
+  size_t operator()(const float& val) const {
     return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(float));
   }
 };
 
 template <>
 struct Hash<double> {
-  size_t operator()(const double& val) {
+  size_t operator()(const double& val) const {
     return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(double));
   }
 };
 
 template <>
 struct Hash<long double> {
-  size_t operator()(const long double& val) {
+  size_t operator()(const long double& val) const {
     return val == 0.0f ? 0 : bitwise_hash((const unsigned char*)&val, sizeof(long double));
   }
 };
@@ -5,6 +5,7 @@
 // hashtable : 哈希表，使用开链法处理冲突
 // 对应书5.7节
 
+#include <atomic>
 #include <initializer_list>
 
 #include "algo.h"
@@ -12,12 +13,22 @@
 #include "functional.h"
 #include "iterator.h"
 #include "memory.h"
+#include "node_handle.h"
 #include "type_traits.h"
 #include "util.h"
 #include "vector.h"
 
 namespace mystl {
 
+// 定义MYSTL_HASHTABLE_PROFILE后，hashtable会额外统计查找次数、查找时访问的结点数与键值比较次数，
+// 用于分析哈希函数的分布情况，默认关闭，不产生任何开销
+// 计数器使用relaxed的原子操作，多个线程同时调用const的查找函数时不会产生数据竞争
+#ifdef MYSTL_HASHTABLE_PROFILE
+#define MYSTL_HT_COUNT(name) ((void)counter_.name.fetch_add(1, std::memory_order_relaxed))
+#else
+#define MYSTL_HT_COUNT(name) ((void)0)
+#endif
+
 // 结点定义
 template <typename T>
 struct HashtableNode {
@@ -185,8 +196,8 @@ struct HtIterator : public HtIteratorBase<T, Hash, KeyEqual> {
       while (!node && ++index < ht->bucket_size_) {
         node = ht->buckets_[index];
       }
-      return *this;
     }
+    return *this;
   }
   iterator operator++(int) {
     iterator tmp = *this;
@@ -252,8 +263,8 @@ struct HtConstIterator : public HtIteratorBase<T, Hash, KeyEqual> {
       while (!node && ++index < ht->bucket_size_) {
         node = ht->buckets_[index];
       }
-      return *this;
     }
+    return *this;
   }
   const_iterator operator++(int) {
     const_iterator tmp = *this;
@@ -483,12 +494,47 @@ inline size_t ht_next_prime(size_t n) {
   return pos == last ? *(last - 1) : *pos;
 }
 
+// 以count为目标重建bucket时，求新的bucket个数，不值得重建时返回0
+// 需要更多的bucket时总是重建，bucket个数减少到原来的四分之三以下、且负载因子仍有余量时才缩小
+inline size_t ht_rehash_bucket_count(size_t count, size_t size, size_t bucket_count, float mlf) {
+  const size_t n = ht_next_prime(count);
+  if (n > bucket_count) {
+    return n;
+  }
+  if ((float)size / (float)n < mlf - 0.25F && (float)n < (float)bucket_count * 0.75) {
+    // worth rehash
+    return n;
+  }
+  return 0;
+}
+
+// hashtable的统计信息，由Hashtable::stats()生成，用于诊断哈希函数的质量
+struct HashtableStats {
+  size_t size;           // 元素个数
+  size_t bucket_count;   // bucket个数
+  float load_factor;     // 负载因子
+  size_t empty_buckets;  // 空bucket的个数
+  size_t longest_chain;  // 最长链表的长度
+  size_t rehash_count;   // 重建bucket的次数
+  size_t bytes_used;     // 占用的字节数，包括对象本身、bucket数组与所有结点
+
+  // chain_histogram[i]表示长度为i的链表个数，大小为longest_chain + 1
+  mystl::Vector<size_t> chain_histogram;
+
+  // 以下计数仅在定义了MYSTL_HASHTABLE_PROFILE时统计，否则为0
+  size_t lookup_count;   // find/count/equal_range的调用次数
+  size_t probe_count;    // 查找时访问的结点总数
+  size_t compare_count;  // 键值比较的总次数，包括插入与重建时的比较
+};
+
 // 模板类hashtable
 // 参数一代表数据类型，参数二代表哈希函数，参数三代表键值相等的比较函数
 template <typename T, typename Hash, typename KeyEqual>
 class Hashtable {
   friend struct mystl::HtIterator<T, Hash, KeyEqual>;
   friend struct mystl::HtConstIterator<T, Hash, KeyEqual>;
+  template <typename, typename, typename>
+  friend class Hashtable;
 
  public:
   using value_traits = HtValueTraits<T>;
@@ -518,6 +564,8 @@ class Hashtable {
   using local_iterator = mystl::HtLocalIterator<T>;
   using const_local_iterator = mystl::HtConstLocalIterator<T>;
 
+  using node_handle = mystl::NodeHandle<T, node_type>;
+
   allocator_type get_allocator() const { return allocator_type(); }
 
  private:
@@ -527,11 +575,50 @@ class Hashtable {
   float mlf_;
   hasher hash_;
   key_equal equal_;
+  size_type rehash_count_;  // 重建bucket的次数
+
+#ifdef MYSTL_HASHTABLE_PROFILE
+  struct ProfileCounter {
+    std::atomic<size_type> lookups;
+    std::atomic<size_type> probes;
+    std::atomic<size_type> compares;
+
+    ProfileCounter() noexcept : lookups(0), probes(0), compares(0) {}
+
+    void reset() noexcept {
+      lookups.store(0, std::memory_order_relaxed);
+      probes.store(0, std::memory_order_relaxed);
+      compares.store(0, std::memory_order_relaxed);
+    }
+
+    // 交换不是原子的，与其它成员的交换一样要求没有其它线程同时访问
+    void swap(ProfileCounter& rhs) noexcept {
+      swap_count(lookups, rhs.lookups);
+      swap_count(probes, rhs.probes);
+      swap_count(compares, rhs.compares);
+    }
+
+    static void swap_count(std::atomic<size_type>& a, std::atomic<size_type>& b) noexcept {
+      const size_type tmp = a.load(std::memory_order_relaxed);
+      a.store(b.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      b.store(tmp, std::memory_order_relaxed);
+    }
+  };
+  mutable ProfileCounter counter_;
+#endif
 
  private:
-  bool is_equal(const key_type& key1, const key_type& key2) { return equal_(key1, key2); }
+  template <typename K1, typename K2>
+  bool is_equal(const K1& key1, const K2& key2) {
+    MYSTL_HT_COUNT(compares);
+    return equal_(key1, key2);
+  }
 
-  bool is_equal(const key_type& key1, const key_type& key2) const { return equal_(key1, key2); }
+  template <typename K1, typename K2>
+  bool is_equal(const K1& key1, const K2& key2) const {
+    MYSTL_HT_COUNT(compares);
+    return equal_(key1, key2);
+  }
 
   const_iterator M_cit(node_ptr node) const noexcept {
     return const_iterator(node, const_cast<Hashtable*>(this));
@@ -559,7 +646,7 @@ class Hashtable {
  public:
   explicit Hashtable(
       size_type bucket_count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
-      : size_(0), mlf_(1.0F), hash_(hash), equal_(equal) {
+      : size_(0), mlf_(1.0F), hash_(hash), equal_(equal), rehash_count_(0) {
     init(bucket_count);
   }
 
@@ -572,21 +659,29 @@ class Hashtable {
       size_type bucket_count,
       const Hash& hash = Hash(),
       const KeyEqual& equal = KeyEqual())
-      : size_(mystl::distance(first, last)), mlf_(1.0F), hash_(hash), equal_(equal) {
+      : size_(mystl::distance(first, last)),
+        mlf_(1.0F),
+        hash_(hash),
+        equal_(equal),
+        rehash_count_(0) {
     init(mystl::max(bucket_count, static_cast<size_type>(mystl::distance(first, last))));
   }
 
-  Hashtable(const Hashtable& rhs) : hash_(rhs.hash_), equal_(rhs.equal_) { copy_init(rhs); }
+  Hashtable(const Hashtable& rhs) : hash_(rhs.hash_), equal_(rhs.equal_), rehash_count_(0) {
+    copy_init(rhs);
+  }
   Hashtable(Hashtable&& rhs) noexcept
       : bucket_size_(rhs.bucket_size_),
         size_(rhs.size_),
         mlf_(rhs.mlf_),
         hash_(rhs.hash_),
-        equal_(rhs.equal_) {
+        equal_(rhs.equal_),
+        rehash_count_(rhs.rehash_count_) {
     buckets_ = mystl::move(rhs.buckets_);
     rhs.bucket_size_ = 0;
     rhs.size_ = 0;
     rhs.mlf_ = 0.0F;
+    rhs.rehash_count_ = 0;
   }
 
   Hashtable& operator=(const Hashtable& rhs);
@@ -674,19 +769,48 @@ class Hashtable {
 
   void clear();
 
-  void swap(Hashtable& rhs) noexcept;
+  // try_emplace，键值已存在时不会构造新结点，args也不会被移动
+  template <typename K, typename... Args>
+  pair<iterator, bool> try_emplace_unique(K&& key, Args&&... args);
 
-  // 查找相关操作
-  size_type count(const key_type& key) const;
+  // 结点句柄相关操作，结点在容器之间转移时不会重新分配内存
+  node_handle extract(const_iterator position) {
+    return node_handle(unlink_node(position.node));
+  }
+
+  iterator insert_node_multi(node_handle&& nh);
+
+  // 插入失败时nh仍然持有原来的结点
+  pair<iterator, bool> insert_node_unique(node_handle& nh);
 
-  iterator find(const key_type& key);
-  const_iterator find(const key_type& key) const;
+  // 把source中的结点转移到当前容器，merge_unique不转移键值已存在的结点
+  template <typename Hash2, typename KeyEqual2>
+  void merge_multi(Hashtable<T, Hash2, KeyEqual2>& source);
+  template <typename Hash2, typename KeyEqual2>
+  void merge_unique(Hashtable<T, Hash2, KeyEqual2>& source);
 
-  pair<iterator, iterator> equal_range_multi(const key_type& key);
-  pair<const_iterator, const_iterator> equal_range_multi(const key_type& key) const;
+  void swap(Hashtable& rhs) noexcept;
 
-  pair<iterator, iterator> equal_range_unique(const key_type& key);
-  pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const;
+  // 查找相关操作
+  // 查找函数均以模板参数K接受键值，K通常为key_type，当哈希函数与键值比较函数都是透明的时，
+  // 上层容器允许传入任意可与key_type比较的类型，从而避免构造临时的key_type
+  template <typename K>
+  size_type count(const K& key) const;
+
+  template <typename K>
+  iterator find(const K& key);
+  template <typename K>
+  const_iterator find(const K& key) const;
+
+  template <typename K>
+  pair<iterator, iterator> equal_range_multi(const K& key);
+  template <typename K>
+  pair<const_iterator, const_iterator> equal_range_multi(const K& key) const;
+
+  template <typename K>
+  pair<iterator, iterator> equal_range_unique(const K& key);
+  template <typename K>
+  pair<const_iterator, const_iterator> equal_range_unique(const K& key) const;
 
   // bucket interface
   local_iterator begin(size_type n) noexcept {
@@ -740,6 +864,10 @@ class Hashtable {
   hasher hash_fcn() const { return hash_; }
   key_equal key_eq() const { return equal_; }
 
+  // 统计信息
+  HashtableStats stats() const;
+  void reset_profile() noexcept;
+
  private:
   void init(size_type n);
   void copy_init(const Hashtable& ht);
@@ -749,8 +877,12 @@ class Hashtable {
   void destroy_node(node_ptr n);
 
   size_type next_size(size_type n) const;
-  size_type hash(const key_type& key, size_type n) const;
-  size_type hash(const key_type& key) const;
+  template <typename K>
+  size_type hash(const K& key, size_type n) const;
+  template <typename K>
+  size_type hash(const K& key) const;
+  template <typename K>
+  node_ptr find_node(const K& key) const;
   void rehash_if_need(size_type n);
 
   template <typename InputIter>
@@ -758,9 +890,10 @@ class Hashtable {
   template <typename InputIter>
   void copy_insert_unique(InputIter first, InputIter last, mystl::InputIteratorTag);
 
-  // insert node
+  // insert node / unlink node
   pair<iterator, bool> insert_node_unique(node_ptr np);
   iterator insert_node_multi(node_ptr np);
+  node_ptr unlink_node(node_ptr p);
 
   // bucket operator
   void replace_bucket(size_type bucket_count);
@@ -821,7 +954,11 @@ Hashtable<T, Hash, KeyEqual>::emplace_unique(Args&&... args) {
     destroy_node(np);
     throw;
   }
-  return insert_node_unique(np);
+  auto res = insert_node_unique(np);
+  if (!res.second) {
+    destroy_node(np);
+  }
+  return res;
 }
 
 // 在不需要重建表格的情况下插入新结点，键值不允许重复
@@ -869,29 +1006,9 @@ typename Hashtable<T, Hash, KeyEqual>::iterator Hashtable<T, Hash, KeyEqual>::in
 // 删除迭代器所指的结点
 template <typename T, typename Hash, typename KeyEqual>
 void Hashtable<T, Hash, KeyEqual>::erase(const_iterator position) {
-  auto p = position.node;
+  auto p = unlink_node(position.node);
   if (p) {
-    const auto n = hash(value_traits::get_key(p->value));
-    auto cur = buckets_[n];
-    if (cur == p) {
-      // p位于链表头部
-      buckets_[n] = cur->next;
-      destroy_node(cur);
-      --size_;
-    } else {
-      auto next = cur->next;
-      while (next) {
-        if (next == p) {
-          cur->next = next->next;
-          destroy_node(next);
-          --size_;
-          break;
-        } else {
-          cur = next;
-          next = cur->next;
-        }
-      }
-    }
+    destroy_node(p);
   }
 }
 
@@ -990,46 +1107,36 @@ typename Hashtable<T, Hash, KeyEqual>::size_type Hashtable<T, Hash, KeyEqual>::b
 // 重新对元素进行一遍哈希，插入到新的位置
 template <typename T, typename Hash, typename KeyEqual>
 void Hashtable<T, Hash, KeyEqual>::rehash(size_type count) {
-  auto n = ht_next_prime(count);
-  if (n > bucket_size_) {
+  const auto n = ht_rehash_bucket_count(count, size_, bucket_size_, max_load_factor());
+  if (n != 0) {
     replace_bucket(n);
-  } else {
-    if ((float)size_ / (float)n < max_load_factor() - 0.25F &&
-        (float)n < (float)bucket_size_ * 0.75) {
-      // worth rehash
-      replace_bucket(n);
-    }
   }
 }
 
 // 查找键值为key的结点，返回其迭代器
 template <typename T, typename Hash, typename KeyEqual>
-typename Hashtable<T, Hash, KeyEqual>::iterator Hashtable<T, Hash, KeyEqual>::find(
-    const key_type& key) {
-  const auto n = hash(key);
-  node_ptr first = buckets_[n];
-  for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {
-  }
-  return iterator(first, this);
+template <typename K>
+typename Hashtable<T, Hash, KeyEqual>::iterator Hashtable<T, Hash, KeyEqual>::find(const K& key) {
+  return iterator(find_node(key), this);
 }
 
 template <typename T, typename Hash, typename KeyEqual>
+template <typename K>
 typename Hashtable<T, Hash, KeyEqual>::const_iterator Hashtable<T, Hash, KeyEqual>::find(
-    const key_type& key) const {
-  const auto n = hash(key);
-  node_ptr first = buckets_[n];
-  for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {
-  }
-  return M_cit(first);
+    const K& key) const {
+  return M_cit(find_node(key));
 }
 
 // 查找键值为key出现的次数
 template <typename T, typename Hash, typename KeyEqual>
+template <typename K>
 typename Hashtable<T, Hash, KeyEqual>::size_type Hashtable<T, Hash, KeyEqual>::count(
-    const key_type& key) const {
+    const K& key) const {
   const auto n = hash(key);
   size_type result = 0;
+  MYSTL_HT_COUNT(lookups);
   for (node_ptr cur = buckets_[n]; cur; cur = cur->next) {
+    MYSTL_HT_COUNT(probes);
     if (is_equal(value_traits::get_key(cur->value), key)) {
       ++result;
     }
@@ -1039,12 +1146,15 @@ typename Hashtable<T, Hash, KeyEqual>::size_type Hashtable<T, Hash, KeyEqual>::c
 
 // 查找与键值key相等的区间，返回一个pair，指向相等区间的首尾
 template <typename T, typename Hash, typename KeyEqual>
+template <typename K>
 pair<
     typename Hashtable<T, Hash, KeyEqual>::iterator,
     typename Hashtable<T, Hash, KeyEqual>::iterator>
-Hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key) {
+Hashtable<T, Hash, KeyEqual>::equal_range_multi(const K& key) {
   const auto n = hash(key);
+  MYSTL_HT_COUNT(lookups);
   for (node_ptr first = buckets_[n]; first; first = first->next) {
+    MYSTL_HT_COUNT(probes);
     if (is_equal(value_traits::get_key(first->value), key)) {
       // 如果出现相等的键值
       for (node_ptr second = first->next; second; second = second->next) {
@@ -1065,38 +1175,44 @@ Hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key) {
 }
 
 template <typename T, typename Hash, typename KeyEqual>
+template <typename K>
 pair<
     typename Hashtable<T, Hash, KeyEqual>::const_iterator,
     typename Hashtable<T, Hash, KeyEqual>::const_iterator>
-Hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key) const {
+Hashtable<T, Hash, KeyEqual>::equal_range_multi(const K& key) const {
   const auto n = hash(key);
+  MYSTL_HT_COUNT(lookups);
   for (node_ptr first = buckets_[n]; first; first = first->next) {
+    MYSTL_HT_COUNT(probes);
     if (is_equal(value_traits::get_key(first->value), key)) {
       // 如果出现相等的键值
       for (node_ptr second = first->next; second; second = second->next) {
         if (!is_equal(value_traits::get_key(second->value), key)) {
           return mystl::make_pair(M_cit(first), M_cit(second));
         }
-        for (auto m = n + 1; m < bucket_size_; ++m) {
-          // 整个链表都相等，查找下一个链表出现的位置
-          if (buckets_[m]) {
-            return mystl::make_pair(M_cit(first), M_cit(buckets_[m]));
-          }
+      }
+      for (auto m = n + 1; m < bucket_size_; ++m) {
+        // 整个链表都相等，查找下一个链表出现的位置
+        if (buckets_[m]) {
+          return mystl::make_pair(M_cit(first), M_cit(buckets_[m]));
         }
-        return mystl::make_pair(M_cit(first), cend());
       }
+      return mystl::make_pair(M_cit(first), cend());
     }
   }
   return make_pair(cend(), cend());
 }
 
 template <typename T, typename Hash, typename KeyEqual>
+template <typename K>
 pair<
     typename Hashtable<T, Hash, KeyEqual>::iterator,
     typename Hashtable<T, Hash, KeyEqual>::iterator>
-Hashtable<T, Hash, KeyEqual>::equal_range_unique(const key_type& key) {
+Hashtable<T, Hash, KeyEqual>::equal_range_unique(const K& key) {
   const auto n = hash(key);
+  MYSTL_HT_COUNT(lookups);
   for (node_ptr first = buckets_[n]; first; first = first->next) {
+    MYSTL_HT_COUNT(probes);
     if (is_equal(value_traits::get_key(first->value), key)) {
       // 如果出现相等的键值
       if (first->next) {
@@ -1115,12 +1231,15 @@ Hashtable<T, Hash, KeyEqual>::equal_range_unique(const key_type& key) {
 }
 
 template <typename T, typename Hash, typename KeyEqual>
+template <typename K>
 pair<
     typename Hashtable<T, Hash, KeyEqual>::const_iterator,
     typename Hashtable<T, Hash, KeyEqual>::const_iterator>
-Hashtable<T, Hash, KeyEqual>::equal_range_unique(const key_type& key) const {
+Hashtable<T, Hash, KeyEqual>::equal_range_unique(const K& key) const {
   const auto n = hash(key);
+  MYSTL_HT_COUNT(lookups);
   for (node_ptr first = buckets_[n]; first; first = first->next) {
+    MYSTL_HT_COUNT(probes);
     if (is_equal(value_traits::get_key(first->value), key)) {
       // 如果出现相等的键值
       if (first->next) {
@@ -1138,6 +1257,98 @@ Hashtable<T, Hash, KeyEqual>::equal_range_unique(const key_type& key) const {
   return make_pair(cend(), cend());
 }
 
+// 键值不存在时才以key与args构造新结点，否则什么也不做
+template <typename T, typename Hash, typename KeyEqual>
+template <typename K, typename... Args>
+pair<typename Hashtable<T, Hash, KeyEqual>::iterator, bool>
+Hashtable<T, Hash, KeyEqual>::try_emplace_unique(K&& key, Args&&... args) {
+  auto p = find_node(key);
+  if (p) {
+    return mystl::make_pair(iterator(p, this), false);
+  }
+  rehash_if_need(1);
+  auto np = create_node(
+      PiecewiseConstructTag(), mystl::forward<K>(key), mystl::forward<Args>(args)...);
+  // 让新结点成为链表的第一个结点
+  const auto n = hash(value_traits::get_key(np->value));
+  np->next = buckets_[n];
+  buckets_[n] = np;
+  ++size_;
+  return mystl::make_pair(iterator(np, this), true);
+}
+
+// 插入结点句柄所持有的结点，键值允许重复
+template <typename T, typename Hash, typename KeyEqual>
+typename Hashtable<T, Hash, KeyEqual>::iterator Hashtable<T, Hash, KeyEqual>::insert_node_multi(
+    node_handle&& nh) {
+  if (nh.empty()) {
+    return end();
+  }
+  rehash_if_need(1);
+  return insert_node_multi(nh.release());
+}
+
+// 插入结点句柄所持有的结点，键值不允许重复
+template <typename T, typename Hash, typename KeyEqual>
+pair<typename Hashtable<T, Hash, KeyEqual>::iterator, bool>
+Hashtable<T, Hash, KeyEqual>::insert_node_unique(node_handle& nh) {
+  if (nh.empty()) {
+    return mystl::make_pair(end(), false);
+  }
+  auto p = find_node(value_traits::get_key(nh.value()));
+  if (p) {
+    return mystl::make_pair(iterator(p, this), false);
+  }
+  rehash_if_need(1);
+  return insert_node_unique(nh.release());
+}
+
+// 把source的所有结点摘下并挂到当前的hashtable上
+template <typename T, typename Hash, typename KeyEqual>
+template <typename Hash2, typename KeyEqual2>
+void Hashtable<T, Hash, KeyEqual>::merge_multi(Hashtable<T, Hash2, KeyEqual2>& source) {
+  if (static_cast<void*>(&source) == static_cast<void*>(this)) {
+    return;
+  }
+  rehash_if_need(source.size_);
+  for (size_type i = 0; i < source.bucket_size_; ++i) {
+    for (node_ptr cur = source.buckets_[i]; cur;) {
+      node_ptr next = cur->next;
+      cur->next = nullptr;
+      insert_node_multi(cur);
+      cur = next;
+    }
+    source.buckets_[i] = nullptr;
+  }
+  source.size_ = 0;
+}
+
+// 把source中键值不存在于当前hashtable的结点摘下并挂到当前的hashtable上，其余结点留在source中
+template <typename T, typename Hash, typename KeyEqual>
+template <typename Hash2, typename KeyEqual2>
+void Hashtable<T, Hash, KeyEqual>::merge_unique(Hashtable<T, Hash2, KeyEqual2>& source) {
+  if (static_cast<void*>(&source) == static_cast<void*>(this)) {
+    return;
+  }
+  for (size_type i = 0; i < source.bucket_size_; ++i) {
+    node_ptr* link = &source.buckets_[i];
+    while (*link) {
+      node_ptr cur = *link;
+      if (find_node(value_traits::get_key(cur->value))) {
+        // 键值已存在，结点留在source中
+        link = &cur->next;
+        continue;
+      }
+      // 先扩容再摘下结点，扩容抛出异常时结点仍留在source中
+      rehash_if_need(1);
+      *link = cur->next;
+      --source.size_;
+      cur->next = nullptr;
+      insert_node_unique(cur);
+    }
+  }
+}
+
 // 交换hashtable
 template <typename T, typename Hash, typename KeyEqual>
 void Hashtable<T, Hash, KeyEqual>::swap(Hashtable& rhs) noexcept {
@@ -1148,6 +1359,10 @@ void Hashtable<T, Hash, KeyEqual>::swap(Hashtable& rhs) noexcept {
     mystl::swap(mlf_, rhs.mlf_);
     mystl::swap(hash_, rhs.hash_);
     mystl::swap(equal_, rhs.equal_);
+    mystl::swap(rehash_count_, rhs.rehash_count_);
+#ifdef MYSTL_HASHTABLE_PROFILE
+    counter_.swap(rhs.counter_);
+#endif
   }
 }
 
@@ -1228,17 +1443,34 @@ typename Hashtable<T, Hash, KeyEqual>::size_type Hashtable<T, Hash, KeyEqual>::n
 
 // hash函数
 template <typename T, typename Hash, typename KeyEqual>
+template <typename K>
 typename Hashtable<T, Hash, KeyEqual>::size_type Hashtable<T, Hash, KeyEqual>::hash(
-    const key_type& key, size_type n) const {
+    const K& key, size_type n) const {
   return hash_(key) % n;
 }
 
 template <typename T, typename Hash, typename KeyEqual>
+template <typename K>
 typename Hashtable<T, Hash, KeyEqual>::size_type Hashtable<T, Hash, KeyEqual>::hash(
-    const key_type& key) const {
+    const K& key) const {
   return hash_(key) % bucket_size_;
 }
 
+// 在key所在的bucket中查找键值等于key的第一个结点，找不到返回nullptr
+template <typename T, typename Hash, typename KeyEqual>
+template <typename K>
+typename Hashtable<T, Hash, KeyEqual>::node_ptr Hashtable<T, Hash, KeyEqual>::find_node(
+    const K& key) const {
+  MYSTL_HT_COUNT(lookups);
+  for (node_ptr cur = buckets_[hash(key)]; cur; cur = cur->next) {
+    MYSTL_HT_COUNT(probes);
+    if (is_equal(value_traits::get_key(cur->value), key)) {
+      return cur;
+    }
+  }
+  return nullptr;
+}
+
 template <typename T, typename Hash, typename KeyEqual>
 void Hashtable<T, Hash, KeyEqual>::rehash_if_need(size_type n) {
   if (static_cast<float>(size_ + n) > (float)bucket_size_ * max_load_factor()) {
@@ -1311,33 +1543,55 @@ Hashtable<T, Hash, KeyEqual>::insert_node_unique(node_ptr np) {
   return mystl::make_pair(iterator(np, this), true);
 }
 
+// 把结点p从所在的链表上摘下，不销毁结点，p不在hashtable中时返回nullptr
+template <typename T, typename Hash, typename KeyEqual>
+typename Hashtable<T, Hash, KeyEqual>::node_ptr Hashtable<T, Hash, KeyEqual>::unlink_node(
+    node_ptr p) {
+  if (p == nullptr) {
+    return nullptr;
+  }
+  const auto n = hash(value_traits::get_key(p->value));
+  for (node_ptr* link = &buckets_[n]; *link; link = &(*link)->next) {
+    if (*link == p) {
+      *link = p->next;
+      p->next = nullptr;
+      --size_;
+      return p;
+    }
+  }
+  return nullptr;
+}
+
 template <typename T, typename Hash, typename KeyEqual>
 void Hashtable<T, Hash, KeyEqual>::replace_bucket(size_type bucket_count) {
   bucket_type bucket(bucket_count);
   if (size_ != 0) {
+    // 直接把原有结点挂到新的bucket上，不重新分配结点
     for (size_type i = 0; i < bucket_size_; ++i) {
-      for (auto first = buckets_[i]; first; first = first->next) {
-        auto tmp = create_node(first->value);
+      for (auto first = buckets_[i]; first;) {
+        auto next = first->next;
         const auto n = hash(value_traits::get_key(first->value), bucket_count);
         auto f = bucket[n];
         bool is_inserted = false;
         for (auto cur = f; cur; cur = cur->next) {
           if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(first->value))) {
-            tmp->next = cur->next;
-            cur->next = tmp;
+            first->next = cur->next;
+            cur->next = first;
             is_inserted = true;
             break;
           }
         }
         if (!is_inserted) {
-          tmp->next = f;
-          bucket[n] = tmp;
+          first->next = f;
+          bucket[n] = first;
         }
+        first = next;
       }
     }
   }
   buckets_.swap(bucket);
   bucket_size_ = buckets_.size();
+  ++rehash_count_;
 }
 
 // 在第n个bucket内，删除[frist, last)的结点
@@ -1353,7 +1607,7 @@ void Hashtable<T, Hash, KeyEqual>::erase_bucket(size_type n, node_ptr first, nod
     while (next != last) {
       cur->next = next->next;
       destroy_node(next);
-      next = next->next;
+      next = cur->next;
       --size_;
     }
   }
@@ -1372,6 +1626,47 @@ void Hashtable<T, Hash, KeyEqual>::erase_bucket(size_type n, node_ptr last) {
   buckets_[n] = last;
 }
 
+// 统计bucket的分布情况，需要遍历所有bucket，复杂度为O(bucket_count + size)
+template <typename T, typename Hash, typename KeyEqual>
+HashtableStats Hashtable<T, Hash, KeyEqual>::stats() const {
+  HashtableStats result;
+  result.size = size_;
+  result.bucket_count = bucket_size_;
+  result.load_factor = load_factor();
+  result.empty_buckets = 0;
+  result.longest_chain = 0;
+  result.rehash_count = rehash_count_;
+  result.bytes_used =
+      sizeof(*this) + buckets_.capacity() * sizeof(node_ptr) + size_ * sizeof(node_type);
+  for (size_type n = 0; n < bucket_size_; ++n) {
+    const auto len = bucket_size(n);
+    if (len >= result.chain_histogram.size()) {
+      result.chain_histogram.resize(len + 1, 0);
+    }
+    ++result.chain_histogram[len];
+    result.longest_chain = mystl::max(result.longest_chain, len);
+  }
+  result.empty_buckets = result.chain_histogram.empty() ? 0 : result.chain_histogram[0];
+#ifdef MYSTL_HASHTABLE_PROFILE
+  result.lookup_count = counter_.lookups.load(std::memory_order_relaxed);
+  result.probe_count = counter_.probes.load(std::memory_order_relaxed);
+  result.compare_count = counter_.compares.load(std::memory_order_relaxed);
+#else
+  result.lookup_count = 0;
+  result.probe_count = 0;
+  result.compare_count = 0;
+#endif
+  return result;
+}
+
+// 清零查找与比较的计数，未定义MYSTL_HASHTABLE_PROFILE时什么也不做
+template <typename T, typename Hash, typename KeyEqual>
+void Hashtable<T, Hash, KeyEqual>::reset_profile() noexcept {
+#ifdef MYSTL_HASHTABLE_PROFILE
+  counter_.reset();
+#endif
+}
+
 template <typename T, typename Hash, typename KeyEqual>
 bool Hashtable<T, Hash, KeyEqual>::equal_to_multi(const Hashtable& other) {
   if (size_ != other.size_) {
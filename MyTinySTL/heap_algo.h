@@ -3,8 +3,12 @@
 
 // 包含 heap 的四个算法 : push_heap, pop_heap, sort_heap, make_heap
 // 对应书4.7节
+// 以及它们的 D 叉堆版本 : push_dary_heap, pop_dary_heap, sort_dary_heap, make_dary_heap,
+// is_dary_heap，和供 PriorityQueue 选择堆的组织方式的策略 DaryHeap
 
+#include "functional.h"
 #include "iterator.h"
+#include "util.h"
 
 namespace mystl {
 
@@ -193,6 +197,211 @@ template <class RandomIter, class Compared>
 void make_heap(RandomIter first, RandomIter last, Compared comp) {
   mystl::make_heap_aux(first, last, distance_type(first), comp);
 }
+
+// D 叉堆
+// 每个节点有 D 个子节点，节点 i 的子节点为 D * i + 1, ..., D * i + D，父节点为 (i - 1) / D
+// 树高为 log_D(n)，相邻的 D 个子节点位于同一段连续内存中，堆很大时每层只有一两次缓存未命中：
+//   * push 只需上溯，比较次数与层数成正比，比二叉堆少，make_dary_heap 也更快
+//   * pop 每层要比较 D - 1 次，总比较次数比二叉堆多，换来的是更少的层数，
+//     是否更快取决于堆是否远大于缓存，push 多于 pop 时（如定时器、Dijkstra）一般选 4 叉堆
+
+// push_dary_heap
+// 接受两个迭代器，表示heap容器的首尾，并且新元素已经插入到底部容器的最尾端，调整heap
+template <size_t D, typename RandomIter, typename Distance, typename T, typename Compared>
+void push_dary_heap_aux(
+    RandomIter first, Distance holeIndex, Distance topIndex, T value, Compared comp) {
+  while (holeIndex > topIndex) {
+    const Distance parent = (holeIndex - 1) / static_cast<Distance>(D);
+    if (!comp(*(first + parent), value)) {
+      break;
+    }
+    *(first + holeIndex) = mystl::move(*(first + parent));
+    holeIndex = parent;
+  }
+  *(first + holeIndex) = mystl::move(value);
+}
+
+template <size_t D, typename RandomIter, typename Compared>
+void push_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+  static_assert(D >= 2, "the arity of a heap should be at least 2");
+  using diff_type = typename IteratorTraits<RandomIter>::difference_type;
+  using value_type = typename IteratorTraits<RandomIter>::value_type;
+  if (last - first < 2) {
+    return;
+  }
+  value_type value = mystl::move(*(last - 1));
+  mystl::push_dary_heap_aux<D>(
+      first, static_cast<diff_type>(last - first - 1), static_cast<diff_type>(0),
+      mystl::move(value), comp);
+}
+
+template <size_t D, typename RandomIter>
+void push_dary_heap(RandomIter first, RandomIter last) {
+  mystl::push_dary_heap<D>(first, last, mystl::Less<void>());
+}
+
+// pop_dary_heap
+// 接受两个迭代器，表示heap容器的首尾，将heap的根节点取出放到容器尾部，调整heap
+template <size_t D, typename RandomIter, typename Distance, typename T, typename Compared>
+void adjust_dary_heap(RandomIter first, Distance holeIndex, Distance len, T value, Compared comp) {
+  const Distance topIndex = holeIndex;
+  const Distance d = static_cast<Distance>(D);
+  // 先进行下溯(percolate down)过程，子节点齐全时比较次数固定为 D - 1，内层循环可以展开
+  Distance child = d * holeIndex + 1;
+  while (len - child >= d) {
+    Distance best = child;
+    for (Distance i = 1; i < d; ++i) {
+      if (comp(*(first + best), *(first + (child + i)))) {
+        best = child + i;
+      }
+    }
+    *(first + holeIndex) = mystl::move(*(first + best));
+    holeIndex = best;
+    child = d * holeIndex + 1;
+  }
+  if (child < len) {
+    // 最后一个有子节点的节点，子节点不足 D 个
+    Distance best = child;
+    for (Distance i = child + 1; i < len; ++i) {
+      if (comp(*(first + best), *(first + i))) {
+        best = i;
+      }
+    }
+    *(first + holeIndex) = mystl::move(*(first + best));
+    holeIndex = best;
+  }
+  // 再执行一次上溯(percolate up)过程
+  mystl::push_dary_heap_aux<D>(first, holeIndex, topIndex, mystl::move(value), comp);
+}
+
+template <size_t D, typename RandomIter, typename Compared>
+void pop_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+  static_assert(D >= 2, "the arity of a heap should be at least 2");
+  using diff_type = typename IteratorTraits<RandomIter>::difference_type;
+  using value_type = typename IteratorTraits<RandomIter>::value_type;
+  if (last - first < 2) {
+    return;
+  }
+  // 先将首值调至尾结点，然后调整[first, last - 1)使之成为一个max-heap
+  --last;
+  value_type value = mystl::move(*last);
+  *last = mystl::move(*first);
+  mystl::adjust_dary_heap<D>(
+      first, static_cast<diff_type>(0), static_cast<diff_type>(last - first), mystl::move(value),
+      comp);
+}
+
+template <size_t D, typename RandomIter>
+void pop_dary_heap(RandomIter first, RandomIter last) {
+  mystl::pop_dary_heap<D>(first, last, mystl::Less<void>());
+}
+
+// sort_dary_heap
+// 接受两个迭代器，表示heap容器的首尾，不断执行pop_dary_heap操作，直到首尾最多相差1
+template <size_t D, typename RandomIter, typename Compared>
+void sort_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+  while (last - first > 1) {
+    mystl::pop_dary_heap<D>(first, last--, comp);
+  }
+}
+
+template <size_t D, typename RandomIter>
+void sort_dary_heap(RandomIter first, RandomIter last) {
+  mystl::sort_dary_heap<D>(first, last, mystl::Less<void>());
+}
+
+// make_dary_heap
+// 接受两个迭代器，表示heap容器的首尾，把容器内的数据变成一个heap
+// 从最后一个有子节点的节点开始，自底向上逐个下溯，共 O(n) 次比较
+template <size_t D, typename RandomIter, typename Compared>
+void make_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+  static_assert(D >= 2, "the arity of a heap should be at least 2");
+  using diff_type = typename IteratorTraits<RandomIter>::difference_type;
+  using value_type = typename IteratorTraits<RandomIter>::value_type;
+  const diff_type len = last - first;
+  if (len < 2) {
+    return;
+  }
+  diff_type holeIndex = (len - 2) / static_cast<diff_type>(D);
+  while (true) {
+    value_type value = mystl::move(*(first + holeIndex));
+    mystl::adjust_dary_heap<D>(first, holeIndex, len, mystl::move(value), comp);
+    if (holeIndex == 0) {
+      return;
+    }
+    --holeIndex;
+  }
+}
+
+template <size_t D, typename RandomIter>
+void make_dary_heap(RandomIter first, RandomIter last) {
+  mystl::make_dary_heap<D>(first, last, mystl::Less<void>());
+}
+
+// is_dary_heap
+// 检查[first, last)是否为一个 D 叉堆
+template <size_t D, typename RandomIter, typename Compared>
+bool is_dary_heap(RandomIter first, RandomIter last, Compared comp) {
+  static_assert(D >= 2, "the arity of a heap should be at least 2");
+  using diff_type = typename IteratorTraits<RandomIter>::difference_type;
+  const diff_type len = last - first;
+  for (diff_type child = 1; child < len; ++child) {
+    if (comp(*(first + (child - 1) / static_cast<diff_type>(D)), *(first + child))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <size_t D, typename RandomIter>
+bool is_dary_heap(RandomIter first, RandomIter last) {
+  return mystl::is_dary_heap<D>(first, last, mystl::Less<void>());
+}
+
+// 堆的策略，PriorityQueue 通过它组织底层容器：D 叉堆
+template <size_t D>
+struct DaryHeap {
+  static constexpr size_t kArity = D;
+
+  template <typename RandomIter, typename Compared>
+  static void push(RandomIter first, RandomIter last, Compared comp) {
+    mystl::push_dary_heap<D>(first, last, comp);
+  }
+
+  template <typename RandomIter, typename Compared>
+  static void pop(RandomIter first, RandomIter last, Compared comp) {
+    mystl::pop_dary_heap<D>(first, last, comp);
+  }
+
+  template <typename RandomIter, typename Compared>
+  static void make(RandomIter first, RandomIter last, Compared comp) {
+    mystl::make_dary_heap<D>(first, last, comp);
+  }
+};
+
+// 二叉堆使用 push_heap, pop_heap, make_heap
+template <>
+struct DaryHeap<2> {
+  static constexpr size_t kArity = 2;
+
+  template <typename RandomIter, typename Compared>
+  static void push(RandomIter first, RandomIter last, Compared comp) {
+    mystl::push_heap(first, last, comp);
+  }
+
+  template <typename RandomIter, typename Compared>
+  static void pop(RandomIter first, RandomIter last, Compared comp) {
+    mystl::pop_heap(first, last, comp);
+  }
+
+  template <typename RandomIter, typename Compared>
+  static void make(RandomIter first, RandomIter last, Compared comp) {
+    mystl::make_heap(first, last, comp);
+  }
+};
+
+using BinaryHeap = DaryHeap<2>;
+
 }  // namespace mystl
 
 #endif  // ! MYTINYSTL_HEAP_ALGO_H_
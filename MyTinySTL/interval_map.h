@@ -0,0 +1,219 @@
+#ifndef MYTINYSTL_INTERVAL_MAP_H_
+#define MYTINYSTL_INTERVAL_MAP_H_
+
+// 这个头文件包含一个模板类 IntervalMap
+// IntervalMap : 区间映射，键值为闭区间[low, high]，实值为任意类型，按左端点、右端点的顺序排序，
+//               允许重复的区间，支持查找与给定区间相交或包含给定点的所有区间
+
+// notes:
+//
+// IntervalMap 建立在 rb tree 之上，结点布局为 RbTreeIntervalTag，每个结点额外记录子树中最大的
+// 右端点，插入、删除与旋转时沿路径维护，结点分配与迭代器与 multimap 完全相同
+//
+// 查找第一个相交区间的时间复杂度为O(log n)，枚举所有相交区间时只进入含有相交区间的子树，
+// 输出k个区间的代价不超过O(min(n, k log n))，区间互不嵌套时接近O(log n + k)
+//
+// 异常保证：
+// mystl::IntervalMap<Endpoint, T> 满足基本异常保证，对 emplace / insert 做强异常安全保证
+
+#include <initializer_list>
+
+#include "functional.h"
+#include "rb_tree.h"
+#include "util.h"
+
+namespace mystl {
+
+// 闭区间[low, high]，要求low不大于high
+template <typename T>
+struct Interval {
+  T low;
+  T high;
+
+  Interval() : low(), high() {}
+  Interval(const T& lo, const T& hi) : low(lo), high(hi) {}
+
+  friend bool operator==(const Interval& lhs, const Interval& rhs) {
+    return lhs.low == rhs.low && lhs.high == rhs.high;
+  }
+  friend bool operator!=(const Interval& lhs, const Interval& rhs) { return !(lhs == rhs); }
+};
+
+// 区间的排序方式：先比较左端点，左端点相等时比较右端点
+template <typename T, typename Compare = mystl::Less<T>>
+struct IntervalLess : public mystl::BinaryFunction<Interval<T>, Interval<T>, bool> {
+  bool operator()(const Interval<T>& lhs, const Interval<T>& rhs) const {
+    Compare comp;
+    if (comp(lhs.low, rhs.low)) {
+      return true;
+    }
+    if (comp(rhs.low, lhs.low)) {
+      return false;
+    }
+    return comp(lhs.high, rhs.high);
+  }
+};
+
+// 模板类IntervalMap
+// 参数一代表区间端点的类型，参数二代表实值类型，参数三代表端点的比较方式，缺省使用mystl::Less
+template <typename Endpoint, typename T, typename Compare = mystl::Less<Endpoint>>
+class IntervalMap {
+ public:
+  using endpoint_type = Endpoint;
+  using key_type = Interval<Endpoint>;
+  using mapped_type = T;
+  using value_type = mystl::pair<const key_type, T>;
+  using key_compare = IntervalLess<Endpoint, Compare>;
+  using endpoint_compare = Compare;
+
+ private:
+  using base_type =
+      mystl::RbTree<value_type, key_compare, mystl::RbTreeIntervalTag<Endpoint, Compare>>;
+  base_type tree_;
+
+ public:
+  using pointer = typename base_type::pointer;
+  using const_pointer = typename base_type::const_pointer;
+  using reference = typename base_type::reference;
+  using const_reference = typename base_type::const_reference;
+  using iterator = typename base_type::iterator;
+  using const_iterator = typename base_type::const_iterator;
+  using reverse_iterator = typename base_type::reverse_iterator;
+  using const_reverse_iterator = typename base_type::const_reverse_iterator;
+  using size_type = typename base_type::size_type;
+  using difference_type = typename base_type::difference_type;
+  using allocator_type = typename base_type::allocator_type;
+
+ public:
+  IntervalMap() = default;
+
+  template <typename InputIterator>
+  IntervalMap(InputIterator first, InputIterator last) : tree_() {
+    tree_.insert_multi(first, last);
+  }
+
+  IntervalMap(std::initializer_list<value_type> ilist) : tree_() {
+    tree_.insert_multi(ilist.begin(), ilist.end());
+  }
+
+  IntervalMap(const IntervalMap& rhs) : tree_(rhs.tree_) {}
+  IntervalMap(IntervalMap&& rhs) : tree_(mystl::move(rhs.tree_)) {}
+
+  IntervalMap& operator=(const IntervalMap& rhs) {
+    tree_ = rhs.tree_;
+    return *this;
+  }
+  IntervalMap& operator=(IntervalMap&& rhs) {
+    tree_ = mystl::move(rhs.tree_);
+    return *this;
+  }
+
+  key_compare key_comp() const { return tree_.key_comp(); }
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+  iterator begin() noexcept { return tree_.begin(); }
+  const_iterator begin() const noexcept { return tree_.begin(); }
+  iterator end() noexcept { return tree_.end(); }
+  const_iterator end() const noexcept { return tree_.end(); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  bool empty() const noexcept { return tree_.empty(); }
+  size_type size() const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+
+  // 插入删除相关
+  template <typename... Args>
+  iterator emplace(Args&&... args) {
+    return tree_.emplace_multi(mystl::forward<Args>(args)...);
+  }
+
+  iterator insert(const value_type& value) { return tree_.insert_multi(value); }
+  iterator insert(value_type&& value) { return tree_.insert_multi(mystl::move(value)); }
+  iterator insert(const Endpoint& low, const Endpoint& high, const mapped_type& obj) {
+    return tree_.emplace_multi(key_type(low, high), obj);
+  }
+
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    tree_.insert_multi(first, last);
+  }
+
+  void erase(iterator position) { tree_.erase(position); }
+  size_type erase(const key_type& key) { return tree_.erase_multi(key); }
+  void erase(iterator first, iterator last) { tree_.erase(first, last); }
+
+  void clear() { tree_.clear(); }
+
+  // 按区间本身查找，与普通的multimap相同
+  iterator find(const key_type& key) { return tree_.find(key); }
+  const_iterator find(const key_type& key) const { return tree_.find(key); }
+  size_type count(const key_type& key) const { return tree_.count_multi(key); }
+
+  // 区间查询相关操作
+  // find_overlap返回按排序顺序第一个与[low, high]相交的区间，不存在时返回end()
+  iterator find_overlap(const Endpoint& low, const Endpoint& high) {
+    return tree_.find_overlap(low, high);
+  }
+  const_iterator find_overlap(const Endpoint& low, const Endpoint& high) const {
+    return tree_.find_overlap(low, high);
+  }
+  iterator find_overlap(const key_type& range) { return find_overlap(range.low, range.high); }
+  const_iterator find_overlap(const key_type& range) const {
+    return find_overlap(range.low, range.high);
+  }
+
+  // 按排序顺序对每个与[low, high]相交的区间调用f(iterator)，f中不能插入或删除元素
+  template <typename Function>
+  void for_each_overlap(const Endpoint& low, const Endpoint& high, Function f) {
+    tree_.for_each_overlap(low, high, f);
+  }
+  template <typename Function>
+  void for_each_overlap(const Endpoint& low, const Endpoint& high, Function f) const {
+    tree_.for_each_overlap(low, high, f);
+  }
+
+  // 按排序顺序对每个包含point的区间调用f(iterator)
+  template <typename Function>
+  void for_each_containing(const Endpoint& point, Function f) {
+    tree_.for_each_overlap(point, point, f);
+  }
+  template <typename Function>
+  void for_each_containing(const Endpoint& point, Function f) const {
+    tree_.for_each_overlap(point, point, f);
+  }
+
+  size_type count_overlap(const Endpoint& low, const Endpoint& high) const {
+    size_type n = 0;
+    tree_.for_each_overlap(low, high, [&n](const_iterator) { ++n; });
+    return n;
+  }
+  size_type count_containing(const Endpoint& point) const {
+    return count_overlap(point, point);
+  }
+
+  void swap(IntervalMap& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+ public:
+  friend bool operator==(const IntervalMap& lhs, const IntervalMap& rhs) {
+    return lhs.tree_ == rhs.tree_;
+  }
+  friend bool operator!=(const IntervalMap& lhs, const IntervalMap& rhs) {
+    return lhs.tree_ != rhs.tree_;
+  }
+};
+
+// 重载 mystl 的 swap
+template <typename Endpoint, typename T, typename Compare>
+void swap(IntervalMap<Endpoint, T, Compare>& lhs, IntervalMap<Endpoint, T, Compare>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_INTERVAL_MAP_H_
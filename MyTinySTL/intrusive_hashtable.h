@@ -0,0 +1,510 @@
+#ifndef MYTINYSTL_INTRUSIVE_HASHTABLE_H_
+#define MYTINYSTL_INTRUSIVE_HASHTABLE_H_
+
+// 这个头文件包含一个模板类 IntrusiveHashtable
+// IntrusiveHashtable : 侵入式哈希表，使用开链法处理冲突，链接指针（hook）存放在元素对象内部，
+//                      除了 bucket 数组之外不分配任何内存
+
+// notes:
+//
+// 元素类型通过继承 IntrusiveHashHook<Tag> 获得链接指针，键值由 KeyOfValue 从元素中取得
+// hook 中还保存元素的哈希值，遍历、删除元素与重建 bucket 时不再调用哈希函数
+// bucket 的个数与重建策略与 hashtable 相同，相同键值的元素在链表中相邻
+// 容器不拥有元素，元素的生命周期由使用者管理，对象析构之前必须先从哈希表中删除，
+// 元素在哈希表中时不能修改它的键值
+//
+// safe link 模式与 intrusive list 相同，见 intrusive_list.h
+//
+// 异常保证：
+// 插入时哈希函数、比较函数或分配 bucket 抛出异常，哈希表保持不变
+// erase(iterator) 与 erase(value) 只使用保存的哈希值，不会抛出异常；
+// erase_unique / erase_multi 需要计算键值的哈希并比较，可能抛出异常
+
+#include "functional.h"
+#include "hashtable.h"
+#include "intrusive_list.h"
+#include "iterator.h"
+#include "util.h"
+#include "vector.h"
+
+namespace mystl {
+
+// 侵入式哈希表的hook，未链接时next指向自身，复制对象时不复制链接关系
+template <typename Tag = IntrusiveDefaultTag>
+struct IntrusiveHashHook {
+  IntrusiveHashHook* next;
+  size_t hash_code;  // 链接时由哈希表写入的哈希值
+
+  IntrusiveHashHook() noexcept : hash_code(0) { reset(); }
+  IntrusiveHashHook(const IntrusiveHashHook& /*rhs*/) noexcept : hash_code(0) { reset(); }
+  IntrusiveHashHook& operator=(const IntrusiveHashHook& /*rhs*/) noexcept { return *this; }
+
+#if MYSTL_INTRUSIVE_SAFE_LINK
+  ~IntrusiveHashHook() { MYSTL_DEBUG(!is_linked()); }
+#endif
+
+  bool is_linked() const noexcept { return next != this; }
+
+  // 置为未链接的状态
+  void reset() noexcept { next = this; }
+};
+
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+class IntrusiveHashtable;
+
+// 迭代器，到达一个bucket的末尾时转到下一个非空的bucket
+template <typename Table, typename Ref, typename Ptr>
+struct IntrusiveHtIterator
+    : public mystl::Iterator<mystl::ForwardIteratorTag, typename Table::value_type> {
+  using iterator = IntrusiveHtIterator<Table, typename Table::reference, typename Table::pointer>;
+  using self = IntrusiveHtIterator;
+
+  using value_type = typename Table::value_type;
+  using pointer = Ptr;
+  using reference = Ref;
+  using hook_ptr = typename Table::hook_ptr;
+  using table_ptr = const Table*;
+
+  hook_ptr node;  // 当前元素的hook
+  table_ptr ht;   // 所在的哈希表
+
+  IntrusiveHtIterator() noexcept : node(nullptr), ht(nullptr) {}
+  IntrusiveHtIterator(hook_ptr n, table_ptr t) noexcept : node(n), ht(t) {}
+  IntrusiveHtIterator(const iterator& rhs) noexcept : node(rhs.node), ht(rhs.ht) {}
+
+  self& operator=(const self& rhs) = default;
+
+  reference operator*() const { return *Table::to_value(node); }
+  pointer operator->() const { return &(operator*()); }
+
+  self& operator++() {
+    MYSTL_DEBUG(node != nullptr);
+    hook_ptr old = node;
+    node = node->next;
+    if (node == nullptr) {
+      node = ht->first_after(ht->bucket_of(old) + 1);
+    }
+    return *this;
+  }
+
+  self operator++(int) {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  bool operator==(const self& rhs) const { return node == rhs.node; }
+  bool operator!=(const self& rhs) const { return node != rhs.node; }
+};
+
+// 模板类IntrusiveHashtable
+// 参数一代表键值类型，参数二代表元素类型，要求继承IntrusiveHashHook<Tag>
+// 参数三代表从元素中取得键值的函数对象，参数四代表哈希函数，参数五代表键值相等的比较函数
+// 参数六代表所使用的hook标签
+template <typename Key, typename T, typename KeyOfValue, typename Hash = mystl::Hash<Key>,
+          typename KeyEqual = mystl::EqualTo<Key>, typename Tag = IntrusiveDefaultTag>
+class IntrusiveHashtable {
+  template <typename, typename, typename>
+  friend struct mystl::IntrusiveHtIterator;
+
+ public:
+  using key_type = Key;
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  using hook_type = IntrusiveHashHook<Tag>;
+  using hook_ptr = hook_type*;
+  using bucket_type = mystl::Vector<hook_ptr>;
+
+  using iterator = IntrusiveHtIterator<IntrusiveHashtable, T&, T*>;
+  using const_iterator = IntrusiveHtIterator<IntrusiveHashtable, const T&, const T*>;
+
+ private:
+  bucket_type buckets_;
+  size_type bucket_size_;  // vector长度
+  size_type size_;         // 总的元素个数
+  float mlf_;
+  hasher hash_;
+  key_equal equal_;
+  KeyOfValue get_key_;
+
+ public:
+  // 构造、移动、析构函数，容器不拥有元素，不能复制
+  explicit IntrusiveHashtable(
+      size_type bucket_count = 100, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+      : buckets_(ht_next_prime(bucket_count), nullptr),
+        bucket_size_(buckets_.size()),
+        size_(0),
+        mlf_(1.0F),
+        hash_(hash),
+        equal_(equal),
+        get_key_() {}
+
+  IntrusiveHashtable(const IntrusiveHashtable&) = delete;
+  IntrusiveHashtable& operator=(const IntrusiveHashtable&) = delete;
+
+  IntrusiveHashtable(IntrusiveHashtable&& rhs) noexcept
+      : buckets_(mystl::move(rhs.buckets_)),
+        bucket_size_(rhs.bucket_size_),
+        size_(rhs.size_),
+        mlf_(rhs.mlf_),
+        hash_(rhs.hash_),
+        equal_(rhs.equal_),
+        get_key_(rhs.get_key_) {
+    rhs.bucket_size_ = 0;
+    rhs.size_ = 0;
+  }
+
+  IntrusiveHashtable& operator=(IntrusiveHashtable&& rhs) noexcept {
+    IntrusiveHashtable tmp(mystl::move(rhs));
+    swap(tmp);
+    return *this;
+  }
+
+  // 析构时解除所有元素的链接，不析构元素
+  ~IntrusiveHashtable() { clear(); }
+
+  // 迭代器相关操作
+  iterator begin() noexcept { return iterator(first_after(0), this); }
+  const_iterator begin() const noexcept { return const_iterator(first_after(0), this); }
+  iterator end() noexcept { return iterator(nullptr, this); }
+  const_iterator end() const noexcept { return const_iterator(nullptr, this); }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  // 由元素得到指向它的迭代器，时间复杂度为O(1)，要求value在当前哈希表中
+  iterator iterator_to(reference value) noexcept { return iterator(to_hook(value), this); }
+  const_iterator iterator_to(const_reference value) const noexcept {
+    return const_iterator(to_hook(const_cast<reference>(value)), this);
+  }
+
+  // 容量相关操作
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+
+  // 插入删除相关操作，只修改链接指针，不复制、不析构元素
+  mystl::pair<iterator, bool> insert_unique(reference value);
+  iterator insert_multi(reference value);
+
+  void erase(const_iterator position) noexcept;
+  void erase(const_reference value) noexcept { erase(iterator_to(value)); }
+  size_type erase_unique(const key_type& key);
+  size_type erase_multi(const key_type& key);
+
+  void clear() noexcept;
+
+  void swap(IntrusiveHashtable& rhs) noexcept;
+
+  // 查找相关操作
+  iterator find(const key_type& key) { return iterator(find_node(key), this); }
+  const_iterator find(const key_type& key) const { return const_iterator(find_node(key), this); }
+
+  size_type count(const key_type& key) const;
+
+  // bucket相关操作
+  size_type bucket_count() const noexcept { return bucket_size_; }
+  size_type bucket(const key_type& key) const { return hash(key); }
+  size_type bucket_size(size_type n) const noexcept;
+
+  // hash policy
+  float load_factor() const noexcept {
+    return bucket_size_ != 0 ? (float)size_ / bucket_size_ : 0.0F;
+  }
+  float max_load_factor() const noexcept { return mlf_; }
+  void max_load_factor(float ml) {
+    THROW_OUT_OF_RANGE_IF(ml != ml || ml < 0, "invalid hash load factor");
+    mlf_ = ml;
+  }
+
+  void rehash(size_type count);
+  void reserve(size_type count) {
+    rehash(static_cast<size_type>((float)count / max_load_factor() + 0.5F));
+  }
+
+  hasher hash_fcn() const { return hash_; }
+  key_equal key_eq() const { return equal_; }
+
+ private:
+  // helper functions
+  static hook_ptr to_hook(reference value) noexcept {
+    return static_cast<hook_ptr>(mystl::address_of(value));
+  }
+  static pointer to_value(hook_ptr h) noexcept { return static_cast<pointer>(h); }
+
+  size_type hash(const key_type& key) const { return hash_(key) % bucket_size_; }
+  // 已链接的结点所在的bucket
+  size_type bucket_of(hook_ptr h) const noexcept { return h->hash_code % bucket_size_; }
+
+  // 从第n个bucket开始的第一个元素，不存在时返回nullptr
+  hook_ptr first_after(size_type n) const noexcept {
+    for (; n < bucket_size_; ++n) {
+      if (buckets_[n] != nullptr) {
+        return buckets_[n];
+      }
+    }
+    return nullptr;
+  }
+
+  hook_ptr find_node(const key_type& key) const;
+  void link_after(hook_ptr* prev_next, hook_ptr x, size_t code) noexcept;
+  void rehash_if_need(size_type n) {
+    if (static_cast<float>(size_ + n) > (float)bucket_size_ * max_load_factor()) {
+      rehash(size_ + n);
+    }
+  }
+  void replace_bucket(size_type bucket_count);
+};
+
+// 插入元素，键值不允许重复，已存在相同键值的元素时返回它
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+mystl::pair<typename IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::iterator, bool>
+IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::insert_unique(reference value) {
+  rehash_if_need(1);
+  const size_t code = hash_(get_key_(value));
+  const auto n = code % bucket_size_;
+  for (auto cur = buckets_[n]; cur; cur = cur->next) {
+    if (equal_(get_key_(*to_value(cur)), get_key_(value))) {
+      return mystl::make_pair(iterator(cur, this), false);
+    }
+  }
+  // 让新元素成为链表的第一个结点
+  hook_ptr x = to_hook(value);
+  link_after(&buckets_[n], x, code);
+  return mystl::make_pair(iterator(x, this), true);
+}
+
+// 插入元素，键值允许重复，存在相同键值的元素时紧跟在它之后
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+typename IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::iterator
+IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::insert_multi(reference value) {
+  rehash_if_need(1);
+  const size_t code = hash_(get_key_(value));
+  const auto n = code % bucket_size_;
+  hook_ptr x = to_hook(value);
+  for (auto cur = buckets_[n]; cur; cur = cur->next) {
+    if (equal_(get_key_(*to_value(cur)), get_key_(value))) {
+      link_after(&cur->next, x, code);
+      return iterator(x, this);
+    }
+  }
+  link_after(&buckets_[n], x, code);
+  return iterator(x, this);
+}
+
+// 删除迭代器所指的元素，由保存的哈希值找到所在的bucket，再在其中找到它的前一个结点
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+void IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::erase(
+    const_iterator position) noexcept {
+  hook_ptr p = position.node;
+  MYSTL_DEBUG(p != nullptr);
+  hook_ptr* link = &buckets_[bucket_of(p)];
+  while (*link != p) {
+    MYSTL_DEBUG(*link != nullptr);
+    link = &(*link)->next;
+  }
+  *link = p->next;
+  --size_;
+#if MYSTL_INTRUSIVE_SAFE_LINK
+  p->reset();
+#endif
+}
+
+// 删除键值为key的元素，返回删除的个数
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+typename IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::size_type
+IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::erase_unique(
+    const key_type& key) {
+  if (size_ == 0) {
+    return 0;
+  }
+  for (hook_ptr* link = &buckets_[hash(key)]; *link; link = &(*link)->next) {
+    hook_ptr p = *link;
+    if (equal_(get_key_(*to_value(p)), key)) {
+      *link = p->next;
+      --size_;
+#if MYSTL_INTRUSIVE_SAFE_LINK
+      p->reset();
+#endif
+      return 1;
+    }
+  }
+  return 0;
+}
+
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+typename IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::size_type
+IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::erase_multi(
+    const key_type& key) {
+  if (size_ == 0) {
+    return 0;
+  }
+  hook_ptr* link = &buckets_[hash(key)];
+  while (*link && !equal_(get_key_(*to_value(*link)), key)) {
+    link = &(*link)->next;
+  }
+  // 相同键值的元素相邻，逐个摘下直到键值不同
+  size_type n = 0;
+  while (*link && equal_(get_key_(*to_value(*link)), key)) {
+    hook_ptr p = *link;
+    *link = p->next;
+#if MYSTL_INTRUSIVE_SAFE_LINK
+    p->reset();
+#endif
+    ++n;
+  }
+  size_ -= n;
+  return n;
+}
+
+// 解除所有元素的链接
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+void IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::clear() noexcept {
+  if (size_ != 0) {
+    for (size_type i = 0; i < bucket_size_; ++i) {
+#if MYSTL_INTRUSIVE_SAFE_LINK
+      for (hook_ptr cur = buckets_[i]; cur;) {
+        hook_ptr next = cur->next;
+        cur->reset();
+        cur = next;
+      }
+#endif
+      buckets_[i] = nullptr;
+    }
+    size_ = 0;
+  }
+}
+
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+void IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::swap(
+    IntrusiveHashtable& rhs) noexcept {
+  if (this != &rhs) {
+    buckets_.swap(rhs.buckets_);
+    mystl::swap(bucket_size_, rhs.bucket_size_);
+    mystl::swap(size_, rhs.size_);
+    mystl::swap(mlf_, rhs.mlf_);
+    mystl::swap(hash_, rhs.hash_);
+    mystl::swap(equal_, rhs.equal_);
+    mystl::swap(get_key_, rhs.get_key_);
+  }
+}
+
+// 查找键值为key出现的次数
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+typename IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::size_type
+IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::count(const key_type& key) const {
+  size_type result = 0;
+  for (hook_ptr cur = find_node(key); cur && equal_(get_key_(*to_value(cur)), key);
+       cur = cur->next) {
+    ++result;
+  }
+  return result;
+}
+
+// 查看在某个bucket中元素的个数
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+typename IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::size_type
+IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::bucket_size(
+    size_type n) const noexcept {
+  size_type result = 0;
+  for (auto cur = buckets_[n]; cur; cur = cur->next) {
+    ++result;
+  }
+  return result;
+}
+
+// 重新对元素进行一遍哈希，新的bucket个数与hashtable的策略相同
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+void IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::rehash(size_type count) {
+  const auto n = ht_rehash_bucket_count(count, size_, bucket_size_, max_load_factor());
+  if (n != 0) {
+    replace_bucket(n);
+  }
+}
+
+// 在key所在的bucket中查找键值等于key的第一个元素，找不到返回nullptr
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+typename IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::hook_ptr
+IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::find_node(const key_type& key) const {
+  // 移动之后的哈希表没有bucket
+  if (size_ == 0) {
+    return nullptr;
+  }
+  for (hook_ptr cur = buckets_[hash(key)]; cur; cur = cur->next) {
+    if (equal_(get_key_(*to_value(cur)), key)) {
+      return cur;
+    }
+  }
+  return nullptr;
+}
+
+// 把x连接在*prev_next所指的结点之前，prev_next为bucket或前一个结点的next，code为x的哈希值
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+void IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::link_after(
+    hook_ptr* prev_next, hook_ptr x, size_t code) noexcept {
+#if MYSTL_INTRUSIVE_SAFE_LINK
+  MYSTL_DEBUG(!x->is_linked());
+#endif
+  x->hash_code = code;
+  x->next = *prev_next;
+  *prev_next = x;
+  ++size_;
+}
+
+// 把所有元素挂到新的bucket上，相同键值的元素保持相邻
+// 只使用保存的哈希值，不调用哈希函数与比较函数，只有分配bucket可能抛出异常
+// 哈希值相同的元素一定落在同一个bucket中，因此链表中哈希值相同的一段元素整体接到新bucket的头部，
+// 相同键值的元素哈希值相同，移动之后仍然相邻
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+void IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>::replace_bucket(
+    size_type bucket_count) {
+  bucket_type bucket(bucket_count, nullptr);
+  for (size_type i = 0; i < bucket_size_; ++i) {
+    for (hook_ptr first = buckets_[i]; first;) {
+      hook_ptr last = first;
+      while (last->next != nullptr && last->next->hash_code == first->hash_code) {
+        last = last->next;
+      }
+      hook_ptr next = last->next;
+      const auto n = first->hash_code % bucket_count;
+      last->next = bucket[n];
+      bucket[n] = first;
+      first = next;
+    }
+  }
+  buckets_.swap(bucket);
+  bucket_size_ = buckets_.size();
+}
+
+// 重载 mystl 的 swap
+template <typename Key, typename T, typename KeyOfValue, typename Hash, typename KeyEqual,
+          typename Tag>
+void swap(IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>& lhs,
+          IntrusiveHashtable<Key, T, KeyOfValue, Hash, KeyEqual, Tag>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_INTRUSIVE_HASHTABLE_H_
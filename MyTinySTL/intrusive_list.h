@@ -0,0 +1,381 @@
+#ifndef MYTINYSTL_INTRUSIVE_LIST_H_
+#define MYTINYSTL_INTRUSIVE_LIST_H_
+
+// 这个头文件包含一个模板类 IntrusiveList
+// IntrusiveList : 侵入式双向链表，链接指针（hook）存放在元素对象内部，容器不分配也不释放任何内存，
+//                 只负责把已存在的对象串起来
+
+// notes:
+//
+// 元素类型通过继承 IntrusiveListHook<Tag> 获得链接指针，hook 与 list 共用 ListNodeBase 的结构，
+// 同一个对象继承多个不同 Tag 的 hook 时可以同时存在于多个链表中
+// 容器不拥有元素，元素的生命周期由使用者管理，对象析构之前必须先从链表中删除
+//
+// safe link 模式（定义了MYSTL_INTRUSIVE_SAFE_LINK为1，未定义NDEBUG时缺省开启）：
+//   * hook 从链表中删除时被置空，is_linked() 可以判断对象是否在某个链表中
+//   * 把已经在链表中的对象再次插入、或者析构仍在链表中的对象时触发断言
+// 关闭 safe link 模式之后删除元素不再置空 hook，is_linked() 的结果不可靠
+
+#include "iterator.h"
+#include "list.h"
+#include "util.h"
+
+#ifndef MYSTL_INTRUSIVE_SAFE_LINK
+#ifdef NDEBUG
+#define MYSTL_INTRUSIVE_SAFE_LINK 0
+#else
+#define MYSTL_INTRUSIVE_SAFE_LINK 1
+#endif
+#endif
+
+namespace mystl {
+
+// 缺省的hook标签，对象需要同时存在于多个侵入式容器中时，为每个容器定义不同的标签
+struct IntrusiveDefaultTag {};
+
+// 侵入式链表的hook，复制对象时不复制链接关系
+template <typename Tag = IntrusiveDefaultTag>
+struct IntrusiveListHook : public ListNodeBase<Tag> {
+  IntrusiveListHook() noexcept { reset(); }
+  IntrusiveListHook(const IntrusiveListHook& /*rhs*/) noexcept { reset(); }
+  IntrusiveListHook& operator=(const IntrusiveListHook& /*rhs*/) noexcept { return *this; }
+
+#if MYSTL_INTRUSIVE_SAFE_LINK
+  ~IntrusiveListHook() { MYSTL_DEBUG(!is_linked()); }
+#endif
+
+  bool is_linked() const noexcept { return this->next != nullptr; }
+
+  // 置为未链接的状态
+  void reset() noexcept { this->prev = this->next = nullptr; }
+};
+
+// 迭代器
+template <typename T, typename Tag, typename Ref, typename Ptr>
+struct IntrusiveListIterator : public mystl::Iterator<mystl::BidirectionalIteratorTag, T> {
+  using iterator = IntrusiveListIterator<T, Tag, T&, T*>;
+  using const_iterator = IntrusiveListIterator<T, Tag, const T&, const T*>;
+  using self = IntrusiveListIterator;
+
+  using value_type = T;
+  using pointer = Ptr;
+  using reference = Ref;
+  using base_ptr = ListNodeBase<Tag>*;
+  using hook_type = IntrusiveListHook<Tag>;
+
+  base_ptr node_;  // 指向当前元素的hook
+
+  IntrusiveListIterator() noexcept : node_(nullptr) {}
+  explicit IntrusiveListIterator(base_ptr x) noexcept : node_(x) {}
+  IntrusiveListIterator(const iterator& rhs) noexcept : node_(rhs.node_) {}
+
+  self& operator=(const self& rhs) = default;
+
+  reference operator*() const { return *static_cast<T*>(static_cast<hook_type*>(node_)); }
+  pointer operator->() const { return &(operator*()); }
+
+  self& operator++() {
+    MYSTL_DEBUG(node_ != nullptr);
+    node_ = node_->next;
+    return *this;
+  }
+
+  self operator++(int) {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  self& operator--() {
+    MYSTL_DEBUG(node_ != nullptr);
+    node_ = node_->prev;
+    return *this;
+  }
+
+  self operator--(int) {
+    self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+  bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+// 模板类IntrusiveList
+// 参数一代表元素类型，要求继承IntrusiveListHook<Tag>，参数二代表所使用的hook标签
+template <typename T, typename Tag = IntrusiveDefaultTag>
+class IntrusiveList {
+ public:
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+
+  using iterator = IntrusiveListIterator<T, Tag, T&, T*>;
+  using const_iterator = IntrusiveListIterator<T, Tag, const T&, const T*>;
+  using reverse_iterator = mystl::ReverseIterator<iterator>;
+  using const_reverse_iterator = mystl::ReverseIterator<const_iterator>;
+
+  using hook_type = IntrusiveListHook<Tag>;
+  using base_ptr = ListNodeBase<Tag>*;
+
+ private:
+  ListNodeBase<Tag> node_;  // 头结点，node_.next为第一个元素，node_.prev为最后一个元素
+  size_type size_;          // 元素个数
+
+ public:
+  // 构造、移动、析构函数，容器不拥有元素，不能复制
+  IntrusiveList() noexcept : size_(0) { node_.unlink(); }
+
+  IntrusiveList(const IntrusiveList&) = delete;
+  IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+  IntrusiveList(IntrusiveList&& rhs) noexcept : IntrusiveList() { swap(rhs); }
+
+  IntrusiveList& operator=(IntrusiveList&& rhs) noexcept {
+    clear();
+    swap(rhs);
+    return *this;
+  }
+
+  // 析构时解除所有元素的链接，不析构元素
+  ~IntrusiveList() { clear(); }
+
+ public:
+  // 迭代器相关操作
+  iterator begin() noexcept { return iterator(node_.next); }
+  const_iterator begin() const noexcept { return const_iterator(node_.next); }
+  iterator end() noexcept { return iterator(&node_); }
+  const_iterator end() const noexcept { return const_iterator(end_node()); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  // 由元素得到指向它的迭代器，时间复杂度为O(1)，要求value在当前链表中
+  iterator iterator_to(reference value) noexcept { return iterator(to_hook(value)); }
+  const_iterator iterator_to(const_reference value) const noexcept {
+    return const_iterator(to_hook(const_cast<reference>(value)));
+  }
+
+  // 容量相关操作
+  bool empty() const noexcept { return node_.next == end_node(); }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+
+  // 访问元素相关操作
+  reference front() {
+    MYSTL_DEBUG(!empty());
+    return *begin();
+  }
+  const_reference front() const {
+    MYSTL_DEBUG(!empty());
+    return *begin();
+  }
+  reference back() {
+    MYSTL_DEBUG(!empty());
+    return *(--end());
+  }
+  const_reference back() const {
+    MYSTL_DEBUG(!empty());
+    return *(--end());
+  }
+
+  // 插入删除相关操作，只修改链接指针，不复制、不析构元素
+  void push_front(reference value) noexcept { link_before(node_.next, to_hook(value)); }
+  void push_back(reference value) noexcept { link_before(&node_, to_hook(value)); }
+
+  void pop_front() noexcept {
+    MYSTL_DEBUG(!empty());
+    unlink(node_.next);
+  }
+  void pop_back() noexcept {
+    MYSTL_DEBUG(!empty());
+    unlink(node_.prev);
+  }
+
+  // 在pos之前插入value，返回指向value的迭代器
+  iterator insert(const_iterator pos, reference value) noexcept {
+    base_ptr x = to_hook(value);
+    link_before(pos.node_, x);
+    return iterator(x);
+  }
+
+  // 删除pos处的元素，返回下一个位置
+  iterator erase(const_iterator pos) noexcept {
+    MYSTL_DEBUG(pos != cend());
+    base_ptr next = pos.node_->next;
+    unlink(pos.node_);
+    return iterator(next);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    while (first != last) {
+      first = erase(first);
+    }
+    return iterator(last.node_);
+  }
+
+  // 删除元素之后对它调用disposer(pointer)，可以用来释放元素
+  template <typename Disposer>
+  iterator erase_and_dispose(const_iterator pos, Disposer disposer) {
+    pointer p = &*iterator(pos.node_);
+    iterator next = erase(pos);
+    disposer(p);
+    return next;
+  }
+
+  template <typename Disposer>
+  void clear_and_dispose(Disposer disposer) {
+    while (!empty()) {
+      pointer p = &front();
+      pop_front();
+      disposer(p);
+    }
+  }
+
+  void remove(const_reference value) noexcept { erase(iterator_to(value)); }
+
+  template <typename UnaryPredicate>
+  void remove_if(UnaryPredicate pred) {
+    for (auto it = begin(); it != end();) {
+      it = pred(*it) ? erase(it) : ++it;
+    }
+  }
+
+  // 解除所有元素的链接
+  void clear() noexcept {
+#if MYSTL_INTRUSIVE_SAFE_LINK
+    for (base_ptr cur = node_.next; cur != &node_;) {
+      base_ptr next = cur->next;
+      static_cast<hook_type*>(cur)->reset();
+      cur = next;
+    }
+#endif
+    node_.unlink();
+    size_ = 0;
+  }
+
+  void swap(IntrusiveList& rhs) noexcept;
+
+  // 将x的所有元素接合于pos之前
+  void splice(const_iterator pos, IntrusiveList& x) noexcept;
+  // 将x中it所指的元素接合于pos之前
+  void splice(const_iterator pos, IntrusiveList& x, const_iterator it) noexcept;
+
+  void reverse() noexcept;
+
+ private:
+  // helper functions
+  base_ptr end_node() const noexcept { return const_cast<base_ptr>(&node_); }
+
+  static base_ptr to_hook(reference value) noexcept {
+    return static_cast<base_ptr>(static_cast<hook_type*>(mystl::address_of(value)));
+  }
+
+  void link_before(base_ptr pos, base_ptr x) noexcept;
+  void unlink(base_ptr x) noexcept;
+  void adopt_head(base_ptr old_head) noexcept;
+};
+
+// 交换两个容器，头结点嵌在容器中，交换之后需要修正首尾元素指向头结点的指针
+template <typename T, typename Tag>
+void IntrusiveList<T, Tag>::swap(IntrusiveList& rhs) noexcept {
+  mystl::swap(node_.prev, rhs.node_.prev);
+  mystl::swap(node_.next, rhs.node_.next);
+  mystl::swap(size_, rhs.size_);
+  adopt_head(&rhs.node_);
+  rhs.adopt_head(&node_);
+}
+
+template <typename T, typename Tag>
+void IntrusiveList<T, Tag>::splice(const_iterator pos, IntrusiveList& x) noexcept {
+  MYSTL_DEBUG(this != &x);
+  if (x.empty()) {
+    return;
+  }
+  base_ptr f = x.node_.next;
+  base_ptr l = x.node_.prev;
+  base_ptr p = pos.node_;
+  x.node_.unlink();
+  p->prev->next = f;
+  f->prev = p->prev;
+  p->prev = l;
+  l->next = p;
+  size_ += x.size_;
+  x.size_ = 0;
+}
+
+template <typename T, typename Tag>
+void IntrusiveList<T, Tag>::splice(const_iterator pos, IntrusiveList& x,
+                                   const_iterator it) noexcept {
+  if (pos.node_ != it.node_ && pos.node_ != it.node_->next) {
+    base_ptr n = it.node_;
+    x.unlink(n);
+    link_before(pos.node_, n);
+  }
+}
+
+// 将链表反转
+template <typename T, typename Tag>
+void IntrusiveList<T, Tag>::reverse() noexcept {
+  base_ptr cur = &node_;
+  do {
+    mystl::swap(cur->prev, cur->next);
+    cur = cur->prev;
+  } while (cur != &node_);
+}
+
+// 把x连接在pos之前
+template <typename T, typename Tag>
+void IntrusiveList<T, Tag>::link_before(base_ptr pos, base_ptr x) noexcept {
+#if MYSTL_INTRUSIVE_SAFE_LINK
+  MYSTL_DEBUG(!static_cast<hook_type*>(x)->is_linked());
+#endif
+  x->prev = pos->prev;
+  x->next = pos;
+  pos->prev->next = x;
+  pos->prev = x;
+  ++size_;
+}
+
+// 把x从链表中断开
+template <typename T, typename Tag>
+void IntrusiveList<T, Tag>::unlink(base_ptr x) noexcept {
+  x->prev->next = x->next;
+  x->next->prev = x->prev;
+  --size_;
+#if MYSTL_INTRUSIVE_SAFE_LINK
+  static_cast<hook_type*>(x)->reset();
+#endif
+}
+
+// 首尾元素原先指向old_head，改为指向当前容器的头结点
+template <typename T, typename Tag>
+void IntrusiveList<T, Tag>::adopt_head(base_ptr old_head) noexcept {
+  if (node_.next == old_head) {
+    node_.unlink();
+  } else {
+    node_.next->prev = &node_;
+    node_.prev->next = &node_;
+  }
+}
+
+// 重载 mystl 的 swap
+template <typename T, typename Tag>
+void swap(IntrusiveList<T, Tag>& lhs, IntrusiveList<T, Tag>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_INTRUSIVE_LIST_H_
@@ -125,6 +125,19 @@ template <typename Iterator>
 struct IsIterator : public m_bool_constant<
                         IsInputIterator<Iterator>::value || IsOutputIterator<Iterator>::value> {};
 
+// 分段迭代器萃取
+// 分段迭代器（如 deque 的迭代器）所指的区间由若干段连续内存组成，容器为自己的迭代器特化此模板后，
+// copy、fill、find 等算法会逐段处理，每段都走指针版本。特化版本需继承 m_true_type 并提供：
+//   segment_iterator、local_iterator 两个类型
+//   segment(it)、local(it)：迭代器所在的段以及在段内的位置
+//   begin(seg)、end(seg)：段的首尾
+//   compose(seg, local)：由段和段内位置还原迭代器，local 不能是段尾
+template <typename Iterator>
+struct SegmentedIteratorTraits : public m_false_type {};
+
+template <typename Iterator>
+struct IsSegmentedIterator : public m_bool_constant<SegmentedIteratorTraits<Iterator>::kValue> {};
+
 // 萃取某个迭代器的category
 template <typename Iterator>
 typename IteratorTraits<Iterator>::iterator_category iterator_category(const Iterator& /*unused*/) {
@@ -379,7 +379,7 @@ class List {
   void push_front(const value_type& value) {
     THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "List<T>'s size is too big");
     auto link_node = create_node(value);
-    link_nodes_at_front(link_node->as_base(), link_node->as_base);
+    link_nodes_at_front(link_node->as_base(), link_node->as_base());
     ++size_;
   }
 
@@ -447,10 +447,10 @@ class List {
   template <typename Compare>
   void merge(List& x, Compare comp);
 
-  void sort() { list_sort(begin(), end(), size(), mystl::Less<T>()); }
+  void sort() { list_sort(mystl::Less<T>()); }
   template <typename Compare>
   void sort(Compare comp) {
-    list_sort(begin(), end(), size(), comp);
+    list_sort(comp);
   }
 
   void reverse();
@@ -486,8 +486,11 @@ class List {
   iterator copy_insert(const_iterator pos, size_type n, Iter first);
 
   // sort
+  static base_ptr append_run(base_ptr tail, base_ptr first, base_ptr last) noexcept;
+  template <typename Compare>
+  static void merge_runs(base_ptr a, base_ptr& b, Compare& comp);
   template <typename Compare>
-  iterator list_sort(iterator f1, iterator l2, size_type n, Compare comp);
+  void list_sort(Compare comp);
 };
 
 // 删除pos处的元素
@@ -523,7 +526,7 @@ void List<T>::clear() {
   if (size_ != 0) {
     auto cur = node_->next;
     for (base_ptr next = cur->next; cur != node_; cur = next, next = cur->next) {
-      destroy(cur->as_node());
+      destroy_node(cur->as_node());
     }
     node_->unlink();
     size_ = 0;
@@ -854,7 +857,7 @@ typename List<T>::iterator List<T>::fill_insert(
       auto enode = end.node_;
       while (true) {
         auto prev = enode->prev;
-        destroy(enode->as_node());
+        destroy_node(enode->as_node());
         if (prev == nullptr) {
           break;
         }
@@ -902,74 +905,127 @@ typename List<T>::iterator List<T>::copy_insert(const_iterator pos, size_type n,
   return r;
 }
 
-// 对List进行归并排序，返回一个迭代器指向区间最小元素的位置
+// 把首尾为first、last的一段结点接在tail之后，返回新的尾结点，first为空时什么也不做
 template <typename T>
-template <typename Compared>
-typename List<T>::iterator List<T>::list_sort(
-    iterator f1, iterator l2, size_type n, Compared comp) {
-  if (n < 2) {
-    return f1;
+typename List<T>::base_ptr List<T>::append_run(base_ptr tail, base_ptr first,
+                                               base_ptr last) noexcept {
+  if (first == nullptr) {
+    return tail;
   }
+  tail->next = first;
+  first->prev = tail;
+  return last;
+}
 
-  if (n == 2) {
-    if (comp(*--l2, *f1)) {
-      auto ln = l2.node_;
-      unlink_nodes(ln, ln);
-      link_nodes(f1.node_, ln, ln);
-      return l2;
+// 把两段以nullptr结尾的有序结点序列合并到b中，a中的结点排在b之前，相等时a优先，保证稳定
+// 合并时顺带维护prev，每段序列首结点的prev指向该序列的尾结点，a和b都不能为空
+// comp抛出异常时，b保存两段序列的全部结点，次序未定
+template <typename T>
+template <typename Compare>
+void List<T>::merge_runs(base_ptr a, base_ptr& b, Compare& comp) {
+  const base_ptr a_last = a->prev;
+  const base_ptr b_last = b->prev;
+  base_ptr rest = b;
+  ListNodeBase<T> head;
+  base_ptr tail = &head;
+  try {
+    while (a != nullptr && rest != nullptr) {
+      if (comp(rest->as_node()->value, a->as_node()->value)) {
+        tail->next = rest;
+        rest->prev = tail;
+        tail = rest;
+        rest = rest->next;
+      } else {
+        tail->next = a;
+        a->prev = tail;
+        tail = a;
+        a = a->next;
+      }
     }
-    return f1;
+  } catch (...) {
+    tail = append_run(append_run(tail, a, a_last), rest, b_last);
+    head.next->prev = tail;
+    b = head.next;
+    throw;
   }
+  tail = append_run(append_run(tail, a, a_last), rest, b_last);
+  head.next->prev = tail;
+  b = head.next;
+}
 
-  auto n2 = n / 2;
-  auto l1 = f1;
-  mystl::advance(l1, n2);
-  auto result = f1 = list_sort(f1, l1, n2, comp);  // 前半段的最小位置
-  auto f2 = l1 = list_sort(l1, l2, n - n2, comp);  // 后半段的最小位置
-
-  // 把较小的一段区间移到前面
-  if (comp(*f2, *f1)) {
-    auto m = f2;
-    ++m;
-    for (; m != l2 && comp(*m, *f1); ++m) {
-      ;
-    }
-    auto f = f2.node_;
-    auto l = m.node_->prev;
-    result = f2;
-    l1 = f2 = m;
-    unlink_nodes(f, l);
-    m = f1;
-    ++m;
-    link_nodes(f1.node_, f, l);
-    f1 = m;
-  } else {
-    ++f1;
+// 自底向上的归并排序，不分配内存，也不需要反复寻找区间的中点
+// 排序时先断开环形链表，binary[i]为空或者保存一段长度为2^i的有序序列，每个结点依次并入binary[0]，
+// 像二进制加一那样向高位进位；最后把所有序列合并，再把首尾接回头结点
+// comp抛出异常时，把binary、carry与尚未处理的结点按任意次序接回头结点后重新抛出，不会丢失结点
+// ForwardList::list_sort与这里的做法相同，修改时需要保持一致
+template <typename T>
+template <typename Compare>
+void List<T>::list_sort(Compare comp) {
+  if (size_ < 2) {
+    return;
   }
+  static constexpr size_t kMaxBins = sizeof(size_type) * 8;
+  base_ptr binary[kMaxBins] = {};
+  size_t fill = 0;  // binary中最高的非空位置加一
+
+  const base_ptr last = node_->prev;
+  last->next = nullptr;
+  base_ptr cur = node_->next;
+  base_ptr carry = nullptr;  // 正在进位或合并的序列，不在binary中
+  try {
+    while (cur != nullptr) {
+      carry = cur;
+      cur = cur->next;
+      carry->next = nullptr;
+      carry->prev = carry;
+      size_t i = 0;
+      // binary[i]中的结点都在carry之前，先取出再合并，异常时结点只留在carry中
+      for (; i < fill && binary[i] != nullptr; ++i) {
+        base_ptr run = binary[i];
+        binary[i] = nullptr;
+        merge_runs(run, carry, comp);
+      }
+      binary[i] = carry;
+      carry = nullptr;
+      if (i == fill) {
+        ++fill;
+      }
+    }
 
-  // 合并两段有序区间
-  while (f1 != l1 && f2 != l2) {
-    if (comp(*f2, *f1)) {
-      auto m = f2;
-      ++m;
-      for (; m != l2 && comp(*m, *f1); ++m) {
-        ;
+    // 位置越高的序列越早形成，合并时放在前面
+    for (size_t i = 0; i < fill; ++i) {
+      if (binary[i] != nullptr) {
+        base_ptr run = binary[i];
+        binary[i] = nullptr;
+        if (carry == nullptr) {
+          carry = run;
+        } else {
+          merge_runs(run, carry, comp);
+        }
       }
-      auto f = f2.node_;
-      auto l = m.node_->prev;
-      if (l1 == f2) {
-        l1 = m;
+    }
+  } catch (...) {
+    base_ptr tail = node_;
+    for (size_t i = 0; i < fill; ++i) {
+      if (binary[i] != nullptr) {
+        tail = append_run(tail, binary[i], binary[i]->prev);
       }
-      f2 = m;
-      unlink_nodes(f, l);
-      ++m;
-      link_nodes(f1.node_, f, l);
-      f1 = m;
-    } else {
-      ++f1;
     }
+    if (carry != nullptr) {
+      tail = append_run(tail, carry, carry->prev);
+    }
+    tail = append_run(tail, cur, last);
+    tail->next = node_;
+    node_->prev = tail;
+    throw;
   }
-  return result;
+
+  // 接回头结点，合并时已经维护好了中间结点的prev
+  base_ptr result_last = carry->prev;
+  node_->next = carry;
+  carry->prev = node_;
+  node_->prev = result_last;
+  result_last->next = node_;
 }
 
 // 重载比较操作符
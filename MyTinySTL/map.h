@@ -23,10 +23,23 @@
 #include "util.h"
 
 namespace mystl {
+
+// forward declaration begin
+template <typename Key, typename T, typename Compare, typename NodeTag>
+class MultiMap;
+// forward declaration end
+
 // 模板类map
 // 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省实用mystl::less
-template <typename Key, typename T, typename Compare = mystl::Less<Key>>
+// 参数四代表结点布局，缺省使用mystl::RbTreeDefaultNodeTag
+template <typename Key, typename T, typename Compare = mystl::Less<Key>,
+          typename NodeTag = mystl::RbTreeDefaultNodeTag>
 class Map {
+  template <typename, typename, typename, typename>
+  friend class Map;
+  template <typename, typename, typename, typename>
+  friend class MultiMap;
+
  public:
   using key_type = Key;
   using mapped_type = T;
@@ -35,7 +48,7 @@ class Map {
 
   // 定义一个functor，用来进行元素比较
   class ValueCompare : public mystl::BinaryFunction<value_type, value_type, bool> {
-    friend class Map<Key, T, Compare>;
+    friend class Map<Key, T, Compare, NodeTag>;
 
    private:
     Compare comp_;
@@ -48,11 +61,11 @@ class Map {
   };
 
  private:
-  using base_type = mystl::RbTree<value_type, key_compare>;
+  using base_type = mystl::RbTree<value_type, key_compare, NodeTag>;
   base_type tree_;
 
  public:
-  using node_type = typename base_type::node_type;
+  using node_type = typename base_type::node_handle;
   using pointer = typename base_type::pointer;
   using const_pointer = typename base_type::const_pointer;
   using reference = typename base_type::reference;
@@ -65,6 +78,8 @@ class Map {
   using difference_type = typename base_type::difference_type;
   using allocator_type = typename base_type::allocator_type;
 
+  using insert_return_type = mystl::InsertReturnType<iterator, node_type>;
+
  public:
   Map() = default;
 
@@ -72,6 +87,11 @@ class Map {
   Map(InputIterator first, InputIterator last) : tree_() {
     tree_.insert_unique(first, last);
   }
+  // 区间已排好序，直接以O(n)构造
+  template <typename InputIterator>
+  Map(SortedUniqueTag /*tag*/, InputIterator first, InputIterator last) : tree_() {
+    tree_.assign_sorted(first, last);
+  }
 
   Map(std::initializer_list<value_type> ilist) : tree_() {
     tree_.insert_unique(ilist.begin(), ilist.end());
@@ -136,19 +156,9 @@ class Map {
     return it->second;
   }
 
-  mapped_type& operator[](const key_type& key) {
-    iterator it = lower_bound(key);
-    if (it == end() || key_comp()(key, it->first)) {
-      it = emplace_hint(it, key, T{});
-    }
-    return it->second;
-  }
+  mapped_type& operator[](const key_type& key) { return try_emplace(key).first->second; }
   mapped_type& operator[](key_type&& key) {
-    iterator it = lower_bound(key);
-    if (it == end() || key_comp()(key, it->first)) {
-      it = emplace_hint(it, std::move(key), T{});
-    }
-    return it->second;
+    return try_emplace(mystl::move(key)).first->second;
   }
 
   // 插入删除相关
@@ -183,25 +193,175 @@ class Map {
 
   void clear() { tree_.clear(); }
 
+  // 键值不存在时才插入由key与args构造的元素，键值已存在时args不会被移动
+  template <typename... Args>
+  pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+    return tree_.try_emplace_unique(key, mystl::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+    return tree_.try_emplace_unique(mystl::move(key), mystl::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator try_emplace(iterator hint, const key_type& key, Args&&... args) {
+    return tree_.try_emplace_unique_use_hint(hint, key, mystl::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator try_emplace(iterator hint, key_type&& key, Args&&... args) {
+    return tree_.try_emplace_unique_use_hint(
+        hint, mystl::move(key), mystl::forward<Args>(args)...);
+  }
+
+  // 键值已存在时对实值赋值，否则插入新元素
+  template <typename M>
+  pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+    auto res = tree_.try_emplace_unique(key, mystl::forward<M>(obj));
+    if (!res.second) {
+      res.first->second = mystl::forward<M>(obj);
+    }
+    return res;
+  }
+  template <typename M>
+  pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+    auto res = tree_.try_emplace_unique(mystl::move(key), mystl::forward<M>(obj));
+    if (!res.second) {
+      res.first->second = mystl::forward<M>(obj);
+    }
+    return res;
+  }
+  template <typename M>
+  iterator insert_or_assign(iterator hint, const key_type& key, M&& obj) {
+    const auto n = size();
+    auto it = tree_.try_emplace_unique_use_hint(hint, key, mystl::forward<M>(obj));
+    if (size() == n) {
+      it->second = mystl::forward<M>(obj);
+    }
+    return it;
+  }
+  template <typename M>
+  iterator insert_or_assign(iterator hint, key_type&& key, M&& obj) {
+    const auto n = size();
+    auto it = tree_.try_emplace_unique_use_hint(hint, mystl::move(key), mystl::forward<M>(obj));
+    if (size() == n) {
+      it->second = mystl::forward<M>(obj);
+    }
+    return it;
+  }
+
+  // 结点句柄相关，结点在容器之间转移时不会重新分配内存
+  node_type extract(iterator position) { return tree_.extract(position); }
+  node_type extract(const key_type& key) {
+    auto it = tree_.find(key);
+    return it == end() ? node_type() : tree_.extract(it);
+  }
+
+  insert_return_type insert(node_type&& nh) {
+    auto res = tree_.insert_node_unique(nh);
+    return insert_return_type{res.first, res.second, mystl::move(nh)};
+  }
+  iterator insert(iterator hint, node_type&& nh) {
+    return tree_.insert_node_unique(hint, nh).first;
+  }
+
+  // 把source中键值不存在于当前容器的结点转移过来
+  template <typename C2>
+  void merge(Map<Key, T, C2, NodeTag>& source) {
+    tree_.merge_unique(source.tree_);
+  }
+  template <typename C2>
+  void merge(Map<Key, T, C2, NodeTag>&& source) {
+    tree_.merge_unique(source.tree_);
+  }
+  template <typename C2>
+  void merge(MultiMap<Key, T, C2, NodeTag>& source) {
+    tree_.merge_unique(source.tree_);
+  }
+  template <typename C2>
+  void merge(MultiMap<Key, T, C2, NodeTag>&& source) {
+    tree_.merge_unique(source.tree_);
+  }
+
+  // 分裂与拼接，只重新链接O(log n)个结点，不逐个插入删除元素
+  // split把键值不小于key的元素移到返回的容器中，join把rhs的元素全部接到末尾，要求rhs中的键值
+  // 都大于当前容器中的键值，extract_range把[first, last)区间内的元素移到返回的容器中
+  Map split(const key_type& key) {
+    Map rhs;
+    tree_.split(key, rhs.tree_);
+    return rhs;
+  }
+  void join(Map& rhs) { tree_.join(rhs.tree_); }
+  void join(Map&& rhs) { tree_.join(rhs.tree_); }
+  Map extract_range(iterator first, iterator last) {
+    Map rhs;
+    tree_.extract_range(first, last, rhs.tree_);
+    return rhs;
+  }
+
   // map相关操作
+  // 当Compare为透明比较器（如mystl::Less<>）时，以下查找函数还接受任意可与key_type比较的类型
   iterator find(const key_type& key) { return tree_.find(key); }
   const_iterator find(const key_type& key) const { return tree_.find(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  iterator find(const K& key) {
+    return tree_.find(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  const_iterator find(const K& key) const {
+    return tree_.find(key);
+  }
 
   size_type count(const key_type& key) const { return tree_.count_unique(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  size_type count(const K& key) const {
+    return tree_.count_unique(key);
+  }
 
   iterator lower_bound(const key_type& key) { return tree_.lower_bound(key); }
   const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  iterator lower_bound(const K& key) {
+    return tree_.lower_bound(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  const_iterator lower_bound(const K& key) const {
+    return tree_.lower_bound(key);
+  }
 
   iterator upper_bound(const key_type& key) { return tree_.upper_bound(key); }
   const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  iterator upper_bound(const K& key) {
+    return tree_.upper_bound(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  const_iterator upper_bound(const K& key) const {
+    return tree_.upper_bound(key);
+  }
 
   pair<iterator, iterator> equal_range(const key_type& key) {
     return tree_.equal_range_unique(key);
   }
-
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
     return tree_.equal_range_unique(key);
   }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  pair<iterator, iterator> equal_range(const K& key) {
+    return tree_.equal_range_unique(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return tree_.equal_range_unique(key);
+  }
+
+  // 顺序统计，只有结点布局为RbTreeOrderStatisticTag（如OrderStatisticMap）时可用
+  // select返回第k小的元素（k从0开始），rank返回键值小于key的元素个数，时间复杂度均为O(log n)
+  iterator select(size_type k) { return tree_.select(k); }
+  const_iterator select(size_type k) const { return tree_.select(k); }
+  size_type rank(const key_type& key) const { return tree_.rank(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  size_type rank(const K& key) const {
+    return tree_.rank(key);
+  }
 
   void swap(Map& rhs) noexcept { tree_.swap(rhs.tree_); }
 
@@ -211,46 +371,57 @@ class Map {
 };
 
 // 重载比较操作符
-template <class Key, class T, class Compare>
-bool operator==(const Map<Key, T, Compare>& lhs, const Map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class NodeTag>
+bool operator==(const Map<Key, T, Compare, NodeTag>& lhs,
+                const Map<Key, T, Compare, NodeTag>& rhs) {
   return lhs == rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<(const Map<Key, T, Compare>& lhs, const Map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class NodeTag>
+bool operator<(const Map<Key, T, Compare, NodeTag>& lhs, const Map<Key, T, Compare, NodeTag>& rhs) {
   return lhs < rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator!=(const Map<Key, T, Compare>& lhs, const Map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class NodeTag>
+bool operator!=(const Map<Key, T, Compare, NodeTag>& lhs,
+                const Map<Key, T, Compare, NodeTag>& rhs) {
   return !(lhs == rhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>(const Map<Key, T, Compare>& lhs, const Map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class NodeTag>
+bool operator>(const Map<Key, T, Compare, NodeTag>& lhs, const Map<Key, T, Compare, NodeTag>& rhs) {
   return rhs < lhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<=(const Map<Key, T, Compare>& lhs, const Map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class NodeTag>
+bool operator<=(const Map<Key, T, Compare, NodeTag>& lhs,
+                const Map<Key, T, Compare, NodeTag>& rhs) {
   return !(rhs < lhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>=(const Map<Key, T, Compare>& lhs, const Map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class NodeTag>
+bool operator>=(const Map<Key, T, Compare, NodeTag>& lhs,
+                const Map<Key, T, Compare, NodeTag>& rhs) {
   return !(lhs < rhs);
 }
 
 // 重载 mystl 的 swap
-template <class Key, class T, class Compare>
-void swap(Map<Key, T, Compare>& lhs, Map<Key, T, Compare>& rhs) noexcept {
+template <class Key, class T, class Compare, class NodeTag>
+void swap(Map<Key, T, Compare, NodeTag>& lhs, Map<Key, T, Compare, NodeTag>& rhs) noexcept {
   lhs.swap(rhs);
 }
 
 // 模板类multimap
 // 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省实用mystl::less
-template <typename Key, typename T, typename Compare = mystl::Less<Key>>
+// 参数四代表结点布局，缺省使用mystl::RbTreeDefaultNodeTag
+template <typename Key, typename T, typename Compare = mystl::Less<Key>,
+          typename NodeTag = mystl::RbTreeDefaultNodeTag>
 class MultiMap {
+  template <typename, typename, typename, typename>
+  friend class Map;
+  template <typename, typename, typename, typename>
+  friend class MultiMap;
+
  public:
   using key_type = Key;
   using mapped_type = T;
@@ -272,11 +443,11 @@ class MultiMap {
   };
 
  private:
-  using base_type = mystl::RbTree<value_type, key_compare>;
+  using base_type = mystl::RbTree<value_type, key_compare, NodeTag>;
   base_type tree_;
 
  public:
-  using node_type = typename base_type::node_type;
+  using node_type = typename base_type::node_handle;
   using pointer = typename base_type::pointer;
   using const_pointer = typename base_type::const_pointer;
   using reference = typename base_type::reference;
@@ -296,6 +467,11 @@ class MultiMap {
   MultiMap(InputIterator first, InputIterator last) : tree_() {
     tree_.insert_multi(first, last);
   }
+  // 区间已排好序，直接以O(n)构造
+  template <typename InputIterator>
+  MultiMap(SortedEquivalentTag /*tag*/, InputIterator first, InputIterator last) : tree_() {
+    tree_.assign_sorted(first, last);
+  }
 
   MultiMap(std::initializer_list<value_type> ilist) : tree_() {
     tree_.insert_multi(ilist.begin(), ilist.end());
@@ -374,23 +550,115 @@ class MultiMap {
 
   void clear() { tree_.clear(); }
 
+  // 结点句柄相关，结点在容器之间转移时不会重新分配内存
+  node_type extract(iterator position) { return tree_.extract(position); }
+  node_type extract(const key_type& key) {
+    auto it = tree_.find(key);
+    return it == end() ? node_type() : tree_.extract(it);
+  }
+
+  iterator insert(node_type&& nh) { return tree_.insert_node_multi(mystl::move(nh)); }
+  iterator insert(iterator hint, node_type&& nh) {
+    return tree_.insert_node_multi(hint, mystl::move(nh));
+  }
+
+  // 把source中的所有结点转移过来
+  template <typename C2>
+  void merge(Map<Key, T, C2, NodeTag>& source) {
+    tree_.merge_multi(source.tree_);
+  }
+  template <typename C2>
+  void merge(Map<Key, T, C2, NodeTag>&& source) {
+    tree_.merge_multi(source.tree_);
+  }
+  template <typename C2>
+  void merge(MultiMap<Key, T, C2, NodeTag>& source) {
+    tree_.merge_multi(source.tree_);
+  }
+  template <typename C2>
+  void merge(MultiMap<Key, T, C2, NodeTag>&& source) {
+    tree_.merge_multi(source.tree_);
+  }
+
+  // 分裂与拼接，只重新链接O(log n)个结点，不逐个插入删除元素
+  // split把键值不小于key的元素移到返回的容器中，join把rhs的元素全部接到末尾，要求rhs中的键值
+  // 都不小于当前容器中的键值，extract_range把[first, last)区间内的元素移到返回的容器中
+  MultiMap split(const key_type& key) {
+    MultiMap rhs;
+    tree_.split(key, rhs.tree_);
+    return rhs;
+  }
+  void join(MultiMap& rhs) { tree_.join(rhs.tree_); }
+  void join(MultiMap&& rhs) { tree_.join(rhs.tree_); }
+  MultiMap extract_range(iterator first, iterator last) {
+    MultiMap rhs;
+    tree_.extract_range(first, last, rhs.tree_);
+    return rhs;
+  }
+
   // map相关操作
+  // 当Compare为透明比较器（如mystl::Less<>）时，以下查找函数还接受任意可与key_type比较的类型
   iterator find(const key_type& key) { return tree_.find(key); }
   const_iterator find(const key_type& key) const { return tree_.find(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  iterator find(const K& key) {
+    return tree_.find(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  const_iterator find(const K& key) const {
+    return tree_.find(key);
+  }
 
   size_type count(const key_type& key) const { return tree_.count_multi(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  size_type count(const K& key) const {
+    return tree_.count_multi(key);
+  }
 
   iterator lower_bound(const key_type& key) { return tree_.lower_bound(key); }
   const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  iterator lower_bound(const K& key) {
+    return tree_.lower_bound(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  const_iterator lower_bound(const K& key) const {
+    return tree_.lower_bound(key);
+  }
 
   iterator upper_bound(const key_type& key) { return tree_.upper_bound(key); }
   const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  iterator upper_bound(const K& key) {
+    return tree_.upper_bound(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  const_iterator upper_bound(const K& key) const {
+    return tree_.upper_bound(key);
+  }
 
   pair<iterator, iterator> equal_range(const key_type& key) { return tree_.equal_range_multi(key); }
-
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
     return tree_.equal_range_multi(key);
   }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  pair<iterator, iterator> equal_range(const K& key) {
+    return tree_.equal_range_multi(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return tree_.equal_range_multi(key);
+  }
+
+  // 顺序统计，只有结点布局为RbTreeOrderStatisticTag（如OrderStatisticMultiMap）时可用
+  // select返回第k小的元素（k从0开始），rank返回键值小于key的元素个数，时间复杂度均为O(log n)
+  iterator select(size_type k) { return tree_.select(k); }
+  const_iterator select(size_type k) const { return tree_.select(k); }
+  size_type rank(const key_type& key) const { return tree_.rank(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  size_type rank(const K& key) const {
+    return tree_.rank(key);
+  }
 
   void swap(MultiMap& rhs) noexcept { tree_.swap(rhs.tree_); }
 
@@ -402,41 +670,62 @@ class MultiMap {
 };
 
 // 重载比较操作符
-template <class Key, class T, class Compare>
-bool operator==(const MultiMap<Key, T, Compare>& lhs, const MultiMap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class NodeTag>
+bool operator==(const MultiMap<Key, T, Compare, NodeTag>& lhs,
+                const MultiMap<Key, T, Compare, NodeTag>& rhs) {
   return lhs == rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<(const MultiMap<Key, T, Compare>& lhs, const MultiMap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class NodeTag>
+bool operator<(const MultiMap<Key, T, Compare, NodeTag>& lhs,
+               const MultiMap<Key, T, Compare, NodeTag>& rhs) {
   return lhs < rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator!=(const MultiMap<Key, T, Compare>& lhs, const MultiMap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class NodeTag>
+bool operator!=(const MultiMap<Key, T, Compare, NodeTag>& lhs,
+                const MultiMap<Key, T, Compare, NodeTag>& rhs) {
   return !(lhs == rhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>(const MultiMap<Key, T, Compare>& lhs, const MultiMap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class NodeTag>
+bool operator>(const MultiMap<Key, T, Compare, NodeTag>& lhs,
+               const MultiMap<Key, T, Compare, NodeTag>& rhs) {
   return rhs < lhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<=(const MultiMap<Key, T, Compare>& lhs, const MultiMap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class NodeTag>
+bool operator<=(const MultiMap<Key, T, Compare, NodeTag>& lhs,
+                const MultiMap<Key, T, Compare, NodeTag>& rhs) {
   return !(rhs < lhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>=(const MultiMap<Key, T, Compare>& lhs, const MultiMap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class NodeTag>
+bool operator>=(const MultiMap<Key, T, Compare, NodeTag>& lhs,
+                const MultiMap<Key, T, Compare, NodeTag>& rhs) {
   return !(lhs < rhs);
 }
 
 // 重载 mystl 的 swap
-template <class Key, class T, class Compare>
-void swap(MultiMap<Key, T, Compare>& lhs, MultiMap<Key, T, Compare>& rhs) noexcept {
+template <class Key, class T, class Compare, class NodeTag>
+void swap(MultiMap<Key, T, Compare, NodeTag>& lhs,
+          MultiMap<Key, T, Compare, NodeTag>& rhs) noexcept {
   lhs.swap(rhs);
 }
 
+// 支持select与rank的map与multimap，每个结点额外记录子树大小
+template <typename Key, typename T, typename Compare = mystl::Less<Key>>
+using OrderStatisticMap = Map<Key, T, Compare, mystl::RbTreeOrderStatisticTag>;
+
+template <typename Key, typename T, typename Compare = mystl::Less<Key>>
+using OrderStatisticMultiMap = MultiMap<Key, T, Compare, mystl::RbTreeOrderStatisticTag>;
+
+// 结点更紧凑的map与multimap，颜色存放在父结点指针的最低位，适合对内存敏感的场合
+template <typename Key, typename T, typename Compare = mystl::Less<Key>>
+using CompactMap = Map<Key, T, Compare, mystl::RbTreeCompactNodeTag>;
+
+template <typename Key, typename T, typename Compare = mystl::Less<Key>>
+using CompactMultiMap = MultiMap<Key, T, Compare, mystl::RbTreeCompactNodeTag>;
+
 }  // namespace mystl
 #endif  // ! MYTINYSTL_MAP_H_
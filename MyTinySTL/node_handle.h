@@ -0,0 +1,121 @@
+#ifndef MYTINYSTL_NODE_HANDLE_H_
+#define MYTINYSTL_NODE_HANDLE_H_
+
+// 这个头文件包含了结点句柄 NodeHandle 与 insert(node) 的返回类型 InsertReturnType
+// NodeHandle : 持有从关联式容器中摘下的结点，可以在不重新分配内存的情况下插入到另一个兼容的容器中
+
+#include <type_traits>
+
+#include "exceptdef.h"
+#include "memory.h"
+#include "util.h"
+
+namespace mystl {
+
+// forward declaration begin
+template <typename T, typename Compare, typename Tag>
+class RbTree;
+
+template <typename T, typename Hash, typename KeyEqual>
+class Hashtable;
+// forward declaration end
+
+// 模板类NodeHandle
+// 参数一代表数据类型，参数二代表容器内部的结点类型
+template <typename T, typename Node>
+class NodeHandle {
+  template <typename, typename, typename>
+  friend class mystl::RbTree;
+  template <typename, typename, typename>
+  friend class mystl::Hashtable;
+
+ public:
+  using value_type = T;
+  using allocator_type = mystl::Allocator<T>;
+
+ private:
+  using data_allocator = mystl::Allocator<T>;
+  using node_allocator = mystl::Allocator<Node>;
+
+  Node* node_;
+
+  explicit NodeHandle(Node* node) noexcept : node_(node) {}
+
+  // 交出结点的所有权
+  Node* release() noexcept {
+    Node* tmp = node_;
+    node_ = nullptr;
+    return tmp;
+  }
+
+ public:
+  NodeHandle() noexcept : node_(nullptr) {}
+
+  NodeHandle(const NodeHandle&) = delete;
+  NodeHandle(NodeHandle&& rhs) noexcept : node_(rhs.node_) { rhs.node_ = nullptr; }
+
+  NodeHandle& operator=(const NodeHandle&) = delete;
+  NodeHandle& operator=(NodeHandle&& rhs) noexcept {
+    if (this != &rhs) {
+      reset();
+      node_ = rhs.node_;
+      rhs.node_ = nullptr;
+    }
+    return *this;
+  }
+
+  ~NodeHandle() { reset(); }
+
+  bool empty() const noexcept { return node_ == nullptr; }
+  explicit operator bool() const noexcept { return node_ != nullptr; }
+  allocator_type get_allocator() const { return allocator_type(); }
+
+  // set类容器通过value访问元素
+  value_type& value() const {
+    MYSTL_DEBUG(node_ != nullptr);
+    return node_->value;
+  }
+
+  // map类容器通过key与mapped访问元素，键值可以在重新插入前修改
+  template <typename U = T>
+  typename std::remove_const<typename U::first_type>::type& key() const {
+    MYSTL_DEBUG(node_ != nullptr);
+    using key_type = typename std::remove_const<typename U::first_type>::type;
+    return const_cast<key_type&>(node_->value.first);
+  }
+
+  template <typename U = T>
+  typename U::second_type& mapped() const {
+    MYSTL_DEBUG(node_ != nullptr);
+    return node_->value.second;
+  }
+
+  void swap(NodeHandle& rhs) noexcept { mystl::swap(node_, rhs.node_); }
+
+ private:
+  void reset() noexcept {
+    if (node_ != nullptr) {
+      data_allocator::destroy(mystl::address_of(node_->value));
+      node_allocator::deallocate(node_);
+      node_ = nullptr;
+    }
+  }
+};
+
+// 重载 mystl 的 swap
+template <typename T, typename Node>
+void swap(NodeHandle<T, Node>& lhs, NodeHandle<T, Node>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+// insert(node_type&&)的返回类型
+// 插入失败时，node保存原来的结点，position指向容器中键值相同的元素
+template <typename Iterator, typename NodeType>
+struct InsertReturnType {
+  Iterator position;
+  bool inserted;
+  NodeType node;
+};
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_NODE_HANDLE_H_
@@ -4,32 +4,168 @@
 // 这个头文件包含了 mystl 的数值算法
 // 对应书6.3节
 
+// notes:
+//
+// accumulate、inner_product、transform_reduce 的版本1在指针（包括 vector 的迭代器）上
+// 使用多个相互独立的累加器（见 reduce_lanes），不再受限于一次加法的延迟，编译器也能把它向量化
+//   * 元素与初值都是整数时总是这样计算：累加按无符号数进行，任意结合的结果都与按顺序累加相同
+//   * 浮点数的加法不满足结合律，默认按顺序累加，结果与循环相同；
+//     只有通过 execution::par、execution::unseq 或 execution::par_unseq 调用（见 parallel_algo.h）
+//     时才重新结合：par 分块累加后再合并各块的部分和，unseq 与 par_unseq 还在块内使用多个累加器，
+//     此时结果可能在舍入上与按顺序累加不同，-0.0 的和可能得到 +0.0
+
+#include <type_traits>
+
 #include "iterator.h"
+#include "type_traits.h"
 
 namespace mystl {
 
+// 多累加器求和使用的累加器个数
+constexpr size_t kReduceLanes = 8;
+
+// reduce_lanes
+// 以 kReduceLanes 个累加器求 f(0) + f(1) + ... + f(n - 1)，
+// 第 i 项加到第 i % kReduceLanes 个累加器上，最后两两合并
+// 各累加器之间没有依赖，内层循环可以被编译器向量化
+template <typename Acc, typename Function>
+Acc reduce_lanes(size_t n, Function f) {
+  Acc acc[kReduceLanes] = {};
+  size_t i = 0;
+  for (; n - i >= kReduceLanes; i += kReduceLanes) {
+    for (size_t j = 0; j < kReduceLanes; ++j) {
+      acc[j] += f(i + j);
+    }
+  }
+  for (size_t j = 0; i + j < n; ++j) {
+    acc[j] += f(i + j);
+  }
+  for (size_t width = kReduceLanes / 2; width > 0; width /= 2) {
+    for (size_t j = 0; j < width; ++j) {
+      acc[j] += acc[j + width];
+    }
+  }
+  return acc[0];
+}
+
+// IsLaneInteger : 除 bool 以外的整数
+template <typename T>
+struct IsLaneInteger
+    : public m_bool_constant<std::is_integral<T>::value &&
+                             !std::is_same<typename std::remove_cv<T>::type, bool>::value> {};
+
+// IsLaneReducible : 把指针 Iter1、Iter2 指向的元素（或对应元素的乘积）以 operator+ 累加到 T 上时，
+// 能否交给 reduce_lanes。Exact 为 true 时只接受整数，为 false 时还接受与 T 相同的浮点类型
+// 只有一个区间时 Iter2 与 Iter1 相同
+template <typename Iter1, typename Iter2, typename T, bool Exact>
+struct IsLaneReducible : public m_false_type {};
+
+template <typename U1, typename U2, typename T, bool Exact>
+struct IsLaneReducible<U1*, U2*, T, Exact>
+    : public m_bool_constant<
+          (IsLaneInteger<U1>::kValue && IsLaneInteger<U2>::kValue && IsLaneInteger<T>::kValue) ||
+          (!Exact && std::is_floating_point<T>::value &&
+           std::is_same<typename std::remove_const<U1>::type, T>::value &&
+           std::is_same<typename std::remove_const<U2>::type, T>::value)> {};
+
+// 累加器的类型：整数使用对应的无符号类型，不会溢出
+template <typename T, bool = std::is_integral<T>::value>
+struct LaneAccumulator {
+  using type = T;
+};
+
+template <typename T>
+struct LaneAccumulator<T, true> {
+  using type = typename std::make_unsigned<T>::type;
+};
+
 // accumulate
 // 版本1：以初值init对每个元素进行累加
 // 版本2：以处置init堆每个元素进行二元操作
 
+// 分段迭代器（如 deque 的迭代器）逐段累加，每段是一对指针
+
 // 版本1
 template <typename InputIter, typename T>
-T accumulate(InputIter first, InputIter last, T init) {
+T accumulate(InputIter first, InputIter last, T init);
+
+template <typename InputIter, typename T>
+T accumulate_lanes(InputIter first, InputIter last, T init, m_false_type /*unused*/) {
   for (; first != last; ++first) {
     init += *first;
   }
   return init;
 }
 
+// 以多累加器累加，每个元素先转换为 T，与 init += *first 的结果相同
+template <typename U, typename T>
+T accumulate_lanes(U* first, U* last, T init, m_true_type /*unused*/) {
+  using acc_type = typename LaneAccumulator<T>::type;
+  const acc_type sum = mystl::reduce_lanes<acc_type>(
+      static_cast<size_t>(last - first),
+      [first](size_t i) { return static_cast<acc_type>(static_cast<T>(first[i])); });
+  return static_cast<T>(static_cast<acc_type>(init) + sum);
+}
+
+template <typename InputIter, typename T>
+T accumulate_seg(InputIter first, InputIter last, T init, m_false_type /*unused*/) {
+  return mystl::accumulate_lanes(first, last, init,
+                                 IsLaneReducible<InputIter, InputIter, T, true>());
+}
+
+template <typename SegIter, typename T>
+T accumulate_seg(SegIter first, SegIter last, T init, m_true_type /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  auto sfirst = traits::segment(first);
+  const auto slast = traits::segment(last);
+  if (sfirst == slast) {
+    return mystl::accumulate(traits::local(first), traits::local(last), init);
+  }
+  init = mystl::accumulate(traits::local(first), traits::end(sfirst), init);
+  for (++sfirst; sfirst != slast; ++sfirst) {
+    init = mystl::accumulate(traits::begin(sfirst), traits::end(sfirst), init);
+  }
+  return mystl::accumulate(traits::begin(slast), traits::local(last), init);
+}
+
+template <typename InputIter, typename T>
+T accumulate(InputIter first, InputIter last, T init) {
+  return accumulate_seg(first, last, init, IsSegmentedIterator<InputIter>());
+}
+
 // 版本2
 template <typename InputIter, typename T, typename BinaryOp>
-T accumulate(InputIter first, InputIter last, T init, BinaryOp binary_op) {
+T accumulate(InputIter first, InputIter last, T init, BinaryOp binary_op);
+
+template <typename InputIter, typename T, typename BinaryOp>
+T accumulate_seg(
+    InputIter first, InputIter last, T init, BinaryOp binary_op, m_false_type /*unused*/) {
   for (; first != last; ++first) {
     init = binary_op(init, *first);
   }
   return init;
 }
 
+template <typename SegIter, typename T, typename BinaryOp>
+T accumulate_seg(SegIter first, SegIter last, T init, BinaryOp binary_op, m_true_type /*unused*/) {
+  using traits = SegmentedIteratorTraits<SegIter>;
+  auto sfirst = traits::segment(first);
+  const auto slast = traits::segment(last);
+  if (sfirst == slast) {
+    return mystl::accumulate(traits::local(first), traits::local(last), init, binary_op);
+  }
+  init = mystl::accumulate(traits::local(first), traits::end(sfirst), init, binary_op);
+  for (++sfirst; sfirst != slast; ++sfirst) {
+    init = mystl::accumulate(traits::begin(sfirst), traits::end(sfirst), init, binary_op);
+  }
+  return mystl::accumulate(traits::begin(slast), traits::local(last), init, binary_op);
+}
+
+template <typename InputIter, typename T, typename BinaryOp>
+T accumulate(InputIter first, InputIter last, T init, BinaryOp binary_op) {
+  return accumulate_seg(first, last, init, binary_op, IsSegmentedIterator<InputIter>());
+}
+
 // adjacent_difference
 // 版本1：计算相邻元素的差值，结果保存到以result为起始的区间上
 // 版本2：自定义相邻元素的二元操作
@@ -73,13 +209,31 @@ OutputIter adjacent_difference(
 
 // 版本1
 template <typename InputIter1, typename InputIter2, typename T>
-T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+T inner_product_lanes(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                      m_false_type /*unused*/) {
   for (; first1 != last1; ++first1, ++first2) {
     init = init + (*first1 * *first2);
   }
   return init;
 }
 
+// 以多累加器累加，每个乘积先转换为 T
+template <typename U1, typename U2, typename T>
+T inner_product_lanes(U1* first1, U1* last1, U2* first2, T init, m_true_type /*unused*/) {
+  using acc_type = typename LaneAccumulator<T>::type;
+  const acc_type sum = mystl::reduce_lanes<acc_type>(
+      static_cast<size_t>(last1 - first1), [first1, first2](size_t i) {
+        return static_cast<acc_type>(static_cast<T>(first1[i] * first2[i]));
+      });
+  return static_cast<T>(static_cast<acc_type>(init) + sum);
+}
+
+template <typename InputIter1, typename InputIter2, typename T>
+T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+  return mystl::inner_product_lanes(first1, last1, first2, init,
+                                    IsLaneReducible<InputIter1, InputIter2, T, true>());
+}
+
 // 版本2
 template <
     typename InputIter1,
@@ -100,6 +254,59 @@ T inner_product(
   return init;
 }
 
+// transform_reduce
+// 版本1：与 inner_product 版本1相同，以init为初值累加两个区间对应元素的乘积
+// 版本2：以 reduce_op 代替 operator+，以 transform_op 代替 operator*，与 inner_product 版本2相同
+// 版本3：以init为初值，以 reduce_op 累加 [first, last) 中每个元素经 unary_op 变换后的值
+// 与 std::transform_reduce 不同，不指定执行策略时按顺序计算，浮点数的结果与循环相同
+
+// 版本1
+template <typename InputIter1, typename InputIter2, typename T>
+T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+  return mystl::inner_product(first1, last1, first2, init);
+}
+
+// 版本2
+template <
+    typename InputIter1,
+    typename InputIter2,
+    typename T,
+    typename BinaryOp1,
+    typename BinaryOp2>
+T transform_reduce(
+    InputIter1 first1,
+    InputIter1 last1,
+    InputIter2 first2,
+    T init,
+    BinaryOp1 reduce_op,
+    BinaryOp2 transform_op) {
+  return mystl::inner_product(first1, last1, first2, init, reduce_op, transform_op);
+}
+
+// 版本3
+template <typename InputIter, typename T, typename BinaryOp, typename UnaryOp>
+T transform_reduce(InputIter first, InputIter last, T init, BinaryOp reduce_op, UnaryOp unary_op) {
+  for (; first != last; ++first) {
+    init = reduce_op(init, unary_op(*first));
+  }
+  return init;
+}
+
+// accumulate_unseq / inner_product_unseq
+// 与 accumulate、inner_product 的版本1相同，但允许重新结合浮点数的加法，
+// 供 execution::unseq 与 execution::par_unseq 使用；只对指针生效，其他迭代器按顺序累加
+template <typename InputIter, typename T>
+T accumulate_unseq(InputIter first, InputIter last, T init) {
+  return mystl::accumulate_lanes(first, last, init,
+                                 IsLaneReducible<InputIter, InputIter, T, false>());
+}
+
+template <typename InputIter1, typename InputIter2, typename T>
+T inner_product_unseq(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+  return mystl::inner_product_lanes(first1, last1, first2, init,
+                                    IsLaneReducible<InputIter1, InputIter2, T, false>());
+}
+
 // iota
 // 填充[first, last)，以value为初值开始递增
 template <typename ForwardIter, typename T>
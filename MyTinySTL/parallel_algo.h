@@ -0,0 +1,712 @@
+#ifndef MYTINYSTL_PARALLEL_ALGO_H_
+#define MYTINYSTL_PARALLEL_ALGO_H_
+
+// 这个头文件包含执行策略（execution policy）与 mystl 部分算法的并行版本
+// 并行版本的第一个参数为执行策略，其余参数与串行版本相同：
+// for_each, transform, count, count_if, find, find_if, all_of, any_of, none_of,
+// fill, copy, accumulate, inner_product, transform_reduce, partial_sum
+
+// notes:
+//
+// execution::seq 串行执行，直接调用串行版本
+// execution::par 把随机访问区间分成若干块，交给线程池并行处理，每一块内部调用串行版本，
+//   因此 deque 这样的分段迭代器在块内仍然逐段处理
+// execution::unseq 串行执行，但允许 accumulate、inner_product、transform_reduce 的版本1
+//   在指针上重新结合浮点数的加法（见 numeric.h），其余算法直接调用串行版本
+// execution::par_unseq 与 par 的分块方式相同，块内按 unseq 的方式处理
+// par.on(pool) / par_unseq.on(pool) 指定使用的线程池，缺省使用 default_thread_pool()
+//
+// 以下情况退化为串行版本：迭代器不是随机访问迭代器、元素个数少于两块、线程池没有工作线程
+// 每块至少 MYSTL_PARALLEL_GRAIN 个元素，块数不超过工作线程数的 kParallelChunksPerThread 倍
+//
+// 并行版本对参数的要求比串行版本更严格：
+//   * 函数对象会在多个线程中被同时调用，且会被复制到每一块中
+//   * accumulate、inner_product、partial_sum 的二元操作必须满足结合律，
+//     各块的结果按顺序合并，因此不要求交换律
+//   * copy、transform、partial_sum 的输入区间与输出区间不能部分重叠（可以完全相同）
+//   * find_if 返回第一个满足条件的元素，某一块找到后，位于它之后的块会尽早停止查找
+
+#include <atomic>
+
+#include "algo.h"
+#include "algobase.h"
+#include "iterator.h"
+#include "numeric.h"
+#include "thread_pool.h"
+#include "type_traits.h"
+#include "vector.h"
+
+namespace mystl {
+
+// 每块至少包含的元素个数
+#ifndef MYSTL_PARALLEL_GRAIN
+#define MYSTL_PARALLEL_GRAIN 8192
+#endif
+
+// 每个工作线程平均分到的块数，多分几块可以让先做完的线程窃取剩下的块
+constexpr size_t kParallelChunksPerThread = 4;
+
+// find_if 每查找这么多个元素检查一次是否已被前面的块找到
+constexpr size_t kParallelCancelStep = 1024;
+
+namespace execution {
+
+// 串行执行
+struct SequencedPolicy {};
+
+// 并行执行
+struct ParallelPolicy {
+  ThreadPool* pool;
+
+  constexpr ParallelPolicy() : pool(nullptr) {}
+  constexpr explicit ParallelPolicy(ThreadPool* p) : pool(p) {}
+
+  ParallelPolicy on(ThreadPool& p) const { return ParallelPolicy(&p); }
+};
+
+// 串行执行，且允许向量化
+struct UnsequencedPolicy {};
+
+// 并行执行，且允许在块内向量化
+struct ParallelUnsequencedPolicy {
+  ThreadPool* pool;
+
+  constexpr ParallelUnsequencedPolicy() : pool(nullptr) {}
+  constexpr explicit ParallelUnsequencedPolicy(ThreadPool* p) : pool(p) {}
+
+  ParallelUnsequencedPolicy on(ThreadPool& p) const { return ParallelUnsequencedPolicy(&p); }
+};
+
+constexpr SequencedPolicy seq{};
+constexpr ParallelPolicy par{};
+constexpr ParallelUnsequencedPolicy par_unseq{};
+constexpr UnsequencedPolicy unseq{};
+
+}  // namespace execution
+
+// IsExecutionPolicy
+template <typename T>
+struct IsExecutionPolicy : public m_false_type {};
+
+template <>
+struct IsExecutionPolicy<execution::SequencedPolicy> : public m_true_type {};
+
+template <>
+struct IsExecutionPolicy<execution::ParallelPolicy> : public m_true_type {};
+
+template <>
+struct IsExecutionPolicy<execution::ParallelUnsequencedPolicy> : public m_true_type {};
+
+template <>
+struct IsExecutionPolicy<execution::UnsequencedPolicy> : public m_true_type {};
+
+// IsUnsequencedPolicy : 执行策略是否允许重新结合浮点数的加法
+template <typename T>
+struct IsUnsequencedPolicy : public m_false_type {};
+
+template <>
+struct IsUnsequencedPolicy<execution::UnsequencedPolicy> : public m_true_type {};
+
+template <>
+struct IsUnsequencedPolicy<execution::ParallelUnsequencedPolicy> : public m_true_type {};
+
+// 只有第一个参数为执行策略时，并行版本才参与重载决议
+template <typename ExecutionPolicy, typename Result>
+using enable_if_policy_t = typename std::enable_if<
+    IsExecutionPolicy<typename std::decay<ExecutionPolicy>::type>::kValue, Result>::type;
+
+/*****************************************************************************************/
+// helper function
+
+inline ThreadPool* policy_pool(const execution::SequencedPolicy& /*unused*/) { return nullptr; }
+
+inline ThreadPool* policy_pool(const execution::UnsequencedPolicy& /*unused*/) {
+  return nullptr;
+}
+
+inline ThreadPool* policy_pool(const execution::ParallelPolicy& policy) {
+  return policy.pool != nullptr ? policy.pool : &mystl::default_thread_pool();
+}
+
+inline ThreadPool* policy_pool(const execution::ParallelUnsequencedPolicy& policy) {
+  return policy.pool != nullptr ? policy.pool : &mystl::default_thread_pool();
+}
+
+// 计算把n个元素分成的块数，返回值小于2表示应当串行执行
+inline size_t parallel_chunk_count(const ThreadPool* pool, size_t n) {
+  if (pool == nullptr || pool->size() == 0) {
+    return 0;
+  }
+  return mystl::min(n / MYSTL_PARALLEL_GRAIN, pool->size() * kParallelChunksPerThread);
+}
+
+// 第c块为下标区间 [n * c / chunks, n * (c + 1) / chunks)，对每一块调用 f(c, begin, end)
+template <typename Function>
+void parallel_chunks(ThreadPool& pool, size_t n, size_t chunks, Function f) {
+  mystl::parallel_for(pool, size_t(0), chunks, size_t(1), [n, chunks, &f](size_t c) {
+    f(c, n * c / chunks, n * (c + 1) / chunks);
+  });
+}
+
+// 以 operator+ / operator* 实现的二元函数对象，用于把版本1转发给版本2
+struct ParallelPlus {
+  template <typename T, typename U>
+  auto operator()(const T& a, const U& b) const -> decltype(a + b) {
+    return a + b;
+  }
+};
+
+struct ParallelMultiplies {
+  template <typename T, typename U>
+  auto operator()(const T& a, const U& b) const -> decltype(a * b) {
+    return a * b;
+  }
+};
+
+/*****************************************************************************************/
+// for_each
+/*****************************************************************************************/
+template <typename RandomIter, typename Function>
+void for_each_par(ThreadPool* pool, RandomIter first, RandomIter last, Function f,
+                  m_true_type /*unused*/) {
+  const size_t n = static_cast<size_t>(last - first);
+  const size_t chunks = parallel_chunk_count(pool, n);
+  if (chunks < 2) {
+    mystl::for_each(first, last, f);
+    return;
+  }
+  parallel_chunks(*pool, n, chunks, [first, &f](size_t, size_t b, size_t e) {
+    mystl::for_each(first + b, first + e, f);
+  });
+}
+
+template <typename InputIter, typename Function>
+void for_each_par(ThreadPool* /*unused*/, InputIter first, InputIter last, Function f,
+                  m_false_type /*unused*/) {
+  mystl::for_each(first, last, f);
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename Function>
+enable_if_policy_t<ExecutionPolicy, void>
+for_each(ExecutionPolicy&& policy, InputIter first, InputIter last, Function f) {
+  mystl::for_each_par(mystl::policy_pool(policy), first, last, f,
+                      IsRandomAccessIterator<InputIter>());
+}
+
+/*****************************************************************************************/
+// transform
+/*****************************************************************************************/
+template <typename RandomIter1, typename RandomIter2, typename UnaryOperation>
+RandomIter2 transform_par(ThreadPool* pool, RandomIter1 first, RandomIter1 last,
+                          RandomIter2 result, UnaryOperation unary_op, m_true_type /*unused*/) {
+  const size_t n = static_cast<size_t>(last - first);
+  const size_t chunks = parallel_chunk_count(pool, n);
+  if (chunks < 2) {
+    return mystl::transform(first, last, result, unary_op);
+  }
+  parallel_chunks(*pool, n, chunks, [first, result, &unary_op](size_t, size_t b, size_t e) {
+    mystl::transform(first + b, first + e, result + b, unary_op);
+  });
+  return result + n;
+}
+
+template <typename InputIter, typename OutputIter, typename UnaryOperation>
+OutputIter transform_par(ThreadPool* /*unused*/, InputIter first, InputIter last,
+                         OutputIter result, UnaryOperation unary_op, m_false_type /*unused*/) {
+  return mystl::transform(first, last, result, unary_op);
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename OutputIter,
+          typename UnaryOperation>
+enable_if_policy_t<ExecutionPolicy, OutputIter>
+transform(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result,
+          UnaryOperation unary_op) {
+  using is_random = m_bool_constant<IsRandomAccessIterator<InputIter>::kValue &&
+                                    IsRandomAccessIterator<OutputIter>::kValue>;
+  return mystl::transform_par(mystl::policy_pool(policy), first, last, result, unary_op,
+                              is_random());
+}
+
+template <typename RandomIter1, typename RandomIter2, typename RandomIter3,
+          typename BinaryOperation>
+RandomIter3 transform_par(ThreadPool* pool, RandomIter1 first1, RandomIter1 last1,
+                          RandomIter2 first2, RandomIter3 result, BinaryOperation binary_op,
+                          m_true_type /*unused*/) {
+  const size_t n = static_cast<size_t>(last1 - first1);
+  const size_t chunks = parallel_chunk_count(pool, n);
+  if (chunks < 2) {
+    return mystl::transform(first1, last1, first2, result, binary_op);
+  }
+  parallel_chunks(*pool, n, chunks,
+                  [first1, first2, result, &binary_op](size_t, size_t b, size_t e) {
+                    mystl::transform(first1 + b, first1 + e, first2 + b, result + b, binary_op);
+                  });
+  return result + n;
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter,
+          typename BinaryOperation>
+OutputIter transform_par(ThreadPool* /*unused*/, InputIter1 first1, InputIter1 last1,
+                         InputIter2 first2, OutputIter result, BinaryOperation binary_op,
+                         m_false_type /*unused*/) {
+  return mystl::transform(first1, last1, first2, result, binary_op);
+}
+
+template <typename ExecutionPolicy, typename InputIter1, typename InputIter2,
+          typename OutputIter, typename BinaryOperation>
+enable_if_policy_t<ExecutionPolicy, OutputIter>
+transform(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2,
+          OutputIter result, BinaryOperation binary_op) {
+  using is_random = m_bool_constant<IsRandomAccessIterator<InputIter1>::kValue &&
+                                    IsRandomAccessIterator<InputIter2>::kValue &&
+                                    IsRandomAccessIterator<OutputIter>::kValue>;
+  return mystl::transform_par(mystl::policy_pool(policy), first1, last1, first2, result,
+                              binary_op, is_random());
+}
+
+/*****************************************************************************************/
+// count_if / count
+/*****************************************************************************************/
+template <typename RandomIter, typename UnaryPredicate>
+size_t count_if_par(ThreadPool* pool, RandomIter first, RandomIter last,
+                    UnaryPredicate unary_pred, m_true_type /*unused*/) {
+  const size_t n = static_cast<size_t>(last - first);
+  const size_t chunks = parallel_chunk_count(pool, n);
+  if (chunks < 2) {
+    return mystl::count_if(first, last, unary_pred);
+  }
+  mystl::Vector<size_t> partial(chunks, 0);
+  parallel_chunks(*pool, n, chunks, [first, &unary_pred, &partial](size_t c, size_t b, size_t e) {
+    partial[c] = mystl::count_if(first + b, first + e, unary_pred);
+  });
+  size_t total = 0;
+  for (auto k : partial) {
+    total += k;
+  }
+  return total;
+}
+
+template <typename InputIter, typename UnaryPredicate>
+size_t count_if_par(ThreadPool* /*unused*/, InputIter first, InputIter last,
+                    UnaryPredicate unary_pred, m_false_type /*unused*/) {
+  return mystl::count_if(first, last, unary_pred);
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename UnaryPredicate>
+enable_if_policy_t<ExecutionPolicy, size_t>
+count_if(ExecutionPolicy&& policy, InputIter first, InputIter last, UnaryPredicate unary_pred) {
+  return mystl::count_if_par(mystl::policy_pool(policy), first, last, unary_pred,
+                             IsRandomAccessIterator<InputIter>());
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename T>
+enable_if_policy_t<ExecutionPolicy, size_t>
+count(ExecutionPolicy&& policy, InputIter first, InputIter last, const T& value) {
+  return mystl::count_if(mystl::forward<ExecutionPolicy>(policy), first, last,
+                         [&value](const typename IteratorTraits<InputIter>::value_type& x) {
+                           return x == value;
+                         });
+}
+
+/*****************************************************************************************/
+// find_if / find / all_of / any_of / none_of
+// 各块共享目前找到的最小下标，每查找 kParallelCancelStep 个元素检查一次，
+// 起点已经不小于该下标的块不可能找到更靠前的元素，于是提前结束
+/*****************************************************************************************/
+template <typename RandomIter, typename UnaryPredicate>
+RandomIter find_if_par(ThreadPool* pool, RandomIter first, RandomIter last,
+                       UnaryPredicate unary_pred, m_true_type /*unused*/) {
+  const size_t n = static_cast<size_t>(last - first);
+  const size_t chunks = parallel_chunk_count(pool, n);
+  if (chunks < 2) {
+    return mystl::find_if(first, last, unary_pred);
+  }
+  std::atomic<size_t> found(n);
+  parallel_chunks(*pool, n, chunks, [first, &unary_pred, &found](size_t, size_t b, size_t e) {
+    while (b < e && b < found.load(std::memory_order_relaxed)) {
+      const size_t step_end = mystl::min(e, b + kParallelCancelStep);
+      auto pos = mystl::find_if(first + b, first + step_end, unary_pred);
+      if (pos != first + step_end) {
+        size_t index = static_cast<size_t>(pos - first);
+        size_t cur = found.load(std::memory_order_relaxed);
+        while (index < cur && !found.compare_exchange_weak(cur, index)) {
+        }
+        return;
+      }
+      b = step_end;
+    }
+  });
+  return first + found.load(std::memory_order_relaxed);
+}
+
+template <typename InputIter, typename UnaryPredicate>
+InputIter find_if_par(ThreadPool* /*unused*/, InputIter first, InputIter last,
+                      UnaryPredicate unary_pred, m_false_type /*unused*/) {
+  return mystl::find_if(first, last, unary_pred);
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename UnaryPredicate>
+enable_if_policy_t<ExecutionPolicy, InputIter>
+find_if(ExecutionPolicy&& policy, InputIter first, InputIter last, UnaryPredicate unary_pred) {
+  return mystl::find_if_par(mystl::policy_pool(policy), first, last, unary_pred,
+                            IsRandomAccessIterator<InputIter>());
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename T>
+enable_if_policy_t<ExecutionPolicy, InputIter>
+find(ExecutionPolicy&& policy, InputIter first, InputIter last, const T& value) {
+  return mystl::find_if(mystl::forward<ExecutionPolicy>(policy), first, last,
+                        [&value](const typename IteratorTraits<InputIter>::value_type& x) {
+                          return x == value;
+                        });
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename UnaryPredicate>
+enable_if_policy_t<ExecutionPolicy, bool>
+all_of(ExecutionPolicy&& policy, InputIter first, InputIter last, UnaryPredicate unary_pred) {
+  return mystl::find_if(mystl::forward<ExecutionPolicy>(policy), first, last,
+                        [&unary_pred](const typename IteratorTraits<InputIter>::value_type& x) {
+                          return !unary_pred(x);
+                        }) == last;
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename UnaryPredicate>
+enable_if_policy_t<ExecutionPolicy, bool>
+any_of(ExecutionPolicy&& policy, InputIter first, InputIter last, UnaryPredicate unary_pred) {
+  return mystl::find_if(mystl::forward<ExecutionPolicy>(policy), first, last, unary_pred) !=
+         last;
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename UnaryPredicate>
+enable_if_policy_t<ExecutionPolicy, bool>
+none_of(ExecutionPolicy&& policy, InputIter first, InputIter last, UnaryPredicate unary_pred) {
+  return !mystl::any_of(mystl::forward<ExecutionPolicy>(policy), first, last, unary_pred);
+}
+
+/*****************************************************************************************/
+// fill / copy
+/*****************************************************************************************/
+template <typename RandomIter, typename T>
+void fill_par(ThreadPool* pool, RandomIter first, RandomIter last, const T& value,
+              m_true_type /*unused*/) {
+  const size_t n = static_cast<size_t>(last - first);
+  const size_t chunks = parallel_chunk_count(pool, n);
+  if (chunks < 2) {
+    mystl::fill(first, last, value);
+    return;
+  }
+  parallel_chunks(*pool, n, chunks, [first, &value](size_t, size_t b, size_t e) {
+    mystl::fill(first + b, first + e, value);
+  });
+}
+
+template <typename ForwardIter, typename T>
+void fill_par(ThreadPool* /*unused*/, ForwardIter first, ForwardIter last, const T& value,
+              m_false_type /*unused*/) {
+  mystl::fill(first, last, value);
+}
+
+template <typename ExecutionPolicy, typename ForwardIter, typename T>
+enable_if_policy_t<ExecutionPolicy, void>
+fill(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, const T& value) {
+  mystl::fill_par(mystl::policy_pool(policy), first, last, value,
+                  IsRandomAccessIterator<ForwardIter>());
+}
+
+template <typename RandomIter1, typename RandomIter2>
+RandomIter2 copy_par(ThreadPool* pool, RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                     m_true_type /*unused*/) {
+  const size_t n = static_cast<size_t>(last - first);
+  const size_t chunks = parallel_chunk_count(pool, n);
+  if (chunks < 2) {
+    return mystl::copy(first, last, result);
+  }
+  parallel_chunks(*pool, n, chunks, [first, result](size_t, size_t b, size_t e) {
+    mystl::copy(first + b, first + e, result + b);
+  });
+  return result + n;
+}
+
+template <typename InputIter, typename OutputIter>
+OutputIter copy_par(ThreadPool* /*unused*/, InputIter first, InputIter last, OutputIter result,
+                    m_false_type /*unused*/) {
+  return mystl::copy(first, last, result);
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename OutputIter>
+enable_if_policy_t<ExecutionPolicy, OutputIter>
+copy(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result) {
+  using is_random = m_bool_constant<IsRandomAccessIterator<InputIter>::kValue &&
+                                    IsRandomAccessIterator<OutputIter>::kValue>;
+  return mystl::copy_par(mystl::policy_pool(policy), first, last, result, is_random());
+}
+
+/*****************************************************************************************/
+// accumulate
+// 每一块以第一个元素为初值累加，各块的结果再按顺序与 init 合并，
+// 因此 binary_op 必须满足结合律，且能以 T 作为两个参数
+// 块内的累加由 accumulate_leaf 完成，Unseq 表示执行策略是否允许重新结合浮点数的加法
+/*****************************************************************************************/
+template <typename InputIter, typename T, typename BinaryOp, typename Unseq>
+T accumulate_leaf(InputIter first, InputIter last, T init, BinaryOp binary_op, Unseq /*unused*/) {
+  return mystl::accumulate(first, last, init, binary_op);
+}
+
+// 版本1转发而来时使用 numeric.h 中的多累加器版本
+template <typename InputIter, typename T>
+T accumulate_leaf(InputIter first, InputIter last, T init, ParallelPlus /*unused*/,
+                  m_false_type /*unused*/) {
+  return mystl::accumulate(first, last, init);
+}
+
+template <typename InputIter, typename T>
+T accumulate_leaf(InputIter first, InputIter last, T init, ParallelPlus /*unused*/,
+                  m_true_type /*unused*/) {
+  return mystl::accumulate_unseq(first, last, init);
+}
+
+template <typename RandomIter, typename T, typename BinaryOp, typename Unseq>
+T accumulate_par(ThreadPool* pool, RandomIter first, RandomIter last, T init, BinaryOp binary_op,
+                 Unseq unseq, m_true_type /*unused*/) {
+  const size_t n = static_cast<size_t>(last - first);
+  const size_t chunks = parallel_chunk_count(pool, n);
+  if (chunks < 2) {
+    return mystl::accumulate_leaf(first, last, init, binary_op, unseq);
+  }
+  mystl::Vector<T> partial(chunks, init);
+  parallel_chunks(*pool, n, chunks,
+                  [first, &binary_op, &partial, unseq](size_t c, size_t b, size_t e) {
+                    partial[c] = mystl::accumulate_leaf(first + b + 1, first + e, T(first[b]),
+                                                        binary_op, unseq);
+                  });
+  for (size_t c = 0; c < chunks; ++c) {
+    init = binary_op(init, partial[c]);
+  }
+  return init;
+}
+
+template <typename InputIter, typename T, typename BinaryOp, typename Unseq>
+T accumulate_par(ThreadPool* /*unused*/, InputIter first, InputIter last, T init,
+                 BinaryOp binary_op, Unseq unseq, m_false_type /*unused*/) {
+  return mystl::accumulate_leaf(first, last, init, binary_op, unseq);
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename T>
+enable_if_policy_t<ExecutionPolicy, T>
+accumulate(ExecutionPolicy&& policy, InputIter first, InputIter last, T init) {
+  using unseq =
+      m_bool_constant<IsUnsequencedPolicy<typename std::decay<ExecutionPolicy>::type>::kValue>;
+  return mystl::accumulate_par(mystl::policy_pool(policy), first, last, init, ParallelPlus(),
+                               unseq(), IsRandomAccessIterator<InputIter>());
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename T, typename BinaryOp>
+enable_if_policy_t<ExecutionPolicy, T>
+accumulate(ExecutionPolicy&& policy, InputIter first, InputIter last, T init,
+           BinaryOp binary_op) {
+  return mystl::accumulate_par(mystl::policy_pool(policy), first, last, init, binary_op,
+                               m_false_type(), IsRandomAccessIterator<InputIter>());
+}
+
+/*****************************************************************************************/
+// inner_product / transform_reduce
+// 分块方式与 accumulate 相同，binary_op1（reduce_op）必须满足结合律
+/*****************************************************************************************/
+template <typename InputIter1, typename InputIter2, typename T, typename BinaryOp1,
+          typename BinaryOp2, typename Unseq>
+T inner_product_leaf(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                     BinaryOp1 binary_op1, BinaryOp2 binary_op2, Unseq /*unused*/) {
+  return mystl::inner_product(first1, last1, first2, init, binary_op1, binary_op2);
+}
+
+template <typename InputIter1, typename InputIter2, typename T>
+T inner_product_leaf(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                     ParallelPlus /*unused*/, ParallelMultiplies /*unused*/,
+                     m_false_type /*unused*/) {
+  return mystl::inner_product(first1, last1, first2, init);
+}
+
+template <typename InputIter1, typename InputIter2, typename T>
+T inner_product_leaf(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                     ParallelPlus /*unused*/, ParallelMultiplies /*unused*/,
+                     m_true_type /*unused*/) {
+  return mystl::inner_product_unseq(first1, last1, first2, init);
+}
+
+template <typename RandomIter1, typename RandomIter2, typename T, typename BinaryOp1,
+          typename BinaryOp2, typename Unseq>
+T inner_product_par(ThreadPool* pool, RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                    T init, BinaryOp1 binary_op1, BinaryOp2 binary_op2, Unseq unseq,
+                    m_true_type /*unused*/) {
+  const size_t n = static_cast<size_t>(last1 - first1);
+  const size_t chunks = parallel_chunk_count(pool, n);
+  if (chunks < 2) {
+    return mystl::inner_product_leaf(first1, last1, first2, init, binary_op1, binary_op2, unseq);
+  }
+  mystl::Vector<T> partial(chunks, init);
+  parallel_chunks(*pool, n, chunks,
+                  [first1, first2, &binary_op1, &binary_op2, &partial, unseq](size_t c, size_t b,
+                                                                              size_t e) {
+                    partial[c] = mystl::inner_product_leaf(
+                        first1 + b + 1, first1 + e, first2 + b + 1,
+                        T(binary_op2(first1[b], first2[b])), binary_op1, binary_op2, unseq);
+                  });
+  for (size_t c = 0; c < chunks; ++c) {
+    init = binary_op1(init, partial[c]);
+  }
+  return init;
+}
+
+template <typename InputIter1, typename InputIter2, typename T, typename BinaryOp1,
+          typename BinaryOp2, typename Unseq>
+T inner_product_par(ThreadPool* /*unused*/, InputIter1 first1, InputIter1 last1,
+                    InputIter2 first2, T init, BinaryOp1 binary_op1, BinaryOp2 binary_op2,
+                    Unseq unseq, m_false_type /*unused*/) {
+  return mystl::inner_product_leaf(first1, last1, first2, init, binary_op1, binary_op2, unseq);
+}
+
+template <typename ExecutionPolicy, typename InputIter1, typename InputIter2, typename T>
+enable_if_policy_t<ExecutionPolicy, T>
+inner_product(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2,
+              T init) {
+  using unseq =
+      m_bool_constant<IsUnsequencedPolicy<typename std::decay<ExecutionPolicy>::type>::kValue>;
+  using is_random = m_bool_constant<IsRandomAccessIterator<InputIter1>::kValue &&
+                                    IsRandomAccessIterator<InputIter2>::kValue>;
+  return mystl::inner_product_par(mystl::policy_pool(policy), first1, last1, first2, init,
+                                  ParallelPlus(), ParallelMultiplies(), unseq(), is_random());
+}
+
+template <typename ExecutionPolicy, typename InputIter1, typename InputIter2, typename T,
+          typename BinaryOp1, typename BinaryOp2>
+enable_if_policy_t<ExecutionPolicy, T>
+inner_product(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2,
+              T init, BinaryOp1 binary_op1, BinaryOp2 binary_op2) {
+  using is_random = m_bool_constant<IsRandomAccessIterator<InputIter1>::kValue &&
+                                    IsRandomAccessIterator<InputIter2>::kValue>;
+  return mystl::inner_product_par(mystl::policy_pool(policy), first1, last1, first2, init,
+                                  binary_op1, binary_op2, m_false_type(), is_random());
+}
+
+template <typename ExecutionPolicy, typename InputIter1, typename InputIter2, typename T>
+enable_if_policy_t<ExecutionPolicy, T>
+transform_reduce(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1,
+                 InputIter2 first2, T init) {
+  return mystl::inner_product(mystl::forward<ExecutionPolicy>(policy), first1, last1, first2,
+                              init);
+}
+
+template <typename ExecutionPolicy, typename InputIter1, typename InputIter2, typename T,
+          typename BinaryOp1, typename BinaryOp2>
+enable_if_policy_t<ExecutionPolicy, T>
+transform_reduce(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1,
+                 InputIter2 first2, T init, BinaryOp1 reduce_op, BinaryOp2 transform_op) {
+  return mystl::inner_product(mystl::forward<ExecutionPolicy>(policy), first1, last1, first2,
+                              init, reduce_op, transform_op);
+}
+
+template <typename RandomIter, typename T, typename BinaryOp, typename UnaryOp>
+T transform_reduce_par(ThreadPool* pool, RandomIter first, RandomIter last, T init,
+                       BinaryOp reduce_op, UnaryOp unary_op, m_true_type /*unused*/) {
+  const size_t n = static_cast<size_t>(last - first);
+  const size_t chunks = parallel_chunk_count(pool, n);
+  if (chunks < 2) {
+    return mystl::transform_reduce(first, last, init, reduce_op, unary_op);
+  }
+  mystl::Vector<T> partial(chunks, init);
+  parallel_chunks(*pool, n, chunks,
+                  [first, &reduce_op, &unary_op, &partial](size_t c, size_t b, size_t e) {
+                    partial[c] = mystl::transform_reduce(first + b + 1, first + e,
+                                                         T(unary_op(first[b])), reduce_op,
+                                                         unary_op);
+                  });
+  for (size_t c = 0; c < chunks; ++c) {
+    init = reduce_op(init, partial[c]);
+  }
+  return init;
+}
+
+template <typename InputIter, typename T, typename BinaryOp, typename UnaryOp>
+T transform_reduce_par(ThreadPool* /*unused*/, InputIter first, InputIter last, T init,
+                       BinaryOp reduce_op, UnaryOp unary_op, m_false_type /*unused*/) {
+  return mystl::transform_reduce(first, last, init, reduce_op, unary_op);
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename T, typename BinaryOp,
+          typename UnaryOp>
+enable_if_policy_t<ExecutionPolicy, T>
+transform_reduce(ExecutionPolicy&& policy, InputIter first, InputIter last, T init,
+                 BinaryOp reduce_op, UnaryOp unary_op) {
+  return mystl::transform_reduce_par(mystl::policy_pool(policy), first, last, init, reduce_op,
+                                     unary_op, IsRandomAccessIterator<InputIter>());
+}
+
+/*****************************************************************************************/
+// partial_sum
+// 并行前缀和分两趟：第一趟并行求出每一块的和，再串行求出每一块之前所有元素的和，
+// 第二趟每一块以该值为起点并行地做局部累计，输入区间的每个元素被读取两次
+/*****************************************************************************************/
+template <typename RandomIter1, typename RandomIter2, typename BinaryOp>
+RandomIter2 partial_sum_par(ThreadPool* pool, RandomIter1 first, RandomIter1 last,
+                            RandomIter2 result, BinaryOp binary_op, m_true_type /*unused*/) {
+  using value_type = typename IteratorTraits<RandomIter1>::value_type;
+  const size_t n = static_cast<size_t>(last - first);
+  const size_t chunks = parallel_chunk_count(pool, n);
+  if (chunks < 2) {
+    return mystl::partial_sum(first, last, result, binary_op);
+  }
+  // prefix[c] 先保存第 c - 1 块的和，最后一块的和用不到，不必计算
+  mystl::Vector<value_type> prefix(chunks, first[0]);
+  parallel_chunks(*pool, n, chunks,
+                  [first, chunks, &binary_op, &prefix](size_t c, size_t b, size_t e) {
+                    if (c + 1 < chunks) {
+                      prefix[c + 1] = mystl::accumulate(first + b + 1, first + e,
+                                                        value_type(first[b]), binary_op);
+                    }
+                  });
+  for (size_t c = 2; c < chunks; ++c) {
+    prefix[c] = binary_op(prefix[c - 1], prefix[c]);
+  }
+  parallel_chunks(*pool, n, chunks,
+                  [first, result, &binary_op, &prefix](size_t c, size_t b, size_t e) {
+                    if (c == 0) {
+                      mystl::partial_sum(first + b, first + e, result + b, binary_op);
+                      return;
+                    }
+                    value_type value = binary_op(prefix[c], first[b]);
+                    result[b] = value;
+                    for (size_t i = b + 1; i < e; ++i) {
+                      value = binary_op(value, first[i]);
+                      result[i] = value;
+                    }
+                  });
+  return result + n;
+}
+
+template <typename InputIter, typename OutputIter, typename BinaryOp>
+OutputIter partial_sum_par(ThreadPool* /*unused*/, InputIter first, InputIter last,
+                           OutputIter result, BinaryOp binary_op, m_false_type /*unused*/) {
+  return mystl::partial_sum(first, last, result, binary_op);
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename OutputIter>
+enable_if_policy_t<ExecutionPolicy, OutputIter>
+partial_sum(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result) {
+  using is_random = m_bool_constant<IsRandomAccessIterator<InputIter>::kValue &&
+                                    IsRandomAccessIterator<OutputIter>::kValue>;
+  return mystl::partial_sum_par(mystl::policy_pool(policy), first, last, result, ParallelPlus(),
+                                is_random());
+}
+
+template <typename ExecutionPolicy, typename InputIter, typename OutputIter, typename BinaryOp>
+enable_if_policy_t<ExecutionPolicy, OutputIter>
+partial_sum(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result,
+            BinaryOp binary_op) {
+  using is_random = m_bool_constant<IsRandomAccessIterator<InputIter>::kValue &&
+                                    IsRandomAccessIterator<OutputIter>::kValue>;
+  return mystl::partial_sum_par(mystl::policy_pool(policy), first, last, result, binary_op,
+                                is_random());
+}
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_PARALLEL_ALGO_H_
@@ -0,0 +1,153 @@
+#ifndef MYTINYSTL_PERSISTENT_MAP_H_
+#define MYTINYSTL_PERSISTENT_MAP_H_
+
+// 这个头文件包含一个模板类 PersistentMap
+// PersistentMap : 持久化映射，元素具有键值和实值，会根据键值大小自动排序，键值不允许重复
+//                 复制（取快照）的时间复杂度为O(1)，修改只影响当前对象，已取得的快照保持不变
+
+// notes:
+//
+// 元素一旦插入就不能通过迭代器修改，没有 operator[]，修改实值使用 insert_or_assign
+// 同一个版本的快照可以交给其它线程读取与销毁，写者在自己的对象上继续修改，不会影响读者
+//
+// 异常保证：
+// mystl::PersistentMap<Key, T> 的所有修改操作都满足强异常安全保证，
+// 新版本完全构造成功后才替换当前版本
+
+#include <initializer_list>
+
+#include "persistent_rb_tree.h"
+#include "util.h"
+
+namespace mystl {
+
+// 模板类PersistentMap
+// 参数一代表键值类型，参数二代表实值类型，参数三代表键值的比较方式，缺省使用mystl::Less
+template <typename Key, typename T, typename Compare = mystl::Less<Key>>
+class PersistentMap {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = mystl::pair<const Key, T>;
+  using key_compare = Compare;
+
+ private:
+  using base_type = mystl::PersistentRbTree<value_type, key_compare>;
+  base_type tree_;
+
+ public:
+  using pointer = typename base_type::pointer;
+  using const_pointer = typename base_type::const_pointer;
+  using reference = typename base_type::reference;
+  using const_reference = typename base_type::const_reference;
+  using iterator = typename base_type::iterator;
+  using const_iterator = typename base_type::const_iterator;
+  using size_type = typename base_type::size_type;
+  using difference_type = typename base_type::difference_type;
+  using allocator_type = typename base_type::allocator_type;
+
+ public:
+  PersistentMap() = default;
+
+  template <typename InputIterator>
+  PersistentMap(InputIterator first, InputIterator last) : tree_() {
+    for (; first != last; ++first) {
+      tree_.insert_unique(*first);
+    }
+  }
+
+  PersistentMap(std::initializer_list<value_type> ilist) : tree_() {
+    for (auto it = ilist.begin(); it != ilist.end(); ++it) {
+      tree_.insert_unique(*it);
+    }
+  }
+
+  // 复制与赋值只共享根结点，时间复杂度为O(1)
+  PersistentMap(const PersistentMap& rhs) : tree_(rhs.tree_) {}
+  PersistentMap(PersistentMap&& rhs) noexcept : tree_(mystl::move(rhs.tree_)) {}
+
+  PersistentMap& operator=(const PersistentMap& rhs) {
+    tree_ = rhs.tree_;
+    return *this;
+  }
+  PersistentMap& operator=(PersistentMap&& rhs) noexcept {
+    tree_ = mystl::move(rhs.tree_);
+    return *this;
+  }
+
+  // 返回当前版本的快照，与复制构造相同
+  PersistentMap snapshot() const { return *this; }
+
+  key_compare key_comp() const { return tree_.key_comp(); }
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+  const_iterator begin() const { return tree_.begin(); }
+  const_iterator end() const { return tree_.end(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  bool empty() const noexcept { return tree_.empty(); }
+  size_type size() const noexcept { return tree_.size(); }
+  size_type max_size() const noexcept { return tree_.max_size(); }
+
+  // 访问元素相关操作
+  const mapped_type& at(const key_type& key) const {
+    const_iterator it = find(key);
+    THROW_OUT_OF_RANGE_IF(it == end(), "PersistentMap<Key, T> no such element exists");
+    return it->second;
+  }
+
+  // 插入删除相关操作，每次修改新建O(log n)个结点，其余结点与旧版本共享
+  mystl::pair<const_iterator, bool> insert(const value_type& value) {
+    return tree_.insert_unique(value);
+  }
+
+  template <typename M>
+  mystl::pair<const_iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+    return tree_.assign_unique(value_type(key, mystl::forward<M>(obj)));
+  }
+
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    // 在副本上逐个插入，全部成功后再替换当前版本
+    base_type tmp(tree_);
+    for (; first != last; ++first) {
+      tmp.insert_unique(*first);
+    }
+    tree_.swap(tmp);
+  }
+
+  size_type erase(const key_type& key) { return tree_.erase_unique(key); }
+
+  void clear() { tree_.clear(); }
+
+  // persistent map相关操作
+  const_iterator find(const key_type& key) const { return tree_.find(key); }
+  size_type count(const key_type& key) const { return tree_.count(key); }
+  const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+  const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+
+  // 两个对象是否共享同一个版本
+  bool same_version(const PersistentMap& rhs) const noexcept {
+    return tree_.same_version(rhs.tree_);
+  }
+
+  void swap(PersistentMap& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+ public:
+  friend bool operator==(const PersistentMap& lhs, const PersistentMap& rhs) {
+    return lhs.tree_ == rhs.tree_;
+  }
+  friend bool operator!=(const PersistentMap& lhs, const PersistentMap& rhs) {
+    return lhs.tree_ != rhs.tree_;
+  }
+};
+
+// 重载 mystl 的 swap
+template <typename Key, typename T, typename Compare>
+void swap(PersistentMap<Key, T, Compare>& lhs, PersistentMap<Key, T, Compare>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_PERSISTENT_MAP_H_
@@ -0,0 +1,599 @@
+#ifndef MYTINYSTL_PERSISTENT_RB_TREE_H_
+#define MYTINYSTL_PERSISTENT_RB_TREE_H_
+
+// 这个头文件包含一个模板类 PersistentRbTree
+// PersistentRbTree : 持久化红黑树，修改时只复制从根到修改点路径上的结点，其余结点在各个版本之间共享
+
+// notes:
+//
+// 结点一旦链接到树上就不再修改，以引用计数管理生命周期，复制一棵树（取快照）只需增加根结点的计数
+// 结点没有父指针（共享的结点可能同时属于多个版本），因此不能复用 rb_tree.h 中基于父指针的
+// 旋转与再平衡函数，插入采用 Okasaki 的 balance，删除采用 Kahrs 的算法，二者都是自上而下重建路径
+// 每次插入、删除新建O(log n)个结点并复制其中的元素
+//
+// 线程安全：引用计数为原子变量，同一个版本的多个副本可以在不同线程中同时读取与销毁，
+// 但同一个 PersistentRbTree 对象不能同时被多个线程修改
+//
+// 迭代器只能前进，在栈中保存尚未访问的祖先结点，迭代器所属的版本被销毁后迭代器失效
+
+#include <atomic>
+
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "rb_tree.h"
+#include "util.h"
+
+namespace mystl {
+
+// 持久化红黑树的结点
+template <typename T>
+struct PersistentRbTreeNode {
+  using color_type = rb_tree_color_type;
+  using node_ptr = PersistentRbTreeNode<T>*;
+
+  std::atomic<size_t> ref_count;  // 引用该结点的父结点与树的个数
+  node_ptr left;
+  node_ptr right;
+  color_type color;
+  T value;
+
+  color_type get_color() const noexcept { return color; }
+  void set_color(color_type c) noexcept { color = c; }
+};
+
+// 持久化红黑树的迭代器，只能前进
+template <typename T>
+struct PersistentRbTreeIterator : public mystl::Iterator<mystl::ForwardIteratorTag, T> {
+  using value_type = T;
+  using pointer = const T*;
+  using reference = const T&;
+  using node_ptr = PersistentRbTreeNode<T>*;
+  using self = PersistentRbTreeIterator<T>;
+
+  // 红黑树的高度不超过2log(n+1)
+  static constexpr size_t kMaxDepth = 2 * sizeof(size_t) * 8;
+
+  node_ptr stack_[kMaxDepth];  // 栈顶为当前结点，其余为当前结点位于其左子树中的祖先
+  size_t depth_;
+
+  // 构造函数
+  PersistentRbTreeIterator() : depth_(0) {}
+  PersistentRbTreeIterator(const self& rhs) : depth_(rhs.depth_) {
+    mystl::copy(rhs.stack_, rhs.stack_ + depth_, stack_);
+  }
+  self& operator=(const self& rhs) {
+    depth_ = rhs.depth_;
+    mystl::copy(rhs.stack_, rhs.stack_ + depth_, stack_);
+    return *this;
+  }
+
+  // 把x及其左边缘上的结点依次压入栈中
+  void push_left(node_ptr x) {
+    for (; x != nullptr; x = x->left) {
+      stack_[depth_++] = x;
+    }
+  }
+  void push(node_ptr x) { stack_[depth_++] = x; }
+
+  // 重载操作符
+  reference operator*() const { return stack_[depth_ - 1]->value; }
+  pointer operator->() const { return &(operator*()); }
+
+  self& operator++() {
+    MYSTL_DEBUG(depth_ != 0);
+    push_left(stack_[--depth_]->right);
+    return *this;
+  }
+
+  self operator++(int) {
+    self tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  bool operator==(const self& rhs) const {
+    return depth_ == 0 ? rhs.depth_ == 0
+                       : rhs.depth_ != 0 && stack_[depth_ - 1] == rhs.stack_[rhs.depth_ - 1];
+  }
+  bool operator!=(const self& rhs) const { return !(*this == rhs); }
+};
+
+// 模板类PersistentRbTree
+// 参数一代表数据类型，参数二代表键值比较类型
+template <typename T, typename Compare>
+class PersistentRbTree {
+ public:
+  // PersistentRbTree的嵌套型别定义
+  using value_traits = RbTreeValueTraits<T>;
+
+  using node_type = PersistentRbTreeNode<T>;
+  using node_ptr = node_type*;
+  using color_type = rb_tree_color_type;
+
+  using key_type = typename value_traits::key_type;
+  using mapped_type = typename value_traits::mapped_type;
+  using value_type = typename value_traits::value_type;
+  using key_compare = Compare;
+
+  using allocator_type = mystl::Allocator<T>;
+  using data_allocator = mystl::Allocator<T>;
+  using node_allocator = mystl::Allocator<node_type>;
+
+  using pointer = typename allocator_type::pointer;
+  using const_pointer = typename allocator_type::const_pointer;
+  using reference = typename allocator_type::reference;
+  using const_reference = typename allocator_type::const_reference;
+  using size_type = typename allocator_type::size_type;
+  using difference_type = typename allocator_type::difference_type;
+
+  // 元素不可修改，iterator与const_iterator相同
+  using iterator = PersistentRbTreeIterator<T>;
+  using const_iterator = iterator;
+
+  allocator_type get_allocator() const { return node_allocator(); }
+  key_compare key_comp() const { return key_comp_; }
+
+ private:
+  node_ptr root_;         // 根结点，当前对象持有它的一个引用
+  size_type node_count_;  // 结点数
+  key_compare key_comp_;  // 结点键值比较的准则
+
+ public:
+  // 构造、复制、析构函数
+  PersistentRbTree() : root_(nullptr), node_count_(0), key_comp_() {}
+
+  // 复制只增加根结点的引用计数，时间复杂度为O(1)
+  PersistentRbTree(const PersistentRbTree& rhs)
+      : root_(retain(rhs.root_)), node_count_(rhs.node_count_), key_comp_(rhs.key_comp_) {}
+  PersistentRbTree(PersistentRbTree&& rhs) noexcept
+      : root_(rhs.root_), node_count_(rhs.node_count_), key_comp_(rhs.key_comp_) {
+    rhs.root_ = nullptr;
+    rhs.node_count_ = 0;
+  }
+
+  PersistentRbTree& operator=(const PersistentRbTree& rhs) {
+    PersistentRbTree tmp(rhs);
+    swap(tmp);
+    return *this;
+  }
+  PersistentRbTree& operator=(PersistentRbTree&& rhs) noexcept {
+    PersistentRbTree tmp(mystl::move(rhs));
+    swap(tmp);
+    return *this;
+  }
+
+  ~PersistentRbTree() { release(root_); }
+
+ public:
+  // 迭代器相关操作
+  const_iterator begin() const {
+    const_iterator it;
+    it.push_left(root_);
+    return it;
+  }
+  const_iterator end() const { return const_iterator(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  // 容量相关操作
+  bool empty() const noexcept { return node_count_ == 0; }
+  size_type size() const noexcept { return node_count_; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+
+  // 修改操作，只影响当前对象，其它副本仍然看到修改前的版本
+  // 插入失败时不会新建任何结点
+  mystl::pair<const_iterator, bool> insert_unique(const value_type& value);
+  // 键值已存在时以value替换原来的元素
+  mystl::pair<const_iterator, bool> assign_unique(const value_type& value);
+
+  size_type erase_unique(const key_type& key);
+
+  void clear() {
+    release(root_);
+    root_ = nullptr;
+    node_count_ = 0;
+  }
+
+  // 查找相关操作
+  template <typename K>
+  const_iterator find(const K& key) const {
+    const_iterator it = lower_bound(key);
+    return (it == end() || key_comp_(key, value_traits::get_key(*it))) ? end() : it;
+  }
+
+  template <typename K>
+  size_type count(const K& key) const {
+    return find(key) != end() ? 1 : 0;
+  }
+
+  template <typename K>
+  const_iterator lower_bound(const K& key) const;
+  template <typename K>
+  const_iterator upper_bound(const K& key) const;
+
+  // 两棵树共享同一个根结点时必然相等，不必逐个比较
+  bool same_version(const PersistentRbTree& rhs) const noexcept { return root_ == rhs.root_; }
+
+  void swap(PersistentRbTree& rhs) noexcept {
+    mystl::swap(root_, rhs.root_);
+    mystl::swap(node_count_, rhs.node_count_);
+    mystl::swap(key_comp_, rhs.key_comp_);
+  }
+
+ private:
+  // 持有结点的一个引用，离开作用域时自动释放，构造新结点的过程中抛出异常也不会泄漏
+  struct NodeRef {
+    node_ptr node;
+
+    NodeRef() noexcept : node(nullptr) {}
+    explicit NodeRef(node_ptr x) noexcept : node(x) {}
+    NodeRef(NodeRef&& rhs) noexcept : node(rhs.node) { rhs.node = nullptr; }
+    NodeRef(const NodeRef&) = delete;
+    NodeRef& operator=(const NodeRef&) = delete;
+    ~NodeRef() { PersistentRbTree::release(node); }
+
+    node_ptr operator->() const noexcept { return node; }
+    // 交出引用
+    node_ptr take() noexcept {
+      node_ptr tmp = node;
+      node = nullptr;
+      return tmp;
+    }
+  };
+
+  // node related
+  static node_ptr retain(node_ptr x) noexcept;
+  static void release(node_ptr x) noexcept;
+  static NodeRef share(node_ptr x) noexcept { return NodeRef(retain(x)); }
+  static NodeRef make_node(color_type color, NodeRef left, const value_type& value,
+                           NodeRef right);
+  static NodeRef paint(color_type color, NodeRef x);
+
+  static bool is_red(node_ptr x) noexcept { return x != nullptr && rb_tree_is_red(x); }
+  static bool is_black(node_ptr x) noexcept { return x != nullptr && !rb_tree_is_red(x); }
+  static const key_type& key_of(node_ptr x) noexcept { return value_traits::get_key(x->value); }
+
+  // rebalance
+  static NodeRef balance(NodeRef left, const value_type& value, NodeRef right);
+  static NodeRef balance_left(NodeRef left, const value_type& value, NodeRef right);
+  static NodeRef balance_right(NodeRef left, const value_type& value, NodeRef right);
+  static NodeRef append(node_ptr left, node_ptr right);
+
+  // path copying
+  NodeRef insert_at(node_ptr x, const value_type& value);
+  NodeRef replace_at(node_ptr x, const value_type& value);
+  NodeRef erase_at(node_ptr x, const key_type& key);
+};
+
+/*****************************************************************************************/
+
+// 插入新元素，键值已存在时什么也不做
+template <typename T, typename Compare>
+mystl::pair<typename PersistentRbTree<T, Compare>::const_iterator, bool>
+PersistentRbTree<T, Compare>::insert_unique(const value_type& value) {
+  const auto& key = value_traits::get_key(value);
+  auto it = find(key);
+  if (it != end()) {
+    return mystl::make_pair(it, false);
+  }
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "PersistentRbTree<T>'s size too big");
+  auto new_root = paint(kRbTreeBlack, insert_at(root_, value));
+  release(root_);
+  root_ = new_root.take();
+  ++node_count_;
+  return mystl::make_pair(find(key), true);
+}
+
+// 插入新元素，键值已存在时替换原来的元素
+template <typename T, typename Compare>
+mystl::pair<typename PersistentRbTree<T, Compare>::const_iterator, bool>
+PersistentRbTree<T, Compare>::assign_unique(const value_type& value) {
+  const auto& key = value_traits::get_key(value);
+  if (find(key) == end()) {
+    return insert_unique(value);
+  }
+  auto new_root = replace_at(root_, value);
+  release(root_);
+  root_ = new_root.take();
+  return mystl::make_pair(find(key), false);
+}
+
+// 删除键值等于key的元素，返回删除的个数
+template <typename T, typename Compare>
+typename PersistentRbTree<T, Compare>::size_type PersistentRbTree<T, Compare>::erase_unique(
+    const key_type& key) {
+  if (find(key) == end()) {
+    return 0;
+  }
+  auto new_root = erase_at(root_, key);
+  auto x = new_root.node == nullptr ? nullptr : paint(kRbTreeBlack, mystl::move(new_root)).take();
+  release(root_);
+  root_ = x;
+  --node_count_;
+  return 1;
+}
+
+// 键值不小于key的第一个元素，沿途向左走过的结点就是迭代器栈中的祖先
+template <typename T, typename Compare>
+template <typename K>
+typename PersistentRbTree<T, Compare>::const_iterator PersistentRbTree<T, Compare>::lower_bound(
+    const K& key) const {
+  const_iterator it;
+  auto x = root_;
+  while (x != nullptr) {
+    if (!key_comp_(key_of(x), key)) {
+      it.push(x);
+      x = x->left;
+    } else {
+      x = x->right;
+    }
+  }
+  return it;
+}
+
+// 键值大于key的第一个元素
+template <typename T, typename Compare>
+template <typename K>
+typename PersistentRbTree<T, Compare>::const_iterator PersistentRbTree<T, Compare>::upper_bound(
+    const K& key) const {
+  const_iterator it;
+  auto x = root_;
+  while (x != nullptr) {
+    if (key_comp_(key, key_of(x))) {
+      it.push(x);
+      x = x->left;
+    } else {
+      x = x->right;
+    }
+  }
+  return it;
+}
+
+// helper function
+
+// 增加结点的引用计数
+template <typename T, typename Compare>
+typename PersistentRbTree<T, Compare>::node_ptr PersistentRbTree<T, Compare>::retain(
+    node_ptr x) noexcept {
+  if (x != nullptr) {
+    x->ref_count.fetch_add(1, std::memory_order_relaxed);
+  }
+  return x;
+}
+
+// 减少结点的引用计数，计数归零时销毁结点并释放它对子结点的引用
+template <typename T, typename Compare>
+void PersistentRbTree<T, Compare>::release(node_ptr x) noexcept {
+  while (x != nullptr && x->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    release(x->left);
+    auto next = x->right;
+    data_allocator::destroy(mystl::address_of(x->value));
+    node_allocator::deallocate(x);
+    x = next;
+  }
+}
+
+// 以left、value、right创建一个新结点，新结点接管left与right的引用
+template <typename T, typename Compare>
+typename PersistentRbTree<T, Compare>::NodeRef PersistentRbTree<T, Compare>::make_node(
+    color_type color, NodeRef left, const value_type& value, NodeRef right) {
+  auto tmp = node_allocator::allocate(1);
+  try {
+    data_allocator::construct(mystl::address_of(tmp->value), value);
+  } catch (...) {
+    node_allocator::deallocate(tmp);
+    throw;
+  }
+  ::new (static_cast<void*>(&tmp->ref_count)) std::atomic<size_t>(1);
+  tmp->left = left.take();
+  tmp->right = right.take();
+  tmp->color = color;
+  return NodeRef(tmp);
+}
+
+// 返回颜色为color的x，颜色不同时复制一个结点
+template <typename T, typename Compare>
+typename PersistentRbTree<T, Compare>::NodeRef PersistentRbTree<T, Compare>::paint(
+    color_type color, NodeRef x) {
+  if (x->get_color() == color) {
+    return x;
+  }
+  return make_node(color, share(x->left), x->value, share(x->right));
+}
+
+/*-----------------------------------------------------------------*\
+|        z          z          x          x                          |
+|       /          /            \          \              y          |
+|      y          x              z          y    ==>     / \         |
+|     /            \            /            \          x   z        |
+|    x              y          y              z                      |
+\*-----------------------------------------------------------------*/
+// 消除左右子树中连续的红结点，四种情况都转换为红色父结点带两个黑色子结点，其余情况返回黑结点
+template <typename T, typename Compare>
+typename PersistentRbTree<T, Compare>::NodeRef PersistentRbTree<T, Compare>::balance(
+    NodeRef left, const value_type& value, NodeRef right) {
+  if (is_red(left.node) && is_red(right.node)) {
+    return make_node(kRbTreeRed, paint(kRbTreeBlack, mystl::move(left)), value,
+                     paint(kRbTreeBlack, mystl::move(right)));
+  }
+  if (is_red(left.node)) {
+    if (is_red(left->left)) {
+      auto ll = left->left;
+      return make_node(
+          kRbTreeRed, make_node(kRbTreeBlack, share(ll->left), ll->value, share(ll->right)),
+          left->value, make_node(kRbTreeBlack, share(left->right), value, mystl::move(right)));
+    }
+    if (is_red(left->right)) {
+      auto lr = left->right;
+      return make_node(
+          kRbTreeRed, make_node(kRbTreeBlack, share(left->left), left->value, share(lr->left)),
+          lr->value, make_node(kRbTreeBlack, share(lr->right), value, mystl::move(right)));
+    }
+  }
+  if (is_red(right.node)) {
+    if (is_red(right->right)) {
+      auto rr = right->right;
+      return make_node(
+          kRbTreeRed, make_node(kRbTreeBlack, mystl::move(left), value, share(right->left)),
+          right->value, make_node(kRbTreeBlack, share(rr->left), rr->value, share(rr->right)));
+    }
+    if (is_red(right->left)) {
+      auto rl = right->left;
+      return make_node(
+          kRbTreeRed, make_node(kRbTreeBlack, mystl::move(left), value, share(rl->left)),
+          rl->value, make_node(kRbTreeBlack, share(rl->right), right->value, share(right->right)));
+    }
+  }
+  return make_node(kRbTreeBlack, mystl::move(left), value, mystl::move(right));
+}
+
+// 左子树的黑高比右子树少一时恢复平衡，right为黑或者为左子结点是黑色的红结点
+template <typename T, typename Compare>
+typename PersistentRbTree<T, Compare>::NodeRef PersistentRbTree<T, Compare>::balance_left(
+    NodeRef left, const value_type& value, NodeRef right) {
+  if (is_red(left.node)) {
+    return make_node(kRbTreeRed, paint(kRbTreeBlack, mystl::move(left)), value,
+                     mystl::move(right));
+  }
+  if (is_black(right.node)) {
+    return balance(mystl::move(left), value, paint(kRbTreeRed, mystl::move(right)));
+  }
+  MYSTL_DEBUG(is_red(right.node) && is_black(right->left));
+  auto rl = right->left;
+  return make_node(kRbTreeRed, make_node(kRbTreeBlack, mystl::move(left), value, share(rl->left)),
+                   rl->value,
+                   balance(share(rl->right), right->value,
+                           paint(kRbTreeRed, share(right->right))));
+}
+
+// 右子树的黑高比左子树少一时恢复平衡，与balance_left对称
+template <typename T, typename Compare>
+typename PersistentRbTree<T, Compare>::NodeRef PersistentRbTree<T, Compare>::balance_right(
+    NodeRef left, const value_type& value, NodeRef right) {
+  if (is_red(right.node)) {
+    return make_node(kRbTreeRed, mystl::move(left), value,
+                     paint(kRbTreeBlack, mystl::move(right)));
+  }
+  if (is_black(left.node)) {
+    return balance(paint(kRbTreeRed, mystl::move(left)), value, mystl::move(right));
+  }
+  MYSTL_DEBUG(is_red(left.node) && is_black(left->right));
+  auto lr = left->right;
+  return make_node(kRbTreeRed,
+                   balance(paint(kRbTreeRed, share(left->left)), left->value, share(lr->left)),
+                   lr->value,
+                   make_node(kRbTreeBlack, share(lr->right), value, mystl::move(right)));
+}
+
+// 把黑高相同的left与right首尾相接，用于删除结点后合并它的两棵子树
+template <typename T, typename Compare>
+typename PersistentRbTree<T, Compare>::NodeRef PersistentRbTree<T, Compare>::append(
+    node_ptr left, node_ptr right) {
+  if (left == nullptr) {
+    return share(right);
+  }
+  if (right == nullptr) {
+    return share(left);
+  }
+  if (is_red(left) && is_red(right)) {
+    auto mid = append(left->right, right->left);
+    if (is_red(mid.node)) {
+      return make_node(
+          kRbTreeRed, make_node(kRbTreeRed, share(left->left), left->value, share(mid->left)),
+          mid->value, make_node(kRbTreeRed, share(mid->right), right->value, share(right->right)));
+    }
+    return make_node(kRbTreeRed, share(left->left), left->value,
+                     make_node(kRbTreeRed, mystl::move(mid), right->value, share(right->right)));
+  }
+  if (!is_red(left) && !is_red(right)) {
+    auto mid = append(left->right, right->left);
+    if (is_red(mid.node)) {
+      return make_node(
+          kRbTreeRed, make_node(kRbTreeBlack, share(left->left), left->value, share(mid->left)),
+          mid->value,
+          make_node(kRbTreeBlack, share(mid->right), right->value, share(right->right)));
+    }
+    return balance_left(
+        share(left->left), left->value,
+        make_node(kRbTreeBlack, mystl::move(mid), right->value, share(right->right)));
+  }
+  if (is_red(right)) {
+    return make_node(kRbTreeRed, append(left, right->left), right->value, share(right->right));
+  }
+  return make_node(kRbTreeRed, share(left->left), left->value, append(left->right, right));
+}
+
+// 在以x为根的子树中插入value，返回新子树的根，调用者保证键值不存在
+template <typename T, typename Compare>
+typename PersistentRbTree<T, Compare>::NodeRef PersistentRbTree<T, Compare>::insert_at(
+    node_ptr x, const value_type& value) {
+  if (x == nullptr) {
+    return make_node(kRbTreeRed, NodeRef(), value, NodeRef());
+  }
+  if (key_comp_(value_traits::get_key(value), key_of(x))) {
+    if (is_red(x)) {
+      return make_node(kRbTreeRed, insert_at(x->left, value), x->value, share(x->right));
+    }
+    return balance(insert_at(x->left, value), x->value, share(x->right));
+  }
+  if (is_red(x)) {
+    return make_node(kRbTreeRed, share(x->left), x->value, insert_at(x->right, value));
+  }
+  return balance(share(x->left), x->value, insert_at(x->right, value));
+}
+
+// 以value替换键值相同的元素，树的形状与颜色不变，调用者保证键值存在
+template <typename T, typename Compare>
+typename PersistentRbTree<T, Compare>::NodeRef PersistentRbTree<T, Compare>::replace_at(
+    node_ptr x, const value_type& value) {
+  const auto& key = value_traits::get_key(value);
+  if (key_comp_(key, key_of(x))) {
+    return make_node(x->get_color(), replace_at(x->left, value), x->value, share(x->right));
+  }
+  if (key_comp_(key_of(x), key)) {
+    return make_node(x->get_color(), share(x->left), x->value, replace_at(x->right, value));
+  }
+  return make_node(x->get_color(), share(x->left), value, share(x->right));
+}
+
+// 在以x为根的子树中删除键值等于key的结点，调用者保证键值存在
+// 从黑结点的子树中删除时黑高可能减一，由balance_left与balance_right补偿
+template <typename T, typename Compare>
+typename PersistentRbTree<T, Compare>::NodeRef PersistentRbTree<T, Compare>::erase_at(
+    node_ptr x, const key_type& key) {
+  if (key_comp_(key, key_of(x))) {
+    if (is_black(x->left)) {
+      return balance_left(erase_at(x->left, key), x->value, share(x->right));
+    }
+    return make_node(kRbTreeRed, erase_at(x->left, key), x->value, share(x->right));
+  }
+  if (key_comp_(key_of(x), key)) {
+    if (is_black(x->right)) {
+      return balance_right(share(x->left), x->value, erase_at(x->right, key));
+    }
+    return make_node(kRbTreeRed, share(x->left), x->value, erase_at(x->right, key));
+  }
+  return append(x->left, x->right);
+}
+
+// 重载比较操作符
+template <typename T, typename Compare>
+bool operator==(const PersistentRbTree<T, Compare>& lhs, const PersistentRbTree<T, Compare>& rhs) {
+  return lhs.same_version(rhs) ||
+         (lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename T, typename Compare>
+bool operator!=(const PersistentRbTree<T, Compare>& lhs, const PersistentRbTree<T, Compare>& rhs) {
+  return !(lhs == rhs);
+}
+
+// 重载 mystl 的 swap
+template <typename T, typename Compare>
+void swap(PersistentRbTree<T, Compare>& lhs, PersistentRbTree<T, Compare>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_PERSISTENT_RB_TREE_H_
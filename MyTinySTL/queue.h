@@ -7,6 +7,8 @@
 // priority_queue : 优先队列
 // 对应书4.8节
 
+// addressable_priority_queue : 可寻址的优先队列，push 返回句柄，可以通过句柄修改或删除元素
+
 #include <initializer_list>
 #include <type_traits>
 
@@ -154,14 +156,17 @@ void swap(Queue<T, Container>& lhs, Queue<T, Container>& rhs) noexcept(noexcept(
 // 模板类 priority_queue
 // 参数一代表数据类型，参数二代表容器类型，缺省使用mystl::Vector作为底层容器
 // 参数三代表比较权值的方式，缺省使用mystl::Less作为比较方式
+// 参数四代表堆的组织方式，缺省使用二叉堆，元素很多时可以使用 mystl::DaryHeap<4> 等更浅的 D 叉堆
 template <
     typename T,
     typename Container = mystl::Vector<T>,
-    typename Compare = mystl::Less<typename Container::value_type>>
+    typename Compare = mystl::Less<typename Container::value_type>,
+    typename HeapPolicy = mystl::BinaryHeap>
 class PriorityQueue {
  public:
   using container_type = Container;
   using value_compare = Compare;
+  using heap_policy = HeapPolicy;
   using value_type = typename Container::value_type;
   using size_type = typename Container::size_type;
   using reference = typename Container::reference;
@@ -180,53 +185,48 @@ class PriorityQueue {
 
   PriorityQueue(const Compare& c) : c_(), comp_(c) {}
 
-  explicit PriorityQueue(size_type n) : c_(n) { mystl::make_heap(c_.begin(), c_.end(), comp_); }
+  explicit PriorityQueue(size_type n) : c_(n) { HeapPolicy::make(c_.begin(), c_.end(), comp_); }
 
   PriorityQueue(size_type n, const value_type& value) : c_(n, value) {
-    mystl::make_heap(c_.begin(), c_.end(), comp_);
+    HeapPolicy::make(c_.begin(), c_.end(), comp_);
   }
 
   template <typename IIter>
   PriorityQueue(IIter first, IIter last) : c_(first, last) {
-    mystl::make_heap(c_.begin(), c_.end(), comp_);
+    HeapPolicy::make(c_.begin(), c_.end(), comp_);
   }
 
   PriorityQueue(std::initializer_list<T> ilist) : c_(ilist) {
-    mystl::make_heap(c_.begin(), c_.end(), comp_);
+    HeapPolicy::make(c_.begin(), c_.end(), comp_);
   }
 
-  PriorityQueue(const Container& s) : c_(s) { mystl::make_heap(c_.begin(), c_.end(), comp_); }
+  PriorityQueue(const Container& s) : c_(s) { HeapPolicy::make(c_.begin(), c_.end(), comp_); }
 
   PriorityQueue(Container&& s) : c_(mystl::move(s)) {
-    mystl::make_heap(c_.begin(), c_.end(), comp_);
+    HeapPolicy::make(c_.begin(), c_.end(), comp_);
   }
 
-  PriorityQueue(const PriorityQueue& rhs) : c_(rhs.c_), comp_(rhs.comp_) {
-    mystl::make_heap(c_.begin(), c_.end(), comp_);
-  }
+  // rhs 的底层容器已经是一个堆，不需要重新建堆
+  PriorityQueue(const PriorityQueue& rhs) : c_(rhs.c_), comp_(rhs.comp_) {}
 
-  PriorityQueue(PriorityQueue&& rhs) : c_(mystl::move(rhs.c_)), comp_(rhs.comp_) {
-    mystl::make_heap(c_.begin(), c_.end(), comp_);
-  }
+  PriorityQueue(PriorityQueue&& rhs) : c_(mystl::move(rhs.c_)), comp_(rhs.comp_) {}
 
   PriorityQueue& operator=(const PriorityQueue& rhs) {
     c_ = rhs.c_;
     comp_ = rhs.comp_;
-    mystl::make_heap(c_.begin(), c_.end(), comp_);
     return *this;
   }
 
   PriorityQueue& operator=(PriorityQueue&& rhs) {
     c_ = mystl::move(rhs.c_);
     comp_ = rhs.comp_;
-    mystl::make_heap(c_.begin(), c_.end(), comp_);
     return *this;
   }
 
   PriorityQueue& operator=(std::initializer_list<T> ilist) {
     c_ = ilist;
     comp_ = value_compare();
-    mystl::make_heap(c_.begin(), c_.end(), comp_);
+    HeapPolicy::make(c_.begin(), c_.end(), comp_);
     return *this;
   }
 
@@ -244,24 +244,40 @@ class PriorityQueue {
   template <typename... Args>
   void emplace(Args&&... args) {
     c_.emplace_back(mystl::forward<Args>(args)...);
-    mystl::push_heap(c_.begin(), c_.end(), comp_);
+    HeapPolicy::push(c_.begin(), c_.end(), comp_);
   }
 
   void push(const value_type& value) {
     c_.push_back(value);
-    mystl::push_heap(c_.begin(), c_.end(), comp_);
+    HeapPolicy::push(c_.begin(), c_.end(), comp_);
   }
 
   void push(value_type&& value) {
     c_.push_back(mystl::move(value));
-    mystl::push_heap(c_.begin(), c_.end(), comp_);
+    HeapPolicy::push(c_.begin(), c_.end(), comp_);
   }
 
   void pop() {
-    mystl::pop_heap(c_.begin(), c_.end(), comp_);
+    HeapPolicy::pop(c_.begin(), c_.end(), comp_);
     c_.pop_back();
   }
 
+  // 把 [first, last) 中的元素一次加入队列
+  // 新增的元素不少于原有的元素时整体重新建堆（线性时间），否则逐个上溯
+  template <typename IIter>
+  void push_range(IIter first, IIter last) {
+    const size_type old_size = c_.size();
+    c_.insert(c_.end(), first, last);
+    const size_type new_size = c_.size();
+    if (new_size - old_size >= old_size) {
+      HeapPolicy::make(c_.begin(), c_.end(), comp_);
+    } else {
+      for (size_type i = old_size + 1; i <= new_size; ++i) {
+        HeapPolicy::push(c_.begin(), c_.begin() + i, comp_);
+      }
+    }
+  }
+
   void clear() {
     while (!empty()) {
       pop();
@@ -285,22 +301,276 @@ class PriorityQueue {
 };
 
 // 重载比较操作符
-template <typename T, typename Container, typename Compare>
+template <typename T, typename Container, typename Compare, typename HeapPolicy>
 bool operator==(
-    PriorityQueue<T, Container, Compare>& lhs, PriorityQueue<T, Container, Compare>& rhs) {
+    PriorityQueue<T, Container, Compare, HeapPolicy>& lhs,
+    PriorityQueue<T, Container, Compare, HeapPolicy>& rhs) {
   return lhs == rhs;
 }
 
-template <typename T, typename Container, typename Compare>
+template <typename T, typename Container, typename Compare, typename HeapPolicy>
 bool operator!=(
-    PriorityQueue<T, Container, Compare>& lhs, PriorityQueue<T, Container, Compare>& rhs) {
+    PriorityQueue<T, Container, Compare, HeapPolicy>& lhs,
+    PriorityQueue<T, Container, Compare, HeapPolicy>& rhs) {
   return !(lhs == rhs);
 }
 
-template <typename T, typename Container, typename Compare>
+template <typename T, typename Container, typename Compare, typename HeapPolicy>
+void swap(
+    PriorityQueue<T, Container, Compare, HeapPolicy>& lhs,
+    PriorityQueue<T, Container, Compare, HeapPolicy>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+// 模板类 AddressablePriorityQueue
+// 参数一代表数据类型，参数二代表比较权值的方式，缺省使用mystl::Less作为比较方式，参数三代表堆的叉数
+// 与 PriorityQueue 相同，top() 是按 comp 最大的元素，使用 mystl::Greater 时为最小堆
+// push 返回一个句柄，元素出队或被删除之前句柄一直有效，不随元素在堆中的移动而改变，
+// 可以用它读取(value)、修改(update, decrease_key)或删除(erase)该元素，
+// 不必像 PriorityQueue 那样重复插入再跳过过期的元素（lazy deletion）
+// 实现为带下标的 D 叉堆：堆中连续存放元素与句柄，pos_ 记录每个句柄在堆中的位置，
+// 元素移动时同时更新 pos_。失效的句柄会被之后的 push 重新使用
+template <typename T, typename Compare = mystl::Less<T>, size_t D = 4>
+class AddressablePriorityQueue {
+  static_assert(D >= 2, "the arity of a heap should be at least 2");
+
+ public:
+  using value_type = T;
+  using value_compare = Compare;
+  using size_type = size_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using handle_type = size_t;
+
+  // 不对应任何元素的句柄，可用于初始化句柄数组，contains(kInvalidHandle) 总是 false
+  static constexpr handle_type kInvalidHandle = static_cast<handle_type>(-1);
+
+ private:
+  struct Node {
+    T value;
+    handle_type handle;
+  };
+
+  // 句柄已经失效时 pos_ 中的值
+  static constexpr size_type kNoPosition = static_cast<size_type>(-1);
+
+  mystl::Vector<Node> heap_;         // D 叉堆
+  mystl::Vector<size_type> pos_;     // pos_[h] 为句柄 h 在 heap_ 中的位置
+  mystl::Vector<handle_type> free_;  // 可以重新使用的句柄
+  value_compare comp_;
+
+ public:
+  // 构造、复制、移动函数
+  AddressablePriorityQueue() = default;
+
+  explicit AddressablePriorityQueue(const Compare& c) : comp_(c) {}
+
+  AddressablePriorityQueue(const AddressablePriorityQueue&) = default;
+  AddressablePriorityQueue(AddressablePriorityQueue&&) = default;
+  AddressablePriorityQueue& operator=(const AddressablePriorityQueue&) = default;
+  AddressablePriorityQueue& operator=(AddressablePriorityQueue&&) = default;
+  ~AddressablePriorityQueue() = default;
+
+ public:
+  // 访问元素相关操作
+  const_reference top() const {
+    MYSTL_DEBUG(!empty());
+    return heap_.front().value;
+  }
+
+  handle_type top_handle() const {
+    MYSTL_DEBUG(!empty());
+    return heap_.front().handle;
+  }
+
+  const_reference value(handle_type h) const {
+    MYSTL_DEBUG(contains(h));
+    return heap_[pos_[h]].value;
+  }
+
+  // 句柄 h 是否对应队列中的一个元素
+  bool contains(handle_type h) const noexcept {
+    return h < pos_.size() && pos_[h] != kNoPosition;
+  }
+
+  // 容量相关操作
+  bool empty() const noexcept { return heap_.empty(); }
+  size_type size() const noexcept { return heap_.size(); }
+
+  void reserve(size_type n) {
+    heap_.reserve(n);
+    pos_.reserve(n);
+  }
+
+  // 修改容器相关操作
+  template <typename... Args>
+  handle_type emplace(Args&&... args) {
+    const handle_type h = new_handle();
+    heap_.push_back(Node{T(mystl::forward<Args>(args)...), h});
+    sift_up(heap_.size() - 1, mystl::move(heap_.back()));
+    return h;
+  }
+
+  handle_type push(const value_type& value) { return emplace(value); }
+
+  handle_type push(value_type&& value) { return emplace(mystl::move(value)); }
+
+  void pop() {
+    MYSTL_DEBUG(!empty());
+    remove_at(0);
+  }
+
+  // 删除句柄 h 对应的元素
+  void erase(handle_type h) {
+    MYSTL_DEBUG(contains(h));
+    remove_at(pos_[h]);
+  }
+
+  // 把句柄 h 对应的元素修改为 value，根据新值向上或向下调整
+  void update(handle_type h, const value_type& value) {
+    MYSTL_DEBUG(contains(h));
+    const size_type i = pos_[h];
+    const bool up = comp_(heap_[i].value, value);
+    Node node{value, h};
+    if (up) {
+      sift_up(i, mystl::move(node));
+    } else {
+      sift_down(i, mystl::move(node));
+    }
+  }
+
+  // 把句柄 h 对应的元素修改为 value，value 不能排在原值之后（comp(value, 原值) 为 false），只需上溯
+  // 名称沿用最小堆（Compare 为 mystl::Greater）的习惯：键值减小、更早出队，如 Dijkstra 中的松弛
+  void decrease_key(handle_type h, const value_type& value) {
+    MYSTL_DEBUG(contains(h));
+    const size_type i = pos_[h];
+    MYSTL_DEBUG(!comp_(value, heap_[i].value));
+    sift_up(i, Node{value, h});
+  }
+
+  void clear() {
+    heap_.clear();
+    pos_.clear();
+    free_.clear();
+  }
+
+  void swap(AddressablePriorityQueue& rhs) noexcept {
+    heap_.swap(rhs.heap_);
+    pos_.swap(rhs.pos_);
+    free_.swap(rhs.free_);
+    mystl::swap(comp_, rhs.comp_);
+  }
+
+ private:
+  handle_type new_handle() {
+    if (!free_.empty()) {
+      const handle_type h = free_.back();
+      free_.pop_back();
+      return h;
+    }
+    pos_.push_back(kNoPosition);
+    return pos_.size() - 1;
+  }
+
+  // 删除 heap_[i]，用最后一个元素填补空位后调整
+  void remove_at(size_type i) {
+    const handle_type h = heap_[i].handle;
+    pos_[h] = kNoPosition;
+    free_.push_back(h);
+    const size_type last = heap_.size() - 1;
+    if (i == last) {
+      heap_.pop_back();
+      return;
+    }
+    Node node = mystl::move(heap_[last]);
+    heap_.pop_back();
+    if (comp_(heap_[i].value, node.value)) {
+      sift_up(i, mystl::move(node));
+    } else {
+      sift_down_to_leaf(i, mystl::move(node));
+    }
+  }
+
+  // 把 node 放到 heap_[i]，同时更新它的位置
+  void place(size_type i, Node&& node) {
+    pos_[node.handle] = i;
+    heap_[i] = mystl::move(node);
+  }
+
+  // 上溯(percolate up)：heap_[i] 为空位，为 node 找到位置
+  void sift_up(size_type i, Node node) {
+    while (i > 0) {
+      const size_type parent = (i - 1) / D;
+      if (!comp_(heap_[parent].value, node.value)) {
+        break;
+      }
+      place(i, mystl::move(heap_[parent]));
+      i = parent;
+    }
+    place(i, mystl::move(node));
+  }
+
+  // heap_[i] 的子节点中最大者的位置，没有子节点时返回 size()
+  size_type max_child(size_type i) const {
+    const size_type n = heap_.size();
+    const size_type child = D * i + 1;
+    if (child >= n) {
+      return n;
+    }
+    const size_type end = n - child > D ? child + D : n;
+    size_type best = child;
+    for (size_type c = child + 1; c < end; ++c) {
+      if (comp_(heap_[best].value, heap_[c].value)) {
+        best = c;
+      }
+    }
+    return best;
+  }
+
+  // 下溯(percolate down)：heap_[i] 为空位，node 比所有子节点都不小时停止，用于 update
+  void sift_down(size_type i, Node node) {
+    for (size_type best = max_child(i); best < heap_.size(); best = max_child(i)) {
+      if (!comp_(node.value, heap_[best].value)) {
+        break;
+      }
+      place(i, mystl::move(heap_[best]));
+      i = best;
+    }
+    place(i, mystl::move(node));
+  }
+
+  // 先把空位一直下移到叶节点，再从那里为 node 上溯，与 pop_heap 相同
+  // node 来自堆的末尾，通常会回到底部附近，这样每层只需比较 D - 1 次
+  void sift_down_to_leaf(size_type i, Node node) {
+    const size_type top = i;
+    for (size_type best = max_child(i); best < heap_.size(); best = max_child(i)) {
+      place(i, mystl::move(heap_[best]));
+      i = best;
+    }
+    while (i > top) {
+      const size_type parent = (i - 1) / D;
+      if (!comp_(heap_[parent].value, node.value)) {
+        break;
+      }
+      place(i, mystl::move(heap_[parent]));
+      i = parent;
+    }
+    place(i, mystl::move(node));
+  }
+};
+
+template <typename T, typename Compare, size_t D>
+constexpr typename AddressablePriorityQueue<T, Compare, D>::handle_type
+    AddressablePriorityQueue<T, Compare, D>::kInvalidHandle;
+
+template <typename T, typename Compare, size_t D>
+constexpr typename AddressablePriorityQueue<T, Compare, D>::size_type
+    AddressablePriorityQueue<T, Compare, D>::kNoPosition;
+
+template <typename T, typename Compare, size_t D>
 void swap(
-    PriorityQueue<T, Container, Compare>& lhs,
-    PriorityQueue<T, Container, Compare>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    AddressablePriorityQueue<T, Compare, D>& lhs,
+    AddressablePriorityQueue<T, Compare, D>& rhs) noexcept {
   lhs.swap(rhs);
 }
 
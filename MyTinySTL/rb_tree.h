@@ -6,8 +6,10 @@
 // 对应书5.2节
 
 #include <cassert>
+#include <cstdint>
 #include <initializer_list>
 #include <iostream>
+#include <utility>
 
 #include "algobase.h"
 #include "allocator.h"
@@ -15,6 +17,7 @@
 #include "functional.h"
 #include "iterator.h"
 #include "memory.h"
+#include "node_handle.h"
 #include "type_traits.h"
 
 namespace mystl {
@@ -25,17 +28,47 @@ using rb_tree_color_type = bool;
 static constexpr rb_tree_color_type kRbTreeRed = false;
 static constexpr rb_tree_color_type kRbTreeBlack = true;
 
+// 有序输入的标签，调用者保证区间已按比较准则排好序，容器直接以O(n)构造平衡树而不再检查
+// kSortedUnique表示严格递增（键值不重复），kSortedEquivalent表示非递减（键值可以重复）
+struct SortedUniqueTag {};
+struct SortedEquivalentTag {};
+
+static constexpr SortedUniqueTag kSortedUnique = SortedUniqueTag();
+static constexpr SortedEquivalentTag kSortedEquivalent = SortedEquivalentTag();
+
+// 结点布局的标签，作为RbTree的第三个模板参数
+// RbTreeDefaultNodeTag    : 默认布局
+// RbTreeOrderStatisticTag : 结点额外记录以它为根的子树的结点数，支持O(log n)的select与rank
+// RbTreeCompactNodeTag    : 颜色存放在父结点指针的最低位，每个结点比默认布局少8字节（64位平台）
+// RbTreeIntervalTag       : 键值为区间，结点额外记录子树中最大的右端点，支持区间相交查询
+struct RbTreeDefaultNodeTag {};
+struct RbTreeOrderStatisticTag {};
+struct RbTreeCompactNodeTag {};
+
+// 参数一代表区间端点的类型，参数二代表端点的比较方式，键值类型需要提供low与high两个端点
+template <typename Endpoint, typename Compare>
+struct RbTreeIntervalTag {
+  using endpoint_type = Endpoint;
+  using endpoint_compare = Compare;
+};
+
+template <typename Tag>
+struct IsRbTreeIntervalTag : mystl::m_false_type {};
+
+template <typename Endpoint, typename Compare>
+struct IsRbTreeIntervalTag<RbTreeIntervalTag<Endpoint, Compare>> : mystl::m_true_type {};
+
 // forward declaration
-template <typename T>
+template <typename T, typename Tag = RbTreeDefaultNodeTag>
 struct RbTreeNodeBase;
 
-template <typename T>
+template <typename T, typename Tag = RbTreeDefaultNodeTag>
 struct RbTreeNode;
 
-template <typename T>
+template <typename T, typename Tag = RbTreeDefaultNodeTag>
 struct RbTreeIterator;
 
-template <typename T>
+template <typename T, typename Tag = RbTreeDefaultNodeTag>
 struct RbTreeConstIterator;
 
 // rb tree value traits
@@ -109,17 +142,21 @@ struct RbTreeNodeTraits {
 };
 
 // rb tree的结点设计
-template <typename T>
+template <typename T, typename Tag>
 struct RbTreeNodeBase {
+  using tag_type = Tag;
   using color_type = rb_tree_color_type;
-  using base_ptr = RbTreeNodeBase<T>*;
-  using node_ptr = RbTreeNode<T>*;
+  using base_ptr = RbTreeNodeBase<T, Tag>*;
+  using node_ptr = RbTreeNode<T, Tag>*;
 
   base_ptr parent;   // 父结点
   base_ptr left;     // 左子结点
   base_ptr right;    // 右子结点
   color_type color;  // 结点颜色
 
+  color_type get_color() const { return color; }
+  void set_color(color_type c) { color = c; }
+
   base_ptr get_base_ptr() { return &*this; }
 
   node_ptr get_node_ptr() { return reinterpret_cast<node_ptr>(&*this); }
@@ -127,10 +164,114 @@ struct RbTreeNodeBase {
   node_ptr& get_node_ref() { return reinterpret_cast<node_ptr&>(*this); }
 };
 
+// 顺序统计布局的结点
 template <typename T>
-struct RbTreeNode : public RbTreeNodeBase<T> {
-  using base_ptr = RbTreeNodeBase<T>*;
-  using node_ptr = RbTreeNode<T>*;
+struct RbTreeNodeBase<T, RbTreeOrderStatisticTag> {
+  using tag_type = RbTreeOrderStatisticTag;
+  using color_type = rb_tree_color_type;
+  using base_ptr = RbTreeNodeBase<T, RbTreeOrderStatisticTag>*;
+  using node_ptr = RbTreeNode<T, RbTreeOrderStatisticTag>*;
+
+  base_ptr parent;   // 父结点
+  base_ptr left;     // 左子结点
+  base_ptr right;    // 右子结点
+  color_type color;  // 结点颜色
+  size_t size;       // 以该结点为根的子树的结点数
+
+  color_type get_color() const { return color; }
+  void set_color(color_type c) { color = c; }
+
+  base_ptr get_base_ptr() { return &*this; }
+
+  node_ptr get_node_ptr() { return reinterpret_cast<node_ptr>(&*this); }
+
+  node_ptr& get_node_ref() { return reinterpret_cast<node_ptr&>(*this); }
+};
+
+template <typename T, typename Endpoint, typename Compare>
+struct RbTreeNodeBase<T, RbTreeIntervalTag<Endpoint, Compare>> {
+  using tag_type = RbTreeIntervalTag<Endpoint, Compare>;
+  using color_type = rb_tree_color_type;
+  using base_ptr = RbTreeNodeBase<T, tag_type>*;
+  using node_ptr = RbTreeNode<T, tag_type>*;
+
+  base_ptr parent;    // 父结点
+  base_ptr left;      // 左子结点
+  base_ptr right;     // 右子结点
+  color_type color;   // 结点颜色
+  Endpoint max_high;  // 以该结点为根的子树中最大的右端点
+
+  color_type get_color() const { return color; }
+  void set_color(color_type c) { color = c; }
+
+  base_ptr get_base_ptr() { return &*this; }
+
+  node_ptr get_node_ptr() { return reinterpret_cast<node_ptr>(&*this); }
+
+  node_ptr& get_node_ref() { return reinterpret_cast<node_ptr&>(*this); }
+};
+
+// 最低位存放结点颜色的父结点指针
+// 结点由operator new分配，至少按指针大小对齐，地址的最低位总为0，可以借来存放颜色
+// 赋值只改变指针部分，颜色保持不变，因此x->parent = y->parent这样的语句与默认布局含义相同
+template <typename BasePtr>
+class RbTreePackedParent {
+ public:
+  using color_type = rb_tree_color_type;
+
+ private:
+  static constexpr uintptr_t kColorMask = 1;
+
+  uintptr_t bits_;
+
+ public:
+  RbTreePackedParent() = default;
+  RbTreePackedParent(const RbTreePackedParent&) = default;
+
+  RbTreePackedParent& operator=(const RbTreePackedParent& rhs) noexcept {
+    return *this = rhs.get();
+  }
+  RbTreePackedParent& operator=(BasePtr p) noexcept {
+    bits_ = reinterpret_cast<uintptr_t>(p) | (bits_ & kColorMask);
+    return *this;
+  }
+
+  BasePtr get() const noexcept { return reinterpret_cast<BasePtr>(bits_ & ~kColorMask); }
+  operator BasePtr() const noexcept { return get(); }
+  BasePtr operator->() const noexcept { return get(); }
+
+  color_type color() const noexcept { return static_cast<color_type>(bits_ & kColorMask); }
+  void set_color(color_type c) noexcept {
+    bits_ = (bits_ & ~kColorMask) | static_cast<uintptr_t>(c);
+  }
+};
+
+// 紧凑布局的结点，省去了color成员及其后的填充
+template <typename T>
+struct RbTreeNodeBase<T, RbTreeCompactNodeTag> {
+  using tag_type = RbTreeCompactNodeTag;
+  using color_type = rb_tree_color_type;
+  using base_ptr = RbTreeNodeBase<T, RbTreeCompactNodeTag>*;
+  using node_ptr = RbTreeNode<T, RbTreeCompactNodeTag>*;
+
+  RbTreePackedParent<base_ptr> parent;  // 父结点，最低位为结点颜色
+  base_ptr left;                        // 左子结点
+  base_ptr right;                       // 右子结点
+
+  color_type get_color() const { return parent.color(); }
+  void set_color(color_type c) { parent.set_color(c); }
+
+  base_ptr get_base_ptr() { return &*this; }
+
+  node_ptr get_node_ptr() { return reinterpret_cast<node_ptr>(&*this); }
+
+  node_ptr& get_node_ref() { return reinterpret_cast<node_ptr&>(*this); }
+};
+
+template <typename T, typename Tag>
+struct RbTreeNode : public RbTreeNodeBase<T, Tag> {
+  using base_ptr = RbTreeNodeBase<T, Tag>*;
+  using node_ptr = RbTreeNode<T, Tag>*;
 
   T value;
 
@@ -140,7 +281,7 @@ struct RbTreeNode : public RbTreeNodeBase<T> {
 };
 
 // rb tree traits
-template <typename T>
+template <typename T, typename Tag = RbTreeDefaultNodeTag>
 struct RbTreeTraits {
   using value_traits = RbTreeValueTraits<T>;
 
@@ -153,17 +294,17 @@ struct RbTreeTraits {
   using const_pointer = const value_type*;
   using const_reference = const value_type&;
 
-  using base_type = RbTreeNodeBase<T>;
-  using node_type = RbTreeNode<T>;
+  using base_type = RbTreeNodeBase<T, Tag>;
+  using node_type = RbTreeNode<T, Tag>;
 
   using base_ptr = base_type*;
   using node_ptr = node_type*;
 };
 
 // rb tree的迭代器设计
-template <typename T>
+template <typename T, typename Tag>
 struct RbTreeIteratorBase : public mystl::Iterator<mystl::BidirectionalIteratorTag, T> {
-  using base_ptr = typename RbTreeTraits<T>::base_ptr;
+  using base_ptr = typename RbTreeTraits<T, Tag>::base_ptr;
 
   base_ptr node;  // 指向结点本身
 
@@ -209,9 +350,9 @@ struct RbTreeIteratorBase : public mystl::Iterator<mystl::BidirectionalIteratorT
   bool operator!=(const RbTreeIteratorBase& rhs) { return node != rhs.node; }
 };
 
-template <typename T>
-struct RbTreeIterator : public RbTreeIteratorBase<T> {
-  using tree_traits = RbTreeTraits<T>;
+template <typename T, typename Tag>
+struct RbTreeIterator : public RbTreeIteratorBase<T, Tag> {
+  using tree_traits = RbTreeTraits<T, Tag>;
 
   using value_type = typename tree_traits::value_type;
   using pointer = typename tree_traits::pointer;
@@ -219,11 +360,11 @@ struct RbTreeIterator : public RbTreeIteratorBase<T> {
   using base_ptr = typename tree_traits::base_ptr;
   using node_ptr = typename tree_traits::node_ptr;
 
-  using iterator = RbTreeIterator<T>;
-  using const_iterator = RbTreeConstIterator<T>;
+  using iterator = RbTreeIterator<T, Tag>;
+  using const_iterator = RbTreeConstIterator<T, Tag>;
   using self = iterator;
 
-  using RbTreeIteratorBase<T>::node;
+  using RbTreeIteratorBase<T, Tag>::node;
 
   // 构造函数
   RbTreeIterator() {}
@@ -259,9 +400,9 @@ struct RbTreeIterator : public RbTreeIteratorBase<T> {
   }
 };
 
-template <typename T>
-struct RbTreeConstIterator : public RbTreeIteratorBase<T> {
-  using tree_traits = RbTreeTraits<T>;
+template <typename T, typename Tag>
+struct RbTreeConstIterator : public RbTreeIteratorBase<T, Tag> {
+  using tree_traits = RbTreeTraits<T, Tag>;
 
   using value_type = typename tree_traits::value_traits;
   using pointer = typename tree_traits::const_pointer;
@@ -269,11 +410,11 @@ struct RbTreeConstIterator : public RbTreeIteratorBase<T> {
   using base_ptr = typename tree_traits::base_ptr;
   using node_ptr = typename tree_traits::node_ptr;
 
-  using iterator = RbTreeIterator<T>;
-  using const_iterator = RbTreeConstIterator<T>;
+  using iterator = RbTreeIterator<T, Tag>;
+  using const_iterator = RbTreeConstIterator<T, Tag>;
   using self = const_iterator;
 
-  using RbTreeIteratorBase<T>::node;
+  using RbTreeIteratorBase<T, Tag>::node;
 
   // 构造函数
   RbTreeConstIterator() {}
@@ -334,19 +475,177 @@ bool rb_tree_is_lchild(NodePtr node) noexcept {
 
 template <typename NodePtr>
 bool rb_tree_is_red(NodePtr node) noexcept {
-  return node->color == kRbTreeRed;
+  return node->get_color() == kRbTreeRed;
 }
 
 template <typename NodePtr>
 void rb_tree_set_black(NodePtr node) noexcept {
-  node->color = kRbTreeBlack;
+  node->set_color(kRbTreeBlack);
 }
 
 template <typename NodePtr>
 void rb_tree_set_red(NodePtr node) noexcept {
-  node->color = kRbTreeRed;
+  node->set_color(kRbTreeRed);
 }
 
+// 结点附加信息的维护
+// 旋转、插入、删除会改变子树的结构，这些操作通过RbTreeNodeAugment同步更新结点上的附加信息
+// 默认布局没有附加信息，以下操作什么也不做
+template <typename Tag>
+struct RbTreeNodeAugment {
+  // 由左右子结点重新计算x的附加信息
+  template <typename NodePtr>
+  static void update(NodePtr) noexcept {}
+
+  // 复制结点时一并复制附加信息
+  template <typename NodePtr>
+  static void copy(NodePtr, NodePtr) noexcept {}
+
+  // x作为叶子结点挂到树上之后调用
+  template <typename NodePtr, typename Root>
+  static void link(NodePtr, const Root&) noexcept {}
+
+  // x即将从树上摘下之前调用
+  template <typename NodePtr, typename Root>
+  static void unlink(NodePtr, const Root&) noexcept {}
+
+  // 删除结点时，x顶替被删除结点的位置之后调用，xp为x的父结点
+  template <typename NodePtr, typename Root>
+  static void relink(NodePtr, const Root&) noexcept {}
+
+  // x的子树被整体替换之后，重新计算x及其所有祖先的附加信息
+  template <typename NodePtr, typename Root>
+  static void update_path(NodePtr, const Root&) noexcept {}
+
+  // 统计以x为根的子树的结点数，默认布局需要遍历整棵子树
+  template <typename NodePtr>
+  static size_t count(NodePtr x) noexcept {
+    size_t n = 0;
+    while (x != nullptr) {
+      n += count(x->right) + 1;
+      x = x->left;
+    }
+    return n;
+  }
+};
+
+// 顺序统计布局维护子树的结点数
+template <>
+struct RbTreeNodeAugment<RbTreeOrderStatisticTag> {
+  template <typename NodePtr>
+  static size_t size(NodePtr x) noexcept {
+    return x == nullptr ? 0 : x->size;
+  }
+
+  template <typename NodePtr>
+  static void update(NodePtr x) noexcept {
+    x->size = size(x->left) + size(x->right) + 1;
+  }
+
+  template <typename NodePtr>
+  static void copy(NodePtr dst, NodePtr src) noexcept {
+    dst->size = src->size;
+  }
+
+  // 新结点的所有祖先的子树大小加一
+  template <typename NodePtr, typename Root>
+  static void link(NodePtr x, const Root& root) noexcept {
+    x->size = 1;
+    while (x != root) {
+      x = x->parent;
+      ++x->size;
+    }
+  }
+
+  // 被摘下结点的所有祖先的子树大小减一
+  template <typename NodePtr, typename Root>
+  static void unlink(NodePtr x, const Root& root) noexcept {
+    while (x != root) {
+      x = x->parent;
+      --x->size;
+    }
+  }
+
+  // 子树大小已在unlink中更新
+  template <typename NodePtr, typename Root>
+  static void relink(NodePtr, const Root&) noexcept {}
+
+  template <typename NodePtr, typename Root>
+  static void update_path(NodePtr x, const Root& root) noexcept {
+    update(x);
+    while (x != root) {
+      x = x->parent;
+      update(x);
+    }
+  }
+
+  template <typename NodePtr>
+  static size_t count(NodePtr x) noexcept {
+    return size(x);
+  }
+};
+
+// 区间布局维护子树中最大的右端点，结点数的统计与默认布局相同
+// 删除结点时祖先的最大值可能变小，只能在结构调整之后由relink沿路径重新计算
+template <typename Endpoint, typename Compare>
+struct RbTreeNodeAugment<RbTreeIntervalTag<Endpoint, Compare>>
+    : public RbTreeNodeAugment<RbTreeDefaultNodeTag> {
+  template <typename Value>
+  static const Endpoint& high_of(const Value& value) {
+    return RbTreeValueTraits<Value>::get_key(value).high;
+  }
+
+  template <typename NodePtr>
+  static void update(NodePtr x) {
+    const Endpoint* m = &high_of(x->get_node_ptr()->value);
+    if (x->left != nullptr && Compare()(*m, x->left->max_high)) {
+      m = &x->left->max_high;
+    }
+    if (x->right != nullptr && Compare()(*m, x->right->max_high)) {
+      m = &x->right->max_high;
+    }
+    x->max_high = *m;
+  }
+
+  template <typename NodePtr>
+  static void copy(NodePtr dst, NodePtr src) {
+    dst->max_high = src->max_high;
+  }
+
+  // 新结点只会让祖先的最大值变大，遇到不小于它的祖先即可停止
+  template <typename NodePtr, typename Root>
+  static void link(NodePtr x, const Root& root) {
+    const Endpoint& high = high_of(x->get_node_ptr()->value);
+    x->max_high = high;
+    while (x != root) {
+      x = x->parent;
+      if (!Compare()(x->max_high, high)) {
+        break;
+      }
+      x->max_high = high;
+    }
+  }
+
+  template <typename NodePtr, typename Root>
+  static void relink(NodePtr xp, const Root& root) {
+    update_path(xp, root);
+  }
+
+  template <typename NodePtr, typename Root>
+  static void update_path(NodePtr x, const Root& root) {
+    update(x);
+    while (x != root) {
+      x = x->parent;
+      update(x);
+    }
+  }
+};
+
+// NodePtr可能是结点指针，也可能是紧凑布局中的RbTreePackedParent，通过left取得结点类型
+template <typename NodePtr>
+using RbTreeAugmentOf = RbTreeNodeAugment<
+    typename std::remove_pointer<decltype(std::declval<NodePtr>()->left)>::type::tag_type>;
+
 template <typename NodePtr>
 NodePtr rb_tree_next(NodePtr node) noexcept {
   if (node->right != nullptr) {
@@ -368,8 +667,8 @@ NodePtr rb_tree_next(NodePtr node) noexcept {
 |     b   c                 a   b         |
 \*---------------------------------------*/
 // 左旋，参数一为左旋点，参数二为根节点
-template <typename NodePtr>
-void rb_tree_rotate_left(NodePtr x, NodePtr& root) noexcept {
+template <typename NodePtr, typename Root>
+void rb_tree_rotate_left(NodePtr x, Root& root) noexcept {
   auto y = x->right;
   x->right = y->left;
   if (y->left != nullptr) {
@@ -391,6 +690,8 @@ void rb_tree_rotate_left(NodePtr x, NodePtr& root) noexcept {
   // 调整x与y的关系
   y->left = x;
   x->parent = y;
+  RbTreeAugmentOf<NodePtr>::update(x);
+  RbTreeAugmentOf<NodePtr>::update(y);
 }
 
 /*----------------------------------------*\
@@ -403,8 +704,8 @@ void rb_tree_rotate_left(NodePtr x, NodePtr& root) noexcept {
 |   b   c                         c   a    |
 \*----------------------------------------*/
 // 右旋，参数一为右旋点，参数二为根节点
-template <typename NodePtr>
-void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept {
+template <typename NodePtr, typename Root>
+void rb_tree_rotate_right(NodePtr x, Root& root) noexcept {
   auto y = x->left;
   x->left = y->right;
   if (y->right) {
@@ -421,9 +722,13 @@ void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept {
   }
   y->right = x;
   x->parent = y;
+  RbTreeAugmentOf<NodePtr>::update(x);
+  RbTreeAugmentOf<NodePtr>::update(y);
 }
 
-// 插入节点后使 rb tree 重新平衡，参数一为新增节点，参数二为根节点
+// 把x染红后自下而上消除连续的红结点，参数一为当前节点，参数二为根节点
+// x的左右子树必须是黑高相等的合法红黑树，插入新节点与拼接两棵树都以此恢复平衡
+// 返回值表示根结点是否由红转黑，此时整棵树的黑高加一
 //
 // case 1: 新增节点位于根节点，令新增节点为黑
 // case 2: 新增节点的父节点为黑，没有破坏平衡，直接返回
@@ -436,8 +741,8 @@ void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept {
 //
 // 参考博客: http://blog.csdn.net/v_JULY_v/article/details/6105630
 //          http://blog.csdn.net/v_JULY_v/article/details/6109153
-template <typename NodePtr>
-void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept {
+template <typename NodePtr, typename Root>
+bool rb_tree_insert_fixup(NodePtr x, Root& root) noexcept {
   rb_tree_set_red(x);  // 新增结点为红色
   while (x != root && rb_tree_is_red(x->parent)) {
     if (rb_tree_is_lchild(x->parent)) {
@@ -486,7 +791,16 @@ void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept {
       }
     }
   }
+  const bool grown = rb_tree_is_red(root);
   rb_tree_set_black(root);  // 根结点永远为黑
+  return grown;
+}
+
+// 插入节点后使 rb tree 重新平衡，参数一为新增节点，参数二为根节点
+template <typename NodePtr, typename Root>
+void rb_tree_insert_rebalance(NodePtr x, Root& root) noexcept {
+  RbTreeAugmentOf<NodePtr>::link(x, root);
+  rb_tree_insert_fixup(x, root);
 }
 
 // 删除节点后使 rb tree
@@ -494,10 +808,12 @@ void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept {
 //
 // 参考博客: http://blog.csdn.net/v_JULY_v/article/details/6105630
 //          http://blog.csdn.net/v_JULY_v/article/details/6109153
-template <typename NodePtr>
-NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, NodePtr& rightmost) {
+template <typename NodePtr, typename Root>
+NodePtr rb_tree_erase_rebalance(NodePtr z, Root& root, NodePtr& leftmost, NodePtr& rightmost) {
   // y是可能的替换结点，指向最终要删除的结点
   auto y = (z->left == nullptr || z->right == nullptr) ? z : rb_tree_next(z);
+  // y的位置上少了一个结点，趁树的结构还未改变时更新它的所有祖先
+  RbTreeAugmentOf<NodePtr>::unlink(y, root);
   // x是y的一个独子结点或NIL结点
   auto x = y->left != nullptr ? y->left : y->right;
   // xp为x的父结点
@@ -533,7 +849,10 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
       z->parent->right = y;
     }
     y->parent = z->parent;
-    mystl::swap(y->color, z->color);
+    auto color = y->get_color();
+    y->set_color(z->get_color());
+    z->set_color(color);
+    RbTreeAugmentOf<NodePtr>::update(y);
     y = z;
   } else {
     // y == z说明z至多只有一个孩子
@@ -559,6 +878,10 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
       rightmost = x == nullptr ? xp : rb_tree_max(x);
     }
   }
+  // x成为根结点时没有需要更新的祖先
+  if (x != root) {
+    RbTreeAugmentOf<NodePtr>::relink(xp, root);
+  }
 
   // 此时，y 指向要删除的节点，x 为替代节点，从 x 节点开始调整。
   // 如果删除的节点为红色，树的性质没有被破坏，否则按照以下情况调整（x 为左子节点为例）：
@@ -601,7 +924,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
             brother = xp->right;
           }
           // 转为case 4
-          brother->color = xp->color;
+          brother->set_color(xp->get_color());
           rb_tree_set_black(xp);
           if (brother->right != nullptr) {
             rb_tree_set_black(brother->right);
@@ -636,7 +959,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
             brother = xp->left;
           }
           // 转为case 4
-          brother->color = xp->color;
+          brother->set_color(xp->get_color());
           rb_tree_set_black(xp);
           if (brother->left != nullptr) {
             rb_tree_set_black(brother->left);
@@ -654,12 +977,15 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 }
 
 // 模板类rb_tree
-// 参数一代表数据类型，参数二代表键值比较类型
-template <typename T, typename Compare>
+// 参数一代表数据类型，参数二代表键值比较类型，参数三代表结点布局
+template <typename T, typename Compare, typename Tag = RbTreeDefaultNodeTag>
 class RbTree {
+  template <typename, typename, typename>
+  friend class RbTree;
+
  public:
   // RbTree的嵌套型别定义
-  using tree_traits = RbTreeTraits<T>;
+  using tree_traits = RbTreeTraits<T, Tag>;
   using value_traits = RbTreeValueTraits<T>;
 
   using base_type = typename tree_traits::base_type;
@@ -683,11 +1009,13 @@ class RbTree {
   using size_type = typename allocator_type::size_type;
   using difference_type = typename allocator_type::difference_type;
 
-  using iterator = RbTreeIterator<T>;
-  using const_iterator = RbTreeConstIterator<T>;
+  using iterator = RbTreeIterator<T, Tag>;
+  using const_iterator = RbTreeConstIterator<T, Tag>;
   using reverse_iterator = mystl::ReverseIterator<iterator>;
   using const_reverse_iterator = mystl::ReverseIterator<const_iterator>;
 
+  using node_handle = mystl::NodeHandle<T, node_type>;
+
   allocator_type get_allocator() const { return node_allocator(); }
   key_compare key_comp() const { return key_comp_; }
 
@@ -699,7 +1027,9 @@ class RbTree {
 
  private:
   // 以下三个函数用于取得根结点，最小结点和最大结点
-  base_ptr& root() const { return header_->parent; }
+  // 紧凑布局中header_->parent的类型为RbTreePackedParent，root()返回它的引用
+  using root_type = decltype(base_type::parent);
+  root_type& root() const { return header_->parent; }
   base_ptr& leftmost() const { return header_->left; }
   base_ptr& rightmost() const { return header_->right; }
 
@@ -713,7 +1043,10 @@ class RbTree {
   RbTree& operator=(const RbTree& rhs);
   RbTree& operator=(RbTree&& rhs);
 
-  ~RbTree() { clear(); }
+  ~RbTree() {
+    clear();
+    base_allocator::deallocate(header_);
+  }
 
  public:
   // 迭代器相关操作
@@ -762,10 +1095,15 @@ class RbTree {
     return emplace_multi_use_hint(hint, mystl::move(value));
   }
 
+  // 空树插入有序区间时直接以O(n)构造平衡树，否则逐个插入
   template <typename InputIterator>
   void insert_multi(InputIterator first, InputIterator last) {
     size_type n = mystl::distance(first, last);
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "RbTree<T, Comp>'s size too big");
+    if (node_count_ == 0 && is_sorted_keys(first, last, false)) {
+      assign_sorted(first, last);
+      return;
+    }
     for (; n > 0; --n, ++first) {
       insert_multi(end(), *first);
     }
@@ -787,6 +1125,10 @@ class RbTree {
   void insert_unique(InputIterator first, InputIterator last) {
     size_type n = mystl::distance(first, last);
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - n, "RbTree<T, Comp>'s size too big");
+    if (node_count_ == 0 && is_sorted_keys(first, last, true)) {
+      assign_sorted(first, last);
+      return;
+    }
     for (; n > 0; --n, ++first) {
       insert_unique(end(), *first);
     }
@@ -802,43 +1144,141 @@ class RbTree {
 
   void clear();
 
+  // try_emplace，键值已存在时不会构造新结点，args也不会被移动
+  template <typename K, typename... Args>
+  mystl::pair<iterator, bool> try_emplace_unique(K&& key, Args&&... args);
+  template <typename K, typename... Args>
+  iterator try_emplace_unique_use_hint(iterator hint, K&& key, Args&&... args);
+
+  // 结点句柄相关操作，结点在容器之间转移时不会重新分配内存
+  node_handle extract(iterator position) { return node_handle(unlink_node(position.node)); }
+
+  iterator insert_node_multi(node_handle&& nh);
+  iterator insert_node_multi(iterator hint, node_handle&& nh);
+
+  // 插入失败时nh仍然持有原来的结点
+  mystl::pair<iterator, bool> insert_node_unique(node_handle& nh);
+  mystl::pair<iterator, bool> insert_node_unique(iterator hint, node_handle& nh);
+
+  // 以已排好序的区间替换树中的所有元素，以O(n)直接构造平衡树，不做任何比较
+  template <typename InputIterator>
+  void assign_sorted(InputIterator first, InputIterator last);
+
+  // 把source中的结点转移到当前容器，merge_unique不转移键值已存在的结点
+  // 比较准则相同且两棵树规模相当时，以O(n + m)的线性归并代替逐个插入
+  template <typename Compare2>
+  void merge_multi(RbTree<T, Compare2, Tag>& source);
+  template <typename Compare2>
+  void merge_unique(RbTree<T, Compare2, Tag>& source);
+  void merge_multi(RbTree& source);
+  void merge_unique(RbTree& source);
+
+  // 分裂与拼接，只沿O(log n)条路径重新链接结点，不逐个插入删除，也不分配或释放内存
+  // split把键值不小于key的元素移到right中，join把right的元素全部接到当前树的末尾，
+  // 要求right中的键值都不小于当前树中的键值，extract_range把[first, last)移到out中
+  // 除RbTreeOrderStatisticTag布局外，移出部分的元素个数需要遍历一次移出的结点才能得到
+  template <typename K>
+  void split(const K& key, RbTree& right);
+  void join(RbTree& right);
+  void extract_range(iterator first, iterator last, RbTree& out);
+
   // rb_tree相关操作
-  iterator find(const key_type& key);
-  const_iterator find(const key_type& key) const;
+  // 查找函数均以模板参数K接受键值，K通常为key_type，当key_compare为透明比较器时，
+  // 上层容器允许传入任意可与key_type比较的类型，从而避免构造临时的key_type
+  template <typename K>
+  iterator find(const K& key) {
+    return find_node(key);
+  }
+  template <typename K>
+  const_iterator find(const K& key) const {
+    return find_node(key);
+  }
 
-  size_type count_multi(const key_type& key) const {
+  template <typename K>
+  size_type count_multi(const K& key) const {
     auto p = equal_range_multi(key);
     return static_cast<size_type>(mystl::distance(p.first, p.second));
   }
-  size_type count_unique(const key_type& key) const { return find(key) != end() ? 1 : 0; }
+  template <typename K>
+  size_type count_unique(const K& key) const {
+    return find_node(key) != header_ ? 1 : 0;
+  }
 
-  iterator lower_bound(const key_type& key);
-  const_iterator lower_bound(const key_type& key) const;
+  template <typename K>
+  iterator lower_bound(const K& key) {
+    return lower_bound_node(key);
+  }
+  template <typename K>
+  const_iterator lower_bound(const K& key) const {
+    return lower_bound_node(key);
+  }
 
-  iterator upper_bound(const key_type& key);
-  const_iterator upper_bound(const key_type& key) const;
+  template <typename K>
+  iterator upper_bound(const K& key) {
+    return upper_bound_node(key);
+  }
+  template <typename K>
+  const_iterator upper_bound(const K& key) const {
+    return upper_bound_node(key);
+  }
 
-  mystl::pair<iterator, iterator> equal_range_multi(const key_type& key) {
+  template <typename K>
+  mystl::pair<iterator, iterator> equal_range_multi(const K& key) {
     return mystl::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
   }
-  mystl::pair<const_iterator, const_iterator> equal_range_multi(const key_type& key) const {
+  template <typename K>
+  mystl::pair<const_iterator, const_iterator> equal_range_multi(const K& key) const {
     return mystl::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
   }
 
-  mystl::pair<iterator, iterator> equal_range_unique(const key_type& key) {
+  template <typename K>
+  mystl::pair<iterator, iterator> equal_range_unique(const K& key) {
     iterator it = find(key);
     auto next = it;
     return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
   }
-  mystl::pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const {
-    iterator it = find(key);
+  template <typename K>
+  mystl::pair<const_iterator, const_iterator> equal_range_unique(const K& key) const {
+    const_iterator it = find(key);
     auto next = it;
     return it == end() ? mystl::make_pair(it, it) : mystl::make_pair(it, ++next);
   }
 
+  // 顺序统计，只有结点布局为RbTreeOrderStatisticTag时可用，时间复杂度为O(log n)
+  // select返回第k小的元素（k从0开始），k不小于size()时返回end()
+  // rank返回键值小于key的元素个数
+  iterator select(size_type k) { return select_node(k); }
+  const_iterator select(size_type k) const { return select_node(k); }
+
+  template <typename K>
+  size_type rank(const K& key) const;
+
+  // 区间查询，只有结点布局为RbTreeIntervalTag时可用，键值代表闭区间[key.low, key.high]
+  // find_overlap返回按键值顺序第一个与[low, high]相交的区间，不存在时返回end()，复杂度O(log n)
+  // for_each_overlap按键值顺序对每个相交的区间调用f(iterator)，只进入含有相交区间的子树，
+  // f中不能插入或删除元素
+  template <typename E>
+  iterator find_overlap(const E& low, const E& high) {
+    return find_overlap_node(low, high);
+  }
+  template <typename E>
+  const_iterator find_overlap(const E& low, const E& high) const {
+    return find_overlap_node(low, high);
+  }
+  template <typename E, typename Function>
+  void for_each_overlap(const E& low, const E& high, Function f) {
+    visit_overlap<iterator>(root(), low, high, f);
+  }
+  template <typename E, typename Function>
+  void for_each_overlap(const E& low, const E& high, Function f) const {
+    visit_overlap<const_iterator>(root(), low, high, f);
+  }
+
   void swap(RbTree& rhs) noexcept;
 
  private:
+  using augment = RbTreeNodeAugment<Tag>;
+
   // node related
   template <typename... Args>
   node_ptr create_node(Args&&... args);
@@ -853,22 +1293,84 @@ class RbTree {
   mystl::pair<base_ptr, bool> get_insert_multi_pos(const key_type& key);
   mystl::pair<mystl::pair<base_ptr, bool>, bool> get_insert_unique_pos(const key_type& key);
 
-  // insert value / insert node
+  // get insert pos use hint
+  mystl::pair<base_ptr, bool> get_insert_multi_pos_use_hint(iterator hint, const key_type& key);
+  mystl::pair<mystl::pair<base_ptr, bool>, bool> get_insert_unique_pos_use_hint(
+      iterator hint, const key_type& key);
+
+  // insert value / insert node / unlink node
   iterator insert_value_at(base_ptr x, const value_type& value, bool add_to_left);
   iterator insert_node_at(base_ptr x, node_ptr node, bool add_to_left);
-
-  // insert use hint
-  iterator insert_multi_use_hint(iterator hint, key_type key, node_ptr node);
-  iterator insert_unique_use_hint(iterator hint, key_type key, node_ptr node);
+  node_ptr unlink_node(base_ptr x);
+
+  // lookup
+  template <typename K>
+  base_ptr find_node(const K& key) const;
+  template <typename K>
+  base_ptr lower_bound_node(const K& key) const;
+  template <typename K>
+  base_ptr upper_bound_node(const K& key) const;
+  base_ptr select_node(size_type k) const;
+  template <typename E>
+  base_ptr find_overlap_node(const E& low, const E& high) const;
+  template <typename Iter, typename E, typename Function>
+  void visit_overlap(base_ptr x, const E& low, const E& high, Function& f) const;
 
   // copy tree / erase tree
   base_ptr copy_from(base_ptr x, base_ptr p);
-  void erase_since(base_ptr x);
+  size_type erase_since(base_ptr x);
+
+  // split / join
+  // 一棵独立的子树及其黑高，根结点的父指针没有意义
+  struct SubTree {
+    base_ptr root;
+    size_type black_height;
+  };
+
+  static size_type black_height(base_ptr x) noexcept;
+  static SubTree join_subtree(SubTree left, base_ptr mid, SubTree right) noexcept;
+  static void split_at(base_ptr root, base_ptr p, SubTree& left, SubTree& right) noexcept;
+  base_ptr cut_range(base_ptr first, base_ptr last) noexcept;
+  void assign_subtree(base_ptr x, size_type n) noexcept;
+  void swap_nodes(RbTree& rhs) noexcept {
+    mystl::swap(header_, rhs.header_);
+    mystl::swap(node_count_, rhs.node_count_);
+  }
+
+  // bulk build
+  // 以下两种结点来源供build_balanced按中序依次取出结点
+  template <typename InputIterator>
+  struct RangeNodeSource {
+    RbTree* tree;
+    InputIterator first;
+    node_ptr next_node() {
+      node_ptr np = tree->create_node(*first);
+      ++first;
+      return np;
+    }
+  };
+  struct ListNodeSource {
+    base_ptr head;  // 以right相连的结点链表
+    node_ptr next_node() {
+      base_ptr x = head;
+      head = head->right;
+      return x->get_node_ptr();
+    }
+  };
+
+  template <typename InputIterator>
+  bool is_sorted_keys(InputIterator first, InputIterator last, bool strict) const;
+  template <typename NodeSource>
+  base_ptr build_balanced(NodeSource& source, size_type n, size_type depth, size_type red_depth);
+  template <typename NodeSource>
+  void build_tree(NodeSource& source, size_type n);
+  base_ptr flatten(base_ptr x, base_ptr head);
+  bool prefer_linear_merge(size_type m) const;
 };
 
 // 复制构造函数
-template <typename T, typename Compare>
-RbTree<T, Compare>::RbTree(const RbTree& rhs) {
+template <typename T, typename Compare, typename Tag>
+RbTree<T, Compare, Tag>::RbTree(const RbTree& rhs) {
   rb_tree_init();
   if (rhs.node_count_ != 0) {
     root() = copy_from(rhs.root(), header_);
@@ -880,15 +1382,15 @@ RbTree<T, Compare>::RbTree(const RbTree& rhs) {
 }
 
 // 移动构造函数
-template <typename T, typename Compare>
-RbTree<T, Compare>::RbTree(RbTree&& rhs) noexcept
+template <typename T, typename Compare, typename Tag>
+RbTree<T, Compare, Tag>::RbTree(RbTree&& rhs) noexcept
     : header_(mystl::move(rhs.header_)), node_count_(rhs.node_count_), key_comp_(rhs.key_comp_) {
   rhs.reset();
 }
 
 // 复制赋值操作符
-template <typename T, typename Compare>
-RbTree<T, Compare>& RbTree<T, Compare>::operator=(const RbTree& rhs) {
+template <typename T, typename Compare, typename Tag>
+RbTree<T, Compare, Tag>& RbTree<T, Compare, Tag>::operator=(const RbTree& rhs) {
   if (this != &rhs) {
     clear();
 
@@ -905,9 +1407,10 @@ RbTree<T, Compare>& RbTree<T, Compare>::operator=(const RbTree& rhs) {
 }
 
 // 移动赋值操作符
-template <typename T, typename Compare>
-RbTree<T, Compare>& RbTree<T, Compare>::operator=(RbTree&& rhs) {
+template <typename T, typename Compare, typename Tag>
+RbTree<T, Compare, Tag>& RbTree<T, Compare, Tag>::operator=(RbTree&& rhs) {
   clear();
+  base_allocator::deallocate(header_);
   header_ = mystl::move(rhs.header_);
   node_count_ = rhs.node_count_;
   key_comp_ = rhs.key_comp_;
@@ -916,9 +1419,9 @@ RbTree<T, Compare>& RbTree<T, Compare>::operator=(RbTree&& rhs) {
 }
 
 // 就地插入元素，键值允许重复
-template <typename T, typename Compare>
+template <typename T, typename Compare, typename Tag>
 template <typename... Args>
-typename RbTree<T, Compare>::iterator RbTree<T, Compare>::emplace_multi(Args&&... args) {
+typename RbTree<T, Compare, Tag>::iterator RbTree<T, Compare, Tag>::emplace_multi(Args&&... args) {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "RbTree<T, Comp>'s size too big");
   node_ptr np = create_node(mystl::forward<Args>(args)...);
   auto res = get_insert_multi_pos(value_traits::get_key(np->value));
@@ -926,10 +1429,10 @@ typename RbTree<T, Compare>::iterator RbTree<T, Compare>::emplace_multi(Args&&..
 }
 
 // 就地插入元素，键值不允许重复
-template <typename T, typename Compare>
+template <typename T, typename Compare, typename Tag>
 template <typename... Args>
-mystl::pair<typename RbTree<T, Compare>::iterator, bool> RbTree<T, Compare>::emplace_unique(
-    Args&&... args) {
+mystl::pair<typename RbTree<T, Compare, Tag>::iterator, bool>
+RbTree<T, Compare, Tag>::emplace_unique(Args&&... args) {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "RbTree<T, Comp>'s size too big");
   node_ptr np = create_node(mystl::forward<Args>(args)...);
   auto res = get_insert_unique_pos(value_traits::get_key(np->value));
@@ -942,87 +1445,44 @@ mystl::pair<typename RbTree<T, Compare>::iterator, bool> RbTree<T, Compare>::emp
 }
 
 // 就地插入元素，键值允许重复，当hint位置与插入位置接近时，，插入操作的时间复杂度可以降低
-template <typename T, typename Compare>
+template <typename T, typename Compare, typename Tag>
 template <typename... Args>
-typename RbTree<T, Compare>::iterator RbTree<T, Compare>::emplace_multi_use_hint(
+typename RbTree<T, Compare, Tag>::iterator RbTree<T, Compare, Tag>::emplace_multi_use_hint(
     iterator hint, Args&&... args) {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "RbTree<T, Comp>'s size too big");
   node_ptr np = create_node(mystl::forward<Args>(args)...);
-  if (node_count_ == 0) {
-    return insert_node_at(header_, np, true);
-  }
-  key_type key = value_traits::get_key(np->value);
-  if (hint == begin()) {
-    // 位于begin处
-    if (key_comp_(key, value_traits::get_key(*hint))) {
-      return insert_node_at(hint.node, np, true);
-    } else {
-      auto pos = get_insert_multi_pos(key);
-      return insert_node_at(pos.first, np, pos.second);
-    }
-  } else if (hint == end()) {
-    // 位于end处
-    if (!key_comp_(key, value_traits::get_key(rightmost()->get_node_ptr()->value))) {
-      return insert_node_at(rightmost(), np, false);
-    } else {
-      auto pos = get_insert_multi_pos(key);
-      return insert_node_at(pos.first, np, pos.second);
-    }
-  }
-  return insert_multi_use_hint(hint, key, np);
+  auto pos = get_insert_multi_pos_use_hint(hint, value_traits::get_key(np->value));
+  return insert_node_at(pos.first, np, pos.second);
 }
 
 // 就地插入元素，键值不允许重复，当hint位置与插入位置接近时，插入操作的时间复杂度可以降低
-template <typename T, typename Compare>
+template <typename T, typename Compare, typename Tag>
 template <typename... Args>
-typename RbTree<T, Compare>::iterator RbTree<T, Compare>::emplace_unique_use_hint(
+typename RbTree<T, Compare, Tag>::iterator RbTree<T, Compare, Tag>::emplace_unique_use_hint(
     iterator hint, Args&&... args) {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "RbTree<T, Comp>'s size too big");
   node_ptr np = create_node(mystl::forward<Args>(args)...);
-  if (node_count_ == 0) {
-    return insert_node_at(header_, np, true);
-  }
-  key_type key = value_traits::get_key(np->value);
-  if (hint == begin()) {
-    // 位于begin处
-    if (key_comp_(key, value_traits::get_key(*hint))) {
-      return insert_node_at(hint.node, np, true);
-    } else {
-      auto pos = get_insert_unique_pos(key);
-      if (!pos.second) {
-        destroy_node(np);
-        return pos.first.first;
-      }
-      return insert_node_at(pos.first.first, np, pos.first.second);
-    }
-  } else if (hint == end()) {
-    // 位于end处
-    if (key_comp_(value_traits::get_key(rightmost()->get_node_ptr()->value), key)) {
-      return insert_node_at(rightmost(), np, false);
-    } else {
-      auto pos = get_insert_unique_pos(key);
-      if (!pos.second) {
-        destroy_node(np);
-        return pos.first.first;
-      }
-      return insert_node_at(pos.first.first, np, pos.first.second);
-    }
+  auto pos = get_insert_unique_pos_use_hint(hint, value_traits::get_key(np->value));
+  if (!pos.second) {
+    destroy_node(np);
+    return pos.first.first;
   }
-  return insert_unique_use_hint(hint, key, np);
+  return insert_node_at(pos.first.first, np, pos.first.second);
 }
 
 // 插入元素，结点键值允许重复
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::iterator RbTree<T, Compare>::insert_multi(const value_type& value) {
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::iterator RbTree<T, Compare, Tag>::insert_multi(
+    const value_type& value) {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "RbTree<T, Comp>'s size too big");
   auto res = get_insert_multi_pos(value_traits::get_key(value));
   return insert_value_at(res.first, value, res.second);
 }
 
 // 插入新值，结点键值不允许重复，返回一个pair，若插入成功，pair的第二个参数为true，否则为false
-template <typename T, typename Compare>
-mystl::pair<typename RbTree<T, Compare>::iterator, bool> RbTree<T, Compare>::insert_unique(
-    const value_type& value) {
+template <typename T, typename Compare, typename Tag>
+mystl::pair<typename RbTree<T, Compare, Tag>::iterator, bool>
+RbTree<T, Compare, Tag>::insert_unique(const value_type& value) {
   THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "RbTree<T, Comp>'s size too big");
   auto res = get_insert_unique_pos(value_traits::get_key(value));
   if (res.second) {
@@ -1033,20 +1493,18 @@ mystl::pair<typename RbTree<T, Compare>::iterator, bool> RbTree<T, Compare>::ins
 }
 
 // 删除hint位置的结点
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::iterator RbTree<T, Compare>::erase(iterator hint) {
-  auto node = hint.node->get_node_ptr();
-  iterator next(node);
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::iterator RbTree<T, Compare, Tag>::erase(iterator hint) {
+  iterator next(hint.node);
   ++next;
-  rb_tree_erase_rebalance(hint.node, root(), leftmost(), rightmost());
-  destroy_node(node);
-  --node_count_;
+  destroy_node(unlink_node(hint.node));
   return next;
 }
 
 // 删除键值等于key的元素，返回删除的个数
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::size_type RbTree<T, Compare>::erase_multi(const key_type& key) {
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::size_type RbTree<T, Compare, Tag>::erase_multi(
+    const key_type& key) {
   auto p = equal_range_multi(key);
   size_type n = mystl::distance(p.first, p.second);
   erase(p.first, p.second);
@@ -1054,8 +1512,9 @@ typename RbTree<T, Compare>::size_type RbTree<T, Compare>::erase_multi(const key
 }
 
 // 删除键值等于key的元素，返回删除的个数
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::size_type RbTree<T, Compare>::erase_unique(const key_type& key) {
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::size_type RbTree<T, Compare, Tag>::erase_unique(
+    const key_type& key) {
   auto it = find(key);
   if (it != end()) {
     erase(it);
@@ -1065,20 +1524,30 @@ typename RbTree<T, Compare>::size_type RbTree<T, Compare>::erase_unique(const ke
 }
 
 // 删除[first, last)区间内的元素
-template <typename T, typename Compare>
-void RbTree<T, Compare>::erase(iterator first, iterator last) {
+template <typename T, typename Compare, typename Tag>
+void RbTree<T, Compare, Tag>::erase(iterator first, iterator last) {
   if (first == begin() && last == end()) {
     clear();
-  } else {
+    return;
+  }
+  // 区间较短时逐个删除，否则把整个区间从树上切下后直接销毁，不再逐个调整平衡
+  const size_type kEraseOneByOneLimit = 16;
+  iterator it = first;
+  for (size_type n = 0; it != last && n < kEraseOneByOneLimit; ++n) {
+    ++it;
+  }
+  if (it == last) {
     while (first != last) {
       erase(first++);
     }
+  } else {
+    node_count_ -= erase_since(cut_range(first.node, last.node));
   }
 }
 
 // 清空RbTree
-template <typename T, typename Compare>
-void RbTree<T, Compare>::clear() {
+template <typename T, typename Compare, typename Tag>
+void RbTree<T, Compare, Tag>::clear() {
   if (node_count_ != 0) {
     erase_since(root());
     leftmost() = header_;
@@ -1088,117 +1557,213 @@ void RbTree<T, Compare>::clear() {
   }
 }
 
-// 查找键值为key的结点，返回指向它的迭代器
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::iterator RbTree<T, Compare>::find(const key_type& key) {
-  auto y = header_;  // 最后一个不小于key的结点
-  auto x = root();
-  while (x != nullptr) {
-    if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
-      // key小于等于x键值，向左走
-      y = x;
-      x = x->left;
-    } else {
-      // key大于x键值，向右走
-      x = x->right;
-    }
+// 键值不存在时才以key与args构造新结点，否则什么也不做
+template <typename T, typename Compare, typename Tag>
+template <typename K, typename... Args>
+mystl::pair<typename RbTree<T, Compare, Tag>::iterator, bool>
+RbTree<T, Compare, Tag>::try_emplace_unique(K&& key, Args&&... args) {
+  auto pos = get_insert_unique_pos(key);
+  if (!pos.second) {
+    return mystl::make_pair(iterator(pos.first.first), false);
   }
-  iterator j = iterator(y);
-  return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "RbTree<T, Comp>'s size too big");
+  node_ptr np = create_node(
+      PiecewiseConstructTag(), mystl::forward<K>(key), mystl::forward<Args>(args)...);
+  return mystl::make_pair(insert_node_at(pos.first.first, np, pos.first.second), true);
 }
 
-// 查找键值为key的结点，返回指向它的迭代器
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::const_iterator RbTree<T, Compare>::find(const key_type& key) const {
-  auto y = header_;  // 最后一个不小于key的结点
-  auto x = root();
-  while (x != nullptr) {
-    if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
-      // key小于等于x键值，向左走
-      y = x;
-      x = x->left;
-    } else {
-      // key大于x键值，向右走
-      x = x->right;
-    }
+template <typename T, typename Compare, typename Tag>
+template <typename K, typename... Args>
+typename RbTree<T, Compare, Tag>::iterator RbTree<T, Compare, Tag>::try_emplace_unique_use_hint(
+    iterator hint, K&& key, Args&&... args) {
+  auto pos = get_insert_unique_pos_use_hint(hint, key);
+  if (!pos.second) {
+    return pos.first.first;
+  }
+  THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1, "RbTree<T, Comp>'s size too big");
+  node_ptr np = create_node(
+      PiecewiseConstructTag(), mystl::forward<K>(key), mystl::forward<Args>(args)...);
+  return insert_node_at(pos.first.first, np, pos.first.second);
+}
+
+// 插入结点句柄所持有的结点，键值允许重复
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::iterator RbTree<T, Compare, Tag>::insert_node_multi(
+    node_handle&& nh) {
+  if (nh.empty()) {
+    return end();
   }
-  const_iterator j = const_iterator(y);
-  return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
+  auto pos = get_insert_multi_pos(value_traits::get_key(nh.value()));
+  return insert_node_at(pos.first, nh.release(), pos.second);
 }
 
-// 键值不小于key的第一个位置
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::iterator RbTree<T, Compare>::lower_bound(const key_type& key) {
-  auto y = header_;
-  auto x = root();
-  while (x != nullptr) {
-    if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
-      // key <= x
-      y = x;
-      x = x->left;
-    } else {
-      x = x->right;
-    }
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::iterator RbTree<T, Compare, Tag>::insert_node_multi(
+    iterator hint, node_handle&& nh) {
+  if (nh.empty()) {
+    return end();
   }
-  return iterator(y);
+  auto pos = get_insert_multi_pos_use_hint(hint, value_traits::get_key(nh.value()));
+  return insert_node_at(pos.first, nh.release(), pos.second);
 }
 
-// 键值不小于key的第一个位置
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::const_iterator RbTree<T, Compare>::lower_bound(
-    const key_type& key) const {
-  auto y = header_;
-  auto x = root();
-  while (x != nullptr) {
-    if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
-      // key <= x
-      y = x;
-      x = x->left;
+// 插入结点句柄所持有的结点，键值不允许重复
+template <typename T, typename Compare, typename Tag>
+mystl::pair<typename RbTree<T, Compare, Tag>::iterator, bool>
+RbTree<T, Compare, Tag>::insert_node_unique(node_handle& nh) {
+  if (nh.empty()) {
+    return mystl::make_pair(end(), false);
+  }
+  auto pos = get_insert_unique_pos(value_traits::get_key(nh.value()));
+  if (!pos.second) {
+    return mystl::make_pair(iterator(pos.first.first), false);
+  }
+  return mystl::make_pair(insert_node_at(pos.first.first, nh.release(), pos.first.second), true);
+}
+
+template <typename T, typename Compare, typename Tag>
+mystl::pair<typename RbTree<T, Compare, Tag>::iterator, bool>
+RbTree<T, Compare, Tag>::insert_node_unique(iterator hint, node_handle& nh) {
+  if (nh.empty()) {
+    return mystl::make_pair(end(), false);
+  }
+  auto pos = get_insert_unique_pos_use_hint(hint, value_traits::get_key(nh.value()));
+  if (!pos.second) {
+    return mystl::make_pair(iterator(pos.first.first), false);
+  }
+  return mystl::make_pair(insert_node_at(pos.first.first, nh.release(), pos.first.second), true);
+}
+
+// 以有序区间[first, last)重建整棵树
+template <typename T, typename Compare, typename Tag>
+template <typename InputIterator>
+void RbTree<T, Compare, Tag>::assign_sorted(InputIterator first, InputIterator last) {
+  clear();
+  const auto n = static_cast<size_type>(mystl::distance(first, last));
+  THROW_LENGTH_ERROR_IF(n > max_size(), "RbTree<T, Comp>'s size too big");
+  RangeNodeSource<InputIterator> source{this, first};
+  build_tree(source, n);
+}
+
+// 比较准则相同时，两棵树先各自串成有序链表，归并后再以O(n + m)重建
+template <typename T, typename Compare, typename Tag>
+void RbTree<T, Compare, Tag>::merge_multi(RbTree& source) {
+  if (&source == this || source.node_count_ == 0) {
+    return;
+  }
+  if (!prefer_linear_merge(source.node_count_)) {
+    merge_multi<Compare>(source);
+    return;
+  }
+  THROW_LENGTH_ERROR_IF(
+      node_count_ > max_size() - source.node_count_, "RbTree<T, Comp>'s size too big");
+  base_ptr lhs = flatten(root(), nullptr);
+  base_ptr rhs = source.flatten(source.root(), nullptr);
+  const size_type n = node_count_ + source.node_count_;
+  base_type dummy;
+  base_ptr tail = &dummy;
+  while (lhs != nullptr && rhs != nullptr) {
+    // 键值相等时当前树的结点在前
+    if (key_comp_(
+            value_traits::get_key(rhs->get_node_ptr()->value),
+            value_traits::get_key(lhs->get_node_ptr()->value))) {
+      tail->right = rhs;
+      rhs = rhs->right;
     } else {
-      x = x->right;
+      tail->right = lhs;
+      lhs = lhs->right;
     }
+    tail = tail->right;
   }
-  return const_iterator(y);
+  tail->right = lhs != nullptr ? lhs : rhs;
+  ListNodeSource merged{dummy.right};
+  build_tree(merged, n);
+  ListNodeSource empty{nullptr};
+  source.build_tree(empty, 0);
 }
 
-// 键值不小于key的最后一个位置
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::iterator RbTree<T, Compare>::upper_bound(const key_type& key) {
-  auto y = header_;
-  auto x = root();
-  while (x != nullptr) {
-    if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value))) {
-      // key < x
-      y = x;
-      x = x->left;
+template <typename T, typename Compare, typename Tag>
+void RbTree<T, Compare, Tag>::merge_unique(RbTree& source) {
+  if (&source == this || source.node_count_ == 0) {
+    return;
+  }
+  if (!prefer_linear_merge(source.node_count_)) {
+    merge_unique<Compare>(source);
+    return;
+  }
+  base_ptr lhs = flatten(root(), nullptr);
+  base_ptr rhs = source.flatten(source.root(), nullptr);
+  size_type n = 0;
+  size_type rest = 0;
+  base_type dummy;
+  base_type rest_dummy;  // 键值重复的结点，留在source中
+  base_ptr tail = &dummy;
+  base_ptr rest_tail = &rest_dummy;
+  while (lhs != nullptr && rhs != nullptr) {
+    const auto& lkey = value_traits::get_key(lhs->get_node_ptr()->value);
+    const auto& rkey = value_traits::get_key(rhs->get_node_ptr()->value);
+    if (key_comp_(lkey, rkey)) {
+      tail->right = lhs;
+      lhs = lhs->right;
+      tail = tail->right;
+      ++n;
+    } else if (key_comp_(rkey, lkey)) {
+      tail->right = rhs;
+      rhs = rhs->right;
+      tail = tail->right;
+      ++n;
     } else {
-      x = x->right;
+      rest_tail->right = rhs;
+      rhs = rhs->right;
+      rest_tail = rest_tail->right;
+      ++rest;
     }
   }
-  return iterator(y);
+  for (base_ptr x = lhs != nullptr ? lhs : rhs; x != nullptr; x = x->right) {
+    tail->right = x;
+    tail = x;
+    ++n;
+  }
+  tail->right = nullptr;
+  rest_tail->right = nullptr;
+  ListNodeSource merged{dummy.right};
+  build_tree(merged, n);
+  ListNodeSource remained{rest_dummy.right};
+  source.build_tree(remained, rest);
 }
 
-// 键值不小于key的最后一个位置
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::const_iterator RbTree<T, Compare>::upper_bound(
-    const key_type& key) const {
-  auto y = header_;
-  auto x = root();
-  while (x != nullptr) {
-    if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value))) {
-      // key < x
-      y = x;
-      x = x->left;
-    } else {
-      x = x->right;
+// 把source的所有结点摘下并挂到当前的树上
+template <typename T, typename Compare, typename Tag>
+template <typename Compare2>
+void RbTree<T, Compare, Tag>::merge_multi(RbTree<T, Compare2, Tag>& source) {
+  if (static_cast<void*>(&source) == static_cast<void*>(this)) {
+    return;
+  }
+  THROW_LENGTH_ERROR_IF(
+      node_count_ > max_size() - source.node_count_, "RbTree<T, Comp>'s size too big");
+  for (auto first = source.begin(); first != source.end();) {
+    auto cur = first++;
+    auto pos = get_insert_multi_pos(value_traits::get_key(*cur));
+    insert_node_at(pos.first, source.unlink_node(cur.node), pos.second);
+  }
+}
+
+// 把source中键值不存在于当前树的结点摘下并挂到当前的树上，其余结点留在source中
+template <typename T, typename Compare, typename Tag>
+template <typename Compare2>
+void RbTree<T, Compare, Tag>::merge_unique(RbTree<T, Compare2, Tag>& source) {
+  for (auto first = source.begin(); first != source.end();) {
+    auto cur = first++;
+    auto pos = get_insert_unique_pos(value_traits::get_key(*cur));
+    if (pos.second) {
+      insert_node_at(pos.first.first, source.unlink_node(cur.node), pos.first.second);
     }
   }
-  return const_iterator(y);
 }
 
 // 交换RbTree
-template <typename T, typename Compare>
-void RbTree<T, Compare>::swap(RbTree& rhs) noexcept {
+template <typename T, typename Compare, typename Tag>
+void RbTree<T, Compare, Tag>::swap(RbTree& rhs) noexcept {
   if (this != &rhs) {
     mystl::swap(header_, rhs.header_);
     mystl::swap(node_count_, rhs.node_count_);
@@ -1209,15 +1774,13 @@ void RbTree<T, Compare>::swap(RbTree& rhs) noexcept {
 // helper function
 
 // 创建一个结点
-template <typename T, typename Compare>
+template <typename T, typename Compare, typename Tag>
 template <typename... Args>
-typename RbTree<T, Compare>::node_ptr RbTree<T, Compare>::create_node(Args&&... args) {
+typename RbTree<T, Compare, Tag>::node_ptr RbTree<T, Compare, Tag>::create_node(Args&&... args) {
   auto tmp = node_allocator::allocate(1);
   try {
     data_allocator::construct(mystl::address_of(tmp->value), mystl::forward<Args>(args)...);
-    tmp->left = nullptr;
-    tmp->right = nullptr;
-    tmp->parent = nullptr;
+    base_allocator::construct(tmp->get_base_ptr());  // 指针置空，颜色为红
   } catch (...) {
     node_allocator::deallocate(tmp);
     throw;
@@ -1226,27 +1789,29 @@ typename RbTree<T, Compare>::node_ptr RbTree<T, Compare>::create_node(Args&&...
 }
 
 // 复制一个结点
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::node_ptr RbTree<T, Compare>::clone_node(base_ptr x) {
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::node_ptr RbTree<T, Compare, Tag>::clone_node(base_ptr x) {
   node_ptr tmp = create_node(x->get_node_ptr()->value);
-  tmp->color = x->color;
+  tmp->set_color(x->get_color());
+  augment::copy(tmp->get_base_ptr(), x);
   tmp->left = nullptr;
   tmp->right = nullptr;
   return tmp;
 }
 
 // 销毁一个结点
-template <typename T, typename Compare>
-void RbTree<T, Compare>::destroy_node(node_ptr p) {
+template <typename T, typename Compare, typename Tag>
+void RbTree<T, Compare, Tag>::destroy_node(node_ptr p) {
   data_allocator::destroy(&p->value);
   node_allocator::deallocate(p);
 }
 
 // 初始化容器
-template <typename T, typename Compare>
-void RbTree<T, Compare>::rb_tree_init() {
+template <typename T, typename Compare, typename Tag>
+void RbTree<T, Compare, Tag>::rb_tree_init() {
   header_ = base_allocator::allocate(1);
-  header_->color = kRbTreeRed;  // header_结点颜色为红，与root区分
+  base_allocator::construct(header_);
+  header_->set_color(kRbTreeRed);  // header_结点颜色为红，与root区分
   root() = nullptr;
   leftmost() = header_;
   rightmost() = header_;
@@ -1254,16 +1819,16 @@ void RbTree<T, Compare>::rb_tree_init() {
 }
 
 // reset函数
-template <typename T, typename Compare>
-void RbTree<T, Compare>::reset() {
+template <typename T, typename Compare, typename Tag>
+void RbTree<T, Compare, Tag>::reset() {
   header_ = nullptr;
   node_count_ = 0;
 }
 
 // get_insert_multi_pos函数
-template <typename T, typename Compare>
-mystl::pair<typename RbTree<T, Compare>::base_ptr, bool> RbTree<T, Compare>::get_insert_multi_pos(
-    const key_type& key) {
+template <typename T, typename Compare, typename Tag>
+mystl::pair<typename RbTree<T, Compare, Tag>::base_ptr, bool>
+RbTree<T, Compare, Tag>::get_insert_multi_pos(const key_type& key) {
   auto x = root();
   auto y = header_;
   bool add_to_left = true;
@@ -1276,9 +1841,9 @@ mystl::pair<typename RbTree<T, Compare>::base_ptr, bool> RbTree<T, Compare>::get
 }
 
 // get_insert_unique_pos函数
-template <typename T, typename Compare>
-mystl::pair<mystl::pair<typename RbTree<T, Compare>::base_ptr, bool>, bool>
-RbTree<T, Compare>::get_insert_unique_pos(const key_type& key) {
+template <typename T, typename Compare, typename Tag>
+mystl::pair<mystl::pair<typename RbTree<T, Compare, Tag>::base_ptr, bool>, bool>
+RbTree<T, Compare, Tag>::get_insert_unique_pos(const key_type& key) {
   // 返回一个pair，第一个值为一个pair，包含插入点的父结点和一个bool表示是否在左边插入，
   // 第二个值为一个bool，表示是否插入成功
   auto x = root();
@@ -1303,14 +1868,14 @@ RbTree<T, Compare>::get_insert_unique_pos(const key_type& key) {
     // 表明新结点没有重复
     return mystl::make_pair(mystl::make_pair(y, add_to_left), true);
   }
-  // 进行至此，表示新结点与现有结点键值重复
-  return mystl::make_pair(mystl::make_pair(y, add_to_left), false);
+  // 进行至此，表示新结点与现有结点键值重复，返回键值相同的结点
+  return mystl::make_pair(mystl::make_pair(j.node, add_to_left), false);
 }
 
 // insert_value_at函数
 // x为插入点的父结点，value为要插入的值，add_to_left表示是否在左边插入
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::iterator RbTree<T, Compare>::insert_value_at(
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::iterator RbTree<T, Compare, Tag>::insert_value_at(
     base_ptr x, const value_type& value, bool add_to_left) {
   node_ptr node = create_node(value);
   node->parent = x;
@@ -1337,8 +1902,8 @@ typename RbTree<T, Compare>::iterator RbTree<T, Compare>::insert_value_at(
 
 // 在x结点处插入新的结点
 // x为插入点的父结点，node为要插入的结点，add_to_left表示是否在左边插入
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::iterator RbTree<T, Compare>::insert_node_at(
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::iterator RbTree<T, Compare, Tag>::insert_node_at(
     base_ptr x, node_ptr node, bool add_to_left) {
   node->parent = x;
   auto base_node = node->get_base_ptr();
@@ -1362,58 +1927,228 @@ typename RbTree<T, Compare>::iterator RbTree<T, Compare>::insert_node_at(
   return iterator(node);
 }
 
-// 插入元素，键值允许重复，使用hint
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::iterator RbTree<T, Compare>::insert_multi_use_hint(
-    iterator hint, key_type key, node_ptr node) {
-  // 在hint附近寻找可插入的位置
-  auto np = hint.node;
-  auto before = hint;
-  --before;
-  auto bnp = before.node;
-  if (!key_comp_(key, value_traits::get_key(*before)) &&
-      !key_comp_(value_traits::get_key(*hint), key)) {
-    // before <= node <= hint
-    if (bnp->right == nullptr) {
-      return insert_node_at(bnp, node, false);
-    } else if (np->left == nullptr) {
-      return insert_node_at(np, node, true);
+// 在hint附近寻找可插入的位置，键值允许重复，返回值与get_insert_multi_pos相同
+template <typename T, typename Compare, typename Tag>
+mystl::pair<typename RbTree<T, Compare, Tag>::base_ptr, bool>
+RbTree<T, Compare, Tag>::get_insert_multi_pos_use_hint(iterator hint, const key_type& key) {
+  if (node_count_ == 0) {
+    return mystl::make_pair(header_, true);
+  }
+  if (hint == begin()) {
+    // 位于begin处
+    if (key_comp_(key, value_traits::get_key(*hint))) {
+      return mystl::make_pair(hint.node, true);
+    }
+  } else if (hint == end()) {
+    // 位于end处
+    if (!key_comp_(key, value_traits::get_key(rightmost()->get_node_ptr()->value))) {
+      return mystl::make_pair(rightmost(), false);
+    }
+  } else {
+    auto before = hint;
+    --before;
+    if (!key_comp_(key, value_traits::get_key(*before)) &&
+        !key_comp_(value_traits::get_key(*hint), key)) {
+      // before <= node <= hint
+      if (before.node->right == nullptr) {
+        return mystl::make_pair(before.node, false);
+      } else if (hint.node->left == nullptr) {
+        return mystl::make_pair(hint.node, true);
+      }
     }
   }
-  auto pos = get_insert_multi_pos(key);
-  return insert_node_at(pos.first, node, pos.second);
-}
-
-// 插入元素，键值不允许重复，使用hint
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::iterator RbTree<T, Compare>::insert_unique_use_hint(
-    iterator hint, key_type key, node_ptr node) {
-  // 在hint附近寻找可插入的位置
-  auto np = hint.node;
-  auto before = hint;
-  --before;
-  auto bnp = before.node;
-  if (key_comp_(value_traits::get_key(*before), key) &&
-      key_comp_(key, value_traits::get_key(*hint))) {
-    // before < node < hint
-    if (bnp->right == nullptr) {
-      return insert_node_at(bnp, node, false);
-    } else if (np->left == nullptr) {
-      return insert_node_at(np, node, true);
+  return get_insert_multi_pos(key);
+}
+
+// 在hint附近寻找可插入的位置，键值不允许重复，返回值与get_insert_unique_pos相同
+template <typename T, typename Compare, typename Tag>
+mystl::pair<mystl::pair<typename RbTree<T, Compare, Tag>::base_ptr, bool>, bool>
+RbTree<T, Compare, Tag>::get_insert_unique_pos_use_hint(iterator hint, const key_type& key) {
+  if (node_count_ == 0) {
+    return mystl::make_pair(mystl::make_pair(header_, true), true);
+  }
+  if (hint == begin()) {
+    // 位于begin处
+    if (key_comp_(key, value_traits::get_key(*hint))) {
+      return mystl::make_pair(mystl::make_pair(hint.node, true), true);
+    }
+  } else if (hint == end()) {
+    // 位于end处
+    if (key_comp_(value_traits::get_key(rightmost()->get_node_ptr()->value), key)) {
+      return mystl::make_pair(mystl::make_pair(rightmost(), false), true);
+    }
+  } else {
+    auto before = hint;
+    --before;
+    if (key_comp_(value_traits::get_key(*before), key) &&
+        key_comp_(key, value_traits::get_key(*hint))) {
+      // before < node < hint
+      if (before.node->right == nullptr) {
+        return mystl::make_pair(mystl::make_pair(before.node, false), true);
+      } else if (hint.node->left == nullptr) {
+        return mystl::make_pair(mystl::make_pair(hint.node, true), true);
+      }
     }
   }
-  auto pos = get_insert_unique_pos(key);
-  if (!pos.second) {
-    destroy_node(node);
-    return pos.first.first;
+  return get_insert_unique_pos(key);
+}
+
+// 把结点x从树上摘下，不销毁结点
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::node_ptr RbTree<T, Compare, Tag>::unlink_node(base_ptr x) {
+  rb_tree_erase_rebalance(x, root(), leftmost(), rightmost());
+  --node_count_;
+  x->parent = nullptr;
+  x->left = nullptr;
+  x->right = nullptr;
+  return x->get_node_ptr();
+}
+
+// 查找键值与key等价的结点，不存在时返回header_
+template <typename T, typename Compare, typename Tag>
+template <typename K>
+typename RbTree<T, Compare, Tag>::base_ptr RbTree<T, Compare, Tag>::find_node(const K& key) const {
+  auto y = lower_bound_node(key);
+  if (y == header_ || key_comp_(key, value_traits::get_key(y->get_node_ptr()->value))) {
+    return header_;
+  }
+  return y;
+}
+
+// 键值不小于key的第一个结点
+template <typename T, typename Compare, typename Tag>
+template <typename K>
+typename RbTree<T, Compare, Tag>::base_ptr RbTree<T, Compare, Tag>::lower_bound_node(
+    const K& key) const {
+  auto y = header_;  // 最后一个不小于key的结点
+  auto x = root();
+  while (x != nullptr) {
+    if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
+      // key <= x，向左走
+      y = x;
+      x = x->left;
+    } else {
+      // key > x，向右走
+      x = x->right;
+    }
+  }
+  return y;
+}
+
+// 键值大于key的第一个结点
+template <typename T, typename Compare, typename Tag>
+template <typename K>
+typename RbTree<T, Compare, Tag>::base_ptr RbTree<T, Compare, Tag>::upper_bound_node(
+    const K& key) const {
+  auto y = header_;
+  auto x = root();
+  while (x != nullptr) {
+    if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value))) {
+      // key < x
+      y = x;
+      x = x->left;
+    } else {
+      x = x->right;
+    }
+  }
+  return y;
+}
+
+// 按子树大小自顶向下定位第k小的结点，不存在时返回header_
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::base_ptr RbTree<T, Compare, Tag>::select_node(size_type k) const {
+  static_assert(std::is_same<Tag, RbTreeOrderStatisticTag>::value,
+                "select requires RbTreeOrderStatisticTag");
+  if (k >= node_count_) {
+    return header_;
+  }
+  auto x = root();
+  while (true) {
+    const size_type left_size = augment::size(x->left);
+    if (k < left_size) {
+      x = x->left;
+    } else if (k == left_size) {
+      return x;
+    } else {
+      k -= left_size + 1;
+      x = x->right;
+    }
+  }
+}
+
+// 沿查找路径累加所有键值小于key的结点及其左子树的大小
+template <typename T, typename Compare, typename Tag>
+template <typename K>
+typename RbTree<T, Compare, Tag>::size_type RbTree<T, Compare, Tag>::rank(const K& key) const {
+  static_assert(std::is_same<Tag, RbTreeOrderStatisticTag>::value,
+                "rank requires RbTreeOrderStatisticTag");
+  size_type result = 0;
+  auto x = root();
+  while (x != nullptr) {
+    if (key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
+      // x < key，x与它的左子树都排在key之前
+      result += augment::size(x->left) + 1;
+      x = x->right;
+    } else {
+      x = x->left;
+    }
+  }
+  return result;
+}
+
+// 与[low, high]相交的第一个区间
+// 左子树中最大的右端点不小于low时，要么左子树中有相交的区间，要么左子树中右端点不小于low的区间
+// 左端点都大于high，而x与右子树的左端点只会更大，整棵树都没有相交的区间，因此总是可以向左走
+template <typename T, typename Compare, typename Tag>
+template <typename E>
+typename RbTree<T, Compare, Tag>::base_ptr RbTree<T, Compare, Tag>::find_overlap_node(
+    const E& low, const E& high) const {
+  static_assert(IsRbTreeIntervalTag<Tag>::kValue, "find_overlap requires RbTreeIntervalTag");
+  typename Tag::endpoint_compare comp;
+  auto x = root();
+  while (x != nullptr) {
+    if (x->left != nullptr && !comp(x->left->max_high, low)) {
+      x = x->left;
+      continue;
+    }
+    const auto& key = value_traits::get_key(x->get_node_ptr()->value);
+    if (comp(high, key.low)) {
+      break;
+    }
+    if (!comp(key.high, low)) {
+      return x;
+    }
+    x = x->right;
+  }
+  return header_;
+}
+
+// 中序遍历以x为根的子树中与[low, high]相交的区间
+// 子树中最大的右端点小于low时整棵子树都不相交，左端点大于high时x与它的右子树都不相交
+template <typename T, typename Compare, typename Tag>
+template <typename Iter, typename E, typename Function>
+void RbTree<T, Compare, Tag>::visit_overlap(base_ptr x, const E& low, const E& high,
+                                            Function& f) const {
+  static_assert(IsRbTreeIntervalTag<Tag>::kValue, "for_each_overlap requires RbTreeIntervalTag");
+  typename Tag::endpoint_compare comp;
+  while (x != nullptr && !comp(x->max_high, low)) {
+    visit_overlap<Iter>(x->left, low, high, f);
+    const auto& key = value_traits::get_key(x->get_node_ptr()->value);
+    if (comp(high, key.low)) {
+      return;
+    }
+    if (!comp(key.high, low)) {
+      f(Iter(x));
+    }
+    x = x->right;
   }
-  return insert_node_at(pos.first.first, node, pos.first.second);
 }
 
 // copy_from函数
 // 递归复制一棵树，结点从x开始，p为x的父结点
-template <typename T, typename Compare>
-typename RbTree<T, Compare>::base_ptr RbTree<T, Compare>::copy_from(base_ptr x, base_ptr p) {
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::base_ptr RbTree<T, Compare, Tag>::copy_from(
+    base_ptr x, base_ptr p) {
   auto top = clone_node(x);
   top->parent = p;
   try {
@@ -1441,50 +2176,360 @@ typename RbTree<T, Compare>::base_ptr RbTree<T, Compare>::copy_from(base_ptr x,
 
 // erase_since函数
 // 从x结点开始删除该结点及其子树
-template <typename T, typename Compare>
-void RbTree<T, Compare>::erase_since(base_ptr x) {
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::size_type RbTree<T, Compare, Tag>::erase_since(base_ptr x) {
+  size_type n = 0;
   while (x != nullptr) {
-    erase_since(x->right);
+    n += erase_since(x->right) + 1;
     auto y = x->left;
     destroy_node(x->get_node_ptr());
     x = y;
   }
+  return n;
+}
+
+// 检查区间内的键值是否已排好序，strict为true时要求严格递增
+template <typename T, typename Compare, typename Tag>
+template <typename InputIterator>
+bool RbTree<T, Compare, Tag>::is_sorted_keys(
+    InputIterator first, InputIterator last, bool strict) const {
+  if (first == last) {
+    return true;
+  }
+  auto next = first;
+  for (++next; next != last; first = next, ++next) {
+    const auto& prev_key = value_traits::get_key(*first);
+    const auto& key = value_traits::get_key(*next);
+    if (strict ? !key_comp_(prev_key, key) : key_comp_(key, prev_key)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 从source中按中序取出n个结点，构造一棵完全平衡的子树，返回子树的根
+// 左右子树的大小至多相差一，因此所有空子结点的深度只差一层：
+// 深度小于red_depth的结点都为黑色，最底一层（深度等于red_depth）不满的结点为红色
+template <typename T, typename Compare, typename Tag>
+template <typename NodeSource>
+typename RbTree<T, Compare, Tag>::base_ptr RbTree<T, Compare, Tag>::build_balanced(
+    NodeSource& source, size_type n, size_type depth, size_type red_depth) {
+  if (n == 0) {
+    return nullptr;
+  }
+  const size_type left_count = (n - 1) / 2;
+  base_ptr left = build_balanced(source, left_count, depth + 1, red_depth);
+  base_ptr x = nullptr;
+  try {
+    x = source.next_node()->get_base_ptr();
+  } catch (...) {
+    erase_since(left);
+    throw;
+  }
+  x->left = left;
+  x->right = nullptr;
+  if (left != nullptr) {
+    left->parent = x;
+  }
+  x->set_color(depth == red_depth ? kRbTreeRed : kRbTreeBlack);
+  try {
+    x->right = build_balanced(source, n - 1 - left_count, depth + 1, red_depth);
+  } catch (...) {
+    erase_since(x);
+    throw;
+  }
+  if (x->right != nullptr) {
+    x->right->parent = x;
+  }
+  augment::update(x);
+  return x;
+}
+
+// 以source中的n个结点构造整棵树，调用前树中不能有结点
+template <typename T, typename Compare, typename Tag>
+template <typename NodeSource>
+void RbTree<T, Compare, Tag>::build_tree(NodeSource& source, size_type n) {
+  size_type red_depth = 0;  // 满的层数，即floor(log2(n + 1))
+  for (auto m = n + 1; m > 1; m >>= 1) {
+    ++red_depth;
+  }
+  node_count_ = 0;
+  root() = build_balanced(source, n, 0, red_depth);
+  if (root() == nullptr) {
+    leftmost() = header_;
+    rightmost() = header_;
+    return;
+  }
+  root()->parent = header_;
+  leftmost() = rb_tree_min(root());
+  rightmost() = rb_tree_max(root());
+  node_count_ = n;
+}
+
+// 把以x为根的子树按中序串成以right相连的链表，接在head之前，返回新的链表头
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::base_ptr RbTree<T, Compare, Tag>::flatten(
+    base_ptr x, base_ptr head) {
+  while (x != nullptr) {
+    head = flatten(x->right, head);
+    x->right = head;
+    head = x;
+    x = x->left;
+  }
+  return head;
+}
+
+// 逐个插入m个结点约需m * log(n + m)次比较，线性归并需要n + m次，取代价较小者
+template <typename T, typename Compare, typename Tag>
+bool RbTree<T, Compare, Tag>::prefer_linear_merge(size_type m) const {
+  size_type lg = 0;
+  for (auto t = node_count_ + m; t > 1; t >>= 1) {
+    ++lg;
+  }
+  return m * lg >= node_count_ + m;
+}
+
+// 把键值不小于key的元素移到right中，right原有的元素会被清除
+template <typename T, typename Compare, typename Tag>
+template <typename K>
+void RbTree<T, Compare, Tag>::split(const K& key, RbTree& right) {
+  MYSTL_DEBUG(this != &right);
+  right.clear();
+  right.key_comp_ = key_comp_;
+  auto p = lower_bound_node(key);
+  if (p == header_) {
+    return;
+  }
+  if (p == leftmost()) {
+    swap_nodes(right);
+    return;
+  }
+  auto moved = cut_range(p, header_);
+  const size_type n = augment::count(moved);
+  right.assign_subtree(moved, n);
+  node_count_ -= n;
+}
+
+// 把right的所有元素接到当前树的末尾，right中的键值都不能小于当前树中的键值
+// 先从right中摘下最小的结点，再以它为中间结点拼接两棵树
+template <typename T, typename Compare, typename Tag>
+void RbTree<T, Compare, Tag>::join(RbTree& right) {
+  if (this == &right || right.node_count_ == 0) {
+    return;
+  }
+  if (node_count_ == 0) {
+    swap_nodes(right);
+    return;
+  }
+  MYSTL_DEBUG(!key_comp_(value_traits::get_key(right.leftmost()->get_node_ptr()->value),
+                         value_traits::get_key(rightmost()->get_node_ptr()->value)));
+  const size_type n = node_count_ + right.node_count_;
+  base_ptr mid = right.unlink_node(right.leftmost());
+  base_ptr r = right.root();
+  auto joined = join_subtree(SubTree{root(), black_height(root())}, mid,
+                             SubTree{r, black_height(r)});
+  right.assign_subtree(nullptr, 0);
+  assign_subtree(joined.root, n);
+}
+
+// 把[first, last)区间内的元素移到out中，out原有的元素会被清除
+template <typename T, typename Compare, typename Tag>
+void RbTree<T, Compare, Tag>::extract_range(iterator first, iterator last, RbTree& out) {
+  MYSTL_DEBUG(this != &out);
+  out.clear();
+  out.key_comp_ = key_comp_;
+  if (first == last) {
+    return;
+  }
+  if (first == begin() && last == end()) {
+    swap_nodes(out);
+    return;
+  }
+  auto moved = cut_range(first.node, last.node);
+  const size_type n = augment::count(moved);
+  out.assign_subtree(moved, n);
+  node_count_ -= n;
+}
+
+// 以x为根的子树的黑高，即x到叶子的路径上黑结点的个数，空树的黑高为0
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::size_type RbTree<T, Compare, Tag>::black_height(
+    base_ptr x) noexcept {
+  size_type h = 0;
+  for (; x != nullptr; x = x->left) {
+    if (!rb_tree_is_red(x)) {
+      ++h;
+    }
+  }
+  return h;
+}
+
+// 以mid为中间结点拼接left与right，left中的键值都不大于mid，right中的键值都不小于mid
+// 沿较高一棵树的边缘向下，找到黑高与另一棵树相同的黑结点，以mid接替它的位置并作为两棵子树的父结点，
+// 此时只可能在mid处出现连续的红结点，与插入新结点的情况相同
+// 时间复杂度为O(|left.black_height - right.black_height| + 1)
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::SubTree RbTree<T, Compare, Tag>::join_subtree(
+    SubTree left, base_ptr mid, SubTree right) noexcept {
+  // 先把两棵树的根染黑，红色的根染黑后黑高加一
+  if (left.root != nullptr && rb_tree_is_red(left.root)) {
+    rb_tree_set_black(left.root);
+    ++left.black_height;
+  }
+  if (right.root != nullptr && rb_tree_is_red(right.root)) {
+    rb_tree_set_black(right.root);
+    ++right.black_height;
+  }
+  base_ptr root = nullptr;
+  base_ptr parent = nullptr;
+  if (left.black_height >= right.black_height) {
+    // 沿left的右边缘向下
+    auto x = left.root;
+    auto h = left.black_height;
+    while (h > right.black_height || (x != nullptr && rb_tree_is_red(x))) {
+      if (!rb_tree_is_red(x)) {
+        --h;
+      }
+      parent = x;
+      x = x->right;
+    }
+    mid->left = x;
+    mid->right = right.root;
+    root = parent == nullptr ? mid : left.root;
+    if (parent != nullptr) {
+      parent->right = mid;
+    }
+  } else {
+    // 沿right的左边缘向下
+    auto x = right.root;
+    auto h = right.black_height;
+    while (h > left.black_height || (x != nullptr && rb_tree_is_red(x))) {
+      if (!rb_tree_is_red(x)) {
+        --h;
+      }
+      parent = x;
+      x = x->left;
+    }
+    mid->left = left.root;
+    mid->right = x;
+    root = parent == nullptr ? mid : right.root;
+    if (parent != nullptr) {
+      parent->left = mid;
+    }
+  }
+  mid->parent = parent;
+  if (mid->left != nullptr) {
+    mid->left->parent = mid;
+  }
+  if (mid->right != nullptr) {
+    mid->right->parent = mid;
+  }
+  augment::update_path(mid, root);
+  const size_type h = mystl::max(left.black_height, right.black_height);
+  const bool grown = rb_tree_insert_fixup(mid, root);
+  return SubTree{root, grown ? h + 1 : h};
+}
+
+// 把以root为根的子树在结点p处分开，p之前的结点组成left，p之后的结点组成right，p不属于任何一边
+// 从p出发沿父指针向上，每个祖先连同它另一侧的子树拼接到对应的一边，
+// 各次拼接的代价之和不超过树高，时间复杂度为O(log n)
+template <typename T, typename Compare, typename Tag>
+void RbTree<T, Compare, Tag>::split_at(base_ptr root, base_ptr p, SubTree& left,
+                                       SubTree& right) noexcept {
+  auto h = black_height(p->left);
+  left = SubTree{p->left, h};
+  right = SubTree{p->right, h};
+  if (!rb_tree_is_red(p)) {
+    ++h;  // 此时h为以p为根的子树的黑高
+  }
+  auto x = p;
+  auto xp = p->parent;
+  bool from_left = x != root && rb_tree_is_lchild(x);
+  while (x != root) {
+    // 拼接会改写xp的链接，先记下它的父结点
+    auto next = xp->parent;
+    const bool next_from_left = xp != root && rb_tree_is_lchild(xp);
+    const auto hp = rb_tree_is_red(xp) ? h : h + 1;
+    if (from_left) {
+      right = join_subtree(right, xp, SubTree{xp->right, h});
+    } else {
+      left = join_subtree(SubTree{xp->left, h}, xp, left);
+    }
+    x = xp;
+    xp = next;
+    h = hp;
+    from_left = next_from_left;
+  }
+}
+
+// 把[first, last)区间内的结点从树上切下，返回由它们组成的子树的根，不修改node_count_
+template <typename T, typename Compare, typename Tag>
+typename RbTree<T, Compare, Tag>::base_ptr RbTree<T, Compare, Tag>::cut_range(
+    base_ptr first, base_ptr last) noexcept {
+  SubTree left, mid, right;
+  if (last == header_) {
+    split_at(root(), first, left, right);
+    mid = join_subtree(SubTree{nullptr, 0}, first, right);
+  } else {
+    split_at(root(), last, left, right);
+    split_at(left.root, first, left, mid);
+    mid = join_subtree(SubTree{nullptr, 0}, first, mid);
+    left = join_subtree(left, last, right);
+  }
+  assign_subtree(left.root, node_count_);
+  return mid.root;
+}
+
+// 以x为根的子树作为整棵树，重新设置header_的链接
+template <typename T, typename Compare, typename Tag>
+void RbTree<T, Compare, Tag>::assign_subtree(base_ptr x, size_type n) noexcept {
+  root() = x;
+  if (x == nullptr) {
+    leftmost() = header_;
+    rightmost() = header_;
+  } else {
+    x->parent = header_;
+    rb_tree_set_black(x);
+    leftmost() = rb_tree_min(x);
+    rightmost() = rb_tree_max(x);
+  }
+  node_count_ = n;
 }
 
 // 重载比较操作符
-template <typename T, typename Compare>
-bool operator==(const RbTree<T, Compare>& lhs, const RbTree<T, Compare>& rhs) {
+template <typename T, typename Compare, typename Tag>
+bool operator==(const RbTree<T, Compare, Tag>& lhs, const RbTree<T, Compare, Tag>& rhs) {
   return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <typename T, typename Compare>
-bool operator<(const RbTree<T, Compare>& lhs, const RbTree<T, Compare>& rhs) {
+template <typename T, typename Compare, typename Tag>
+bool operator<(const RbTree<T, Compare, Tag>& lhs, const RbTree<T, Compare, Tag>& rhs) {
   return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T, typename Compare>
-bool operator!=(const RbTree<T, Compare>& lhs, const RbTree<T, Compare>& rhs) {
+template <typename T, typename Compare, typename Tag>
+bool operator!=(const RbTree<T, Compare, Tag>& lhs, const RbTree<T, Compare, Tag>& rhs) {
   return !(lhs == rhs);
 }
 
-template <typename T, typename Compare>
-bool operator>(const RbTree<T, Compare>& lhs, const RbTree<T, Compare>& rhs) {
+template <typename T, typename Compare, typename Tag>
+bool operator>(const RbTree<T, Compare, Tag>& lhs, const RbTree<T, Compare, Tag>& rhs) {
   return rhs < lhs;
 }
 
-template <typename T, typename Compare>
-bool operator<=(const RbTree<T, Compare>& lhs, const RbTree<T, Compare>& rhs) {
+template <typename T, typename Compare, typename Tag>
+bool operator<=(const RbTree<T, Compare, Tag>& lhs, const RbTree<T, Compare, Tag>& rhs) {
   return !(rhs < lhs);
 }
 
-template <typename T, typename Compare>
-bool operator>=(const RbTree<T, Compare>& lhs, const RbTree<T, Compare>& rhs) {
+template <typename T, typename Compare, typename Tag>
+bool operator>=(const RbTree<T, Compare, Tag>& lhs, const RbTree<T, Compare, Tag>& rhs) {
   return !(lhs < rhs);
 }
 
 // 重载mystl的swap
-template <typename T, typename Compare>
-void swap(RbTree<T, Compare>& lhs, RbTree<T, Compare>& rhs) noexcept {
+template <typename T, typename Compare, typename Tag>
+void swap(RbTree<T, Compare, Tag>& lhs, RbTree<T, Compare, Tag>& rhs) noexcept {
   lhs.swap(rhs);
 }
 
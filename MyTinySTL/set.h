@@ -20,10 +20,22 @@
 
 namespace mystl {
 
+// forward declaration begin
+template <typename Key, typename Compare, typename NodeTag>
+class MultiSet;
+// forward declaration end
+
 // 模板类set，键值不允许重复
 // 参数一代表键值类型，参数二代表键值比较方式，缺省使用mystl::Less
-template <typename Key, typename Compare = mystl::Less<Key>>
+// 参数三代表结点布局，缺省使用mystl::RbTreeDefaultNodeTag
+template <typename Key, typename Compare = mystl::Less<Key>,
+          typename NodeTag = mystl::RbTreeDefaultNodeTag>
 class Set {
+  template <typename, typename, typename>
+  friend class Set;
+  template <typename, typename, typename>
+  friend class MultiSet;
+
  public:
   using key_type = Key;
   using value_type = Key;
@@ -32,12 +44,12 @@ class Set {
 
  private:
   // 以mystl::RbTree作为底层机制
-  using base_type = mystl::RbTree<value_type, key_compare>;
+  using base_type = mystl::RbTree<value_type, key_compare, NodeTag>;
   base_type tree_;
 
  public:
   // 使用RbTree定义的型别
-  using node_type = typename base_type::node_type;
+  using node_type = typename base_type::node_handle;
   using pointer = typename base_type::const_pointer;
   using const_pointer = typename base_type::const_pointer;
   using reference = typename base_type::const_reference;
@@ -50,6 +62,8 @@ class Set {
   using difference_type = typename base_type::difference_type;
   using allocator_type = typename base_type::allocator_type;
 
+  using insert_return_type = mystl::InsertReturnType<iterator, node_type>;
+
  public:
   // 构造、复制、移动函数
   Set() = default;
@@ -58,6 +72,11 @@ class Set {
   Set(InputIterator first, InputIterator last) : tree_() {
     tree_.insert_unique(first, last);
   }
+  // 区间已排好序，直接以O(n)构造
+  template <typename InputIterator>
+  Set(SortedUniqueTag /*tag*/, InputIterator first, InputIterator last) : tree_() {
+    tree_.assign_sorted(first, last);
+  }
   Set(std::initializer_list<value_type> ilist) : tree_() {
     tree_.insert_unique(ilist.begin(), ilist.end());
   }
@@ -139,24 +158,118 @@ class Set {
 
   void clear() { tree_.clear(); }
 
+  // 结点句柄相关，结点在容器之间转移时不会重新分配内存
+  node_type extract(iterator position) { return tree_.extract(position); }
+  node_type extract(const key_type& key) {
+    auto it = tree_.find(key);
+    return it == end() ? node_type() : tree_.extract(it);
+  }
+
+  insert_return_type insert(node_type&& nh) {
+    auto res = tree_.insert_node_unique(nh);
+    return insert_return_type{res.first, res.second, mystl::move(nh)};
+  }
+  iterator insert(iterator hint, node_type&& nh) {
+    return tree_.insert_node_unique(hint, nh).first;
+  }
+
+  // 把source中键值不存在于当前容器的结点转移过来
+  template <typename C2>
+  void merge(Set<Key, C2, NodeTag>& source) {
+    tree_.merge_unique(source.tree_);
+  }
+  template <typename C2>
+  void merge(Set<Key, C2, NodeTag>&& source) {
+    tree_.merge_unique(source.tree_);
+  }
+  template <typename C2>
+  void merge(MultiSet<Key, C2, NodeTag>& source) {
+    tree_.merge_unique(source.tree_);
+  }
+  template <typename C2>
+  void merge(MultiSet<Key, C2, NodeTag>&& source) {
+    tree_.merge_unique(source.tree_);
+  }
+
+  // 分裂与拼接，只重新链接O(log n)个结点，不逐个插入删除元素
+  // split把键值不小于key的元素移到返回的容器中，join把rhs的元素全部接到末尾，要求rhs中的键值
+  // 都大于当前容器中的键值，extract_range把[first, last)区间内的元素移到返回的容器中
+  Set split(const key_type& key) {
+    Set rhs;
+    tree_.split(key, rhs.tree_);
+    return rhs;
+  }
+  void join(Set& rhs) { tree_.join(rhs.tree_); }
+  void join(Set&& rhs) { tree_.join(rhs.tree_); }
+  Set extract_range(iterator first, iterator last) {
+    Set rhs;
+    tree_.extract_range(first, last, rhs.tree_);
+    return rhs;
+  }
+
   // set相关操作
+  // 当Compare为透明比较器（如mystl::Less<>）时，以下查找函数还接受任意可与key_type比较的类型
   iterator find(const key_type& key) { return tree_.find(key); }
   const_iterator find(const key_type& key) const { return tree_.find(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  iterator find(const K& key) {
+    return tree_.find(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  const_iterator find(const K& key) const {
+    return tree_.find(key);
+  }
 
   size_type count(const key_type& key) const { return tree_.count_unique(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  size_type count(const K& key) const {
+    return tree_.count_unique(key);
+  }
 
   iterator lower_bound(const key_type& key) { return tree_.lower_bound(key); }
   const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  iterator lower_bound(const K& key) {
+    return tree_.lower_bound(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  const_iterator lower_bound(const K& key) const {
+    return tree_.lower_bound(key);
+  }
 
   iterator upper_bound(const key_type& key) { return tree_.upper_bound(key); }
   const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  iterator upper_bound(const K& key) {
+    return tree_.upper_bound(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  const_iterator upper_bound(const K& key) const {
+    return tree_.upper_bound(key);
+  }
 
   pair<iterator, iterator> equal_range(const key_type& key) {
     return tree_.equal_range_unique(key);
   }
-
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
-    return tree_.equal_range_multi(key);
+    return tree_.equal_range_unique(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  pair<iterator, iterator> equal_range(const K& key) {
+    return tree_.equal_range_unique(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return tree_.equal_range_unique(key);
+  }
+
+  // 顺序统计，只有结点布局为RbTreeOrderStatisticTag（如OrderStatisticSet）时可用
+  // select返回第k小的元素（k从0开始），rank返回键值小于key的元素个数，时间复杂度均为O(log n)
+  iterator select(size_type k) const { return tree_.select(k); }
+  size_type rank(const key_type& key) const { return tree_.rank(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  size_type rank(const K& key) const {
+    return tree_.rank(key);
   }
 
   void swap(Set& rhs) noexcept { tree_.swap(rhs.tree_); }
@@ -167,46 +280,53 @@ class Set {
 };
 
 // 重载比较操作符
-template <typename Key, typename Compare>
-bool operator==(const Set<Key, Compare>& lhs, const Set<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename NodeTag>
+bool operator==(const Set<Key, Compare, NodeTag>& lhs, const Set<Key, Compare, NodeTag>& rhs) {
   return lhs == rhs;
 }
 
-template <typename Key, typename Compare>
-bool operator<(const Set<Key, Compare>& lhs, const Set<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename NodeTag>
+bool operator<(const Set<Key, Compare, NodeTag>& lhs, const Set<Key, Compare, NodeTag>& rhs) {
   return lhs < rhs;
 }
 
-template <typename Key, typename Compare>
-bool operator!=(const Set<Key, Compare>& lhs, const Set<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename NodeTag>
+bool operator!=(const Set<Key, Compare, NodeTag>& lhs, const Set<Key, Compare, NodeTag>& rhs) {
   return !(lhs == rhs);
 }
 
-template <typename Key, typename Compare>
-bool operator>(const Set<Key, Compare>& lhs, const Set<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename NodeTag>
+bool operator>(const Set<Key, Compare, NodeTag>& lhs, const Set<Key, Compare, NodeTag>& rhs) {
   return rhs < lhs;
 }
 
-template <typename Key, typename Compare>
-bool operator<=(const Set<Key, Compare>& lhs, const Set<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename NodeTag>
+bool operator<=(const Set<Key, Compare, NodeTag>& lhs, const Set<Key, Compare, NodeTag>& rhs) {
   return !(rhs < lhs);
 }
 
-template <typename Key, typename Compare>
-bool operator>=(const Set<Key, Compare>& lhs, const Set<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename NodeTag>
+bool operator>=(const Set<Key, Compare, NodeTag>& lhs, const Set<Key, Compare, NodeTag>& rhs) {
   return !(lhs < rhs);
 }
 
 // 重载mystl的swap
-template <typename Key, typename Compare>
-void swap(Set<Key, Compare>& lhs, Set<Key, Compare>& rhs) noexcept {
+template <typename Key, typename Compare, typename NodeTag>
+void swap(Set<Key, Compare, NodeTag>& lhs, Set<Key, Compare, NodeTag>& rhs) noexcept {
   lhs.swap(rhs);
 }
 
 // 模板类multiset，键值允许重复
 // 参数一代表键值类型，参数二代表键值比较方式，缺省使用mystl::Less
-template <typename Key, typename Compare = mystl::Less<Key>>
+// 参数三代表结点布局，缺省使用mystl::RbTreeDefaultNodeTag
+template <typename Key, typename Compare = mystl::Less<Key>,
+          typename NodeTag = mystl::RbTreeDefaultNodeTag>
 class MultiSet {
+  template <typename, typename, typename>
+  friend class Set;
+  template <typename, typename, typename>
+  friend class MultiSet;
+
  public:
   using key_type = Key;
   using value_type = Key;
@@ -215,12 +335,12 @@ class MultiSet {
 
  private:
   // 以mystl::RbTree作为底层机制
-  using base_type = mystl::RbTree<value_type, key_compare>;
+  using base_type = mystl::RbTree<value_type, key_compare, NodeTag>;
   base_type tree_;
 
  public:
   // 使用RbTree定义的型别
-  using node_type = typename base_type::node_type;
+  using node_type = typename base_type::node_handle;
   using pointer = typename base_type::const_pointer;
   using const_pointer = typename base_type::const_pointer;
   using reference = typename base_type::const_reference;
@@ -241,6 +361,11 @@ class MultiSet {
   MultiSet(InputIterator first, InputIterator last) : tree_() {
     tree_.insert_multi(first, last);
   }
+  // 区间已排好序，直接以O(n)构造
+  template <typename InputIterator>
+  MultiSet(SortedEquivalentTag /*tag*/, InputIterator first, InputIterator last) : tree_() {
+    tree_.assign_sorted(first, last);
+  }
   MultiSet(std::initializer_list<value_type> ilist) : tree_() {
     tree_.insert_multi(ilist.begin(), ilist.end());
   }
@@ -320,23 +445,114 @@ class MultiSet {
 
   void clear() { tree_.clear(); }
 
+  // 结点句柄相关，结点在容器之间转移时不会重新分配内存
+  node_type extract(iterator position) { return tree_.extract(position); }
+  node_type extract(const key_type& key) {
+    auto it = tree_.find(key);
+    return it == end() ? node_type() : tree_.extract(it);
+  }
+
+  iterator insert(node_type&& nh) { return tree_.insert_node_multi(mystl::move(nh)); }
+  iterator insert(iterator hint, node_type&& nh) {
+    return tree_.insert_node_multi(hint, mystl::move(nh));
+  }
+
+  // 把source中的所有结点转移过来
+  template <typename C2>
+  void merge(Set<Key, C2, NodeTag>& source) {
+    tree_.merge_multi(source.tree_);
+  }
+  template <typename C2>
+  void merge(Set<Key, C2, NodeTag>&& source) {
+    tree_.merge_multi(source.tree_);
+  }
+  template <typename C2>
+  void merge(MultiSet<Key, C2, NodeTag>& source) {
+    tree_.merge_multi(source.tree_);
+  }
+  template <typename C2>
+  void merge(MultiSet<Key, C2, NodeTag>&& source) {
+    tree_.merge_multi(source.tree_);
+  }
+
+  // 分裂与拼接，只重新链接O(log n)个结点，不逐个插入删除元素
+  // split把键值不小于key的元素移到返回的容器中，join把rhs的元素全部接到末尾，要求rhs中的键值
+  // 都不小于当前容器中的键值，extract_range把[first, last)区间内的元素移到返回的容器中
+  MultiSet split(const key_type& key) {
+    MultiSet rhs;
+    tree_.split(key, rhs.tree_);
+    return rhs;
+  }
+  void join(MultiSet& rhs) { tree_.join(rhs.tree_); }
+  void join(MultiSet&& rhs) { tree_.join(rhs.tree_); }
+  MultiSet extract_range(iterator first, iterator last) {
+    MultiSet rhs;
+    tree_.extract_range(first, last, rhs.tree_);
+    return rhs;
+  }
+
   // set相关操作
+  // 当Compare为透明比较器（如mystl::Less<>）时，以下查找函数还接受任意可与key_type比较的类型
   iterator find(const key_type& key) { return tree_.find(key); }
   const_iterator find(const key_type& key) const { return tree_.find(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  iterator find(const K& key) {
+    return tree_.find(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  const_iterator find(const K& key) const {
+    return tree_.find(key);
+  }
 
   size_type count(const key_type& key) const { return tree_.count_multi(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  size_type count(const K& key) const {
+    return tree_.count_multi(key);
+  }
 
   iterator lower_bound(const key_type& key) { return tree_.lower_bound(key); }
   const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  iterator lower_bound(const K& key) {
+    return tree_.lower_bound(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  const_iterator lower_bound(const K& key) const {
+    return tree_.lower_bound(key);
+  }
 
   iterator upper_bound(const key_type& key) { return tree_.upper_bound(key); }
   const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  iterator upper_bound(const K& key) {
+    return tree_.upper_bound(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  const_iterator upper_bound(const K& key) const {
+    return tree_.upper_bound(key);
+  }
 
   pair<iterator, iterator> equal_range(const key_type& key) { return tree_.equal_range_multi(key); }
-
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
     return tree_.equal_range_multi(key);
   }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  pair<iterator, iterator> equal_range(const K& key) {
+    return tree_.equal_range_multi(key);
+  }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return tree_.equal_range_multi(key);
+  }
+
+  // 顺序统计，只有结点布局为RbTreeOrderStatisticTag（如OrderStatisticMultiSet）时可用
+  // select返回第k小的元素（k从0开始），rank返回键值小于key的元素个数，时间复杂度均为O(log n)
+  iterator select(size_type k) const { return tree_.select(k); }
+  size_type rank(const key_type& key) const { return tree_.rank(key); }
+  template <typename K, typename C = Compare, typename = mystl::EnableIfTransparent<C>>
+  size_type rank(const K& key) const {
+    return tree_.rank(key);
+  }
 
   void swap(MultiSet& rhs) noexcept { tree_.swap(rhs.tree_); }
 
@@ -348,42 +564,62 @@ class MultiSet {
 };
 
 // 重载比较操作符
-template <typename Key, typename Compare>
-bool operator==(const MultiSet<Key, Compare>& lhs, const MultiSet<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename NodeTag>
+bool operator==(const MultiSet<Key, Compare, NodeTag>& lhs,
+                const MultiSet<Key, Compare, NodeTag>& rhs) {
   return lhs == rhs;
 }
 
-template <typename Key, typename Compare>
-bool operator<(const MultiSet<Key, Compare>& lhs, const MultiSet<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename NodeTag>
+bool operator<(const MultiSet<Key, Compare, NodeTag>& lhs,
+               const MultiSet<Key, Compare, NodeTag>& rhs) {
   return lhs < rhs;
 }
 
-template <typename Key, typename Compare>
-bool operator!=(const MultiSet<Key, Compare>& lhs, const MultiSet<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename NodeTag>
+bool operator!=(const MultiSet<Key, Compare, NodeTag>& lhs,
+                const MultiSet<Key, Compare, NodeTag>& rhs) {
   return !(lhs == rhs);
 }
 
-template <typename Key, typename Compare>
-bool operator>(const MultiSet<Key, Compare>& lhs, const MultiSet<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename NodeTag>
+bool operator>(const MultiSet<Key, Compare, NodeTag>& lhs,
+               const MultiSet<Key, Compare, NodeTag>& rhs) {
   return rhs < lhs;
 }
 
-template <typename Key, typename Compare>
-bool operator<=(const MultiSet<Key, Compare>& lhs, const MultiSet<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename NodeTag>
+bool operator<=(const MultiSet<Key, Compare, NodeTag>& lhs,
+                const MultiSet<Key, Compare, NodeTag>& rhs) {
   return !(rhs < lhs);
 }
 
-template <typename Key, typename Compare>
-bool operator>=(const MultiSet<Key, Compare>& lhs, const MultiSet<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename NodeTag>
+bool operator>=(const MultiSet<Key, Compare, NodeTag>& lhs,
+                const MultiSet<Key, Compare, NodeTag>& rhs) {
   return !(lhs < rhs);
 }
 
 // 重载mystl的swap
-template <typename Key, typename Compare>
-void swap(MultiSet<Key, Compare>& lhs, MultiSet<Key, Compare>& rhs) noexcept {
+template <typename Key, typename Compare, typename NodeTag>
+void swap(MultiSet<Key, Compare, NodeTag>& lhs, MultiSet<Key, Compare, NodeTag>& rhs) noexcept {
   lhs.swap(rhs);
 }
 
+// 支持select与rank的set与multiset，每个结点额外记录子树大小
+template <typename Key, typename Compare = mystl::Less<Key>>
+using OrderStatisticSet = Set<Key, Compare, mystl::RbTreeOrderStatisticTag>;
+
+template <typename Key, typename Compare = mystl::Less<Key>>
+using OrderStatisticMultiSet = MultiSet<Key, Compare, mystl::RbTreeOrderStatisticTag>;
+
+// 结点更紧凑的set与multiset，颜色存放在父结点指针的最低位，适合对内存敏感的场合
+template <typename Key, typename Compare = mystl::Less<Key>>
+using CompactSet = Set<Key, Compare, mystl::RbTreeCompactNodeTag>;
+
+template <typename Key, typename Compare = mystl::Less<Key>>
+using CompactMultiSet = MultiSet<Key, Compare, mystl::RbTreeCompactNodeTag>;
+
 }  // namespace mystl
 
 #endif  // ! MYTINYSTL_SET_H_
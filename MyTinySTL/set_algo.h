@@ -5,37 +5,70 @@
 // 所有函数都要求序列有序
 // 对应书6.5节
 
+// notes:
+//
+// 两个序列都是随机访问迭代器、且长度相差 kSetGallopRatio 倍以上时，改用倍增查找（galloping）：
+// 归并中某一侧的元素较小时，不再逐个前进，而是用 gallop_lower_bound 找到下一个不小于另一侧
+// 当前元素的位置，中间的一段整体复制或跳过。比较次数从 O(n + m) 降为 O(m log(n / m))，
+// 结果（包括重复元素的个数与来源）与逐个归并相同
+// set_intersection 在指向同一种 4 字节整数（如 uint32_t）的指针上使用 SIMD 前进（见 simd.h）
+
 #include "algobase.h"
+#include "functional.h"
 #include "iterator.h"
+#include "simd.h"
 
 namespace mystl {
 
-// set_union
-// 计算S1 ∪ S2的结果并保存到result中，返回一个迭代器指向输出结果的尾部
-template <typename InputIter1, typename InputIter2, typename OutputIter>
-OutputIter set_union(
-    InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
-  while (first1 != last1 && first2 != last2) {
-    if (*first1 < *first2) {
-      *result = *first1;
-      ++first1;
-    } else if (*first2 < *first1) {
-      *result = *first2;
-      ++first2;
+// 较长的序列至少是较短的序列的这么多倍时使用倍增查找
+constexpr size_t kSetGallopRatio = 64;
+
+// 两个序列的长度是否相差足够大
+inline bool set_skewed(size_t n1, size_t n2) {
+  return n1 / kSetGallopRatio >= n2 || n2 / kSetGallopRatio >= n1;
+}
+
+// gallop_lower_bound
+// 在有序区间 [first, last) 中查找第一个不小于value的位置，调用者保证 comp(*first, value) 为 true
+// 依次检查下标 1, 3, 7, 15, ... 直到越过目标，再在最后一段中二分查找，
+// 比较次数与结果到first的距离的对数成正比
+template <typename RandomIter, typename T, typename Compared>
+RandomIter gallop_lower_bound(RandomIter first, RandomIter last, const T& value, Compared comp) {
+  using diff_type = typename IteratorTraits<RandomIter>::difference_type;
+  const diff_type n = last - first;
+  diff_type prev = 0;
+  diff_type cur = 1;
+  while (cur < n && comp(first[cur], value)) {
+    prev = cur;
+    cur = cur * 2 + 1;
+  }
+  // 结果在 (prev, min(cur, n)] 中
+  RandomIter pos = first + (prev + 1);
+  diff_type len = (cur < n ? cur : n) - (prev + 1);
+  while (len > 0) {
+    const diff_type half = len / 2;
+    RandomIter mid = pos + half;
+    if (comp(*mid, value)) {
+      pos = mid + 1;
+      len -= half + 1;
     } else {
-      *result = *first1;
-      ++first1;
-      ++first2;
+      len = half;
     }
-    ++result;
   }
-  // 将剩余元素拷贝到result
-  return mystl::copy(first2, last2, mystl::copy(first1, last1, result));
+  return pos;
 }
 
-// 重载版本使用函数对象comp代替比较操作
+// 两个迭代器是否都是随机访问迭代器
+template <typename Iter1, typename Iter2>
+struct IsSetRandomAccess
+    : public m_bool_constant<IsRandomAccessIterator<Iter1>::kValue &&
+                             IsRandomAccessIterator<Iter2>::kValue> {};
+
+// set_union
+// 计算S1 ∪ S2的结果并保存到result中，返回一个迭代器指向输出结果的尾部
+// 逐个归并
 template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
-OutputIter set_union(
+OutputIter set_union_merge(
     InputIter1 first1,
     InputIter1 last1,
     InputIter2 first2,
@@ -60,16 +93,24 @@ OutputIter set_union(
   return mystl::copy(first2, last2, mystl::copy(first1, last1, result));
 }
 
-// set_intersection
-// 计算S1 ∩ S2的结果并保存到result中，返回一个迭代器指向输出结果的尾部
-template <typename InputIter1, typename InputIter2, typename OutputIter>
-OutputIter set_intersection(
-    InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
+// 倍增查找
+template <typename RandomIter1, typename RandomIter2, typename OutputIter, typename Compared>
+OutputIter set_union_gallop(
+    RandomIter1 first1,
+    RandomIter1 last1,
+    RandomIter2 first2,
+    RandomIter2 last2,
+    OutputIter result,
+    Compared comp) {
   while (first1 != last1 && first2 != last2) {
-    if (*first1 < *first2) {
-      ++first1;
-    } else if (*first2 < *first1) {
-      ++first2;
+    if (comp(*first1, *first2)) {
+      auto next = mystl::gallop_lower_bound(first1, last1, *first2, comp);
+      result = mystl::copy(first1, next, result);
+      first1 = next;
+    } else if (comp(*first2, *first1)) {
+      auto next = mystl::gallop_lower_bound(first2, last2, *first1, comp);
+      result = mystl::copy(first2, next, result);
+      first2 = next;
     } else {
       *result = *first1;
       ++first1;
@@ -77,12 +118,63 @@ OutputIter set_intersection(
       ++result;
     }
   }
-  return result;
+  // 将剩余元素拷贝到result
+  return mystl::copy(first2, last2, mystl::copy(first1, last1, result));
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
+OutputIter set_union_dispatch(
+    InputIter1 first1,
+    InputIter1 last1,
+    InputIter2 first2,
+    InputIter2 last2,
+    OutputIter result,
+    Compared comp,
+    m_false_type /*unused*/) {
+  return mystl::set_union_merge(first1, last1, first2, last2, result, comp);
+}
+
+template <typename RandomIter1, typename RandomIter2, typename OutputIter, typename Compared>
+OutputIter set_union_dispatch(
+    RandomIter1 first1,
+    RandomIter1 last1,
+    RandomIter2 first2,
+    RandomIter2 last2,
+    OutputIter result,
+    Compared comp,
+    m_true_type /*unused*/) {
+  if (mystl::set_skewed(static_cast<size_t>(last1 - first1),
+                        static_cast<size_t>(last2 - first2))) {
+    return mystl::set_union_gallop(first1, last1, first2, last2, result, comp);
+  }
+  return mystl::set_union_merge(first1, last1, first2, last2, result, comp);
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter>
+OutputIter set_union(
+    InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
+  return mystl::set_union_dispatch(first1, last1, first2, last2, result, mystl::Less<void>(),
+                                   IsSetRandomAccess<InputIter1, InputIter2>());
 }
 
 // 重载版本使用函数对象comp代替比较操作
 template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
-OutputIter set_intersection(
+OutputIter set_union(
+    InputIter1 first1,
+    InputIter1 last1,
+    InputIter2 first2,
+    InputIter2 last2,
+    OutputIter result,
+    Compared comp) {
+  return mystl::set_union_dispatch(first1, last1, first2, last2, result, comp,
+                                   IsSetRandomAccess<InputIter1, InputIter2>());
+}
+
+// set_intersection
+// 计算S1 ∩ S2的结果并保存到result中，返回一个迭代器指向输出结果的尾部
+// 逐个归并
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
+OutputIter set_intersection_merge(
     InputIter1 first1,
     InputIter1 last1,
     InputIter2 first2,
@@ -104,30 +196,111 @@ OutputIter set_intersection(
   return result;
 }
 
-// set_difference
-// 计算S1 - S2的结果并保存到result中，返回一个迭代器指向输出结果的尾部
-template <typename InputIter1, typename InputIter2, typename OutputIter>
-OutputIter set_difference(
-    InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
+// 倍增查找
+template <typename RandomIter1, typename RandomIter2, typename OutputIter, typename Compared>
+OutputIter set_intersection_gallop(
+    RandomIter1 first1,
+    RandomIter1 last1,
+    RandomIter2 first2,
+    RandomIter2 last2,
+    OutputIter result,
+    Compared comp) {
   while (first1 != last1 && first2 != last2) {
-    if (*first1 < *first2) {
-      *result = *first1;
-      ++first1;
-      ++result;
-    } else if (*first2 < *first1) {
-      ++first2;
+    if (comp(*first1, *first2)) {
+      first1 = mystl::gallop_lower_bound(first1, last1, *first2, comp);
+    } else if (comp(*first2, *first1)) {
+      first2 = mystl::gallop_lower_bound(first2, last2, *first1, comp);
     } else {
+      *result = *first1;
       ++first1;
       ++first2;
+      ++result;
     }
   }
-  // 将剩余元素拷贝到result
-  return mystl::copy(first1, last1, result);
+  return result;
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
+OutputIter set_intersection_dispatch(
+    InputIter1 first1,
+    InputIter1 last1,
+    InputIter2 first2,
+    InputIter2 last2,
+    OutputIter result,
+    Compared comp,
+    m_false_type /*unused*/) {
+  return mystl::set_intersection_merge(first1, last1, first2, last2, result, comp);
+}
+
+template <typename RandomIter1, typename RandomIter2, typename OutputIter, typename Compared>
+OutputIter set_intersection_dispatch(
+    RandomIter1 first1,
+    RandomIter1 last1,
+    RandomIter2 first2,
+    RandomIter2 last2,
+    OutputIter result,
+    Compared comp,
+    m_true_type /*unused*/) {
+  if (mystl::set_skewed(static_cast<size_t>(last1 - first1),
+                        static_cast<size_t>(last2 - first2))) {
+    return mystl::set_intersection_gallop(first1, last1, first2, last2, result, comp);
+  }
+  return mystl::set_intersection_merge(first1, last1, first2, last2, result, comp);
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter>
+OutputIter set_intersection_simd(
+    InputIter1 first1,
+    InputIter1 last1,
+    InputIter2 first2,
+    InputIter2 last2,
+    OutputIter result,
+    m_false_type /*unused*/) {
+  return mystl::set_intersection_dispatch(first1, last1, first2, last2, result, mystl::Less<void>(),
+                                          IsSetRandomAccess<InputIter1, InputIter2>());
+}
+
+#if MYSTL_SIMD_X86
+// 指向同一种 4 字节整数的指针：长度相差很大时仍用倍增查找，否则用 SIMD 前进
+template <typename T1, typename T2, typename OutputIter>
+OutputIter set_intersection_simd(
+    T1* first1, T1* last1, T2* first2, T2* last2, OutputIter result, m_true_type /*unused*/) {
+  const size_t n1 = static_cast<size_t>(last1 - first1);
+  const size_t n2 = static_cast<size_t>(last2 - first2);
+  if (mystl::set_skewed(n1, n2)) {
+    return mystl::set_intersection_gallop(first1, last1, first2, last2, result,
+                                          mystl::Less<void>());
+  }
+  using value_type = typename std::remove_const<T1>::type;
+  return mystl::simd_set_intersection<value_type>(first1, last1, first2, last2, result);
+}
+#endif  // MYSTL_SIMD_X86
+
+template <typename InputIter1, typename InputIter2, typename OutputIter>
+OutputIter set_intersection(
+    InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
+  return mystl::set_intersection_simd(first1, last1, first2, last2, result,
+                                      IsSimdIntersectable<InputIter1, InputIter2>());
 }
 
 // 重载版本使用函数对象comp代替比较操作
 template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
-OutputIter set_difference(
+OutputIter set_intersection(
+    InputIter1 first1,
+    InputIter1 last1,
+    InputIter2 first2,
+    InputIter2 last2,
+    OutputIter result,
+    Compared comp) {
+  return mystl::set_intersection_dispatch(first1, last1, first2, last2, result, comp,
+                                          IsSetRandomAccess<InputIter1, InputIter2>());
+}
+
+// set_difference
+// 计算S1 - S2的结果并保存到result中，返回一个迭代器指向输出结果的尾部
+// 逐个归并
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
+OutputIter set_difference_merge(
     InputIter1 first1,
     InputIter1 last1,
     InputIter2 first2,
@@ -150,32 +323,84 @@ OutputIter set_difference(
   return mystl::copy(first1, last1, result);
 }
 
-// set_symmetric_difference
-// 计算(S1 - S2) ∪ (S2 - S1)的结果并保存到result中，返回一个迭代器指向输出结果的尾部
-template <typename InputIter1, typename InputIter2, typename OutputIter>
-OutputIter set_symmetric_difference(
-    InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
+// 倍增查找
+template <typename RandomIter1, typename RandomIter2, typename OutputIter, typename Compared>
+OutputIter set_difference_gallop(
+    RandomIter1 first1,
+    RandomIter1 last1,
+    RandomIter2 first2,
+    RandomIter2 last2,
+    OutputIter result,
+    Compared comp) {
   while (first1 != last1 && first2 != last2) {
-    if (*first1 < *first2) {
-      *result = *first1;
-      ++first1;
-      ++result;
-    } else if (*first2 < *first1) {
-      *result = *first2 ;
-      ++first2;
-      ++result;
+    if (comp(*first1, *first2)) {
+      auto next = mystl::gallop_lower_bound(first1, last1, *first2, comp);
+      result = mystl::copy(first1, next, result);
+      first1 = next;
+    } else if (comp(*first2, *first1)) {
+      first2 = mystl::gallop_lower_bound(first2, last2, *first1, comp);
     } else {
       ++first1;
       ++first2;
     }
   }
   // 将剩余元素拷贝到result
-  return mystl::copy(first2, last2, mystl::copy(first1, last1, result));
+  return mystl::copy(first1, last1, result);
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
+OutputIter set_difference_dispatch(
+    InputIter1 first1,
+    InputIter1 last1,
+    InputIter2 first2,
+    InputIter2 last2,
+    OutputIter result,
+    Compared comp,
+    m_false_type /*unused*/) {
+  return mystl::set_difference_merge(first1, last1, first2, last2, result, comp);
+}
+
+template <typename RandomIter1, typename RandomIter2, typename OutputIter, typename Compared>
+OutputIter set_difference_dispatch(
+    RandomIter1 first1,
+    RandomIter1 last1,
+    RandomIter2 first2,
+    RandomIter2 last2,
+    OutputIter result,
+    Compared comp,
+    m_true_type /*unused*/) {
+  if (mystl::set_skewed(static_cast<size_t>(last1 - first1),
+                        static_cast<size_t>(last2 - first2))) {
+    return mystl::set_difference_gallop(first1, last1, first2, last2, result, comp);
+  }
+  return mystl::set_difference_merge(first1, last1, first2, last2, result, comp);
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter>
+OutputIter set_difference(
+    InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
+  return mystl::set_difference_dispatch(first1, last1, first2, last2, result, mystl::Less<void>(),
+                                        IsSetRandomAccess<InputIter1, InputIter2>());
 }
 
 // 重载版本使用函数对象comp代替比较操作
 template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
-OutputIter set_symmetric_difference(
+OutputIter set_difference(
+    InputIter1 first1,
+    InputIter1 last1,
+    InputIter2 first2,
+    InputIter2 last2,
+    OutputIter result,
+    Compared comp) {
+  return mystl::set_difference_dispatch(first1, last1, first2, last2, result, comp,
+                                        IsSetRandomAccess<InputIter1, InputIter2>());
+}
+
+// set_symmetric_difference
+// 计算(S1 - S2) ∪ (S2 - S1)的结果并保存到result中，返回一个迭代器指向输出结果的尾部
+// 逐个归并
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
+OutputIter set_symmetric_difference_merge(
     InputIter1 first1,
     InputIter1 last1,
     InputIter2 first2,
@@ -200,5 +425,81 @@ OutputIter set_symmetric_difference(
   return mystl::copy(first2, last2, mystl::copy(first1, last1, result));
 }
 
+// 倍增查找
+template <typename RandomIter1, typename RandomIter2, typename OutputIter, typename Compared>
+OutputIter set_symmetric_difference_gallop(
+    RandomIter1 first1,
+    RandomIter1 last1,
+    RandomIter2 first2,
+    RandomIter2 last2,
+    OutputIter result,
+    Compared comp) {
+  while (first1 != last1 && first2 != last2) {
+    if (comp(*first1, *first2)) {
+      auto next = mystl::gallop_lower_bound(first1, last1, *first2, comp);
+      result = mystl::copy(first1, next, result);
+      first1 = next;
+    } else if (comp(*first2, *first1)) {
+      auto next = mystl::gallop_lower_bound(first2, last2, *first1, comp);
+      result = mystl::copy(first2, next, result);
+      first2 = next;
+    } else {
+      ++first1;
+      ++first2;
+    }
+  }
+  // 将剩余元素拷贝到result
+  return mystl::copy(first2, last2, mystl::copy(first1, last1, result));
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
+OutputIter set_symmetric_difference_dispatch(
+    InputIter1 first1,
+    InputIter1 last1,
+    InputIter2 first2,
+    InputIter2 last2,
+    OutputIter result,
+    Compared comp,
+    m_false_type /*unused*/) {
+  return mystl::set_symmetric_difference_merge(first1, last1, first2, last2, result, comp);
+}
+
+template <typename RandomIter1, typename RandomIter2, typename OutputIter, typename Compared>
+OutputIter set_symmetric_difference_dispatch(
+    RandomIter1 first1,
+    RandomIter1 last1,
+    RandomIter2 first2,
+    RandomIter2 last2,
+    OutputIter result,
+    Compared comp,
+    m_true_type /*unused*/) {
+  if (mystl::set_skewed(static_cast<size_t>(last1 - first1),
+                        static_cast<size_t>(last2 - first2))) {
+    return mystl::set_symmetric_difference_gallop(first1, last1, first2, last2, result, comp);
+  }
+  return mystl::set_symmetric_difference_merge(first1, last1, first2, last2, result, comp);
+}
+
+template <typename InputIter1, typename InputIter2, typename OutputIter>
+OutputIter set_symmetric_difference(
+    InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
+  return mystl::set_symmetric_difference_dispatch(first1, last1, first2, last2, result,
+                                                  mystl::Less<void>(),
+                                                  IsSetRandomAccess<InputIter1, InputIter2>());
+}
+
+// 重载版本使用函数对象comp代替比较操作
+template <typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
+OutputIter set_symmetric_difference(
+    InputIter1 first1,
+    InputIter1 last1,
+    InputIter2 first2,
+    InputIter2 last2,
+    OutputIter result,
+    Compared comp) {
+  return mystl::set_symmetric_difference_dispatch(first1, last1, first2, last2, result, comp,
+                                                  IsSetRandomAccess<InputIter1, InputIter2>());
+}
+
 }  // namespace mystl
 #endif  // !MYTINYSTL_SET_ALGO_H_
@@ -0,0 +1,777 @@
+#ifndef MYTINYSTL_SIMD_H_
+#define MYTINYSTL_SIMD_H_
+
+// 这个头文件包含针对连续存储的算术类型的 SIMD 内核，供 algobase.h、algo.h 与 set_algo.h 使用：
+// simd_find, simd_count, simd_min_element, simd_max_element, simd_mismatch, simd_set_intersection
+
+// notes:
+//
+// 只在 x86 上的 GCC / Clang 中启用（定义 MYSTL_NO_SIMD 可以关闭），其他平台上 IsSimdLane 恒为假，
+// 算法继续使用原来的逐个元素的循环
+// 每个内核有 SSE2 与 AVX2 两个版本：SSE2 是 x86-64 的基本指令集，AVX2 版本用 target 属性单独编译，
+// 第一次调用时检测处理器是否支持，之后直接选择对应的版本
+// 内核一次比较一个向量，相等的结果通过 movemask 转成字节掩码，
+// 因此不同宽度的元素可以用同样的方式求出下标（字节下标除以元素大小）和个数
+//
+// 支持的元素类型为除 bool 以外大小为 1、2、4、8 字节的算术类型：
+//   * find、count 对整数按位比较，对浮点数使用浮点比较（NaN 不等于任何值，+0 等于 -0）
+//   * min_element、max_element 不支持 8 字节整数；浮点数先求出最值，
+//     遇到 NaN 时交给逐个元素的循环处理，以保持与 operator< 相同的结果
+//   * mismatch 只支持整数，按字节比较
+//   * set_intersection 只支持 4 字节整数（如 uint32_t）
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "type_traits.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && \
+    !defined(MYSTL_NO_SIMD)
+#define MYSTL_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define MYSTL_SIMD_X86 0
+#endif
+
+namespace mystl {
+
+// IsSimdLane : 元素类型能否交给 SIMD 内核处理
+template <typename T>
+struct IsSimdLane
+    : public m_bool_constant<MYSTL_SIMD_X86 && std::is_arithmetic<T>::value &&
+                             !std::is_same<T, bool>::value && !std::is_volatile<T>::value &&
+                             (std::is_integral<T>::value
+                                  ? (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+                                     sizeof(T) == 8)
+                                  : (sizeof(T) == 4 || sizeof(T) == 8))> {};
+
+// IsSimdMinMaxLane : 能否用 SIMD 求最值，8 字节整数没有对应的指令
+template <typename T>
+struct IsSimdMinMaxLane
+    : public m_bool_constant<IsSimdLane<T>::kValue &&
+                             !(std::is_integral<T>::value && sizeof(T) == 8)> {};
+
+// IsSimdFindable : 能否在 [first, last) 中用 SIMD 查找与 T 类型的值相等的元素
+// 迭代器必须是指针；值的类型与元素类型相同，或者二者都是整数，
+// 或者值是浮点数且元素的每个值都能用它精确表示（如 unsigned char 与 double、float 与 double），
+// 这样元素与值相等当且仅当值能精确转换为元素类型并与元素相等
+template <typename Iter, typename T>
+struct IsSimdFindable : public m_false_type {};
+
+template <typename U, typename T>
+struct IsSimdFindable<U*, T>
+    : public m_bool_constant<
+          IsSimdLane<typename std::remove_const<U>::type>::kValue &&
+          (std::is_same<typename std::remove_const<U>::type, T>::value ||
+           (std::is_integral<U>::value && std::is_integral<T>::value) ||
+           (std::is_floating_point<T>::value &&
+            std::numeric_limits<U>::digits <= std::numeric_limits<T>::digits &&
+            std::numeric_limits<U>::max_exponent <= std::numeric_limits<T>::max_exponent))> {};
+
+// simd_lane_holds : 值能否用 static_cast 转换为元素类型 Lane，不能时应当退回逐个元素的循环
+// 整数之间的转换总是有定义的；浮点数超出 Lane 的范围时转换是未定义行为，NaN 也不能转换为整数
+template <typename Lane, typename T, typename LaneIsIntegral>
+bool simd_lane_holds_aux(const T& /*value*/, m_false_type /*unused*/, LaneIsIntegral /*unused*/) {
+  return true;
+}
+
+// 整数的范围是 [min, max + 1)，两端都是2的幂，能用浮点数精确表示；NaN 与任何值比较都为假
+template <typename Lane, typename T>
+bool simd_lane_holds_aux(const T& value, m_true_type /*unused*/, m_true_type /*unused*/) {
+  return value >= static_cast<T>(std::numeric_limits<Lane>::min()) &&
+         value < static_cast<T>(std::numeric_limits<Lane>::max() / 2 + 1) * 2;
+}
+
+template <typename Lane, typename T>
+bool simd_lane_holds_aux(const T& value, m_true_type /*unused*/, m_false_type /*unused*/) {
+  return !(value < static_cast<T>(std::numeric_limits<Lane>::lowest()) ||
+           value > static_cast<T>(std::numeric_limits<Lane>::max()));
+}
+
+template <typename Lane, typename T>
+bool simd_lane_holds(const T& value) {
+  return simd_lane_holds_aux<Lane>(
+      value,
+      m_bool_constant<std::is_floating_point<T>::value && !std::is_same<Lane, T>::value>(),
+      m_bool_constant<std::is_integral<Lane>::value>());
+}
+
+// IsSimdMinMaxIterator : 能否在 [first, last) 中用 SIMD 求最值
+template <typename Iter>
+struct IsSimdMinMaxIterator : public m_false_type {};
+
+template <typename U>
+struct IsSimdMinMaxIterator<U*>
+    : public m_bool_constant<IsSimdMinMaxLane<typename std::remove_const<U>::type>::kValue> {};
+
+// IsSimdMismatchable : 两个序列能否按字节比较，二者必须是指向同一种整数类型的指针
+template <typename Iter1, typename Iter2>
+struct IsSimdMismatchable : public m_false_type {};
+
+template <typename U1, typename U2>
+struct IsSimdMismatchable<U1*, U2*>
+    : public m_bool_constant<
+          IsSimdLane<typename std::remove_const<U1>::type>::kValue &&
+          std::is_integral<U1>::value &&
+          std::is_same<typename std::remove_const<U1>::type,
+                       typename std::remove_const<U2>::type>::value> {};
+
+// IsSimdIntersectable : 两个有序序列能否用 SIMD 求交集，二者必须是指向同一种 4 字节整数类型的指针
+template <typename Iter1, typename Iter2>
+struct IsSimdIntersectable : public m_false_type {};
+
+template <typename U1, typename U2>
+struct IsSimdIntersectable<U1*, U2*>
+    : public m_bool_constant<
+          IsSimdLane<typename std::remove_const<U1>::type>::kValue &&
+          std::is_integral<U1>::value && sizeof(U1) == 4 &&
+          std::is_same<typename std::remove_const<U1>::type,
+                       typename std::remove_const<U2>::type>::value> {};
+
+#if MYSTL_SIMD_X86
+
+#define MYSTL_SIMD_INLINE __attribute__((always_inline)) inline
+#define MYSTL_SIMD_AVX2 __attribute__((target("avx2,popcnt")))
+#define MYSTL_SIMD_AVX2_INLINE __attribute__((target("avx2,popcnt"), always_inline)) inline
+
+namespace simd {
+
+// 元素的种类：0 为无符号整数，1 为有符号整数，2 为浮点数
+template <typename T>
+struct LaneKind
+    : public MIntegralConstant<int, std::is_floating_point<T>::value ? 2
+                                    : std::is_signed<T>::value       ? 1
+                                                                     : 0> {};
+
+/*****************************************************************************************/
+// SSE2 操作
+// load / store 读写一个向量，splat 把一个值复制到每个分量，eq 返回逐字节的相等掩码，
+// min / max 逐分量求最值，nan 返回含有 NaN 的分量的掩码（整数恒为0）
+/*****************************************************************************************/
+
+template <typename T, size_t Size = sizeof(T), int Kind = LaneKind<T>::kValue>
+struct Sse2Ops;
+
+template <typename T>
+struct Sse2IntOps {
+  using vec = __m128i;
+  static MYSTL_SIMD_INLINE vec load(const T* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  }
+  static MYSTL_SIMD_INLINE void store(T* p, vec v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+  }
+  static MYSTL_SIMD_INLINE unsigned nan(vec) { return 0; }
+  // 根据掩码 m 逐位选择 b（m 为1）或 a（m 为0）
+  static MYSTL_SIMD_INLINE vec select(vec a, vec b, vec m) {
+    return _mm_or_si128(_mm_and_si128(m, b), _mm_andnot_si128(m, a));
+  }
+};
+
+template <typename T>
+struct Sse2Ops<T, 1, 0> : public Sse2IntOps<T> {
+  using vec = __m128i;
+  static MYSTL_SIMD_INLINE vec splat(T v) { return _mm_set1_epi8(static_cast<char>(v)); }
+  static MYSTL_SIMD_INLINE unsigned eq(vec a, vec b) {
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+  }
+  static MYSTL_SIMD_INLINE vec min(vec a, vec b) { return _mm_min_epu8(a, b); }
+  static MYSTL_SIMD_INLINE vec max(vec a, vec b) { return _mm_max_epu8(a, b); }
+};
+
+// SSE2 只有无符号字节的最值指令，翻转符号位后比较
+template <typename T>
+struct Sse2Ops<T, 1, 1> : public Sse2Ops<T, 1, 0> {
+  using vec = __m128i;
+  static MYSTL_SIMD_INLINE vec bias() { return _mm_set1_epi8(static_cast<char>(0x80)); }
+  static MYSTL_SIMD_INLINE vec min(vec a, vec b) {
+    const vec k = bias();
+    return _mm_xor_si128(_mm_min_epu8(_mm_xor_si128(a, k), _mm_xor_si128(b, k)), k);
+  }
+  static MYSTL_SIMD_INLINE vec max(vec a, vec b) {
+    const vec k = bias();
+    return _mm_xor_si128(_mm_max_epu8(_mm_xor_si128(a, k), _mm_xor_si128(b, k)), k);
+  }
+};
+
+template <typename T>
+struct Sse2Ops<T, 2, 1> : public Sse2IntOps<T> {
+  using vec = __m128i;
+  static MYSTL_SIMD_INLINE vec splat(T v) { return _mm_set1_epi16(static_cast<short>(v)); }
+  static MYSTL_SIMD_INLINE unsigned eq(vec a, vec b) {
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(a, b)));
+  }
+  static MYSTL_SIMD_INLINE vec min(vec a, vec b) { return _mm_min_epi16(a, b); }
+  static MYSTL_SIMD_INLINE vec max(vec a, vec b) { return _mm_max_epi16(a, b); }
+};
+
+// SSE2 只有有符号 16 位的最值指令，翻转符号位后比较
+template <typename T>
+struct Sse2Ops<T, 2, 0> : public Sse2Ops<T, 2, 1> {
+  using vec = __m128i;
+  static MYSTL_SIMD_INLINE vec bias() { return _mm_set1_epi16(static_cast<short>(0x8000)); }
+  static MYSTL_SIMD_INLINE vec min(vec a, vec b) {
+    const vec k = bias();
+    return _mm_xor_si128(_mm_min_epi16(_mm_xor_si128(a, k), _mm_xor_si128(b, k)), k);
+  }
+  static MYSTL_SIMD_INLINE vec max(vec a, vec b) {
+    const vec k = bias();
+    return _mm_xor_si128(_mm_max_epi16(_mm_xor_si128(a, k), _mm_xor_si128(b, k)), k);
+  }
+};
+
+// SSE2 没有 32 位的最值指令，用比较的结果选择
+template <typename T>
+struct Sse2Ops<T, 4, 1> : public Sse2IntOps<T> {
+  using vec = __m128i;
+  static MYSTL_SIMD_INLINE vec splat(T v) { return _mm_set1_epi32(static_cast<int>(v)); }
+  static MYSTL_SIMD_INLINE unsigned eq(vec a, vec b) {
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi32(a, b)));
+  }
+  static MYSTL_SIMD_INLINE vec greater(vec a, vec b) { return _mm_cmpgt_epi32(a, b); }
+  static MYSTL_SIMD_INLINE vec min(vec a, vec b) {
+    return Sse2IntOps<T>::select(a, b, greater(a, b));
+  }
+  static MYSTL_SIMD_INLINE vec max(vec a, vec b) {
+    return Sse2IntOps<T>::select(a, b, greater(b, a));
+  }
+};
+
+template <typename T>
+struct Sse2Ops<T, 4, 0> : public Sse2IntOps<T> {
+  using vec = __m128i;
+  static MYSTL_SIMD_INLINE vec splat(T v) { return _mm_set1_epi32(static_cast<int>(v)); }
+  static MYSTL_SIMD_INLINE unsigned eq(vec a, vec b) {
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi32(a, b)));
+  }
+  static MYSTL_SIMD_INLINE vec greater(vec a, vec b) {
+    const vec k = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    return _mm_cmpgt_epi32(_mm_xor_si128(a, k), _mm_xor_si128(b, k));
+  }
+  static MYSTL_SIMD_INLINE vec min(vec a, vec b) {
+    return Sse2IntOps<T>::select(a, b, greater(a, b));
+  }
+  static MYSTL_SIMD_INLINE vec max(vec a, vec b) {
+    return Sse2IntOps<T>::select(a, b, greater(b, a));
+  }
+};
+
+// SSE2 没有 64 位的相等比较，两个 32 位的一半都相等时才相等
+template <typename T, int Kind>
+struct Sse2Ops<T, 8, Kind> : public Sse2IntOps<T> {
+  using vec = __m128i;
+  static MYSTL_SIMD_INLINE vec splat(T v) { return _mm_set1_epi64x(static_cast<long long>(v)); }
+  static MYSTL_SIMD_INLINE unsigned eq(vec a, vec b) {
+    const vec half = _mm_cmpeq_epi32(a, b);
+    const vec both = _mm_and_si128(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return static_cast<unsigned>(_mm_movemask_epi8(both));
+  }
+};
+
+template <typename T>
+struct Sse2Ops<T, 4, 2> {
+  using vec = __m128;
+  static MYSTL_SIMD_INLINE vec load(const T* p) { return _mm_loadu_ps(p); }
+  static MYSTL_SIMD_INLINE void store(T* p, vec v) { _mm_storeu_ps(p, v); }
+  static MYSTL_SIMD_INLINE vec splat(T v) { return _mm_set1_ps(v); }
+  static MYSTL_SIMD_INLINE unsigned eq(vec a, vec b) {
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(a, b))));
+  }
+  static MYSTL_SIMD_INLINE vec min(vec a, vec b) { return _mm_min_ps(a, b); }
+  static MYSTL_SIMD_INLINE vec max(vec a, vec b) { return _mm_max_ps(a, b); }
+  static MYSTL_SIMD_INLINE unsigned nan(vec v) {
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpunord_ps(v, v)));
+  }
+};
+
+template <typename T>
+struct Sse2Ops<T, 8, 2> {
+  using vec = __m128d;
+  static MYSTL_SIMD_INLINE vec load(const T* p) { return _mm_loadu_pd(p); }
+  static MYSTL_SIMD_INLINE void store(T* p, vec v) { _mm_storeu_pd(p, v); }
+  static MYSTL_SIMD_INLINE vec splat(T v) { return _mm_set1_pd(v); }
+  static MYSTL_SIMD_INLINE unsigned eq(vec a, vec b) {
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(a, b))));
+  }
+  static MYSTL_SIMD_INLINE vec min(vec a, vec b) { return _mm_min_pd(a, b); }
+  static MYSTL_SIMD_INLINE vec max(vec a, vec b) { return _mm_max_pd(a, b); }
+  static MYSTL_SIMD_INLINE unsigned nan(vec v) {
+    return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpunord_pd(v, v)));
+  }
+};
+
+/*****************************************************************************************/
+// AVX2 操作，接口与 SSE2 操作相同，每个向量 32 字节
+/*****************************************************************************************/
+
+template <typename T, size_t Size = sizeof(T), int Kind = LaneKind<T>::kValue>
+struct Avx2Ops;
+
+template <typename T>
+struct Avx2IntOps {
+  using vec = __m256i;
+  static MYSTL_SIMD_AVX2_INLINE vec load(const T* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  static MYSTL_SIMD_AVX2_INLINE void store(T* p, vec v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+  }
+  static MYSTL_SIMD_AVX2_INLINE unsigned nan(vec) { return 0; }
+};
+
+template <typename T>
+struct Avx2Ops<T, 1, 0> : public Avx2IntOps<T> {
+  using vec = __m256i;
+  static MYSTL_SIMD_AVX2_INLINE vec splat(T v) { return _mm256_set1_epi8(static_cast<char>(v)); }
+  static MYSTL_SIMD_AVX2_INLINE unsigned eq(vec a, vec b) {
+    return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+  }
+  static MYSTL_SIMD_AVX2_INLINE vec min(vec a, vec b) { return _mm256_min_epu8(a, b); }
+  static MYSTL_SIMD_AVX2_INLINE vec max(vec a, vec b) { return _mm256_max_epu8(a, b); }
+};
+
+template <typename T>
+struct Avx2Ops<T, 1, 1> : public Avx2Ops<T, 1, 0> {
+  using vec = __m256i;
+  static MYSTL_SIMD_AVX2_INLINE vec min(vec a, vec b) { return _mm256_min_epi8(a, b); }
+  static MYSTL_SIMD_AVX2_INLINE vec max(vec a, vec b) { return _mm256_max_epi8(a, b); }
+};
+
+template <typename T>
+struct Avx2Ops<T, 2, 0> : public Avx2IntOps<T> {
+  using vec = __m256i;
+  static MYSTL_SIMD_AVX2_INLINE vec splat(T v) {
+    return _mm256_set1_epi16(static_cast<short>(v));
+  }
+  static MYSTL_SIMD_AVX2_INLINE unsigned eq(vec a, vec b) {
+    return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b)));
+  }
+  static MYSTL_SIMD_AVX2_INLINE vec min(vec a, vec b) { return _mm256_min_epu16(a, b); }
+  static MYSTL_SIMD_AVX2_INLINE vec max(vec a, vec b) { return _mm256_max_epu16(a, b); }
+};
+
+template <typename T>
+struct Avx2Ops<T, 2, 1> : public Avx2Ops<T, 2, 0> {
+  using vec = __m256i;
+  static MYSTL_SIMD_AVX2_INLINE vec min(vec a, vec b) { return _mm256_min_epi16(a, b); }
+  static MYSTL_SIMD_AVX2_INLINE vec max(vec a, vec b) { return _mm256_max_epi16(a, b); }
+};
+
+template <typename T>
+struct Avx2Ops<T, 4, 0> : public Avx2IntOps<T> {
+  using vec = __m256i;
+  static MYSTL_SIMD_AVX2_INLINE vec splat(T v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+  static MYSTL_SIMD_AVX2_INLINE unsigned eq(vec a, vec b) {
+    return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, b)));
+  }
+  static MYSTL_SIMD_AVX2_INLINE vec greater(vec a, vec b) {
+    const vec k = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+    return _mm256_cmpgt_epi32(_mm256_xor_si256(a, k), _mm256_xor_si256(b, k));
+  }
+  static MYSTL_SIMD_AVX2_INLINE vec min(vec a, vec b) { return _mm256_min_epu32(a, b); }
+  static MYSTL_SIMD_AVX2_INLINE vec max(vec a, vec b) { return _mm256_max_epu32(a, b); }
+};
+
+template <typename T>
+struct Avx2Ops<T, 4, 1> : public Avx2Ops<T, 4, 0> {
+  using vec = __m256i;
+  static MYSTL_SIMD_AVX2_INLINE vec greater(vec a, vec b) { return _mm256_cmpgt_epi32(a, b); }
+  static MYSTL_SIMD_AVX2_INLINE vec min(vec a, vec b) { return _mm256_min_epi32(a, b); }
+  static MYSTL_SIMD_AVX2_INLINE vec max(vec a, vec b) { return _mm256_max_epi32(a, b); }
+};
+
+template <typename T, int Kind>
+struct Avx2Ops<T, 8, Kind> : public Avx2IntOps<T> {
+  using vec = __m256i;
+  static MYSTL_SIMD_AVX2_INLINE vec splat(T v) {
+    return _mm256_set1_epi64x(static_cast<long long>(v));
+  }
+  static MYSTL_SIMD_AVX2_INLINE unsigned eq(vec a, vec b) {
+    return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi64(a, b)));
+  }
+};
+
+template <typename T>
+struct Avx2Ops<T, 4, 2> {
+  using vec = __m256;
+  static MYSTL_SIMD_AVX2_INLINE vec load(const T* p) { return _mm256_loadu_ps(p); }
+  static MYSTL_SIMD_AVX2_INLINE void store(T* p, vec v) { _mm256_storeu_ps(p, v); }
+  static MYSTL_SIMD_AVX2_INLINE vec splat(T v) { return _mm256_set1_ps(v); }
+  static MYSTL_SIMD_AVX2_INLINE unsigned eq(vec a, vec b) {
+    const __m256i m = _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+    return static_cast<unsigned>(_mm256_movemask_epi8(m));
+  }
+  static MYSTL_SIMD_AVX2_INLINE vec min(vec a, vec b) { return _mm256_min_ps(a, b); }
+  static MYSTL_SIMD_AVX2_INLINE vec max(vec a, vec b) { return _mm256_max_ps(a, b); }
+  static MYSTL_SIMD_AVX2_INLINE unsigned nan(vec v) {
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)));
+  }
+};
+
+template <typename T>
+struct Avx2Ops<T, 8, 2> {
+  using vec = __m256d;
+  static MYSTL_SIMD_AVX2_INLINE vec load(const T* p) { return _mm256_loadu_pd(p); }
+  static MYSTL_SIMD_AVX2_INLINE void store(T* p, vec v) { _mm256_storeu_pd(p, v); }
+  static MYSTL_SIMD_AVX2_INLINE vec splat(T v) { return _mm256_set1_pd(v); }
+  static MYSTL_SIMD_AVX2_INLINE unsigned eq(vec a, vec b) {
+    const __m256i m = _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));
+    return static_cast<unsigned>(_mm256_movemask_epi8(m));
+  }
+  static MYSTL_SIMD_AVX2_INLINE vec min(vec a, vec b) { return _mm256_min_pd(a, b); }
+  static MYSTL_SIMD_AVX2_INLINE vec max(vec a, vec b) { return _mm256_max_pd(a, b); }
+  static MYSTL_SIMD_AVX2_INLINE unsigned nan(vec v) {
+    return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(v, v, _CMP_UNORD_Q)));
+  }
+};
+
+/*****************************************************************************************/
+// 内核
+// 编译器不允许把 AVX2 的函数内联到没有 target 属性的函数中，
+// 因此每个内核写两份，除了属性与所用的操作以外完全相同
+/*****************************************************************************************/
+
+// 逐个元素处理不足一个向量的部分
+template <typename T>
+const T* find_tail(const T* first, const T* last, T value) {
+  for (; first != last; ++first) {
+    if (*first == value) {
+      return first;
+    }
+  }
+  return last;
+}
+
+template <typename T>
+size_t count_tail(const T* first, const T* last, T value) {
+  size_t n = 0;
+  for (; first != last; ++first) {
+    n += *first == value ? 1 : 0;
+  }
+  return n;
+}
+
+// find：返回第一个相等的元素的位置
+template <typename T>
+const T* find_sse2(const T* first, const T* last, T value) {
+  using ops = Sse2Ops<T>;
+  constexpr ptrdiff_t kLanes = sizeof(typename ops::vec) / sizeof(T);
+  const auto s = ops::splat(value);
+  for (; last - first >= kLanes; first += kLanes) {
+    const unsigned m = ops::eq(ops::load(first), s);
+    if (m != 0) {
+      return first + __builtin_ctz(m) / sizeof(T);
+    }
+  }
+  return find_tail(first, last, value);
+}
+
+template <typename T>
+MYSTL_SIMD_AVX2 const T* find_avx2(const T* first, const T* last, T value) {
+  using ops = Avx2Ops<T>;
+  constexpr ptrdiff_t kLanes = sizeof(typename ops::vec) / sizeof(T);
+  const auto s = ops::splat(value);
+  for (; last - first >= kLanes; first += kLanes) {
+    const unsigned m = ops::eq(ops::load(first), s);
+    if (m != 0) {
+      return first + __builtin_ctz(m) / sizeof(T);
+    }
+  }
+  return find_tail(first, last, value);
+}
+
+// count：相等的分量在掩码中占 sizeof(T) 位
+template <typename T>
+size_t count_sse2(const T* first, const T* last, T value) {
+  using ops = Sse2Ops<T>;
+  constexpr ptrdiff_t kLanes = sizeof(typename ops::vec) / sizeof(T);
+  const auto s = ops::splat(value);
+  size_t bits = 0;
+  for (; last - first >= kLanes; first += kLanes) {
+    bits += static_cast<size_t>(__builtin_popcount(ops::eq(ops::load(first), s)));
+  }
+  return bits / sizeof(T) + count_tail(first, last, value);
+}
+
+template <typename T>
+MYSTL_SIMD_AVX2 size_t count_avx2(const T* first, const T* last, T value) {
+  using ops = Avx2Ops<T>;
+  constexpr ptrdiff_t kLanes = sizeof(typename ops::vec) / sizeof(T);
+  const auto s = ops::splat(value);
+  size_t bits = 0;
+  for (; last - first >= kLanes; first += kLanes) {
+    bits += static_cast<size_t>(__builtin_popcount(ops::eq(ops::load(first), s)));
+  }
+  return bits / sizeof(T) + count_tail(first, last, value);
+}
+
+// 求最值：Max 为 true 时求最大值，否则求最小值，结果写入 value
+// 末尾不足一个向量的部分与前面的元素重叠读取一次；遇到 NaN 时返回false
+template <bool Max, typename T>
+bool extreme_sse2(const T* first, const T* last, T& value) {
+  using ops = Sse2Ops<T>;
+  constexpr ptrdiff_t kLanes = sizeof(typename ops::vec) / sizeof(T);
+  auto acc = ops::load(first);
+  unsigned nan = ops::nan(acc);
+  for (first += kLanes; last - first >= kLanes; first += kLanes) {
+    const auto v = ops::load(first);
+    nan |= ops::nan(v);
+    acc = Max ? ops::max(acc, v) : ops::min(acc, v);
+  }
+  const auto v = ops::load(last - kLanes);
+  nan |= ops::nan(v);
+  acc = Max ? ops::max(acc, v) : ops::min(acc, v);
+  if (nan != 0) {
+    return false;
+  }
+  T lanes[kLanes];
+  ops::store(lanes, acc);
+  value = lanes[0];
+  for (ptrdiff_t i = 1; i < kLanes; ++i) {
+    if (Max ? value < lanes[i] : lanes[i] < value) {
+      value = lanes[i];
+    }
+  }
+  return true;
+}
+
+template <bool Max, typename T>
+MYSTL_SIMD_AVX2 bool extreme_avx2(const T* first, const T* last, T& value) {
+  using ops = Avx2Ops<T>;
+  constexpr ptrdiff_t kLanes = sizeof(typename ops::vec) / sizeof(T);
+  auto acc = ops::load(first);
+  unsigned nan = ops::nan(acc);
+  for (first += kLanes; last - first >= kLanes; first += kLanes) {
+    const auto v = ops::load(first);
+    nan |= ops::nan(v);
+    acc = Max ? ops::max(acc, v) : ops::min(acc, v);
+  }
+  const auto v = ops::load(last - kLanes);
+  nan |= ops::nan(v);
+  acc = Max ? ops::max(acc, v) : ops::min(acc, v);
+  if (nan != 0) {
+    return false;
+  }
+  T lanes[kLanes];
+  ops::store(lanes, acc);
+  value = lanes[0];
+  for (ptrdiff_t i = 1; i < kLanes; ++i) {
+    if (Max ? value < lanes[i] : lanes[i] < value) {
+      value = lanes[i];
+    }
+  }
+  return true;
+}
+
+// mismatch：返回两段长度为n的字节序列中第一个不同的字节的下标，全部相同时返回n
+inline size_t mismatch_sse2(const unsigned char* a, const unsigned char* b, size_t n) {
+  size_t i = 0;
+  for (; n - i >= 16; i += 16) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+    if (m != 0xffffu) {
+      return i + static_cast<size_t>(__builtin_ctz(~m));
+    }
+  }
+  while (i != n && a[i] == b[i]) {
+    ++i;
+  }
+  return i;
+}
+
+MYSTL_SIMD_AVX2 inline size_t mismatch_avx2(const unsigned char* a, const unsigned char* b,
+                                            size_t n) {
+  size_t i = 0;
+  for (; n - i >= 32; i += 32) {
+    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    const unsigned m = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+    if (m != 0xffffffffu) {
+      return i + static_cast<size_t>(__builtin_ctz(~m));
+    }
+  }
+  while (i != n && a[i] == b[i]) {
+    ++i;
+  }
+  return i;
+}
+
+// set_intersection：与逐个元素的归并相同，但一侧较小时不再一次前进一个元素，
+// 而是一次比较一个向量，小于另一侧当前元素的分量个数就是可以前进的距离（序列有序，这些分量在前部）
+// 重复的元素仍逐个配对，结果与 set_intersection 的定义相同
+template <typename T>
+const T* skip_less_sse2(const T* first, const T* last, T value) {
+  using ops = Sse2Ops<T>;
+  constexpr ptrdiff_t kLanes = sizeof(typename ops::vec) / sizeof(T);
+  if (first == last || !(*first < value)) {
+    return first;
+  }
+  const auto s = ops::splat(value);
+  for (; last - first >= kLanes; first += kLanes) {
+    const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(ops::greater(s, ops::load(first))));
+    if (m != 0xffffu) {
+      return first + __builtin_popcount(m) / sizeof(T);
+    }
+  }
+  while (first != last && *first < value) {
+    ++first;
+  }
+  return first;
+}
+
+template <typename T>
+MYSTL_SIMD_AVX2_INLINE const T* skip_less_avx2(const T* first, const T* last, T value) {
+  using ops = Avx2Ops<T>;
+  constexpr ptrdiff_t kLanes = sizeof(typename ops::vec) / sizeof(T);
+  if (first == last || !(*first < value)) {
+    return first;
+  }
+  const auto s = ops::splat(value);
+  for (; last - first >= kLanes; first += kLanes) {
+    const unsigned m =
+        static_cast<unsigned>(_mm256_movemask_epi8(ops::greater(s, ops::load(first))));
+    if (m != 0xffffffffu) {
+      return first + __builtin_popcount(m) / sizeof(T);
+    }
+  }
+  while (first != last && *first < value) {
+    ++first;
+  }
+  return first;
+}
+
+template <typename T, typename OutputIter>
+OutputIter intersection_sse2(const T* first1, const T* last1, const T* first2, const T* last2,
+                             OutputIter result) {
+  while (first1 != last1 && first2 != last2) {
+    if (*first1 < *first2) {
+      first1 = skip_less_sse2(first1 + 1, last1, *first2);
+    } else if (*first2 < *first1) {
+      first2 = skip_less_sse2(first2 + 1, last2, *first1);
+    } else {
+      *result = *first1;
+      ++first1;
+      ++first2;
+      ++result;
+    }
+  }
+  return result;
+}
+
+template <typename T, typename OutputIter>
+MYSTL_SIMD_AVX2 OutputIter intersection_avx2(const T* first1, const T* last1, const T* first2,
+                                             const T* last2, OutputIter result) {
+  while (first1 != last1 && first2 != last2) {
+    if (*first1 < *first2) {
+      first1 = skip_less_avx2(first1 + 1, last1, *first2);
+    } else if (*first2 < *first1) {
+      first2 = skip_less_avx2(first2 + 1, last2, *first1);
+    } else {
+      *result = *first1;
+      ++first1;
+      ++first2;
+      ++result;
+    }
+  }
+  return result;
+}
+
+// 处理器是否支持 AVX2，只检测一次
+inline bool has_avx2() noexcept {
+#if defined(__AVX2__)
+  return true;
+#else
+  static const bool kAvx2 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+  return kAvx2;
+#endif
+}
+
+}  // namespace simd
+
+#undef MYSTL_SIMD_INLINE
+#undef MYSTL_SIMD_AVX2
+#undef MYSTL_SIMD_AVX2_INLINE
+
+/*****************************************************************************************/
+// 对外的接口，调用者保证元素类型满足 IsSimdLane（求最值时满足 IsSimdMinMaxLane）
+/*****************************************************************************************/
+
+// 在 [first, last) 中查找第一个等于value的元素，找不到时返回last
+template <typename T>
+const T* simd_find(const T* first, const T* last, T value) {
+  return simd::has_avx2() ? simd::find_avx2(first, last, value)
+                          : simd::find_sse2(first, last, value);
+}
+
+// 统计 [first, last) 中等于value的元素个数
+template <typename T>
+size_t simd_count(const T* first, const T* last, T value) {
+  return simd::has_avx2() ? simd::count_avx2(first, last, value)
+                          : simd::count_sse2(first, last, value);
+}
+
+// 返回 [first, last) 中第一个最小（Max 为 true 时最大）的元素的位置
+// 先用 SIMD 求出最值，再查找它第一次出现的位置；含有 NaN 或元素太少时逐个比较
+template <bool Max, typename T>
+const T* simd_extreme_element(const T* first, const T* last) {
+  if (first == last) {
+    return last;
+  }
+  T value = *first;
+  const bool avx2 = simd::has_avx2();
+  const ptrdiff_t lanes = avx2 ? 32 / sizeof(T) : 16 / sizeof(T);
+  bool ok = false;
+  if (last - first >= lanes) {
+    ok = avx2 ? simd::extreme_avx2<Max>(first, last, value)
+              : simd::extreme_sse2<Max>(first, last, value);
+  }
+  if (ok) {
+    return avx2 ? simd::find_avx2(first, last, value) : simd::find_sse2(first, last, value);
+  }
+  const T* result = first;
+  while (++first != last) {
+    if (Max ? *result < *first : *first < *result) {
+      result = first;
+    }
+  }
+  return result;
+}
+
+template <typename T>
+const T* simd_min_element(const T* first, const T* last) {
+  return simd_extreme_element<false>(first, last);
+}
+
+template <typename T>
+const T* simd_max_element(const T* first, const T* last) {
+  return simd_extreme_element<true>(first, last);
+}
+
+// 返回 [first1, last1) 与从first2开始的序列中第一处不同的元素的下标
+template <typename T>
+size_t simd_mismatch(const T* first1, const T* last1, const T* first2) {
+  const size_t bytes = static_cast<size_t>(last1 - first1) * sizeof(T);
+  const auto a = reinterpret_cast<const unsigned char*>(first1);
+  const auto b = reinterpret_cast<const unsigned char*>(first2);
+  const size_t i = simd::has_avx2() ? simd::mismatch_avx2(a, b, bytes)
+                                    : simd::mismatch_sse2(a, b, bytes);
+  return i / sizeof(T);
+}
+
+// 求有序序列 [first1, last1) 与 [first2, last2) 的交集，写入result，返回输出结果的尾部
+template <typename T, typename OutputIter>
+OutputIter simd_set_intersection(const T* first1, const T* last1, const T* first2,
+                                 const T* last2, OutputIter result) {
+  return simd::has_avx2() ? simd::intersection_avx2(first1, last1, first2, last2, result)
+                          : simd::intersection_sse2(first1, last1, first2, last2, result);
+}
+
+#endif  // MYSTL_SIMD_X86
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_SIMD_H_
@@ -0,0 +1,578 @@
+#ifndef MYTINYSTL_THREAD_POOL_H_
+#define MYTINYSTL_THREAD_POOL_H_
+
+// 这个头文件包含一个工作窃取（work-stealing）的线程池与建立在它之上的任务调度接口
+// WorkStealingDeque : Chase-Lev 双端队列，拥有者在底部压入弹出，其他线程从顶部窃取
+// ThreadPool        : 每个工作线程一个 WorkStealingDeque，外部线程提交的任务放入全局注入队列
+// TaskGroup         : spawn 派生任务，wait 等待全部完成，等待时当前线程也会执行任务
+// parallel_for      : 把下标区间二分到不超过 grain 的小段，每一段作为一个任务
+
+// notes:
+//
+// 工作线程优先执行自己队列底部的任务（后进先出，局部性好），
+// 自己的队列为空时依次尝试全局注入队列和其他工作线程队列的顶部（先进先出，窃取到的多是大任务）
+// 找不到任务时先让出处理器若干次，仍然没有任务才在条件变量上睡眠
+//
+// 在工作线程中 spawn 的任务放入该线程自己的队列，不需要加锁；
+// 在其他线程中 spawn 的任务放入全局注入队列，由互斥量保护
+//
+// wait 不会阻塞当前线程，而是不断取出任务来执行，直到任务组中的任务全部完成，
+// 因此在任务中嵌套 spawn / wait 构成的分治递归（fork-join）不会死锁，
+// 线程池没有工作线程时所有任务都由调用 wait 的线程执行
+//
+// 任务抛出的第一个异常会被保存下来，在 wait 中重新抛出，其余异常被丢弃
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "allocator.h"
+#include "concurrent_queue.h"
+#include "exceptdef.h"
+#include "queue.h"
+#include "util.h"
+#include "vector.h"
+
+namespace mystl {
+
+// 模板类WorkStealingDeque
+// 参数一代表数据类型，要求可以平凡复制（通常为指针）
+// push / pop 只能由拥有者线程调用，steal 可以由任意线程调用
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "WorkStealingDeque<T> requires T to be trivially copyable");
+
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+ private:
+  // 环形数组，容量为2的幂；扩容后旧的数组可能仍被窃取者读取，因此留到析构时再释放
+  struct Array {
+    std::atomic<T>* slots;
+    ptrdiff_t mask;
+    Array* retired;
+  };
+
+  using slot_allocator = mystl::Allocator<std::atomic<T>>;
+  using array_allocator = mystl::Allocator<Array>;
+
+  // top_ 被窃取者修改，bottom_ 被拥有者修改，二者之间用填充隔开，避免伪共享
+  std::atomic<ptrdiff_t> top_;
+  char top_pad_[MYSTL_CACHE_LINE_SIZE - sizeof(std::atomic<ptrdiff_t>)];
+  std::atomic<ptrdiff_t> bottom_;
+  std::atomic<Array*> array_;
+  char bottom_pad_[MYSTL_CACHE_LINE_SIZE - sizeof(std::atomic<ptrdiff_t>) -
+                   sizeof(std::atomic<Array*>)];
+
+ public:
+  // 构造、析构函数，初始容量会被调整为不小于capacity的2的幂
+  explicit WorkStealingDeque(size_type capacity = 64);
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  ~WorkStealingDeque();
+
+  // 容量相关操作，在并发修改时只是一个近似值
+  size_type size() const noexcept {
+    const ptrdiff_t b = bottom_.load(std::memory_order_acquire);
+    const ptrdiff_t t = top_.load(std::memory_order_acquire);
+    return b > t ? static_cast<size_type>(b - t) : 0;
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+  // 拥有者在底部放入、取出元素，队列为空时 pop 返回false
+  void push(value_type value);
+  bool pop(value_type& value);
+
+  // 从顶部窃取元素，队列为空或与其他线程竞争失败时返回false
+  bool steal(value_type& value);
+
+ private:
+  // helper functions
+  Array* create_array(ptrdiff_t capacity);
+  Array* grow(Array* old, ptrdiff_t top, ptrdiff_t bottom);
+};
+
+/*****************************************************************************************/
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_type capacity) : top_(0), bottom_(0) {
+  THROW_LENGTH_ERROR_IF(capacity > static_cast<size_type>(PTRDIFF_MAX) / sizeof(T) / 2,
+                        "WorkStealingDeque<T>'s capacity too big");
+  ptrdiff_t cap = 2;
+  while (static_cast<size_type>(cap) < capacity) {
+    cap <<= 1;
+  }
+  array_.store(create_array(cap), std::memory_order_relaxed);
+}
+
+template <typename T>
+WorkStealingDeque<T>::~WorkStealingDeque() {
+  Array* a = array_.load(std::memory_order_relaxed);
+  while (a != nullptr) {
+    Array* next = a->retired;
+    slot_allocator::deallocate(a->slots, static_cast<size_type>(a->mask + 1));
+    array_allocator::deallocate(a);
+    a = next;
+  }
+}
+
+// 在底部放入元素，数组已满时扩容为原来的两倍
+template <typename T>
+void WorkStealingDeque<T>::push(value_type value) {
+  const ptrdiff_t b = bottom_.load(std::memory_order_relaxed);
+  const ptrdiff_t t = top_.load(std::memory_order_acquire);
+  Array* a = array_.load(std::memory_order_relaxed);
+  if (b - t > a->mask) {
+    a = grow(a, t, b);
+  }
+  a->slots[b & a->mask].store(value, std::memory_order_relaxed);
+  // 先写元素再发布 bottom_，窃取者读到新的 bottom_ 时一定能看到元素
+  bottom_.store(b + 1, std::memory_order_release);
+}
+
+// 从底部取出元素，只剩一个元素时要与窃取者竞争 top_
+template <typename T>
+bool WorkStealingDeque<T>::pop(value_type& value) {
+  const ptrdiff_t b = bottom_.load(std::memory_order_relaxed) - 1;
+  Array* a = array_.load(std::memory_order_relaxed);
+  bottom_.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  ptrdiff_t t = top_.load(std::memory_order_relaxed);
+  if (t > b) {
+    bottom_.store(b + 1, std::memory_order_release);
+    return false;
+  }
+  value = a->slots[b & a->mask].load(std::memory_order_relaxed);
+  if (t < b) {
+    return true;
+  }
+  const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                std::memory_order_relaxed);
+  bottom_.store(b + 1, std::memory_order_release);
+  return won;
+}
+
+// 从顶部窃取元素
+template <typename T>
+bool WorkStealingDeque<T>::steal(value_type& value) {
+  ptrdiff_t t = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const ptrdiff_t b = bottom_.load(std::memory_order_acquire);
+  if (t >= b) {
+    return false;
+  }
+  Array* a = array_.load(std::memory_order_acquire);
+  value = a->slots[t & a->mask].load(std::memory_order_relaxed);
+  return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed);
+}
+
+/*****************************************************************************************/
+// helper function
+
+template <typename T>
+typename WorkStealingDeque<T>::Array* WorkStealingDeque<T>::create_array(ptrdiff_t capacity) {
+  Array* a = array_allocator::allocate();
+  try {
+    a->slots = slot_allocator::allocate(static_cast<size_type>(capacity));
+  } catch (...) {
+    array_allocator::deallocate(a);
+    throw;
+  }
+  for (ptrdiff_t i = 0; i < capacity; ++i) {
+    ::new (static_cast<void*>(a->slots + i)) std::atomic<T>();
+  }
+  a->mask = capacity - 1;
+  a->retired = nullptr;
+  return a;
+}
+
+// 把 [top, bottom) 中的元素复制到两倍大小的新数组中，旧数组挂在新数组的 retired 链上
+template <typename T>
+typename WorkStealingDeque<T>::Array*
+WorkStealingDeque<T>::grow(Array* old, ptrdiff_t top, ptrdiff_t bottom) {
+  Array* a = create_array((old->mask + 1) * 2);
+  for (ptrdiff_t i = top; i < bottom; ++i) {
+    a->slots[i & a->mask].store(old->slots[i & old->mask].load(std::memory_order_relaxed),
+                                std::memory_order_relaxed);
+  }
+  a->retired = old;
+  array_.store(a, std::memory_order_release);
+  return a;
+}
+
+/*****************************************************************************************/
+
+// 线程池执行的任务，execute 负责执行任务并释放自身
+class ThreadPoolTask {
+ public:
+  virtual ~ThreadPoolTask() = default;
+  virtual void execute() noexcept = 0;
+};
+
+// ThreadPool
+class ThreadPool {
+ public:
+  using size_type = size_t;
+  using task_type = ThreadPoolTask;
+
+  // 工作线程在找不到任务时，睡眠之前让出处理器的次数
+  static constexpr unsigned kSpinCount = 64;
+
+ private:
+  struct Worker {
+    WorkStealingDeque<task_type*> deque;
+    std::thread thread;
+  };
+
+  // 当前线程所属的线程池与在其中的编号，不是工作线程时 pool 为nullptr
+  struct Context {
+    ThreadPool* pool;
+    size_type index;
+  };
+
+  mystl::Vector<Worker*> workers_;
+  mystl::Queue<task_type*> injection_;       // 全局注入队列，由 mutex_ 保护
+  std::atomic<size_type> injection_size_;    // 注入队列的长度，用于不加锁地判断是否为空
+  std::atomic<size_type> sleeping_;          // 正在睡眠（或准备睡眠）的工作线程数
+  std::mutex mutex_;
+  std::condition_variable wakeup_;
+  bool stop_;
+
+ public:
+  // 构造、析构函数，threads 为工作线程的数目，可以为0
+  explicit ThreadPool(size_type threads = std::thread::hardware_concurrency());
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool();
+
+  // 工作线程的数目
+  size_type size() const noexcept { return workers_.size(); }
+
+  // 当前线程是否为本线程池的工作线程
+  bool in_worker() const noexcept { return context().pool == this; }
+
+  // 提交一个任务，任务执行完后由它自己释放
+  void submit(task_type* task);
+
+  // 取出一个任务在当前线程中执行，没有可执行的任务时返回false
+  bool run_pending_task();
+
+ private:
+  // helper functions
+  static Context& context() noexcept {
+    static thread_local Context ctx = {nullptr, 0};
+    return ctx;
+  }
+
+  void worker_loop(size_type index);
+  task_type* find_task(size_type index);
+  bool has_task() const noexcept;
+  void notify_one();
+};
+
+/*****************************************************************************************/
+
+inline ThreadPool::ThreadPool(size_type threads)
+    : injection_size_(0), sleeping_(0), stop_(false) {
+  workers_.reserve(threads);
+  try {
+    for (size_type i = 0; i < threads; ++i) {
+      workers_.push_back(new Worker());
+    }
+    for (size_type i = 0; i < threads; ++i) {
+      workers_[i]->thread = std::thread(&ThreadPool::worker_loop, this, i);
+    }
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wakeup_.notify_all();
+    for (auto w : workers_) {
+      if (w->thread.joinable()) {
+        w->thread.join();
+      }
+      delete w;
+    }
+    throw;
+  }
+}
+
+// 析构时工作线程会先执行完队列中剩余的任务再退出
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wakeup_.notify_all();
+  for (auto w : workers_) {
+    w->thread.join();
+  }
+  for (auto w : workers_) {
+    delete w;
+  }
+}
+
+// 提交任务：工作线程放入自己的队列，其他线程放入全局注入队列
+inline void ThreadPool::submit(task_type* task) {
+  Context& ctx = context();
+  if (ctx.pool == this) {
+    workers_[ctx.index]->deque.push(task);
+    // 与 worker_loop 中 sleeping_ 的修改配对：要么我们看到睡眠者并唤醒它，要么它看到新任务
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed) != 0) {
+      notify_one();
+    }
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  injection_.push(task);
+  injection_size_.store(injection_.size(), std::memory_order_relaxed);
+  if (sleeping_.load(std::memory_order_relaxed) != 0) {
+    wakeup_.notify_one();
+  }
+}
+
+inline bool ThreadPool::run_pending_task() {
+  Context& ctx = context();
+  task_type* task = find_task(ctx.pool == this ? ctx.index : size());
+  if (task == nullptr) {
+    return false;
+  }
+  task->execute();
+  return true;
+}
+
+/*****************************************************************************************/
+// helper function
+
+inline void ThreadPool::worker_loop(size_type index) {
+  context() = Context{this, index};
+  unsigned spins = 0;
+  for (;;) {
+    task_type* task = find_task(index);
+    if (task != nullptr) {
+      task->execute();
+      spins = 0;
+      continue;
+    }
+    if (++spins < kSpinCount) {
+      std::this_thread::yield();
+      continue;
+    }
+    spins = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    sleeping_.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (has_task()) {
+      sleeping_.fetch_sub(1, std::memory_order_relaxed);
+      continue;
+    }
+    if (stop_) {
+      sleeping_.fetch_sub(1, std::memory_order_relaxed);
+      break;
+    }
+    wakeup_.wait(lock);
+    sleeping_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  context() = Context{nullptr, 0};
+}
+
+// 依次尝试自己的队列、全局注入队列和其他工作线程的队列，index 等于 size() 表示不是工作线程
+inline ThreadPool::task_type* ThreadPool::find_task(size_type index) {
+  const size_type n = size();
+  task_type* task = nullptr;
+  if (index < n && workers_[index]->deque.pop(task)) {
+    return task;
+  }
+  if (injection_size_.load(std::memory_order_relaxed) != 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!injection_.empty()) {
+      task = injection_.front();
+      injection_.pop();
+      injection_size_.store(injection_.size(), std::memory_order_relaxed);
+      return task;
+    }
+  }
+  for (size_type i = 1; i <= n; ++i) {
+    const size_type victim = (index + i) % n;
+    if (victim != index && workers_[victim]->deque.steal(task)) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+inline bool ThreadPool::has_task() const noexcept {
+  if (injection_size_.load(std::memory_order_relaxed) != 0) {
+    return true;
+  }
+  for (auto w : workers_) {
+    if (!w->deque.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline void ThreadPool::notify_one() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  wakeup_.notify_one();
+}
+
+// 默认的线程池，工作线程数为处理器的数目，在第一次使用时创建
+inline ThreadPool& default_thread_pool() {
+  static ThreadPool pool;
+  return pool;
+}
+
+/*****************************************************************************************/
+
+// TaskGroup
+class TaskGroup {
+ public:
+  using size_type = size_t;
+
+ private:
+  template <typename Function>
+  class Task : public ThreadPoolTask {
+   public:
+    Task(TaskGroup* group, Function&& f) : group_(group), f_(mystl::move(f)) {}
+    Task(TaskGroup* group, const Function& f) : group_(group), f_(f) {}
+
+    // 先释放任务（及其中的函数对象）再通知任务组，此后任务组随时可能被销毁
+    void execute() noexcept override {
+      TaskGroup* group = group_;
+      try {
+        f_();
+      } catch (...) {
+        group->set_exception(std::current_exception());
+      }
+      delete this;
+      group->finish();
+    }
+
+   private:
+    TaskGroup* group_;
+    Function f_;
+  };
+
+  ThreadPool& pool_;
+  std::atomic<size_type> pending_;
+  std::atomic<bool> failed_;
+  std::exception_ptr error_;
+
+ public:
+  explicit TaskGroup(ThreadPool& pool = default_thread_pool())
+      : pool_(pool), pending_(0), failed_(false) {}
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  // 析构时等待所有任务完成，但不会抛出任务中的异常
+  ~TaskGroup() { join(); }
+
+  ThreadPool& pool() const noexcept { return pool_; }
+
+  // 派生一个任务，f 会被复制（或移动）到任务中，以无参数的形式调用
+  template <typename Function>
+  void spawn(Function&& f);
+
+  // 等待所有已派生的任务完成，等待期间当前线程也执行任务；任务抛出过异常时重新抛出
+  void wait();
+
+ private:
+  // helper functions
+  void join() noexcept;
+  void finish() noexcept { pending_.fetch_sub(1, std::memory_order_acq_rel); }
+  void set_exception(std::exception_ptr e) noexcept {
+    if (!failed_.exchange(true, std::memory_order_acq_rel)) {
+      error_ = e;
+    }
+  }
+};
+
+/*****************************************************************************************/
+
+template <typename Function>
+void TaskGroup::spawn(Function&& f) {
+  using task_type = Task<typename std::decay<Function>::type>;
+  // submit 成功之后任务随时可能执行完并释放自身，因此计数要在 submit 之前增加，失败时撤销；
+  // submit 抛出异常时任务没有进入队列，仍由 unique_ptr 释放
+  std::unique_ptr<task_type> task(new task_type(this, mystl::forward<Function>(f)));
+  pending_.fetch_add(1, std::memory_order_relaxed);
+  try {
+    pool_.submit(task.get());
+  } catch (...) {
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+    throw;
+  }
+  task.release();
+}
+
+inline void TaskGroup::wait() {
+  join();
+  if (failed_.load(std::memory_order_acquire)) {
+    std::exception_ptr e = error_;
+    error_ = nullptr;
+    failed_.store(false, std::memory_order_relaxed);
+    std::rethrow_exception(e);
+  }
+}
+
+inline void TaskGroup::join() noexcept {
+  while (pending_.load(std::memory_order_acquire) != 0) {
+    if (!pool_.run_pending_task()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+/*****************************************************************************************/
+// parallel_for
+// 对 [first, last) 中的每个下标 i 调用 f(i)，区间被二分直到长度不超过 grain，每一段作为一个任务
+// f 会在多个线程中被同时调用
+/*****************************************************************************************/
+template <typename Size, typename Function>
+void parallel_for_split(TaskGroup& group, Size first, Size last, Size grain, Function& f) {
+  while (last - first > grain) {
+    const Size mid = first + (last - first) / 2;
+    group.spawn([&group, mid, last, grain, &f] {
+      mystl::parallel_for_split(group, mid, last, grain, f);
+    });
+    last = mid;
+  }
+  for (; first != last; ++first) {
+    f(first);
+  }
+}
+
+template <typename Size, typename Function>
+void parallel_for(ThreadPool& pool, Size first, Size last, Size grain, Function f) {
+  if (!(first < last)) {
+    return;
+  }
+  TaskGroup group(pool);
+  mystl::parallel_for_split(group, first, last, grain == 0 ? Size(1) : grain, f);
+  group.wait();
+}
+
+template <typename Size, typename Function>
+void parallel_for(Size first, Size last, Size grain, Function f) {
+  mystl::parallel_for(mystl::default_thread_pool(), first, last, grain, f);
+}
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_THREAD_POOL_H_
@@ -34,6 +34,34 @@ struct IsPair : mystl::m_false_type {};
 template <typename T1, class T2>
 struct IsPair<mystl::pair<T1, T2>> : mystl::m_true_type {};
 
+// is_transparent
+// 判断函数对象是否定义了is_transparent，定义了的比较器/哈希函数支持异构查找
+template <typename T>
+struct IsTransparent {
+ private:
+  struct Two {
+    char a;
+    char b;
+  };
+  template <typename U>
+  static Two test(...);
+
+  template <typename U>
+  static char test(typename U::is_transparent* = 0);
+
+ public:
+  static const bool kValue = sizeof(test<T>(0)) == sizeof(char);
+};
+
+// 仅当T为透明函数对象时有效，用于约束异构查找的重载
+template <typename T, typename R = void>
+using EnableIfTransparent = typename std::enable_if<IsTransparent<T>::kValue, R>::type;
+
+// 仅当哈希函数与键值比较函数都为透明函数对象时有效，用于约束unordered容器的异构查找
+template <typename Hash, typename KeyEqual, typename R = void>
+using EnableIfTransparentHash = typename std::
+    enable_if<IsTransparent<Hash>::kValue && IsTransparent<KeyEqual>::kValue, R>::type;
+
 }  // namespace mystl
 
 #endif  // !MYTINYSTL_TYPE_TRAITS_H_
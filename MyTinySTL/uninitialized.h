@@ -147,13 +147,14 @@ ForwardIter unchecked_uninit_move(
 template <typename InputIter, typename ForwardIter>
 ForwardIter unchecked_uninit_move(
     InputIter first, InputIter last, ForwardIter result, std::false_type /*unused*/) {
-  ForwardIter cur = first;
+  ForwardIter cur = result;
   try {
     for (; first != last; ++first, ++cur) {
       mystl::construct(&*cur, mystl::move(*first));
     }
   } catch (...) {
     mystl::destroy(result, cur);
+    throw;
   }
   return cur;
 }
@@ -201,6 +202,43 @@ ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result) {
       std::is_trivially_move_assignable<typename IteratorTraits<InputIter>::value_type>{});
 }
 
+// uninitialized_move_if_noexcept
+// 元素的移动构造不会抛出异常（或者元素不能复制）时移动，否则复制，
+// 这样构造失败时[first, last)上的内容保持不变，返回构造结束的位置
+template <typename InputIter, typename ForwardIter>
+ForwardIter unchecked_uninit_move_if_noexcept(
+    InputIter first, InputIter last, ForwardIter result, std::true_type /*unused*/) {
+  return mystl::uninitialized_move(first, last, result);
+}
+
+template <typename InputIter, typename ForwardIter>
+ForwardIter unchecked_uninit_move_if_noexcept(
+    InputIter first, InputIter last, ForwardIter result, std::false_type /*unused*/) {
+  ForwardIter cur = result;
+  try {
+    for (; first != last; ++first, ++cur) {
+      mystl::construct(&*cur, *first);
+    }
+  } catch (...) {
+    mystl::destroy(result, cur);
+    throw;
+  }
+  return cur;
+}
+
+template <typename InputIter, typename ForwardIter>
+ForwardIter uninitialized_move_if_noexcept(InputIter first, InputIter last, ForwardIter result) {
+  using value_type = typename IteratorTraits<InputIter>::value_type;
+  return mystl::unchecked_uninit_move_if_noexcept(
+      first,
+      last,
+      result,
+      std::integral_constant<
+          bool,
+          std::is_nothrow_move_constructible<value_type>::value ||
+              !std::is_copy_constructible<value_type>::value>{});
+}
+
 }  // namespace mystl
 
 #endif  // !MYTINYSTL_UNINITIALIZED_H_
\ No newline at end of file
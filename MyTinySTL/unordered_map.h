@@ -23,6 +23,11 @@
 
 namespace mystl {
 
+// forward declaration begin
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+class UnorderedMultiMap;
+// forward declaration end
+
 // 模板类 unordered_map，键值不允许重复
 // 参数一代表键值类型，参数二代表实值类型，参数三代表哈希函数，缺省使用 mystl::hash
 // 参数四代表键值比较方式，缺省使用 mystl::equal_to
@@ -32,6 +37,11 @@ template <
     typename Hash = mystl::Hash<Key>,
     typename KeyEqual = mystl::EqualTo<Key>>
 class UnorderedMap {
+  template <typename, typename, typename, typename>
+  friend class UnorderedMap;
+  template <typename, typename, typename, typename>
+  friend class UnorderedMultiMap;
+
  private:
   using base_type = Hashtable<mystl::pair<const Key, T>, Hash, KeyEqual>;
   base_type ht_;
@@ -56,6 +66,9 @@ class UnorderedMap {
   using local_iterator = typename base_type::local_iterator;
   using const_local_iterator = typename base_type::const_local_iterator;
 
+  using node_type = typename base_type::node_handle;
+  using insert_return_type = mystl::InsertReturnType<iterator, node_type>;
+
   allocator_type get_allocator() const { return ht_.get_allocator(); }
 
  public:
@@ -158,6 +171,83 @@ class UnorderedMap {
 
   void clear() { ht_.clear(); }
 
+  // 键值不存在时才插入由key与args构造的元素，键值已存在时args不会被移动
+  template <typename... Args>
+  pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+    return ht_.try_emplace_unique(key, mystl::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+    return ht_.try_emplace_unique(mystl::move(key), mystl::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator try_emplace(const_iterator /*hint*/, const key_type& key, Args&&... args) {
+    return ht_.try_emplace_unique(key, mystl::forward<Args>(args)...).first;
+  }
+  template <typename... Args>
+  iterator try_emplace(const_iterator /*hint*/, key_type&& key, Args&&... args) {
+    return ht_.try_emplace_unique(mystl::move(key), mystl::forward<Args>(args)...).first;
+  }
+
+  // 键值已存在时对实值赋值，否则插入新元素
+  template <typename M>
+  pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+    auto res = ht_.try_emplace_unique(key, mystl::forward<M>(obj));
+    if (!res.second) {
+      res.first->second = mystl::forward<M>(obj);
+    }
+    return res;
+  }
+  template <typename M>
+  pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+    auto res = ht_.try_emplace_unique(mystl::move(key), mystl::forward<M>(obj));
+    if (!res.second) {
+      res.first->second = mystl::forward<M>(obj);
+    }
+    return res;
+  }
+  template <typename M>
+  iterator insert_or_assign(const_iterator /*hint*/, const key_type& key, M&& obj) {
+    return insert_or_assign(key, mystl::forward<M>(obj)).first;
+  }
+  template <typename M>
+  iterator insert_or_assign(const_iterator /*hint*/, key_type&& key, M&& obj) {
+    return insert_or_assign(mystl::move(key), mystl::forward<M>(obj)).first;
+  }
+
+  // 结点句柄相关，结点在容器之间转移时不会重新分配内存
+  node_type extract(const_iterator position) { return ht_.extract(position); }
+  node_type extract(const key_type& key) {
+    auto it = ht_.find(key);
+    return it.node == nullptr ? node_type() : ht_.extract(it);
+  }
+
+  insert_return_type insert(node_type&& nh) {
+    auto res = ht_.insert_node_unique(nh);
+    return insert_return_type{res.first, res.second, mystl::move(nh)};
+  }
+  iterator insert(const_iterator /*hint*/, node_type&& nh) {
+    return ht_.insert_node_unique(nh).first;
+  }
+
+  // 把source中键值不存在于当前容器的结点转移过来
+  template <typename H2, typename E2>
+  void merge(UnorderedMap<Key, T, H2, E2>& source) {
+    ht_.merge_unique(source.ht_);
+  }
+  template <typename H2, typename E2>
+  void merge(UnorderedMap<Key, T, H2, E2>&& source) {
+    ht_.merge_unique(source.ht_);
+  }
+  template <typename H2, typename E2>
+  void merge(UnorderedMultiMap<Key, T, H2, E2>& source) {
+    ht_.merge_unique(source.ht_);
+  }
+  template <typename H2, typename E2>
+  void merge(UnorderedMultiMap<Key, T, H2, E2>&& source) {
+    ht_.merge_unique(source.ht_);
+  }
+
   void swap(UnorderedMap& other) noexcept { ht_.swap(other.ht_); }
 
   mapped_type& at(const key_type& key) {
@@ -171,30 +261,41 @@ class UnorderedMap {
     return it->second;
   }
 
-  mapped_type& operator[](const key_type& key) {
-    iterator it = ht_.find(key);
-    if (it.node == nullptr) {
-      it = ht_.emplace_unique(key, T{}).first;
-    }
-    return it->second;
-  }
+  mapped_type& operator[](const key_type& key) { return try_emplace(key).first->second; }
   mapped_type& operator[](key_type&& key) {
-    iterator it = ht_.find(key);
-    if (it.node == nullptr) {
-      it = ht_.emplace_unique(mystl::move(key), T{}).first;
-    }
-    return it->second;
+    return try_emplace(mystl::move(key)).first->second;
   }
 
+  // 当Hash与KeyEqual都是透明函数对象时，以下查找函数还接受任意可与key_type比较的类型
   size_type count(const key_type& key) const { return ht_.count(key); }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  size_type count(const K& key) const {
+    return ht_.count(key);
+  }
 
   iterator find(const key_type& key) { return ht_.find(key); }
   const_iterator find(const key_type& key) const { return ht_.find(key); }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  iterator find(const K& key) {
+    return ht_.find(key);
+  }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  const_iterator find(const K& key) const {
+    return ht_.find(key);
+  }
 
   pair<iterator, iterator> equal_range(const key_type& key) { return ht_.equal_range_unique(key); }
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
     return ht_.equal_range_unique(key);
   }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  pair<iterator, iterator> equal_range(const K& key) {
+    return ht_.equal_range_unique(key);
+  }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return ht_.equal_range_unique(key);
+  }
 
   local_iterator begin(size_type n) noexcept { return ht_.begin(n); }
   const_local_iterator begin(size_type n) const noexcept { return ht_.begin(n); }
@@ -221,6 +322,10 @@ class UnorderedMap {
   hasher hash_fcn() const { return ht_.hash_fcn(); }
   hasher key_eq() const { return ht_.key_eq(); }
 
+  // 统计信息，见HashtableStats
+  HashtableStats stats() const { return ht_.stats(); }
+  void reset_profile() noexcept { ht_.reset_profile(); }
+
  public:
   friend bool operator==(const UnorderedMap& lhs, const UnorderedMap& rhs) {
     return lhs.ht_.equal_to_unique(rhs.ht_);
@@ -260,6 +365,11 @@ template <
     typename Hash = mystl::Hash<Key>,
     typename KeyEqual = mystl::EqualTo<Key>>
 class UnorderedMultiMap {
+  template <typename, typename, typename, typename>
+  friend class UnorderedMap;
+  template <typename, typename, typename, typename>
+  friend class UnorderedMultiMap;
+
  private:
   using base_type = Hashtable<mystl::pair<const Key, T>, Hash, KeyEqual>;
   base_type ht_;
@@ -284,6 +394,8 @@ class UnorderedMultiMap {
   using local_iterator = typename base_type::local_iterator;
   using const_local_iterator = typename base_type::const_local_iterator;
 
+  using node_type = typename base_type::node_handle;
+
   allocator_type get_allocator() const { return ht_.get_allocator(); }
 
  public:
@@ -386,17 +498,68 @@ class UnorderedMultiMap {
 
   void clear() { ht_.clear(); }
 
+  // 结点句柄相关，结点在容器之间转移时不会重新分配内存
+  node_type extract(const_iterator position) { return ht_.extract(position); }
+  node_type extract(const key_type& key) {
+    auto it = ht_.find(key);
+    return it.node == nullptr ? node_type() : ht_.extract(it);
+  }
+
+  iterator insert(node_type&& nh) { return ht_.insert_node_multi(mystl::move(nh)); }
+  iterator insert(const_iterator /*hint*/, node_type&& nh) {
+    return ht_.insert_node_multi(mystl::move(nh));
+  }
+
+  // 把source中的所有结点转移过来
+  template <typename H2, typename E2>
+  void merge(UnorderedMap<Key, T, H2, E2>& source) {
+    ht_.merge_multi(source.ht_);
+  }
+  template <typename H2, typename E2>
+  void merge(UnorderedMap<Key, T, H2, E2>&& source) {
+    ht_.merge_multi(source.ht_);
+  }
+  template <typename H2, typename E2>
+  void merge(UnorderedMultiMap<Key, T, H2, E2>& source) {
+    ht_.merge_multi(source.ht_);
+  }
+  template <typename H2, typename E2>
+  void merge(UnorderedMultiMap<Key, T, H2, E2>&& source) {
+    ht_.merge_multi(source.ht_);
+  }
+
   void swap(UnorderedMultiMap& other) noexcept { ht_.swap(other.ht_); }
 
+  // 当Hash与KeyEqual都是透明函数对象时，以下查找函数还接受任意可与key_type比较的类型
   size_type count(const key_type& key) const { return ht_.count(key); }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  size_type count(const K& key) const {
+    return ht_.count(key);
+  }
 
   iterator find(const key_type& key) { return ht_.find(key); }
   const_iterator find(const key_type& key) const { return ht_.find(key); }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  iterator find(const K& key) {
+    return ht_.find(key);
+  }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  const_iterator find(const K& key) const {
+    return ht_.find(key);
+  }
 
   pair<iterator, iterator> equal_range(const key_type& key) { return ht_.equal_range_multi(key); }
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
     return ht_.equal_range_multi(key);
   }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  pair<iterator, iterator> equal_range(const K& key) {
+    return ht_.equal_range_multi(key);
+  }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return ht_.equal_range_multi(key);
+  }
 
   local_iterator begin(size_type n) noexcept { return ht_.begin(n); }
   const_local_iterator begin(size_type n) const noexcept { return ht_.begin(n); }
@@ -423,6 +586,10 @@ class UnorderedMultiMap {
   hasher hash_fcn() const { return ht_.hash_fcn(); }
   hasher key_eq() const { return ht_.key_eq(); }
 
+  // 统计信息，见HashtableStats
+  HashtableStats stats() const { return ht_.stats(); }
+  void reset_profile() noexcept { ht_.reset_profile(); }
+
  public:
   friend bool operator==(const UnorderedMultiMap& lhs, const UnorderedMultiMap& rhs) {
     return lhs.ht_.equal_to_multi(rhs.ht_);
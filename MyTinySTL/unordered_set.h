@@ -24,11 +24,21 @@
 
 namespace mystl {
 
+// forward declaration begin
+template <typename Key, typename Hash, typename KeyEqual>
+class UnorderedMultiSet;
+// forward declaration end
+
 // 模板类unordered_set，键值不允许重复
 // 参数一代表键值类型，参数二代表哈希函数，缺省使用mystl::hash，
 // 参数三代表键值比较方式，缺省使用mystl::equal_to
 template <typename Key, typename Hash = mystl::Hash<Key>, typename KeyEqual = mystl::EqualTo<Key>>
 class UnorderedSet {
+  template <typename, typename, typename>
+  friend class UnorderedSet;
+  template <typename, typename, typename>
+  friend class UnorderedMultiSet;
+
  private:
   // 使用hashtable作为底层机制
   using base_type = Hashtable<Key, Hash, KeyEqual>;
@@ -54,6 +64,9 @@ class UnorderedSet {
   using local_iterator = typename base_type::const_local_iterator;
   using const_local_iterator = typename base_type::const_local_iterator;
 
+  using node_type = typename base_type::node_handle;
+  using insert_return_type = mystl::InsertReturnType<iterator, node_type>;
+
   allocator_type get_allocator() const { return ht_.get_allocator(); }
 
  public:
@@ -159,17 +172,71 @@ class UnorderedSet {
 
   void clear() { ht_.clear(); }
 
+  // 结点句柄相关，结点在容器之间转移时不会重新分配内存
+  node_type extract(const_iterator position) { return ht_.extract(position); }
+  node_type extract(const key_type& key) {
+    auto it = ht_.find(key);
+    return it.node == nullptr ? node_type() : ht_.extract(it);
+  }
+
+  insert_return_type insert(node_type&& nh) {
+    auto res = ht_.insert_node_unique(nh);
+    return insert_return_type{res.first, res.second, mystl::move(nh)};
+  }
+  iterator insert(const_iterator /*hint*/, node_type&& nh) {
+    return ht_.insert_node_unique(nh).first;
+  }
+
+  // 把source中键值不存在于当前容器的结点转移过来
+  template <typename H2, typename E2>
+  void merge(UnorderedSet<Key, H2, E2>& source) {
+    ht_.merge_unique(source.ht_);
+  }
+  template <typename H2, typename E2>
+  void merge(UnorderedSet<Key, H2, E2>&& source) {
+    ht_.merge_unique(source.ht_);
+  }
+  template <typename H2, typename E2>
+  void merge(UnorderedMultiSet<Key, H2, E2>& source) {
+    ht_.merge_unique(source.ht_);
+  }
+  template <typename H2, typename E2>
+  void merge(UnorderedMultiSet<Key, H2, E2>&& source) {
+    ht_.merge_unique(source.ht_);
+  }
+
   void swap(UnorderedSet& other) noexcept { ht_.swap(other.ht_); }
 
+  // 当Hash与KeyEqual都是透明函数对象时，以下查找函数还接受任意可与key_type比较的类型
   size_type count(const key_type& key) const { return ht_.count(key); }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  size_type count(const K& key) const {
+    return ht_.count(key);
+  }
 
   iterator find(const key_type& key) { return ht_.find(key); }
   const_iterator find(const key_type& key) const { return ht_.find(key); }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  iterator find(const K& key) {
+    return ht_.find(key);
+  }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  const_iterator find(const K& key) const {
+    return ht_.find(key);
+  }
 
   pair<iterator, iterator> equal_range(const key_type& key) { return ht_.equal_range_unique(key); }
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
     return ht_.equal_range_unique(key);
   }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  pair<iterator, iterator> equal_range(const K& key) {
+    return ht_.equal_range_unique(key);
+  }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return ht_.equal_range_unique(key);
+  }
 
   local_iterator begin(size_type n) noexcept { return ht_.begin(n); }
   const_local_iterator begin(size_type n) const noexcept { return ht_.begin(n); }
@@ -197,6 +264,10 @@ class UnorderedSet {
   hasher hash_fcn() const { return ht_.hash_fcn(); }
   key_equal key_eq() const { return ht_.key_eq(); }
 
+  // 统计信息，见HashtableStats
+  HashtableStats stats() const { return ht_.stats(); }
+  void reset_profile() noexcept { ht_.reset_profile(); }
+
  public:
   friend bool operator==(const UnorderedSet& lhs, const UnorderedSet& rhs) {
     return lhs.ht_.equal_to_unique(rhs.ht_);
@@ -229,6 +300,11 @@ void swap(
 // 参数三代表键值比较方式，缺省使用mystl::equal_to
 template <typename Key, typename Hash = mystl::Hash<Key>, typename KeyEqual = mystl::EqualTo<Key>>
 class UnorderedMultiSet {
+  template <typename, typename, typename>
+  friend class UnorderedSet;
+  template <typename, typename, typename>
+  friend class UnorderedMultiSet;
+
  private:
   // 使用hashtable作为底层机制
   using base_type = Hashtable<Key, Hash, KeyEqual>;
@@ -254,6 +330,8 @@ class UnorderedMultiSet {
   using local_iterator = typename base_type::const_local_iterator;
   using const_local_iterator = typename base_type::const_local_iterator;
 
+  using node_type = typename base_type::node_handle;
+
   allocator_type get_allocator() const { return ht_.get_allocator(); }
 
  public:
@@ -359,17 +437,68 @@ class UnorderedMultiSet {
 
   void clear() { ht_.clear(); }
 
+  // 结点句柄相关，结点在容器之间转移时不会重新分配内存
+  node_type extract(const_iterator position) { return ht_.extract(position); }
+  node_type extract(const key_type& key) {
+    auto it = ht_.find(key);
+    return it.node == nullptr ? node_type() : ht_.extract(it);
+  }
+
+  iterator insert(node_type&& nh) { return ht_.insert_node_multi(mystl::move(nh)); }
+  iterator insert(const_iterator /*hint*/, node_type&& nh) {
+    return ht_.insert_node_multi(mystl::move(nh));
+  }
+
+  // 把source中的所有结点转移过来
+  template <typename H2, typename E2>
+  void merge(UnorderedSet<Key, H2, E2>& source) {
+    ht_.merge_multi(source.ht_);
+  }
+  template <typename H2, typename E2>
+  void merge(UnorderedSet<Key, H2, E2>&& source) {
+    ht_.merge_multi(source.ht_);
+  }
+  template <typename H2, typename E2>
+  void merge(UnorderedMultiSet<Key, H2, E2>& source) {
+    ht_.merge_multi(source.ht_);
+  }
+  template <typename H2, typename E2>
+  void merge(UnorderedMultiSet<Key, H2, E2>&& source) {
+    ht_.merge_multi(source.ht_);
+  }
+
   void swap(UnorderedMultiSet& other) noexcept { ht_.swap(other.ht_); }
 
+  // 当Hash与KeyEqual都是透明函数对象时，以下查找函数还接受任意可与key_type比较的类型
   size_type count(const key_type& key) const { return ht_.count(key); }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  size_type count(const K& key) const {
+    return ht_.count(key);
+  }
 
   iterator find(const key_type& key) { return ht_.find(key); }
   const_iterator find(const key_type& key) const { return ht_.find(key); }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  iterator find(const K& key) {
+    return ht_.find(key);
+  }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  const_iterator find(const K& key) const {
+    return ht_.find(key);
+  }
 
   pair<iterator, iterator> equal_range(const key_type& key) { return ht_.equal_range_multi(key); }
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
     return ht_.equal_range_multi(key);
   }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  pair<iterator, iterator> equal_range(const K& key) {
+    return ht_.equal_range_multi(key);
+  }
+  template <typename K, typename H = Hash, typename = mystl::EnableIfTransparentHash<H, KeyEqual>>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const {
+    return ht_.equal_range_multi(key);
+  }
 
   local_iterator begin(size_type n) noexcept { return ht_.begin(n); }
   const_local_iterator begin(size_type n) const noexcept { return ht_.begin(n); }
@@ -397,6 +526,10 @@ class UnorderedMultiSet {
   hasher hash_fcn() const { return ht_.hash_fcn(); }
   key_equal key_eq() const { return ht_.key_eq(); }
 
+  // 统计信息，见HashtableStats
+  HashtableStats stats() const { return ht_.stats(); }
+  void reset_profile() noexcept { ht_.reset_profile(); }
+
  public:
   friend bool operator==(const UnorderedMultiSet& lhs, const UnorderedMultiSet& rhs) {
     return lhs.ht_.equal_to_multi(rhs.ht_);
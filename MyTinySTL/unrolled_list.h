@@ -0,0 +1,619 @@
+#ifndef MYTINYSTL_UNROLLED_LIST_H_
+#define MYTINYSTL_UNROLLED_LIST_H_
+
+// unrolled list：展开链表，每个结点（块）连续存放多个元素，块之间以双向链表相连
+
+// notes:
+//
+// 每个块大约占用BlockBytes字节，遍历时每个块只有一次指针跳转，缓存命中率接近 deque，
+// 在中间插入删除只移动同一个块内的元素，块满时一分为二，删除后不足半满时与后一个块合并
+//
+// 迭代器失效规则：
+//   * 插入、删除只会使同一个块（以及被拆分、合并的相邻块）中的迭代器失效，其余块中的迭代器保持有效
+//   * splice 只移动整块，x 中元素的迭代器保持有效并指向当前容器；pos 不在块首时 pos 所在的块被拆分
+//   * end() 不随插入删除改变，swap 与移动之后原先的 end() 失效
+//
+// 异常保证：
+// mystl::UnrolledList<T> 满足基本异常保证，在尾部插入且不需要拆分块时满足强异常安全保证
+
+#include <initializer_list>
+#include <type_traits>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace mystl {
+
+// 每个块存放的元素个数，扣除块首的两个指针与计数之后尽量填满BlockBytes，至少为4
+template <typename T, size_t BlockBytes>
+struct UnrolledListBlockSize {
+  static constexpr size_t kHeaderBytes = 3 * sizeof(void*);
+  static constexpr size_t kValue = BlockBytes > kHeaderBytes + 4 * sizeof(T)
+                                       ? (BlockBytes - kHeaderBytes) / sizeof(T)
+                                       : 4;
+};
+
+template <typename T, size_t N>
+struct UnrolledListNode;
+
+// 块的链接部分，容器中的头结点只含有这一部分，count恒为0
+template <typename T, size_t N>
+struct UnrolledListNodeBase {
+  using base_ptr = UnrolledListNodeBase<T, N>*;
+  using node_ptr = UnrolledListNode<T, N>*;
+
+  base_ptr prev;
+  base_ptr next;
+  size_t count;  // 块中的元素个数
+
+  node_ptr as_node() { return static_cast<node_ptr>(this); }
+
+  void unlink() {
+    prev = next = this;
+    count = 0;
+  }
+};
+
+// 块中的元素存放在[data(), data() + count)
+template <typename T, size_t N>
+struct UnrolledListNode : public UnrolledListNodeBase<T, N> {
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type buf[N];
+
+  T* data() { return reinterpret_cast<T*>(buf); }
+
+  bool full() const { return this->count == N; }
+};
+
+// 迭代器由所在的块与块内下标组成
+template <typename T, typename Ref, typename Ptr, size_t N>
+struct UnrolledListIterator : public mystl::Iterator<mystl::BidirectionalIteratorTag, T> {
+  using iterator = UnrolledListIterator<T, T&, T*, N>;
+  using const_iterator = UnrolledListIterator<T, const T&, const T*, N>;
+  using self = UnrolledListIterator;
+
+  using value_type = T;
+  using pointer = Ptr;
+  using reference = Ref;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using base_ptr = UnrolledListNodeBase<T, N>*;
+
+  base_ptr node;    // 所在的块
+  size_type index;  // 块内的下标
+
+  UnrolledListIterator() noexcept : node(nullptr), index(0) {}
+  UnrolledListIterator(base_ptr n, size_type i) noexcept : node(n), index(i) {}
+  UnrolledListIterator(const iterator& rhs) noexcept : node(rhs.node), index(rhs.index) {}
+
+  self& operator=(const self& rhs) = default;
+
+  reference operator*() const { return node->as_node()->data()[index]; }
+  pointer operator->() const { return &(operator*()); }
+
+  self& operator++() {
+    MYSTL_DEBUG(index < node->count);
+    if (++index == node->count) {
+      node = node->next;
+      index = 0;
+    }
+    return *this;
+  }
+
+  self operator++(int) {
+    self tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  self& operator--() {
+    if (index == 0) {
+      node = node->prev;
+      index = node->count;
+    }
+    MYSTL_DEBUG(index != 0);
+    --index;
+    return *this;
+  }
+
+  self operator--(int) {
+    self tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  bool operator==(const self& rhs) const { return node == rhs.node && index == rhs.index; }
+  bool operator!=(const self& rhs) const { return !(*this == rhs); }
+};
+
+// 模板类UnrolledList
+// 参数一代表数据类型，参数二代表每个块大约占用的字节数
+template <typename T, size_t BlockBytes = 512>
+class UnrolledList {
+ public:
+  static constexpr size_t kBlockSize = UnrolledListBlockSize<T, BlockBytes>::kValue;
+
+  using allocator_type = mystl::Allocator<T>;
+  using data_allocator = mystl::Allocator<T>;
+  using node_allocator = mystl::Allocator<UnrolledListNode<T, kBlockSize>>;
+
+  using value_type = typename allocator_type::value_type;
+  using pointer = typename allocator_type::pointer;
+  using const_pointer = typename allocator_type::const_pointer;
+  using reference = typename allocator_type::reference;
+  using const_reference = typename allocator_type::const_reference;
+  using size_type = typename allocator_type::size_type;
+  using difference_type = typename allocator_type::difference_type;
+
+  using iterator = UnrolledListIterator<T, T&, T*, kBlockSize>;
+  using const_iterator = UnrolledListIterator<T, const T&, const T*, kBlockSize>;
+  using reverse_iterator = mystl::ReverseIterator<iterator>;
+  using const_reverse_iterator = mystl::ReverseIterator<const_iterator>;
+
+  using base_type = UnrolledListNodeBase<T, kBlockSize>;
+  using base_ptr = base_type*;
+  using node_ptr = UnrolledListNode<T, kBlockSize>*;
+
+  allocator_type get_allocator() { return allocator_type(); }
+
+ private:
+  base_type head_;  // 头结点，head_.next为第一个块，head_.prev为最后一个块
+  size_type size_;  // 元素个数
+
+ public:
+  // 构造、复制、移动、析构函数
+  UnrolledList() noexcept : size_(0) { head_.unlink(); }
+
+  explicit UnrolledList(size_type n) : UnrolledList() { fill_init(n, value_type()); }
+
+  UnrolledList(size_type n, const T& value) : UnrolledList() { fill_init(n, value); }
+
+  template <
+      typename Iter,
+      typename std::enable_if<mystl::IsInputIterator<Iter>::kValue, int>::type = 0>
+  UnrolledList(Iter first, Iter last) : UnrolledList() {
+    copy_init(first, last);
+  }
+
+  UnrolledList(std::initializer_list<T> ilist) : UnrolledList() {
+    copy_init(ilist.begin(), ilist.end());
+  }
+
+  UnrolledList(const UnrolledList& rhs) : UnrolledList() { copy_init(rhs.begin(), rhs.end()); }
+
+  UnrolledList(UnrolledList&& rhs) noexcept : UnrolledList() { swap(rhs); }
+
+  UnrolledList& operator=(const UnrolledList& rhs) {
+    if (this != &rhs) {
+      UnrolledList tmp(rhs);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  UnrolledList& operator=(UnrolledList&& rhs) noexcept {
+    clear();
+    swap(rhs);
+    return *this;
+  }
+
+  UnrolledList& operator=(std::initializer_list<T> ilist) {
+    UnrolledList tmp(ilist);
+    swap(tmp);
+    return *this;
+  }
+
+  ~UnrolledList() { clear(); }
+
+ public:
+  // 迭代器相关操作
+  iterator begin() noexcept { return iterator(head_.next, 0); }
+  const_iterator begin() const noexcept { return const_iterator(head_.next, 0); }
+  iterator end() noexcept { return iterator(&head_, 0); }
+  const_iterator end() const noexcept { return const_iterator(end_node(), 0); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+  // 容量相关操作
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept { return static_cast<size_type>(-1); }
+
+  // 当前使用的块数
+  size_type block_count() const noexcept {
+    size_type n = 0;
+    for (base_ptr b = head_.next; b != end_node(); b = b->next) {
+      ++n;
+    }
+    return n;
+  }
+
+  // 访问元素相关操作
+  reference front() {
+    MYSTL_DEBUG(!empty());
+    return *begin();
+  }
+  const_reference front() const {
+    MYSTL_DEBUG(!empty());
+    return *begin();
+  }
+  reference back() {
+    MYSTL_DEBUG(!empty());
+    return *(--end());
+  }
+  const_reference back() const {
+    MYSTL_DEBUG(!empty());
+    return *(--end());
+  }
+
+  // emplace_front / emplace_back / emplace
+  template <typename... Args>
+  void emplace_front(Args&&... args) {
+    emplace(cbegin(), mystl::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    emplace(cend(), mystl::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args);
+
+  // insert
+  iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+  iterator insert(const_iterator pos, value_type&& value) {
+    return emplace(pos, mystl::move(value));
+  }
+
+  // push_front / push_back
+  void push_front(const value_type& value) { emplace(cbegin(), value); }
+  void push_front(value_type&& value) { emplace(cbegin(), mystl::move(value)); }
+  void push_back(const value_type& value) { emplace(cend(), value); }
+  void push_back(value_type&& value) { emplace(cend(), mystl::move(value)); }
+
+  // pop_front / pop_back
+  void pop_front() {
+    MYSTL_DEBUG(!empty());
+    erase(cbegin());
+  }
+  void pop_back() {
+    MYSTL_DEBUG(!empty());
+    erase(--cend());
+  }
+
+  // erase / clear
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+
+  void clear() noexcept;
+
+  void swap(UnrolledList& rhs) noexcept;
+
+  // 将x的所有块接合于pos之前，pos在块首（包括begin()与end()）时时间复杂度为O(1)，
+  // 否则先把pos所在的块一分为二
+  void splice(const_iterator pos, UnrolledList& x);
+
+ private:
+  // helper functions
+  base_ptr end_node() const noexcept { return const_cast<base_ptr>(&head_); }
+
+  node_ptr create_block();
+  void destroy_block(base_ptr b) noexcept;
+  void link_block(base_ptr pos, base_ptr b) noexcept;
+  void unlink_block(base_ptr b) noexcept;
+  void adopt_head(base_ptr old_head) noexcept;
+
+  node_ptr split_block(base_ptr b, size_type i);
+  void merge_next(base_ptr b);
+  template <typename... Args>
+  void insert_in_block(base_ptr b, size_type i, Args&&... args);
+
+  void fill_init(size_type n, const value_type& value);
+  template <typename Iter>
+  void copy_init(Iter first, Iter last);
+};
+
+// 在pos处构造一个元素，pos所在的块已满时一分为二
+template <typename T, size_t BlockBytes>
+template <typename... Args>
+typename UnrolledList<T, BlockBytes>::iterator UnrolledList<T, BlockBytes>::emplace(
+    const_iterator pos, Args&&... args) {
+  THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "UnrolledList<T>'s size is too big");
+  base_ptr b = pos.node;
+  size_type i = pos.index;
+  if (b == end_node() || (i == 0 && b->prev != end_node() && !b->prev->as_node()->full())) {
+    // 在末尾或块首插入时，优先放到前一个块的末尾
+    b = b->prev;
+    i = b->count;
+  }
+  if (b == end_node() || (b->as_node()->full() && (i == 0 || i == b->count))) {
+    // 在已满的块的两端插入时不拆分块，新建一个块放在它的前面或后面
+    base_ptr nb = create_block();
+    link_block(b != end_node() && i == 0 ? b : b->next, nb);
+    try {
+      insert_in_block(nb, 0, mystl::forward<Args>(args)...);
+    } catch (...) {
+      unlink_block(nb);
+      destroy_block(nb);
+      throw;
+    }
+    ++size_;
+    return iterator(nb, 0);
+  }
+  if (b->as_node()->full()) {
+    // 拆分会移动元素，参数可能引用其中的元素，先构造新元素
+    value_type tmp(mystl::forward<Args>(args)...);
+    const size_type half = kBlockSize / 2;
+    base_ptr nb = split_block(b, half);
+    if (i > half) {
+      b = nb;
+      i -= half;
+    }
+    insert_in_block(b, i, mystl::move(tmp));
+    ++size_;
+    return iterator(b, i);
+  }
+  insert_in_block(b, i, mystl::forward<Args>(args)...);
+  ++size_;
+  return iterator(b, i);
+}
+
+// 删除pos处的元素，块变空时释放，不足半满时尝试与后一个块合并
+template <typename T, size_t BlockBytes>
+typename UnrolledList<T, BlockBytes>::iterator UnrolledList<T, BlockBytes>::erase(
+    const_iterator pos) {
+  MYSTL_DEBUG(pos != cend());
+  base_ptr b = pos.node;
+  const size_type i = pos.index;
+  T* d = b->as_node()->data();
+  mystl::move(d + i + 1, d + b->count, d + i);
+  data_allocator::destroy(d + b->count - 1);
+  --b->count;
+  --size_;
+  if (b->count == 0) {
+    base_ptr next = b->next;
+    unlink_block(b);
+    destroy_block(b);
+    return iterator(next, 0);
+  }
+  merge_next(b);
+  return i < b->count ? iterator(b, i) : iterator(b->next, 0);
+}
+
+// 删除[first, last)内的元素
+template <typename T, size_t BlockBytes>
+typename UnrolledList<T, BlockBytes>::iterator UnrolledList<T, BlockBytes>::erase(
+    const_iterator first, const_iterator last) {
+  // 合并块会使last失效，先求出元素个数
+  size_type n = mystl::distance(first, last);
+  iterator cur(first.node, first.index);
+  for (; n > 0; --n) {
+    cur = erase(cur);
+  }
+  return cur;
+}
+
+// 清空容器
+template <typename T, size_t BlockBytes>
+void UnrolledList<T, BlockBytes>::clear() noexcept {
+  base_ptr b = head_.next;
+  while (b != &head_) {
+    base_ptr next = b->next;
+    destroy_block(b);
+    b = next;
+  }
+  head_.unlink();
+  size_ = 0;
+}
+
+// 交换两个容器，头结点嵌在容器中，交换之后需要修正首尾块指向头结点的指针
+template <typename T, size_t BlockBytes>
+void UnrolledList<T, BlockBytes>::swap(UnrolledList& rhs) noexcept {
+  mystl::swap(head_.prev, rhs.head_.prev);
+  mystl::swap(head_.next, rhs.head_.next);
+  mystl::swap(size_, rhs.size_);
+  adopt_head(&rhs.head_);
+  rhs.adopt_head(&head_);
+}
+
+// 将x的所有块接合于pos之前
+template <typename T, size_t BlockBytes>
+void UnrolledList<T, BlockBytes>::splice(const_iterator pos, UnrolledList& x) {
+  MYSTL_DEBUG(this != &x);
+  if (x.empty()) {
+    return;
+  }
+  THROW_LENGTH_ERROR_IF(size_ > max_size() - x.size_, "UnrolledList<T>'s size is too big");
+  base_ptr p = pos.node;
+  if (pos.index != 0) {
+    p = split_block(p, pos.index);
+  }
+  base_ptr f = x.head_.next;
+  base_ptr l = x.head_.prev;
+  x.head_.unlink();
+  p->prev->next = f;
+  f->prev = p->prev;
+  p->prev = l;
+  l->next = p;
+  size_ += x.size_;
+  x.size_ = 0;
+}
+
+// helper functions
+
+// 分配一个空块
+template <typename T, size_t BlockBytes>
+typename UnrolledList<T, BlockBytes>::node_ptr UnrolledList<T, BlockBytes>::create_block() {
+  node_ptr b = node_allocator::allocate(1);
+  b->prev = b->next = nullptr;
+  b->count = 0;
+  return b;
+}
+
+// 析构块中的元素并释放块
+template <typename T, size_t BlockBytes>
+void UnrolledList<T, BlockBytes>::destroy_block(base_ptr b) noexcept {
+  T* d = b->as_node()->data();
+  data_allocator::destroy(d, d + b->count);
+  node_allocator::deallocate(b->as_node());
+}
+
+// 把块b连接在pos之前
+template <typename T, size_t BlockBytes>
+void UnrolledList<T, BlockBytes>::link_block(base_ptr pos, base_ptr b) noexcept {
+  b->prev = pos->prev;
+  b->next = pos;
+  pos->prev->next = b;
+  pos->prev = b;
+}
+
+template <typename T, size_t BlockBytes>
+void UnrolledList<T, BlockBytes>::unlink_block(base_ptr b) noexcept {
+  b->prev->next = b->next;
+  b->next->prev = b->prev;
+}
+
+// 首尾块原先指向old_head，改为指向当前容器的头结点
+template <typename T, size_t BlockBytes>
+void UnrolledList<T, BlockBytes>::adopt_head(base_ptr old_head) noexcept {
+  if (head_.next == old_head) {
+    head_.unlink();
+  } else {
+    head_.next->prev = &head_;
+    head_.prev->next = &head_;
+  }
+}
+
+// 把块b中下标不小于i的元素移到紧随其后的新块中，返回新块
+template <typename T, size_t BlockBytes>
+typename UnrolledList<T, BlockBytes>::node_ptr UnrolledList<T, BlockBytes>::split_block(
+    base_ptr b, size_type i) {
+  node_ptr nb = create_block();
+  T* d = b->as_node()->data();
+  try {
+    mystl::uninitialized_move(d + i, d + b->count, nb->data());
+  } catch (...) {
+    node_allocator::deallocate(nb);
+    throw;
+  }
+  nb->count = b->count - i;
+  data_allocator::destroy(d + i, d + b->count);
+  b->count = i;
+  link_block(b->next, nb);
+  return nb;
+}
+
+// 块b不足半满且能容纳后一个块的所有元素时，把后一个块并入b
+template <typename T, size_t BlockBytes>
+void UnrolledList<T, BlockBytes>::merge_next(base_ptr b) {
+  base_ptr next = b->next;
+  if (next == end_node() || b->count >= kBlockSize / 2 || b->count + next->count > kBlockSize) {
+    return;
+  }
+  T* d = b->as_node()->data();
+  T* nd = next->as_node()->data();
+  mystl::uninitialized_move(nd, nd + next->count, d + b->count);
+  b->count += next->count;
+  unlink_block(next);
+  destroy_block(next);
+}
+
+// 在未满的块b的下标i处构造元素
+template <typename T, size_t BlockBytes>
+template <typename... Args>
+void UnrolledList<T, BlockBytes>::insert_in_block(base_ptr b, size_type i, Args&&... args) {
+  MYSTL_DEBUG(b->count < kBlockSize && i <= b->count);
+  T* d = b->as_node()->data();
+  const size_type n = b->count;
+  if (i == n) {
+    data_allocator::construct(d + n, mystl::forward<Args>(args)...);
+    ++b->count;
+    return;
+  }
+  // 先构造新元素，避免参数引用容器中将要移动的元素
+  value_type tmp(mystl::forward<Args>(args)...);
+  data_allocator::construct(d + n, mystl::move(d[n - 1]));
+  ++b->count;
+  mystl::move_backward(d + i, d + n - 1, d + n);
+  d[i] = mystl::move(tmp);
+}
+
+// 用n个元素初始化容器，块尽量填满
+template <typename T, size_t BlockBytes>
+void UnrolledList<T, BlockBytes>::fill_init(size_type n, const value_type& value) {
+  try {
+    for (; n > 0; --n) {
+      emplace_back(value);
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+// 以[first, last)初始化容器
+template <typename T, size_t BlockBytes>
+template <typename Iter>
+void UnrolledList<T, BlockBytes>::copy_init(Iter first, Iter last) {
+  try {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+// 重载比较操作符
+template <typename T, size_t BlockBytes>
+bool operator==(const UnrolledList<T, BlockBytes>& lhs, const UnrolledList<T, BlockBytes>& rhs) {
+  return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, size_t BlockBytes>
+bool operator<(const UnrolledList<T, BlockBytes>& lhs, const UnrolledList<T, BlockBytes>& rhs) {
+  return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, size_t BlockBytes>
+bool operator!=(const UnrolledList<T, BlockBytes>& lhs, const UnrolledList<T, BlockBytes>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename T, size_t BlockBytes>
+bool operator>(const UnrolledList<T, BlockBytes>& lhs, const UnrolledList<T, BlockBytes>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename T, size_t BlockBytes>
+bool operator<=(const UnrolledList<T, BlockBytes>& lhs, const UnrolledList<T, BlockBytes>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename T, size_t BlockBytes>
+bool operator>=(const UnrolledList<T, BlockBytes>& lhs, const UnrolledList<T, BlockBytes>& rhs) {
+  return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <typename T, size_t BlockBytes>
+void swap(UnrolledList<T, BlockBytes>& lhs, UnrolledList<T, BlockBytes>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace mystl
+#endif  // !MYTINYSTL_UNROLLED_LIST_H_
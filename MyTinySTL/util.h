@@ -53,6 +53,9 @@ void swap(Tp (&a)[N], Tp (&b)[N]) {
 
 // pair
 
+// 分段构造pair的标签：first由第一个参数构造，second由其余参数原地构造，不产生second的临时对象
+struct PiecewiseConstructTag {};
+
 // 结构体模板
 // 两个模板参数分别表示两个数据的类型
 // 用first和second来分别去除第一个和第二个数据
@@ -96,6 +99,10 @@ struct pair {
   pair(const pair& rhs) = default;
   pair(pair&& rhs) noexcept = default;
 
+  template <typename Other1, typename... Args>
+  pair(PiecewiseConstructTag /*unused*/, Other1&& a, Args&&... args)
+      : first(mystl::forward<Other1>(a)), second(mystl::forward<Args>(args)...) {}
+
   template <
       typename Other1,
       typename Other2,
@@ -515,6 +515,7 @@ template <typename T>
 void Vector<T>::fill_assign(size_type n, const value_type& value) {
   if (n > capacity()) {
     Vector tmp(n, value);
+    swap(tmp);
   } else if (n > size()) {
     mystl::fill(begin(), end(), value);
     end_ = mystl::uninitialized_fill_n(end_, n - size(), value);
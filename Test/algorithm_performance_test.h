@@ -1,7 +1,8 @@
 ﻿#ifndef MYTINYSTL_ALGORITHM_PERFORMANCE_TEST_H_
 #define MYTINYSTL_ALGORITHM_PERFORMANCE_TEST_H_
 
-// 仅仅针对 sort, binary_search 做了性能测试
+// 针对 sort, binary_search 以及 count, find, min_element, max_element, equal, mismatch
+// 与 set_intersection 做了性能测试
 
 #include <algorithm>
 
@@ -55,6 +56,150 @@ namespace algorithm_performance_test
     delete []arr;                                              \
 } while(0)
 
+// 扫描类函数的性能测试宏定义，args 为调用参数，可以使用 arr、last 与 arr2
+// [arr, last) 共 count 个元素，arr2 与 arr 的内容相同
+// 每个测试共扫描 LEN3 * 20 个元素，即重复 LEN3 * 20 / count 轮
+// 每轮从 volatile 指针重新读取 arr 与 arr2，避免编译器把不变的调用提到循环外
+#define FUN_TEST3(mode, fun, count, args) do {                \
+    std::string fun_name = #fun;                               \
+    srand((int)time(0));                                       \
+    char buf[10];                                              \
+    clock_t start, end;                                        \
+    int *volatile data1 = new int[count];                      \
+    int *volatile data2 = new int[count];                      \
+    for(size_t i = 0; i < count; ++i)                          \
+        *(data1 + i) = *(data2 + i) = rand() % 1000;           \
+    const size_t rounds = static_cast<size_t>(LEN3) * 20 / count; \
+    size_t sum = 0;                                            \
+    start = clock();                                           \
+    for(size_t i = 0; i < rounds; ++i) {                       \
+        int *arr = data1, *arr2 = data2, *last = arr + count;  \
+        sum += scan_result(mode::fun args, arr);               \
+        (void)arr2; (void)last;                                \
+    }                                                          \
+    end = clock();                                             \
+    scan_sink = sum;                                           \
+    int n = static_cast<int>(static_cast<double>(end - start)  \
+        / CLOCKS_PER_SEC * 1000);                              \
+    std::snprintf(buf, sizeof(buf), "%d", n);                  \
+    std::string t = buf;                                       \
+    t += "ms   |";                                             \
+    std::cout << std::setw(WIDE) << t;                         \
+    delete []data1;                                            \
+    delete []data2;                                            \
+} while(0)
+
+// 集合算法的性能测试宏定义，[arr, last) 共 count 个元素，[arr2, last2) 共 count / ratio 个元素
+// 两个序列都是有序的 unsigned 整数，每个测试共处理 LEN3 * 2 个元素
+#define FUN_TEST4(mode, fun, count, ratio) do {              \
+    std::string fun_name = #fun;                               \
+    srand((int)time(0));                                       \
+    char buf[10];                                              \
+    clock_t start, end;                                        \
+    const size_t count2 = (count) / (ratio);                   \
+    unsigned *volatile data1 = new unsigned[count];            \
+    unsigned *volatile data2 = new unsigned[count2];           \
+    unsigned *out = new unsigned[count2];                      \
+    for(size_t i = 0; i < count; ++i)                          \
+        *(data1 + i) = rand() % (count * 4);                   \
+    for(size_t i = 0; i < count2; ++i)                         \
+        *(data2 + i) = rand() % (count * 4);                   \
+    std::sort(data1, data1 + count);                           \
+    std::sort(data2, data2 + count2);                          \
+    const size_t rounds = static_cast<size_t>(LEN3) * 2 / count;  \
+    size_t sum = 0;                                            \
+    start = clock();                                           \
+    for(size_t i = 0; i < rounds; ++i) {                       \
+        unsigned *arr = data1, *arr2 = data2;                  \
+        sum += mode::fun(arr, arr + count, arr2, arr2 + count2, out) - out; \
+    }                                                          \
+    end = clock();                                             \
+    scan_sink = sum;                                           \
+    int n = static_cast<int>(static_cast<double>(end - start)  \
+        / CLOCKS_PER_SEC * 1000);                              \
+    std::snprintf(buf, sizeof(buf), "%d", n);                  \
+    std::string t = buf;                                       \
+    t += "ms   |";                                             \
+    std::cout << std::setw(WIDE) << t;                         \
+    delete []data1;                                            \
+    delete []data2;                                            \
+    delete []out;                                              \
+} while(0)
+
+// 把扫描类函数的结果转换成整数累加起来，避免调用被优化掉
+volatile size_t scan_sink = 0;
+
+inline size_t scan_result(int* pos, int* base) { return static_cast<size_t>(pos - base); }
+inline size_t scan_result(bool b, int*) { return b ? 1 : 0; }
+inline size_t scan_result(std::ptrdiff_t n, int*) { return static_cast<size_t>(n); }
+inline size_t scan_result(size_t n, int*) { return static_cast<size_t>(n); }
+
+template <class T1, class T2>
+size_t scan_result(const std::pair<T1, T2>& p, int* base)
+{
+  return static_cast<size_t>(p.first - base);
+}
+
+template <class T1, class T2>
+size_t scan_result(const mystl::pair<T1, T2>& p, int* base)
+{
+  return static_cast<size_t>(p.first - base);
+}
+
+#define SCAN_TEST(fun, args) do {                                                 \
+  std::cout << "[---------------------- function : " << std::setw(12) << std::left    \
+            << #fun << std::right << " ----------------]" << std::endl;          \
+  std::cout << "| orders of magnitude |";                                         \
+  TEST_LEN(LEN1, LEN2, LEN3, WIDE);                                               \
+  std::cout << "|         std         |";                                         \
+  FUN_TEST3(std, fun, LEN1, args);                                                \
+  FUN_TEST3(std, fun, LEN2, args);                                                \
+  FUN_TEST3(std, fun, LEN3, args);                                                \
+  std::cout << std::endl << "|        mystl        |";                           \
+  FUN_TEST3(mystl, fun, LEN1, args);                                              \
+  FUN_TEST3(mystl, fun, LEN2, args);                                              \
+  FUN_TEST3(mystl, fun, LEN3, args);                                              \
+  std::cout << std::endl;                                                         \
+} while(0)
+
+// 以下函数在 int 指针上使用 SIMD 内核，与 std 的版本比较
+void scan_test()
+{
+  SCAN_TEST(count, (arr, last, 500));
+  SCAN_TEST(find, (arr, last, -1));
+  SCAN_TEST(min_element, (arr, last));
+  SCAN_TEST(max_element, (arr, last));
+  SCAN_TEST(equal, (arr, last, arr2));
+  SCAN_TEST(mismatch, (arr, last, arr2));
+}
+
+// 两个序列长度相同时 mystl 使用 SIMD 前进，相差 1000 倍时使用倍增查找
+void set_intersection_test()
+{
+  std::cout << "[--------------- function : set_intersection -------------------]" << std::endl;
+  std::cout << "|   ratio = 1         |";
+  TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+  std::cout << "|         std         |";
+  FUN_TEST4(std, set_intersection, LEN1, 1);
+  FUN_TEST4(std, set_intersection, LEN2, 1);
+  FUN_TEST4(std, set_intersection, LEN3, 1);
+  std::cout << std::endl << "|        mystl        |";
+  FUN_TEST4(mystl, set_intersection, LEN1, 1);
+  FUN_TEST4(mystl, set_intersection, LEN2, 1);
+  FUN_TEST4(mystl, set_intersection, LEN3, 1);
+  std::cout << std::endl << "|   ratio = 1000      |";
+  TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+  std::cout << "|         std         |";
+  FUN_TEST4(std, set_intersection, LEN1, 1000);
+  FUN_TEST4(std, set_intersection, LEN2, 1000);
+  FUN_TEST4(std, set_intersection, LEN3, 1000);
+  std::cout << std::endl << "|        mystl        |";
+  FUN_TEST4(mystl, set_intersection, LEN1, 1000);
+  FUN_TEST4(mystl, set_intersection, LEN2, 1000);
+  FUN_TEST4(mystl, set_intersection, LEN3, 1000);
+  std::cout << std::endl;
+}
+
 void binary_search_test()
 {
   std::cout << "[------------------- function : binary_search ------------------]" << std::endl;
@@ -95,6 +240,8 @@ void algorithm_performance_test()
   std::cout << "[--------------- Run algorithm performance test ----------------]" << std::endl;
   sort_test();
   binary_search_test();
+  scan_test();
+  set_intersection_test();
   std::cout << "[--------------- End algorithm performance test ----------------]" << std::endl;
   std::cout << "[===============================================================]" << std::endl;
 #endif // PERFORMANCE_TEST_ON
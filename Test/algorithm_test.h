@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <limits>
 #include <numeric>
 
 #include "../MyTinySTL/algorithm.h"
@@ -295,6 +296,34 @@ TEST(sort_heap_test) {
   EXPECT_CON_EQ(arr3, arr4);
 }
 
+TEST(dary_heap_test) {
+  int arr1[] = {5, 1, 9, 3, 7, 3, 8, 2, 6, 4, 0, 9, 1};
+  int arr2[13], arr3[13], arr4[13];
+  for (int i = 0; i < 13; ++i) {
+    arr2[i] = arr3[i] = arr4[i] = arr1[i];
+  }
+  std::sort(arr1, arr1 + 13);
+  mystl::make_dary_heap<4>(arr2, arr2 + 13);
+  EXPECT_TRUE(mystl::is_dary_heap<4>(arr2, arr2 + 13));
+  EXPECT_EQ(arr1[12], arr2[0]);
+  mystl::sort_dary_heap<4>(arr2, arr2 + 13);
+  EXPECT_CON_EQ(arr1, arr2);
+  for (int i = 1; i <= 13; ++i) {
+    mystl::push_dary_heap<8>(arr3, arr3 + i);
+  }
+  EXPECT_TRUE(mystl::is_dary_heap<8>(arr3, arr3 + 13));
+  for (int i = 13; i > 1; --i) {
+    mystl::pop_dary_heap<8>(arr3, arr3 + i);
+  }
+  EXPECT_CON_EQ(arr1, arr3);
+  std::sort(arr1, arr1 + 13, std::greater<int>());
+  mystl::make_dary_heap<3>(arr4, arr4 + 13, std::greater<int>());
+  EXPECT_TRUE(mystl::is_dary_heap<3>(arr4, arr4 + 13, std::greater<int>()));
+  EXPECT_FALSE(mystl::is_dary_heap<3>(arr4, arr4 + 13));
+  mystl::sort_dary_heap<3>(arr4, arr4 + 13, std::greater<int>());
+  EXPECT_CON_EQ(arr1, arr4);
+}
+
 // set_algo test
 TEST(set_difference_test) {
   int arr1[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
@@ -310,6 +339,17 @@ TEST(set_difference_test) {
   std::set_difference(arr1, arr1 + 9, arr3, arr3 + 3, exp, std::less<int>());
   mystl::set_difference(arr1, arr1 + 9, arr3, arr3 + 3, act, std::less<int>());
   EXPECT_CON_EQ(exp, act);
+  int big[256], small[] = {3, 3, 3, 200};
+  for (int i = 0; i < 256; ++i) {
+    big[i] = i / 2;
+  }
+  int exp2[256] = {0}, act2[256] = {0};
+  std::set_difference(big, big + 256, small, small + 4, exp2);
+  mystl::set_difference(big, big + 256, small, small + 4, act2);
+  EXPECT_CON_EQ(exp2, act2);
+  std::set_difference(small, small + 4, big, big + 256, exp2);
+  mystl::set_difference(small, small + 4, big, big + 256, act2);
+  EXPECT_CON_EQ(exp2, act2);
 }
 
 TEST(set_intersection_test) {
@@ -327,6 +367,25 @@ TEST(set_intersection_test) {
   mystl::set_intersection(arr1, arr1 + 9, arr3, arr3 + 3, act,
                           std::less<int>());
   EXPECT_CON_EQ(exp, act);
+  int big[256], small[] = {3, 3, 3, 200};
+  for (int i = 0; i < 256; ++i) {
+    big[i] = i / 2;
+  }
+  int exp2[4] = {0}, act2[4] = {0};
+  std::set_intersection(big, big + 256, small, small + 4, exp2);
+  mystl::set_intersection(big, big + 256, small, small + 4, act2);
+  EXPECT_CON_EQ(exp2, act2);
+  std::set_intersection(small, small + 4, big, big + 256, exp2, std::less<int>());
+  mystl::set_intersection(small, small + 4, big, big + 256, act2, std::less<int>());
+  EXPECT_CON_EQ(exp2, act2);
+  unsigned u1[40], u2[40], exp3[40] = {0}, act3[40] = {0};
+  for (unsigned i = 0; i < 40; ++i) {
+    u1[i] = i / 3 + 0x7ffffff0u;
+    u2[i] = i / 2 * 3 + 0x7ffffff0u;
+  }
+  std::set_intersection(u1, u1 + 40, u2, u2 + 40, exp3);
+  mystl::set_intersection(u1, u1 + 40, u2, u2 + 40, act3);
+  EXPECT_CON_EQ(exp3, act3);
 }
 
 TEST(set_symmetric_difference_test) {
@@ -345,6 +404,14 @@ TEST(set_symmetric_difference_test) {
   mystl::set_symmetric_difference(arr2, arr2 + 5, arr3, arr3 + 5, act,
                                   std::less<int>());
   EXPECT_CON_EQ(exp, act);
+  int big[256], small[] = {3, 3, 3, 200};
+  for (int i = 0; i < 256; ++i) {
+    big[i] = i / 2;
+  }
+  int exp2[260] = {0}, act2[260] = {0};
+  std::set_symmetric_difference(big, big + 256, small, small + 4, exp2);
+  mystl::set_symmetric_difference(big, big + 256, small, small + 4, act2);
+  EXPECT_CON_EQ(exp2, act2);
 }
 
 TEST(set_union_test) {
@@ -361,6 +428,14 @@ TEST(set_union_test) {
   std::set_union(arr2, arr2 + 5, arr3, arr3 + 5, exp, std::less<int>());
   mystl::set_union(arr2, arr2 + 5, arr3, arr3 + 5, act, std::less<int>());
   EXPECT_CON_EQ(exp, act);
+  int big[256], small[] = {3, 3, 3, 200};
+  for (int i = 0; i < 256; ++i) {
+    big[i] = i / 2;
+  }
+  int exp2[260] = {0}, act2[260] = {0};
+  std::set_union(small, small + 4, big, big + 256, exp2, std::less<int>());
+  mystl::set_union(small, small + 4, big, big + 256, act2, std::less<int>());
+  EXPECT_CON_EQ(exp2, act2);
 }
 
 // numeric test
@@ -372,6 +447,14 @@ TEST(accumulate_test) {
             mystl::accumulate(arr1, arr1 + 5, 5));
   EXPECT_EQ(std::accumulate(arr1, arr1 + 5, 0, std::minus<int>()),
             mystl::accumulate(arr1, arr1 + 5, 0, std::minus<int>()));
+  int arr2[] = {1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 11, -12, 13, -14, 15, -16, 17, -18, 19};
+  double arr3[] = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0, 1.1, 1.2, 1.3};
+  EXPECT_EQ(std::accumulate(arr2, arr2 + 19, 0),
+            mystl::accumulate(arr2, arr2 + 19, 0));
+  EXPECT_EQ(std::accumulate(arr2, arr2 + 19, 10L),
+            mystl::accumulate(arr2, arr2 + 19, 10L));
+  EXPECT_EQ(std::accumulate(arr3, arr3 + 13, 0.0),
+            mystl::accumulate(arr3, arr3 + 13, 0.0));
 }
 
 TEST(adjacent_difference_test) {
@@ -396,6 +479,12 @@ TEST(inner_product_test) {
                                std::multiplies<int>()),
             mystl::inner_product(arr2, arr2 + 5, arr3, 0, std::minus<int>(),
                                  std::multiplies<int>()));
+  short arr4[] = {1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 11, -12, 13, -14, 15, -16, 17};
+  float arr5[] = {0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f, 8.5f, 9.5f, 10.5f};
+  EXPECT_EQ(std::inner_product(arr4, arr4 + 17, arr4, 0),
+            mystl::inner_product(arr4, arr4 + 17, arr4, 0));
+  EXPECT_EQ(std::inner_product(arr5, arr5 + 11, arr5, 0.1f),
+            mystl::inner_product(arr5, arr5 + 11, arr5, 0.1f));
 }
 
 TEST(iota_test) {
@@ -424,6 +513,21 @@ TEST(partial_sum_test) {
   EXPECT_CON_EQ(exp2, act2);
 }
 
+TEST(transform_reduce_test) {
+  int arr1[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  int arr2[] = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+  EXPECT_EQ(std::inner_product(arr1, arr1 + 12, arr2, 0),
+            mystl::transform_reduce(arr1, arr1 + 12, arr2, 0));
+  EXPECT_EQ(std::inner_product(arr1, arr1 + 12, arr2, 0, std::minus<int>(),
+                               std::multiplies<int>()),
+            mystl::transform_reduce(arr1, arr1 + 12, arr2, 0, std::minus<int>(),
+                                    std::multiplies<int>()));
+  int exp[12];
+  std::transform(arr1, arr1 + 12, exp, unary_op);
+  EXPECT_EQ(std::accumulate(exp, exp + 12, 5),
+            mystl::transform_reduce(arr1, arr1 + 12, 5, binary_op, unary_op));
+}
+
 // algo test
 TEST(adjacent_find_test) {
   int arr1[] = {1, 2, 3, 3, 4};
@@ -467,6 +571,32 @@ TEST(count_test) {
   EXPECT_EQ(std::count(arr1, arr1 + 9, 2), mystl::count(arr1, arr1 + 9, 2));
   EXPECT_EQ(std::count(arr1, arr1 + 9, 3), mystl::count(arr1, arr1 + 9, 3));
   EXPECT_EQ(std::count(arr1, arr1 + 9, 6), mystl::count(arr1, arr1 + 9, 6));
+  // 符号不同的整数按通常的算术转换比较
+  unsigned char arr2[64];
+  unsigned short arr3[64];
+  unsigned arr4[64];
+  for (int i = 0; i < 64; ++i) {
+    arr2[i] = static_cast<unsigned char>(i == 40 ? 255 : i);
+    arr3[i] = static_cast<unsigned short>(i == 40 ? 65535 : i);
+    arr4[i] = i == 40 ? 4294967295u : static_cast<unsigned>(i);
+  }
+  const signed char sc = -1;
+  const short ss = -1;
+  EXPECT_EQ(std::count(arr2, arr2 + 64, sc), mystl::count(arr2, arr2 + 64, sc));
+  EXPECT_EQ(std::count(arr2, arr2 + 64, 255), mystl::count(arr2, arr2 + 64, 255));
+  EXPECT_EQ(std::count(arr3, arr3 + 64, ss), mystl::count(arr3, arr3 + 64, ss));
+  EXPECT_EQ(std::count(arr4, arr4 + 64, -1), mystl::count(arr4, arr4 + 64, -1));
+  // 浮点数的值超出元素类型的范围、不是整数或者是 NaN
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_EQ(std::count(arr2, arr2 + 64, 255.0), mystl::count(arr2, arr2 + 64, 255.0));
+  EXPECT_EQ(std::count(arr2, arr2 + 64, 511.0), mystl::count(arr2, arr2 + 64, 511.0));
+  EXPECT_EQ(std::count(arr2, arr2 + 64, 2.5), mystl::count(arr2, arr2 + 64, 2.5));
+  EXPECT_EQ(std::count(arr2, arr2 + 64, -1.0), mystl::count(arr2, arr2 + 64, -1.0));
+  EXPECT_EQ(std::count(arr2, arr2 + 64, nan), mystl::count(arr2, arr2 + 64, nan));
+  EXPECT_EQ(std::count(arr4, arr4 + 64, 4294967295.0),
+            mystl::count(arr4, arr4 + 64, 4294967295.0));
+  EXPECT_EQ(std::count(arr4, arr4 + 64, 4294967296.0),
+            mystl::count(arr4, arr4 + 64, 4294967296.0));
 }
 
 TEST(count_if_test) {
@@ -493,6 +623,32 @@ TEST(find_test) {
   int arr1[] = {1, 2, 3, 4, 5};
   EXPECT_EQ(std::find(arr1, arr1 + 5, 3), mystl::find(arr1, arr1 + 5, 3));
   EXPECT_EQ(std::find(arr1, arr1 + 5, 6), mystl::find(arr1, arr1 + 5, 6));
+  // 符号不同的整数按通常的算术转换比较
+  unsigned char arr2[64];
+  unsigned arr3[64];
+  for (int i = 0; i < 64; ++i) {
+    arr2[i] = static_cast<unsigned char>(i == 40 ? 255 : i);
+    arr3[i] = i == 40 ? 4294967295u : static_cast<unsigned>(i);
+  }
+  const signed char sc = -1;
+  EXPECT_EQ(std::find(arr2, arr2 + 64, sc), mystl::find(arr2, arr2 + 64, sc));
+  EXPECT_EQ(std::find(arr2, arr2 + 64, 255), mystl::find(arr2, arr2 + 64, 255));
+  EXPECT_EQ(std::find(arr3, arr3 + 64, -1), mystl::find(arr3, arr3 + 64, -1));
+  // 浮点数的值超出元素类型的范围、不是整数或者是 NaN
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_EQ(std::find(arr2, arr2 + 64, 40.0), mystl::find(arr2, arr2 + 64, 40.0));
+  EXPECT_EQ(std::find(arr2, arr2 + 64, 1e300), mystl::find(arr2, arr2 + 64, 1e300));
+  EXPECT_EQ(std::find(arr2, arr2 + 64, nan), mystl::find(arr2, arr2 + 64, nan));
+  EXPECT_EQ(std::find(arr3, arr3 + 64, 4294967295.0),
+            mystl::find(arr3, arr3 + 64, 4294967295.0));
+  EXPECT_EQ(std::find(arr3, arr3 + 64, -0.5), mystl::find(arr3, arr3 + 64, -0.5));
+  float arr4[64];
+  for (int i = 0; i < 64; ++i) {
+    arr4[i] = i == 40 ? 0.5f : static_cast<float>(i) * 0.1f;
+  }
+  EXPECT_EQ(std::find(arr4, arr4 + 64, 0.5), mystl::find(arr4, arr4 + 64, 0.5));
+  EXPECT_EQ(std::find(arr4, arr4 + 64, 0.1), mystl::find(arr4, arr4 + 64, 0.1));
+  EXPECT_EQ(std::find(arr4, arr4 + 64, 1e300), mystl::find(arr4, arr4 + 64, 1e300));
 }
 
 TEST(find_end_test) {
@@ -0,0 +1,182 @@
+#ifndef MYTINYSTL_CIRCULAR_BUFFER_TEST_H_
+#define MYTINYSTL_CIRCULAR_BUFFER_TEST_H_
+
+// circular buffer test : 测试 circular buffer 的接口，并比较以 deque 和 circular buffer
+// 作为底层容器时 queue、stack 的性能
+
+#include <queue>
+#include <stack>
+#include <stdexcept>
+
+#include "../MyTinySTL/circular_buffer.h"
+#include "../MyTinySTL/queue.h"
+#include "../MyTinySTL/stack.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace circular_buffer_test {
+
+// 有界的工作队列：每轮放入batch个元素再全部取出，队列长度不超过batch，返回耗时（毫秒）
+template <typename Queue>
+long work_queue_time(Queue q, size_t rounds, int batch) {
+  long sum = 0;
+  clock_t start = clock();
+  for (size_t i = 0; i < rounds; ++i) {
+    for (int j = 0; j < batch; ++j) {
+      q.push(j);
+    }
+    while (!q.empty()) {
+      sum += q.front();
+      q.pop();
+    }
+  }
+  clock_t end = clock();
+  if (sum != static_cast<long>(rounds) * batch * (batch - 1) / 2) {
+    std::cout << red << " work queue result mismatch" << std::endl;
+  }
+  return static_cast<long>((end - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+// 每轮压入batch个元素再全部弹出，返回耗时
+template <typename Stack>
+long stack_time(Stack s, size_t rounds, int batch) {
+  long sum = 0;
+  clock_t start = clock();
+  for (size_t i = 0; i < rounds; ++i) {
+    for (int j = 0; j < batch; ++j) {
+      s.push(j);
+    }
+    while (!s.empty()) {
+      sum += s.top();
+      s.pop();
+    }
+  }
+  clock_t end = clock();
+  if (sum != static_cast<long>(rounds) * batch * (batch - 1) / 2) {
+    std::cout << red << " stack result mismatch" << std::endl;
+  }
+  return static_cast<long>((end - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+// 移动构造可能抛出异常、复制构造在copy_fails为true时抛出异常的元素，用来检查扩容失败时元素保持不变
+struct FragileValue {
+  static bool copy_fails;
+  int value;
+  explicit FragileValue(int v) : value(v) {}
+  FragileValue(const FragileValue& rhs) : value(rhs.value) {
+    if (copy_fails) {
+      throw std::runtime_error("FragileValue");
+    }
+  }
+  FragileValue(FragileValue&& rhs) : value(rhs.value) {}
+};
+bool FragileValue::copy_fails = false;
+
+// 输出一行，依次为 std 的适配器、以 Deque 为底层容器、以 CircularBuffer 为底层容器的耗时
+void print_row(const char* name, long t1, long t2, long t3) {
+  std::cout << "|" << std::setw(20) << name << " |" << std::setw(11) << t1 << "ms|"
+            << std::setw(11) << t2 << "ms|" << std::setw(11) << t3 << "ms|" << std::endl;
+}
+
+void circular_buffer_test() {
+  using ring = mystl::CircularBuffer<int>;
+  using overwrite_ring = mystl::CircularBuffer<int, true>;
+
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[----------- Run container test : CircularBuffer ---------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  int a[] = {1, 2, 3, 4, 5};
+  ring c1;
+  ring c2(5);
+  ring c3(5, 1);
+  ring c4(a, a + 5);
+  ring c5(c2);
+  ring c6(std::move(c2));
+  ring c7;
+  c7 = c3;
+  ring c8;
+  c8 = std::move(c3);
+  ring c9{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  ring c10;
+  c10 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  overwrite_ring c11;
+  c11.reserve(4);
+
+  FUN_AFTER(c1, c1.assign(5, 1));
+  FUN_AFTER(c1, c1.assign(a, a + 5));
+  FUN_AFTER(c1, c1.assign({1, 2, 3}));
+  FUN_AFTER(c1, c1.emplace_back(4));
+  FUN_AFTER(c1, c1.emplace_front(0));
+  FUN_AFTER(c1, c1.push_back(5));
+  FUN_AFTER(c1, c1.push_front(-1));
+  FUN_AFTER(c1, c1.pop_front());
+  FUN_AFTER(c1, c1.pop_back());
+  FUN_AFTER(c1, for (int i = 0; i < 6; ++i) c1.push_back(i));
+  FUN_AFTER(c1, c1.swap(c4));
+  FUN_AFTER(c11, for (int i = 1; i <= 6; ++i) c11.push_back(i));
+  FUN_AFTER(c11, c11.push_front(0));
+  FUN_VALUE(c1.front());
+  FUN_VALUE(c1.back());
+  FUN_VALUE(c1[2]);
+  FUN_VALUE(c1.at(3));
+  FUN_VALUE(*(c9.begin() + 4));
+  FUN_VALUE(*(c9.rbegin()));
+  FUN_VALUE(c11.array_one().second);
+  FUN_VALUE(c11.array_two().second);
+  std::cout << std::boolalpha;
+  FUN_VALUE(c1.empty());
+  FUN_VALUE(c11.full());
+  FUN_VALUE((c9 == c10));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(c1.size());
+  FUN_VALUE(c1.capacity());
+  FUN_VALUE(c11.capacity());
+  FUN_AFTER(c1, c1.clear());
+  FUN_VALUE(c1.capacity());
+  mystl::CircularBuffer<FragileValue> c12;
+  c12.reserve(4);
+  for (int i = 0; i < 6; ++i) {
+    if (c12.full()) {
+      c12.pop_front();
+    }
+    c12.emplace_back(i);
+  }
+  FragileValue::copy_fails = true;
+  try {
+    c12.emplace_back(6);
+  } catch (const std::runtime_error&) {
+  }
+  FragileValue::copy_fails = false;
+  FUN_VALUE(c12.size());
+  FUN_VALUE(c12.capacity());
+  FUN_VALUE(c12.front().value);
+  FUN_VALUE(c12.back().value);
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|     operation       |     std     |    Deque    | CircularBuf |" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  const size_t rounds = SCALE_S(LEN2);
+  const int batch = 64;
+  ring reserved;
+  reserved.reserve(batch);
+  print_row("work queue x64",
+            work_queue_time(std::queue<int>(), rounds, batch),
+            work_queue_time(mystl::Queue<int>(), rounds, batch),
+            work_queue_time(mystl::Queue<int, ring>(reserved), rounds, batch));
+  print_row("stack x64",
+            stack_time(std::stack<int>(), rounds, batch),
+            stack_time(mystl::Stack<int>(), rounds, batch),
+            stack_time(mystl::Stack<int, ring>(reserved), rounds, batch));
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[----------- End container test : CircularBuffer ---------------]" << std::endl;
+}
+
+}  // namespace circular_buffer_test
+}  // namespace test
+}  // namespace mystl
+#endif  // !MYTINYSTL_CIRCULAR_BUFFER_TEST_H_
@@ -0,0 +1,361 @@
+#ifndef MYTINYSTL_CONCURRENT_QUEUE_TEST_H_
+#define MYTINYSTL_CONCURRENT_QUEUE_TEST_H_
+
+// concurrent queue test : 测试 spsc queue、mpmc queue 的接口，
+// 并在多个线程之间比较它们与加锁的 queue 的吞吐量和延迟
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+#include "../MyTinySTL/concurrent_queue.h"
+#include "../MyTinySTL/queue.h"
+#include "../MyTinySTL/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace concurrent_queue_test {
+
+// 用互斥量保护的有界 Queue，接口与 SpscQueue 相同，作为比较的基准
+template <typename T>
+class MutexQueue {
+ public:
+  explicit MutexQueue(size_t capacity) : capacity_(capacity) {}
+
+  bool try_push(const T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.size() == capacity_) {
+      return false;
+    }
+    queue_.push(value);
+    return true;
+  }
+
+  bool try_pop(T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+      return false;
+    }
+    value = queue_.front();
+    queue_.pop();
+    return true;
+  }
+
+  size_t try_push_n(const T* first, size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t count = mystl::min(n, capacity_ - queue_.size());
+    for (size_t i = 0; i < count; ++i) {
+      queue_.push(first[i]);
+    }
+    return count;
+  }
+
+  size_t try_pop_n(T* result, size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t count = mystl::min(n, queue_.size());
+    for (size_t i = 0; i < count; ++i) {
+      result[i] = queue_.front();
+      queue_.pop();
+    }
+    return count;
+  }
+
+ private:
+  std::mutex mutex_;
+  mystl::Queue<T> queue_;
+  size_t capacity_;
+};
+
+// 把线程绑定到第cpu个处理器上，只在 Linux 下生效
+void pin_thread(std::thread& t, unsigned cpu) {
+#if defined(__linux__)
+  const unsigned n = std::thread::hardware_concurrency();
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(n == 0 ? 0 : cpu % n, &set);
+  pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#else
+  (void)t;
+  (void)cpu;
+#endif
+}
+
+// 生产者线程向队列放入count个整数，消费者线程全部取出，每次处理batch个，返回耗时（毫秒）
+// 两个线程同时运行，使用 steady_clock 计时而不是 clock
+template <typename Queue>
+long throughput_time(size_t count, size_t batch) {
+  Queue q(1024);
+  long sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  std::thread consumer([&] {
+    int buf[64];
+    long local = 0;
+    for (size_t got = 0; got < count;) {
+      size_t k = 0;
+      if (batch == 1) {
+        k = q.try_pop(buf[0]) ? 1 : 0;
+      } else {
+        k = q.try_pop_n(buf, mystl::min(batch, count - got));
+      }
+      if (k == 0) {
+        std::this_thread::yield();
+      }
+      for (size_t i = 0; i < k; ++i) {
+        local += buf[i];
+      }
+      got += k;
+    }
+    sum = local;
+  });
+  std::thread producer([&] {
+    int buf[64];
+    for (size_t sent = 0; sent < count;) {
+      const size_t want = mystl::min(batch, count - sent);
+      for (size_t i = 0; i < want; ++i) {
+        buf[i] = static_cast<int>((sent + i) & 1023);
+      }
+      for (size_t done = 0; done < want;) {
+        size_t k = 0;
+        if (batch == 1) {
+          k = q.try_push(buf[0]) ? 1 : 0;
+        } else {
+          k = q.try_push_n(buf + done, want - done);
+        }
+        if (k == 0) {
+          std::this_thread::yield();
+        }
+        done += k;
+      }
+      sent += want;
+    }
+  });
+  pin_thread(producer, 0);
+  pin_thread(consumer, 1);
+  producer.join();
+  consumer.join();
+  auto end = std::chrono::steady_clock::now();
+  long expect = 0;
+  for (size_t i = 0; i < count; ++i) {
+    expect += static_cast<long>(i & 1023);
+  }
+  if (sum != expect) {
+    std::cout << red << " throughput result mismatch" << std::endl;
+  }
+  return static_cast<long>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+}
+
+// 两个线程通过一对队列来回传递一个整数rounds次，返回平均每个来回的耗时（纳秒）
+template <typename Queue>
+long ping_pong_time(size_t rounds) {
+  Queue ping(16);
+  Queue pong(16);
+  std::thread echo([&] {
+    int value = 0;
+    for (size_t i = 0; i < rounds; ++i) {
+      while (!ping.try_pop(value)) {
+        std::this_thread::yield();
+      }
+      while (!pong.try_push(value + 1)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  pin_thread(echo, 1);
+  auto start = std::chrono::steady_clock::now();
+  int value = 0;
+  for (size_t i = 0; i < rounds; ++i) {
+    while (!ping.try_push(value)) {
+      std::this_thread::yield();
+    }
+    while (!pong.try_pop(value)) {
+      std::this_thread::yield();
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  echo.join();
+  if (value != static_cast<int>(rounds)) {
+    std::cout << red << " ping-pong result mismatch" << std::endl;
+  }
+  return static_cast<long>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / rounds);
+}
+
+// producers个生产者线程共放入count个整数，consumers个消费者线程全部取出，返回耗时（毫秒）
+// 生产者与消费者的数目可以分别调整，用来观察两端各自的竞争对吞吐量的影响
+template <typename Queue>
+long scaling_time(size_t count, unsigned producers, unsigned consumers) {
+  Queue q(1024);
+  mystl::Vector<long> sums(consumers, 0);
+  mystl::Vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned c = 0; c < consumers; ++c) {
+    // 前 count % consumers 个消费者各多取一个
+    const size_t want = count / consumers + (c < count % consumers ? 1 : 0);
+    threads.emplace_back([&q, &sums, c, want] {
+      int value = 0;
+      long local = 0;
+      for (size_t got = 0; got < want; ++got) {
+        while (!q.try_pop(value)) {
+          std::this_thread::yield();
+        }
+        local += value;
+      }
+      sums[c] = local;
+    });
+  }
+  for (unsigned p = 0; p < producers; ++p) {
+    threads.emplace_back([&q, p, producers, count] {
+      for (size_t i = p; i < count; i += producers) {
+        while (!q.try_push(static_cast<int>(i & 1023))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (unsigned i = 0; i < threads.size(); ++i) {
+    pin_thread(threads[i], i);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  auto end = std::chrono::steady_clock::now();
+  long sum = 0;
+  long expect = 0;
+  for (unsigned c = 0; c < consumers; ++c) {
+    sum += sums[c];
+  }
+  for (size_t i = 0; i < count; ++i) {
+    expect += static_cast<long>(i & 1023);
+  }
+  if (sum != expect) {
+    std::cout << red << " scaling result mismatch" << std::endl;
+  }
+  return static_cast<long>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+}
+
+// 输出一行，依次为加锁的 Queue、无锁队列的耗时
+void print_row(const char* name, long t1, long t2, const char* unit) {
+  std::cout << "|" << std::setw(20) << name << " |" << std::setw(11) << t1 << unit << "|"
+            << std::setw(11) << t2 << unit << "|" << std::endl;
+}
+
+void spsc_queue_test() {
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[-------------- Run container test : SpscQueue -----------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  int a[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  int b[8] = {0};
+  int x = 0;
+  mystl::SpscQueue<int> q(6);
+  FUN_VALUE(q.capacity());
+  std::cout << std::boolalpha;
+  FUN_VALUE(q.empty());
+  FUN_VALUE(q.try_push(1));
+  FUN_VALUE(q.try_push(2));
+  FUN_VALUE(q.try_push_n(a + 2, 6));
+  FUN_VALUE(q.try_push(9));
+  FUN_VALUE(q.size());
+  FUN_VALUE(q.try_pop(x));
+  FUN_VALUE(x);
+  FUN_VALUE(q.try_pop_n(b, 3));
+  FUN_VALUE(b[0]);
+  FUN_VALUE(b[2]);
+  q.push(9);
+  q.push_n(a, 2);
+  q.pop_n(b, 5);
+  FUN_VALUE(b[4]);
+  q.pop(x);
+  FUN_VALUE(x);
+  FUN_VALUE(q.size());
+  FUN_VALUE(q.try_pop(x));
+  FUN_VALUE(q.empty());
+  std::cout << std::noboolalpha;
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  std::cout << "|     operation       | mutex Queue |  SpscQueue  |" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  using mutex_queue = MutexQueue<int>;
+  using spsc_queue = mystl::SpscQueue<int>;
+  const size_t count = SCALE_LL(LEN2);
+  const size_t rounds = SCALE_SS(LEN2);
+  print_row("throughput",
+            throughput_time<mutex_queue>(count, 1),
+            throughput_time<spsc_queue>(count, 1),
+            "ms");
+  print_row("throughput x32",
+            throughput_time<mutex_queue>(count, 32),
+            throughput_time<spsc_queue>(count, 32),
+            "ms");
+  print_row("ping-pong latency",
+            ping_pong_time<mutex_queue>(rounds),
+            ping_pong_time<spsc_queue>(rounds),
+            "ns");
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[-------------- End container test : SpscQueue -----------------]" << std::endl;
+}
+
+void mpmc_queue_test() {
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[-------------- Run container test : MpmcQueue -----------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  int x = 0;
+  mystl::MpmcQueue<int> q(6);
+  FUN_VALUE(q.capacity());
+  std::cout << std::boolalpha;
+  FUN_VALUE(q.empty());
+  FUN_VALUE(q.try_push(1));
+  FUN_VALUE(q.try_emplace(2));
+  for (int i = 3; i <= 8; ++i) {
+    q.push(i);
+  }
+  FUN_VALUE(q.try_push(9));
+  FUN_VALUE(q.size());
+  FUN_VALUE(q.try_pop(x));
+  FUN_VALUE(x);
+  q.emplace(9);
+  q.pop(x);
+  FUN_VALUE(x);
+  FUN_VALUE(q.size());
+  while (q.try_pop(x)) {
+  }
+  FUN_VALUE(x);
+  FUN_VALUE(q.empty());
+  std::cout << std::noboolalpha;
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  std::cout << "|     operation       | mutex Queue |  MpmcQueue  |" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  using mutex_queue = MutexQueue<int>;
+  using mpmc_queue = mystl::MpmcQueue<int>;
+  const size_t count = SCALE_L(LEN2);
+  const unsigned shapes[][2] = {{1, 1}, {1, 4}, {4, 1}, {2, 2}, {4, 4}};
+  for (const auto& shape : shapes) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%uP x %uC", shape[0], shape[1]);
+    print_row(name,
+              scaling_time<mutex_queue>(count, shape[0], shape[1]),
+              scaling_time<mpmc_queue>(count, shape[0], shape[1]),
+              "ms");
+  }
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[-------------- End container test : MpmcQueue -----------------]" << std::endl;
+}
+
+}  // namespace concurrent_queue_test
+}  // namespace test
+}  // namespace mystl
+#endif  // !MYTINYSTL_CONCURRENT_QUEUE_TEST_H_
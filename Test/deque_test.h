@@ -1,17 +1,87 @@
 #ifndef MYTINYSTL_DEQUE_TEST_H_
 #define MYTINYSTL_DEQUE_TEST_H_
 
-// deque test : 测试 deque 的接口和 push_front/push_back 的性能
+// deque test : 测试 deque 的接口和 push_front/push_back 的性能，缓存空闲缓冲区的效果，
+// 以及 copy、fill 等算法逐段处理 deque 迭代器的效果
 
+#include <algorithm>
 #include <deque>
+#include <numeric>
 
+#include "../MyTinySTL/algo.h"
 #include "../MyTinySTL/deque.h"
+#include "../MyTinySTL/numeric.h"
+#include "../MyTinySTL/vector.h"
 #include "test.h"
 
 namespace mystl {
 namespace test {
 namespace deque_test {
 
+// 在缓冲区边界上反复push_back/pop_back，每次越过边界都要分配或释放一个缓冲区，返回耗时（毫秒）
+template <typename Container>
+long boundary_time(size_t rounds) {
+  Container c;
+  for (size_t i = 0; i + 1 < Container::kBufferSize; ++i) {
+    c.push_back(0);
+  }
+  clock_t start = clock();
+  for (size_t i = 0; i < rounds; ++i) {
+    c.push_back(1);
+    c.push_back(2);
+    c.pop_back();
+    c.pop_back();
+  }
+  clock_t end = clock();
+  return static_cast<long>((end - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+// 生产者每次放入16个元素，消费者随后取走16个，队列长度保持不变，返回耗时
+template <typename Container>
+long queue_flow_time(size_t rounds) {
+  Container c;
+  for (int i = 0; i < 100; ++i) {
+    c.push_back(i);
+  }
+  clock_t start = clock();
+  for (size_t i = 0; i < rounds; ++i) {
+    for (int j = 0; j < 16; ++j) {
+      c.push_back(j);
+    }
+    for (int j = 0; j < 16; ++j) {
+      c.pop_front();
+    }
+  }
+  clock_t end = clock();
+  if (c.size() != 100) {
+    std::cout << red << " queue flow size mismatch" << std::endl;
+  }
+  return static_cast<long>((end - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+// 在两个长度为n的容器上执行rounds次op(src, dst)，返回耗时
+template <typename Container, typename Op>
+long algo_time(size_t n, size_t rounds, Op op) {
+  Container src(n, 1);
+  Container dst(n);
+  long sink = 0;
+  clock_t start = clock();
+  for (size_t i = 0; i < rounds; ++i) {
+    sink += op(src, dst);
+  }
+  clock_t end = clock();
+  if (sink == -1) {
+    std::cout << " ";
+  }
+  return static_cast<long>((end - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+// 输出一行三个耗时，各列的含义见表头
+void print_row(const char* name, long t1, long t2, long t3) {
+  std::cout << "|" << std::setw(20) << name << " |" << std::setw(11) << t1 << "ms|"
+            << std::setw(11) << t2 << "ms|" << std::setw(11) << t3 << "ms|" << std::endl;
+}
+
 void deque_test() {
   std::cout << "[===============================================================]" << std::endl;
   std::cout << "[----------------- Run container test : Deque ------------------]" << std::endl;
@@ -30,6 +100,7 @@ void deque_test() {
   mystl::Deque<int> d9{1, 2, 3, 4, 5, 6, 7, 8, 9};
   mystl::Deque<int> d10;
   d10 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  mystl::Deque<int, 4, 1> d11(a, a + 5);
 
   FUN_AFTER(d1, d1.assign(5, 1));
   FUN_AFTER(d1, d1.assign(8, 8));
@@ -53,6 +124,10 @@ void deque_test() {
   FUN_AFTER(d1, d1.clear());
   FUN_AFTER(d1, d1.shrink_to_fit());
   FUN_AFTER(d1, d1.swap(d4));
+  FUN_AFTER(d11, d11.insert(d11.begin() + 2, 6, 0));
+  FUN_AFTER(d11, d11.erase(d11.begin() + 1, d11.end() - 1));
+  FUN_AFTER(d11, for (int i = 0; i < 9; ++i) d11.push_front(i));
+  FUN_AFTER(d11, for (int i = 0; i < 9; ++i) d11.pop_back());
   FUN_VALUE(*(d1.begin()));
   FUN_VALUE(*(d1.end() - 1));
   FUN_VALUE(*(d1.rbegin()));
@@ -89,6 +164,70 @@ void deque_test() {
 #endif
   std::cout << std::endl;
   std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|     operation       |  no cache   |   cache 2   |  buffer 64  |" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  const size_t rounds = SCALE_LL(LEN2);
+  print_row("boundary push/pop",
+            boundary_time<mystl::Deque<int, 0, 0>>(rounds),
+            boundary_time<mystl::Deque<int>>(rounds),
+            boundary_time<mystl::Deque<int, 64>>(rounds));
+  print_row("queue flow",
+            queue_flow_time<mystl::Deque<int, 0, 0>>(rounds),
+            queue_flow_time<mystl::Deque<int>>(rounds),
+            queue_flow_time<mystl::Deque<int, 64>>(rounds));
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|     algorithm       | std::deque  |    Deque    |   Vector    |" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  using std_deque = std::deque<int>;
+  using my_deque = mystl::Deque<int>;
+  using my_vector = mystl::Vector<int>;
+  const size_t n = 16384;
+  const size_t algo_rounds = SCALE_SS(LEN2);
+  print_row("copy",
+            algo_time<std_deque>(n, algo_rounds, [](std_deque& s, std_deque& d) {
+              return *std::copy(s.begin(), s.end() - 1, d.begin() + 1);
+            }),
+            algo_time<my_deque>(n, algo_rounds, [](my_deque& s, my_deque& d) {
+              return *mystl::copy(s.begin(), s.end() - 1, d.begin() + 1);
+            }),
+            algo_time<my_vector>(n, algo_rounds, [](my_vector& s, my_vector& d) {
+              return *mystl::copy(s.begin(), s.end() - 1, d.begin() + 1);
+            }));
+  print_row("fill",
+            algo_time<std_deque>(n, algo_rounds, [](std_deque& s, std_deque&) {
+              std::fill(s.begin(), s.end(), 2);
+              return s[0];
+            }),
+            algo_time<my_deque>(n, algo_rounds, [](my_deque& s, my_deque&) {
+              mystl::fill(s.begin(), s.end(), 2);
+              return s[0];
+            }),
+            algo_time<my_vector>(n, algo_rounds, [](my_vector& s, my_vector&) {
+              mystl::fill(s.begin(), s.end(), 2);
+              return s[0];
+            }));
+  print_row("accumulate",
+            algo_time<std_deque>(n, algo_rounds, [](std_deque& s, std_deque&) {
+              return std::accumulate(s.begin(), s.end(), 0L);
+            }),
+            algo_time<my_deque>(n, algo_rounds, [](my_deque& s, my_deque&) {
+              return mystl::accumulate(s.begin(), s.end(), 0L);
+            }),
+            algo_time<my_vector>(n, algo_rounds, [](my_vector& s, my_vector&) {
+              return mystl::accumulate(s.begin(), s.end(), 0L);
+            }));
+  print_row("find",
+            algo_time<std_deque>(n, algo_rounds, [](std_deque& s, std_deque&) {
+              return std::find(s.begin(), s.end(), 0) - s.begin();
+            }),
+            algo_time<my_deque>(n, algo_rounds, [](my_deque& s, my_deque&) {
+              return mystl::find(s.begin(), s.end(), 0) - s.begin();
+            }),
+            algo_time<my_vector>(n, algo_rounds, [](my_vector& s, my_vector&) {
+              return mystl::find(s.begin(), s.end(), 0) - s.begin();
+            }));
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
   PASSED;
 #endif
   std::cout << "[----------------- End container test : deque ------------------]" << std::endl;
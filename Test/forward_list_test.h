@@ -0,0 +1,176 @@
+#ifndef MYTINYSTL_FORWARD_LIST_TEST_H_
+#define MYTINYSTL_FORWARD_LIST_TEST_H_
+
+// forward list test : 测试 forward list 的接口，并与 list 比较头部插入、排序以及大量短链表的性能
+
+#include <stdexcept>
+#include <vector>
+
+#include "../MyTinySTL/forward_list.h"
+#include "../MyTinySTL/list.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace forward_list_test {
+
+bool is_odd(int x) { return x & 1; }
+
+// 比较若干次之后抛出异常，检查sort在异常时不丢失结点
+struct ThrowingLess {
+  int* left;
+  bool operator()(int a, int b) const {
+    if ((*left)-- == 0) {
+      throw std::runtime_error("ThrowingLess");
+    }
+    return a < b;
+  }
+};
+
+// 在头部插入count个元素，返回耗时（毫秒）
+template <typename Container>
+long push_front_time(size_t count) {
+  clock_t start = clock();
+  Container c;
+  for (size_t i = 0; i < count; ++i) {
+    c.push_front(static_cast<int>(i));
+  }
+  clock_t end = clock();
+  if (c.front() != static_cast<int>(count - 1)) {
+    std::cout << red << " push_front result mismatch" << std::endl;
+  }
+  return static_cast<long>((end - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+// 对count个随机元素排序，返回耗时
+template <typename Container>
+long sort_time(size_t count) {
+  Container c;
+  for (size_t i = 0; i < count; ++i) {
+    c.push_front(rand());
+  }
+  clock_t start = clock();
+  c.sort();
+  clock_t end = clock();
+  return static_cast<long>((end - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+// 建立count条长度为8的短链表并全部销毁，返回耗时
+template <typename Container>
+long short_chains_time(size_t count) {
+  clock_t start = clock();
+  {
+    std::vector<Container> chains(count);
+    for (int r = 0; r < 8; ++r) {
+      for (size_t i = 0; i < count; ++i) {
+        chains[i].push_front(r);
+      }
+    }
+  }
+  clock_t end = clock();
+  return static_cast<long>((end - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+// 输出一行，依次为 list、forward list、不记录大小并使用结点池的 forward list 的耗时
+void print_row(const char* name, long t1, long t2, long t3) {
+  std::cout << "|" << std::setw(20) << name << " |" << std::setw(11) << t1 << "ms|"
+            << std::setw(11) << t2 << "ms|" << std::setw(11) << t3 << "ms|" << std::endl;
+}
+
+void forward_list_test() {
+  using compact_list = mystl::ForwardList<int, false, mystl::PoolAllocator>;
+
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[------------- Run container test : ForwardList ----------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  int a[] = {1, 2, 3, 4, 5};
+  mystl::ForwardList<int> l1;
+  mystl::ForwardList<int> l2(5);
+  mystl::ForwardList<int> l3(5, 1);
+  mystl::ForwardList<int> l4(a, a + 5);
+  mystl::ForwardList<int> l5(l2);
+  mystl::ForwardList<int> l6(std::move(l2));
+  mystl::ForwardList<int> l7;
+  l7 = l3;
+  mystl::ForwardList<int> l8;
+  l8 = std::move(l3);
+  mystl::ForwardList<int> l9{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  mystl::ForwardList<int> l10;
+  l10 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  compact_list l11{3, 1, 2};
+
+  FUN_AFTER(l1, l1.assign(8, 8));
+  FUN_AFTER(l1, l1.assign(a, a + 5));
+  FUN_AFTER(l1, l1.assign({1, 2, 3, 4, 5, 6}));
+  FUN_AFTER(l1, l1.insert_after(l1.before_begin(), 0));
+  FUN_AFTER(l1, l1.insert_after(l1.begin(), 2, 7));
+  FUN_AFTER(l1, l1.insert_after(l1.begin(), a, a + 3));
+  FUN_AFTER(l1, l1.emplace_front(1));
+  FUN_AFTER(l1, l1.emplace_after(l1.begin(), 9));
+  FUN_AFTER(l1, l1.push_front(2));
+  FUN_AFTER(l1, l1.pop_front());
+  FUN_AFTER(l1, l1.erase_after(l1.begin()));
+  FUN_AFTER(l1, l1.erase_after(l1.begin(), ++(++(++l1.begin()))));
+  FUN_AFTER(l1, l1.remove(7));
+  FUN_AFTER(l1, l1.remove_if(is_odd));
+  FUN_AFTER(l1, l1.resize(10));
+  FUN_AFTER(l1, l1.resize(5, 1));
+  FUN_AFTER(l1, l1.splice_after(l1.before_begin(), l8));
+  FUN_AFTER(l1, l1.splice_after(l1.begin(), l4, l4.before_begin()));
+  FUN_AFTER(l1, l1.splice_after(l1.before_begin(), l4, l4.begin(), l4.end()));
+  FUN_AFTER(l1, l1.unique());
+  FUN_AFTER(l1, l1.sort());
+  FUN_AFTER(l1, l1.merge(l9));
+  FUN_AFTER(l1, l1.sort(mystl::Greater<int>()));
+  int compares = 5;
+  try {
+    l1.sort(ThrowingLess{&compares});
+  } catch (const std::runtime_error&) {
+  }
+  FUN_VALUE(l1.size());
+  FUN_AFTER(l1, l1.sort());
+  FUN_AFTER(l1, l1.reverse());
+  FUN_AFTER(l1, l1.swap(l10));
+  FUN_AFTER(l11, l11.sort());
+  FUN_VALUE(*l1.begin());
+  FUN_VALUE(l1.front());
+  FUN_VALUE(l11.front());
+  std::cout << std::boolalpha;
+  FUN_VALUE(l1.empty());
+  FUN_VALUE((l1 == l10));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(l1.size());
+  FUN_VALUE(l11.size());
+  FUN_VALUE(sizeof(mystl::ForwardList<int>));
+  FUN_VALUE(sizeof(compact_list));
+  FUN_AFTER(l1, l1.clear());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|     operation       |    List     | ForwardList | FList + pool|" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  const size_t n1 = LEN2;
+  const size_t n2 = SCALE_S(LEN2);
+  print_row("short chains x8",
+            short_chains_time<mystl::List<int>>(n2),
+            short_chains_time<mystl::ForwardList<int>>(n2),
+            short_chains_time<compact_list>(n2));
+  print_row("push_front",
+            push_front_time<mystl::List<int>>(n1),
+            push_front_time<mystl::ForwardList<int>>(n1),
+            push_front_time<compact_list>(n1));
+  print_row("sort",
+            sort_time<mystl::List<int>>(n1),
+            sort_time<mystl::ForwardList<int>>(n1),
+            sort_time<compact_list>(n1));
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[------------- End container test : ForwardList ----------------]" << std::endl;
+}
+
+}  // namespace forward_list_test
+}  // namespace test
+}  // namespace mystl
+#endif  // !MYTINYSTL_FORWARD_LIST_TEST_H_
@@ -0,0 +1,171 @@
+#ifndef MYTINYSTL_HASHTABLE_STATS_TEST_H_
+#define MYTINYSTL_HASHTABLE_STATS_TEST_H_
+
+// hashtable stats test : 输出不同哈希函数在不同键值分布下 hashtable 的 bucket 分布情况
+// 以 -DMYSTL_HASHTABLE_PROFILE 编译时，额外输出每次查找平均访问的结点数与键值比较次数
+
+#include <thread>
+
+#include "../MyTinySTL/astring.h"
+#include "../MyTinySTL/unordered_set.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace hashtable_stats_test {
+
+// 输出一行统计信息
+void print_stats(const char* name, const mystl::HashtableStats& s) {
+  std::cout << "| " << std::setw(20) << std::left << name << std::right << "|" << std::setw(8)
+            << s.size << "|" << std::setw(8) << s.bucket_count << "|" << std::setw(6)
+            << std::setprecision(2) << std::fixed << s.load_factor << "|" << std::setw(8)
+            << s.empty_buckets << "|" << std::setw(8) << s.longest_chain << "|" << std::setw(7)
+            << s.rehash_count << "|" << std::setw(8) << s.bytes_used / 1024 << "|";
+  if (s.lookup_count != 0) {
+    std::cout << std::setw(7) << (double)s.probe_count / s.lookup_count << "|";
+  } else {
+    std::cout << std::setw(7) << "-" << "|";
+  }
+  std::cout << std::endl;
+  std::cout.unsetf(std::ios_base::floatfield);
+}
+
+// 输出链表长度的分布，只列出前几项
+void print_histogram(const char* name, const mystl::HashtableStats& s) {
+  std::cout << " " << name << " chain histogram :";
+  const size_t n = mystl::min(s.chain_histogram.size(), static_cast<size_t>(6));
+  for (size_t i = 0; i < n; ++i) {
+    std::cout << " [" << i << "]" << s.chain_histogram[i];
+  }
+  if (n < s.chain_histogram.size()) {
+    std::cout << " ... [" << s.longest_chain << "]" << s.chain_histogram[s.longest_chain];
+  }
+  std::cout << std::endl;
+}
+
+// 检查统计信息是否自洽：元素个数、负载因子与链表长度的分布相符，
+// 每个键值查找了一次，以 -DMYSTL_HASHTABLE_PROFILE 编译时查找次数等于 lookups，否则计数为0
+void check_stats(const char* name, const mystl::HashtableStats& s, size_t count, size_t lookups,
+                 float max_load_factor) {
+  size_t buckets = 0;
+  size_t elements = 0;
+  for (size_t i = 0; i < s.chain_histogram.size(); ++i) {
+    buckets += s.chain_histogram[i];
+    elements += i * s.chain_histogram[i];
+  }
+  bool ok = s.size == count && elements == count && buckets == s.bucket_count &&
+            s.chain_histogram.size() == s.longest_chain + 1 &&
+            s.empty_buckets == s.chain_histogram[0] &&
+            s.load_factor == static_cast<float>(s.size) / s.bucket_count &&
+            s.load_factor <= max_load_factor;
+#ifdef MYSTL_HASHTABLE_PROFILE
+  // 查找的键值都存在，每次查找至少访问一个结点、比较一次键值
+  ok = ok && s.lookup_count == lookups && s.probe_count >= lookups &&
+       s.compare_count >= lookups;
+#else
+  (void)lookups;
+  ok = ok && s.lookup_count == 0 && s.probe_count == 0 && s.compare_count == 0;
+#endif
+  if (!ok) {
+    std::cout << red << " " << name << " stats mismatch" << std::endl;
+  }
+}
+
+// 插入所有键值后逐个查找一遍，返回统计信息
+template <typename Set, typename Vec>
+mystl::HashtableStats build_and_probe(Set& s, const Vec& keys) {
+  for (size_t i = 0; i < keys.size(); ++i) {
+    s.insert(keys[i]);
+  }
+  s.reset_profile();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    s.find(keys[i]);
+  }
+  return s.stats();
+}
+
+void hashtable_stats_test() {
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[------------------ Run hashtable stats test -------------------]" << std::endl;
+  const size_t len = 10000;
+  std::cout << "|       workload      |  size  | bucket | load | empty  | longest| rehash|   KB   |"
+            << " probe |" << std::endl;
+
+  // 整数的哈希函数为恒等映射，连续的键值分布均匀
+  mystl::Vector<int> seq;
+  for (size_t i = 0; i < len; ++i) seq.push_back(static_cast<int>(i));
+  mystl::UnorderedSet<int> s1;
+  auto st1 = build_and_probe(s1, seq);
+  print_stats("int sequential", st1);
+
+  // 步长为8的键值，模拟对齐的地址或id
+  mystl::Vector<int> stride8;
+  for (size_t i = 0; i < len; ++i) stride8.push_back(static_cast<int>(i * 8));
+  mystl::UnorderedSet<int> s2;
+  auto st2 = build_and_probe(s2, stride8);
+  print_stats("int stride 8", st2);
+
+  // 步长恰为bucket个数的键值，恒等映射会让所有元素落在同一个bucket中
+  mystl::UnorderedSet<int> s3;
+  s3.reserve(len);
+  const size_t stride = s3.bucket_count();
+  mystl::Vector<int> stride_bucket;
+  for (size_t i = 0; i < len / 10; ++i) {
+    stride_bucket.push_back(static_cast<int>(i * stride));
+  }
+  auto st3 = build_and_probe(s3, stride_bucket);
+  print_stats("int stride bucket", st3);
+
+  mystl::Vector<double> dbl;
+  for (size_t i = 0; i < len; ++i) dbl.push_back(static_cast<double>(i) * 0.5);
+  mystl::UnorderedSet<double> s4;
+  auto st4 = build_and_probe(s4, dbl);
+  print_stats("double", st4);
+
+  mystl::Vector<mystl::string> str;
+  for (size_t i = 0; i < len; ++i) str.push_back(mystl::string("key") + std::to_string(i).c_str());
+  mystl::UnorderedSet<mystl::string> s5;
+  auto st5 = build_and_probe(s5, str);
+  print_stats("string", st5);
+
+  check_stats("int sequential", st1, len, len, s1.max_load_factor());
+  check_stats("int stride 8", st2, len, len, s2.max_load_factor());
+  check_stats("int stride bucket", st3, len / 10, len / 10, s3.max_load_factor());
+  check_stats("double", st4, len, len, s4.max_load_factor());
+  check_stats("string", st5, len, len, s5.max_load_factor());
+  // 恒等映射下所有元素落在同一个bucket中
+  if (st3.longest_chain != len / 10 || st1.longest_chain != 1) {
+    std::cout << red << " int stride bucket chain mismatch" << std::endl;
+  }
+
+  // 多个线程同时在const的哈希表上查找，计数不会丢失
+  const mystl::UnorderedSet<int>& cs1 = s1;
+  s1.reset_profile();
+  std::thread readers[4];
+  for (auto& t : readers) {
+    t = std::thread([&cs1, &seq] {
+      for (size_t i = 0; i < seq.size(); ++i) {
+        cs1.find(seq[i]);
+      }
+    });
+  }
+  for (auto& t : readers) {
+    t.join();
+  }
+  check_stats("int concurrent find", s1.stats(), len, 4 * len, s1.max_load_factor());
+
+  std::cout << "|---------------------|--------|--------|------|--------|--------|-------|--------|"
+            << "-------|" << std::endl;
+  print_histogram("int sequential", st1);
+  print_histogram("int stride 8", st2);
+  print_histogram("int stride bucket", st3);
+  print_histogram("double", st4);
+  print_histogram("string", st5);
+  PASSED;
+  std::cout << "[------------------ End hashtable stats test -------------------]" << std::endl;
+}
+
+}  // namespace hashtable_stats_test
+}  // namespace test
+}  // namespace mystl
+#endif  // !MYTINYSTL_HASHTABLE_STATS_TEST_H_
@@ -0,0 +1,123 @@
+#ifndef MYTINYSTL_INTERVAL_MAP_TEST_H_
+#define MYTINYSTL_INTERVAL_MAP_TEST_H_
+
+// interval map test : 测试 interval map 的接口，并比较区间查询与逐个检查所有区间的耗时
+
+#include <vector>
+
+#include "../MyTinySTL/interval_map.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace interval_map_test {
+
+// interval map 的遍历输出
+template <typename IMap>
+void print_map(const char* name, const IMap& m) {
+  std::cout << " " << name << " :";
+  for (auto it = m.begin(); it != m.end(); ++it) {
+    std::cout << " <[" << it->first.low << "," << it->first.high << "]," << it->second << ">";
+  }
+  std::cout << std::endl;
+}
+
+// 输出与[low, high]相交的所有区间
+template <typename IMap>
+void print_overlap(const IMap& m, int low, int high) {
+  std::cout << " overlap [" << low << "," << high << "] :";
+  m.for_each_overlap(low, high, [](typename IMap::const_iterator it) {
+    std::cout << " [" << it->first.low << "," << it->first.high << "]";
+  });
+  std::cout << std::endl;
+}
+
+#define IMAP_COUT(m) print_map(#m, m)
+
+#define IMAP_FUN_AFTER(con, fun)                        \
+  do {                                                  \
+    std::string str = #fun;                             \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun;                                                \
+    IMAP_COUT(con);                                     \
+  } while (0)
+
+// 比较区间查询与逐个检查所有区间的耗时，count为区间个数，每次查询的结果约为几个区间
+void query_performance(size_t count) {
+  const int queries = 100;
+  const int range = static_cast<int>(count) * 10;
+  mystl::IntervalMap<int, int> m;
+  std::vector<mystl::Interval<int>> v;
+  srand(static_cast<unsigned>(count));
+  for (size_t i = 0; i < count; ++i) {
+    const int low = rand() % range;
+    const int high = low + rand() % 20;
+    m.insert(low, high, static_cast<int>(i));
+    v.push_back(mystl::Interval<int>(low, high));
+  }
+  std::vector<int> points;
+  for (int i = 0; i < queries; ++i) {
+    points.push_back(rand() % range);
+  }
+  clock_t start = clock();
+  size_t hit1 = 0;
+  for (int i = 0; i < queries; ++i) {
+    for (size_t j = 0; j < v.size(); ++j) {
+      hit1 += !(v[j].high < points[i]) && !(points[i] < v[j].low);
+    }
+  }
+  clock_t mid = clock();
+  size_t hit2 = 0;
+  for (int i = 0; i < queries; ++i) {
+    hit2 += m.count_containing(points[i]);
+  }
+  clock_t end = clock();
+  std::cout << "|" << std::setw(20) << count << " |" << std::setw(11)
+            << (mid - start) * 1000 / CLOCKS_PER_SEC << "ms|" << std::setw(11)
+            << (end - mid) * 1000 / CLOCKS_PER_SEC << "ms|" << std::endl;
+  if (hit1 != hit2) {
+    std::cout << red << " query result mismatch" << std::endl;
+  }
+}
+
+void interval_map_test() {
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[-------------- Run container test : interval map --------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  mystl::IntervalMap<int, int> m1{{{1, 5}, 1}, {{3, 8}, 2}, {{10, 12}, 3}};
+  IMAP_COUT(m1);
+  IMAP_FUN_AFTER(m1, m1.insert(6, 10, 4));
+  IMAP_FUN_AFTER(m1, m1.insert(mystl::make_pair(mystl::Interval<int>(3, 8), 5)));
+  IMAP_FUN_AFTER(m1, m1.emplace(mystl::Interval<int>(15, 20), 6));
+  print_overlap(m1, 4, 6);
+  print_overlap(m1, 9, 9);
+  print_overlap(m1, 13, 14);
+  FUN_VALUE(m1.find_overlap(7, 9)->second);
+  FUN_VALUE(m1.find_overlap(mystl::Interval<int>(11, 30))->second);
+  FUN_VALUE((m1.find_overlap(13, 14) == m1.end()));
+  FUN_VALUE(m1.count_overlap(0, 100));
+  FUN_VALUE(m1.count_containing(4));
+  FUN_VALUE(m1.count_containing(10));
+  FUN_VALUE(m1.count(mystl::Interval<int>(3, 8)));
+  IMAP_FUN_AFTER(m1, m1.erase(mystl::Interval<int>(3, 8)));
+  IMAP_FUN_AFTER(m1, m1.erase(m1.find_overlap(0, 2)));
+  FUN_VALUE(m1.count_containing(4));
+  IMAP_FUN_AFTER(m1, m1.clear());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  std::cout << "|     intervals       | linear scan | stab query  |" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  query_performance(LEN1);
+  query_performance(LEN2);
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[-------------- End container test : interval map --------------]" << std::endl;
+}
+
+}  // namespace interval_map_test
+}  // namespace test
+}  // namespace mystl
+#endif  // !MYTINYSTL_INTERVAL_MAP_TEST_H_
@@ -0,0 +1,188 @@
+#ifndef MYTINYSTL_INTRUSIVE_TEST_H_
+#define MYTINYSTL_INTRUSIVE_TEST_H_
+
+// intrusive test : 测试 intrusive list / intrusive hashtable 的接口，
+// 并与 List<T*> / UnorderedMap<Key, T*> 比较插入、遍历与查找的性能
+
+#include "../MyTinySTL/intrusive_hashtable.h"
+#include "../MyTinySTL/intrusive_list.h"
+#include "../MyTinySTL/list.h"
+#include "../MyTinySTL/unordered_map.h"
+#include "../MyTinySTL/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace intrusive_test {
+
+// 同时挂在两个链表（连接表与定时器表）和一个哈希表中的连接对象
+struct TimerTag {};
+
+struct Connection : public mystl::IntrusiveListHook<>,
+                    public mystl::IntrusiveListHook<TimerTag>,
+                    public mystl::IntrusiveHashHook<> {
+  int id;
+  explicit Connection(int i = 0) : id(i) {}
+};
+
+struct ConnectionId {
+  const int& operator()(const Connection& c) const { return c.id; }
+};
+
+using ConnectionList = mystl::IntrusiveList<Connection>;
+using TimerList = mystl::IntrusiveList<Connection, TimerTag>;
+using ConnectionTable = mystl::IntrusiveHashtable<int, Connection, ConnectionId>;
+
+// 输出容器中所有连接的id
+template <typename Container>
+void print_ids(const char* name, const Container& c) {
+  std::cout << " " << name << " :";
+  for (auto it = c.begin(); it != c.end(); ++it) {
+    std::cout << " " << it->id;
+  }
+  std::cout << std::endl;
+}
+
+#define INTRUSIVE_COUT(c) print_ids(#c, c)
+
+#define INTRUSIVE_FUN_AFTER(con, fun)                   \
+  do {                                                  \
+    std::string str = #fun;                             \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun;                                                \
+    INTRUSIVE_COUT(con);                                \
+  } while (0)
+
+// 比较链表的插入、遍历与清空，count为对象个数
+void list_performance(size_t count) {
+  mystl::Vector<Connection> objs(count);
+  for (size_t i = 0; i < count; ++i) {
+    objs[i].id = static_cast<int>(i);
+  }
+  long long sum1 = 0;
+  long long sum2 = 0;
+  clock_t start = clock();
+  {
+    mystl::List<Connection*> l;
+    for (size_t i = 0; i < count; ++i) {
+      l.push_back(&objs[i]);
+    }
+    for (auto it = l.begin(); it != l.end(); ++it) {
+      sum1 += (*it)->id;
+    }
+  }
+  clock_t mid = clock();
+  {
+    ConnectionList l;
+    for (size_t i = 0; i < count; ++i) {
+      l.push_back(objs[i]);
+    }
+    for (auto it = l.begin(); it != l.end(); ++it) {
+      sum2 += it->id;
+    }
+  }
+  clock_t end = clock();
+  std::cout << "|" << std::setw(20) << "list" << " |" << std::setw(11)
+            << (mid - start) * 1000 / CLOCKS_PER_SEC << "ms|" << std::setw(11)
+            << (end - mid) * 1000 / CLOCKS_PER_SEC << "ms|" << std::endl;
+  if (sum1 != sum2) {
+    std::cout << red << " list result mismatch" << std::endl;
+  }
+}
+
+// 比较哈希表的插入与查找，count为对象个数
+void hashtable_performance(size_t count) {
+  mystl::Vector<Connection> objs(count);
+  for (size_t i = 0; i < count; ++i) {
+    objs[i].id = static_cast<int>(i * 7919);
+  }
+  size_t hit1 = 0;
+  size_t hit2 = 0;
+  clock_t start = clock();
+  {
+    mystl::UnorderedMap<int, Connection*> m;
+    for (size_t i = 0; i < count; ++i) {
+      m.emplace(objs[i].id, &objs[i]);
+    }
+    for (size_t i = 0; i < count; ++i) {
+      hit1 += m.count(static_cast<int>(i * 7919));
+    }
+  }
+  clock_t mid = clock();
+  {
+    ConnectionTable h;
+    for (size_t i = 0; i < count; ++i) {
+      h.insert_unique(objs[i]);
+    }
+    for (size_t i = 0; i < count; ++i) {
+      hit2 += h.count(static_cast<int>(i * 7919));
+    }
+  }
+  clock_t end = clock();
+  std::cout << "|" << std::setw(20) << "hashtable" << " |" << std::setw(11)
+            << (mid - start) * 1000 / CLOCKS_PER_SEC << "ms|" << std::setw(11)
+            << (end - mid) * 1000 / CLOCKS_PER_SEC << "ms|" << std::endl;
+  if (hit1 != count || hit2 != count) {
+    std::cout << red << " hashtable result mismatch" << std::endl;
+  }
+}
+
+void intrusive_test() {
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[------------ Run container test : intrusive -------------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  Connection c[6];
+  for (int i = 0; i < 6; ++i) {
+    c[i].id = i;
+  }
+  ConnectionList l1;
+  TimerList t1;
+  ConnectionTable h1(10);
+  INTRUSIVE_FUN_AFTER(l1, for (int i = 0; i < 4; ++i) l1.push_back(c[i]));
+  INTRUSIVE_FUN_AFTER(l1, l1.push_front(c[4]));
+  INTRUSIVE_FUN_AFTER(l1, l1.insert(l1.iterator_to(c[2]), c[5]));
+  INTRUSIVE_FUN_AFTER(t1, t1.push_back(c[3]));
+  INTRUSIVE_FUN_AFTER(t1, t1.push_back(c[1]));
+  INTRUSIVE_FUN_AFTER(l1, l1.erase(l1.iterator_to(c[3])));
+  INTRUSIVE_COUT(t1);
+  INTRUSIVE_FUN_AFTER(l1, l1.pop_front());
+  INTRUSIVE_FUN_AFTER(l1, l1.reverse());
+  INTRUSIVE_FUN_AFTER(l1, l1.remove_if([](const Connection& x) { return x.id % 2 == 0; }));
+  std::cout << std::boolalpha;
+  FUN_VALUE(static_cast<IntrusiveListHook<>&>(c[0]).is_linked());
+  FUN_VALUE(static_cast<IntrusiveListHook<>&>(c[1]).is_linked());
+  std::cout << std::noboolalpha;
+  FUN_VALUE(l1.size());
+  FUN_VALUE(l1.front().id);
+  INTRUSIVE_FUN_AFTER(h1, for (int i = 0; i < 6; ++i) h1.insert_unique(c[i]));
+  FUN_VALUE(h1.find(3)->id);
+  FUN_VALUE(h1.count(3));
+  FUN_VALUE(h1.insert_unique(c[3]).second);
+  INTRUSIVE_FUN_AFTER(h1, h1.erase(c[3]));
+  INTRUSIVE_FUN_AFTER(h1, h1.erase_unique(5));
+  FUN_VALUE(h1.size());
+  FUN_VALUE(h1.bucket_count());
+  INTRUSIVE_FUN_AFTER(h1, h1.reserve(1000));
+  FUN_VALUE(h1.bucket_count());
+  INTRUSIVE_FUN_AFTER(h1, h1.clear());
+  INTRUSIVE_FUN_AFTER(t1, t1.clear());
+  INTRUSIVE_FUN_AFTER(l1, l1.clear());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << " elements : " << LEN2 << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  std::cout << "|     container       |  T* / alloc |  intrusive  |" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  list_performance(LEN2);
+  hashtable_performance(LEN2);
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[------------ End container test : intrusive -------------------]" << std::endl;
+}
+
+}  // namespace intrusive_test
+}  // namespace test
+}  // namespace mystl
+#endif  // !MYTINYSTL_INTRUSIVE_TEST_H_
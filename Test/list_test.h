@@ -5,6 +5,7 @@
 
 #include <ios>
 #include <list>
+#include <stdexcept>
 
 #include "../MyTinySTL/list.h"
 #include "functional.h"
@@ -16,6 +17,17 @@ namespace list_test {
 // 辅助测试函数
 bool is_odd(int x) { return x & 1; }
 
+// 比较若干次之后抛出异常，检查sort在异常时既不丢失结点也不破坏链表
+struct ThrowingLess {
+  int* left;
+  bool operator()(int a, int b) const {
+    if ((*left)-- == 0) {
+      throw std::runtime_error("ThrowingLess");
+    }
+    return a < b;
+  }
+};
+
 void list_test() {
   std::cout << "[===============================================================]" << std::endl;
   std::cout << "[------------------ Run container test : list ------------------]" << std::endl;
@@ -70,6 +82,13 @@ void list_test() {
   FUN_AFTER(l1, l1.unique([&](int a, int b) { return b == a + 1; }));
   FUN_AFTER(l1, l1.merge(l7));
   FUN_AFTER(l1, l1.sort(mystl::Greater<int>()));
+  int compares = 5;
+  try {
+    l1.sort(ThrowingLess{&compares});
+  } catch (const std::runtime_error&) {
+  }
+  FUN_VALUE(l1.size());
+  FUN_AFTER(l1, l1.sort());
   FUN_AFTER(l1, l1.reverse());
   FUN_AFTER(l1, l1.clear());
   FUN_AFTER(l1, l1.swap(l9));
@@ -5,6 +5,7 @@
 
 #include <map>
 
+#include "../MyTinySTL/astring.h"
 #include "../MyTinySTL/map.h"
 #include "../MyTinySTL/vector.h"
 #include "test.h"
@@ -16,6 +17,15 @@ namespace map_test {
 // pair 的宏定义
 #define PAIR mystl::pair<int, int>
 
+// 不能复制也不能移动的 mapped_type，只能由 try_emplace 在结点中原地构造
+struct NonMovable {
+  int a;
+  int b;
+  NonMovable(int x, int y) : a(x), b(y) {}
+  NonMovable(const NonMovable&) = delete;
+  NonMovable& operator=(const NonMovable&) = delete;
+};
+
 // map 的遍历输出
 #define MAP_COUT(m)                                                             \
   do {                                                                          \
@@ -98,6 +108,32 @@ void map_test() {
   std::cout << std::noboolalpha;
   FUN_VALUE(m1.size());
   FUN_VALUE(m1.max_size());
+  // 透明比较器：直接用字面量查找，不构造临时的 string
+  mystl::Map<mystl::string, int, mystl::Less<>> m11{{"a", 1}, {"b", 2}, {"c", 3}};
+  FUN_VALUE(m11.count("b"));
+  FUN_VALUE(m11.find("b")->second);
+  FUN_VALUE(m11.lower_bound("bb")->second);
+  FUN_VALUE(m11.upper_bound("a")->second);
+  mystl::Map<int, int> m12{PAIR(1, 1), PAIR(2, 2)};
+  mystl::Map<int, int> m13{PAIR(2, 20), PAIR(3, 30)};
+  MAP_FUN_AFTER(m12, m12.try_emplace(1, 100));
+  MAP_FUN_AFTER(m12, m12.try_emplace(4, 4));
+  MAP_FUN_AFTER(m12, m12.insert_or_assign(1, 100));
+  mystl::Map<int, NonMovable> m16;
+  m16.try_emplace(1, 10, 11);
+  m16.try_emplace(m16.end(), 2, 20, 21);
+  m16.try_emplace(1, 30, 31);
+  FUN_VALUE(m16.size());
+  FUN_VALUE(m16.find(1)->second.a);
+  FUN_VALUE(m16.find(2)->second.b);
+  MAP_FUN_AFTER(m13, m13.insert(m12.extract(4)));
+  MAP_FUN_AFTER(m12, m12.merge(m13));
+  FUN_VALUE(m13.size());
+  auto m14 = m12.split(3);
+  MAP_COUT(m14);
+  MAP_FUN_AFTER(m12, m12.join(m14));
+  auto m15 = m12.extract_range(m12.find(2), m12.end());
+  MAP_COUT(m15);
   PASSED;
 #if PERFORMANCE_TEST_ON
   std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -170,6 +206,16 @@ void multimap_test() {
   std::cout << std::noboolalpha;
   FUN_VALUE(m1.size());
   FUN_VALUE(m1.max_size());
+  mystl::MultiMap<int, int> m12{PAIR(1, 1), PAIR(2, 2)};
+  mystl::Map<int, int> m13{PAIR(2, 20), PAIR(3, 30)};
+  MAP_FUN_AFTER(m12, m12.insert(m1.extract(3)));
+  MAP_FUN_AFTER(m12, m12.merge(m13));
+  FUN_VALUE(m13.size());
+  auto m14 = m12.split(2);
+  MAP_COUT(m14);
+  MAP_FUN_AFTER(m12, m12.join(m14));
+  auto m15 = m12.extract_range(m12.begin(), m12.find(3));
+  MAP_COUT(m15);
   PASSED;
 #if PERFORMANCE_TEST_ON
   std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -0,0 +1,213 @@
+#ifndef MYTINYSTL_PARALLEL_ALGO_TEST_H_
+#define MYTINYSTL_PARALLEL_ALGO_TEST_H_
+
+// parallel algorithm test : 测试以执行策略为第一个参数的算法，并比较 seq 与 par 的耗时，
+// 以及循环、seq、unseq、par_unseq 下 accumulate 与 inner_product 的耗时
+
+#include <chrono>
+
+#include "../MyTinySTL/algorithm.h"
+#include "../MyTinySTL/deque.h"
+#include "../MyTinySTL/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace parallel_algo_test {
+
+// 以执行策略policy调用rounds次f，返回耗时（毫秒）
+template <typename Function>
+long policy_time(const mystl::execution::ParallelPolicy& policy, size_t rounds, Function f) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < rounds; ++i) {
+    f(policy);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return static_cast<long>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+}
+
+// 输出一行，依次为 seq、par 的耗时
+// 没有工作线程的线程池上的 par 会直接调用串行版本，与 seq 相同，这样 f 只需接受一种执行策略
+template <typename Function>
+void print_row(const char* name, size_t rounds, Function f) {
+  mystl::ThreadPool serial(0);
+  const long t1 = policy_time(mystl::execution::par.on(serial), rounds, f);
+  const long t2 = policy_time(mystl::execution::par, rounds, f);
+  std::cout << "|" << std::setw(20) << name << " |" << std::setw(11) << t1 << "ms|"
+            << std::setw(11) << t2 << "ms|" << std::endl;
+}
+
+// 用于 reduce_time，表示用循环计算
+struct Loop {};
+
+// 求 [a, a + n) 的和
+template <typename T>
+struct Sum {
+  const T* volatile a;
+  size_t n;
+
+  T operator()(Loop) const {
+    T sum = T();
+    for (size_t i = 0; i < n; ++i) {
+      sum += a[i];
+    }
+    return sum;
+  }
+  template <typename Policy>
+  T operator()(const Policy& policy) const {
+    return mystl::accumulate(policy, a, a + n, T());
+  }
+};
+
+// 求 [a, a + n) 与 [b, b + n) 的内积
+template <typename T>
+struct Dot {
+  const T* volatile a;
+  const T* volatile b;
+  size_t n;
+
+  T operator()(Loop) const {
+    T sum = T();
+    for (size_t i = 0; i < n; ++i) {
+      sum = sum + a[i] * b[i];
+    }
+    return sum;
+  }
+  template <typename Policy>
+  T operator()(const Policy& policy) const {
+    return mystl::inner_product(policy, a, a + n, b, T());
+  }
+};
+
+// 以执行策略policy调用rounds次f并累加结果，返回耗时（毫秒）
+template <typename Policy, typename Function>
+long reduce_time(const Policy& policy, size_t rounds, Function f) {
+  volatile double sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < rounds; ++i) {
+    sink = sink + static_cast<double>(f(policy));
+  }
+  auto end = std::chrono::steady_clock::now();
+  return static_cast<long>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+}
+
+// 输出一行，依次为循环、seq、unseq、par_unseq 的耗时
+template <typename Function>
+void print_reduce_row(const char* name, size_t rounds, Function f) {
+  std::cout << "|" << std::setw(20) << name << " |";
+  std::cout << std::setw(11) << reduce_time(Loop(), rounds, f) << "ms|";
+  std::cout << std::setw(11) << reduce_time(mystl::execution::seq, rounds, f) << "ms|";
+  std::cout << std::setw(11) << reduce_time(mystl::execution::unseq, rounds, f) << "ms|";
+  std::cout << std::setw(11) << reduce_time(mystl::execution::par_unseq, rounds, f) << "ms|"
+            << std::endl;
+}
+
+void parallel_algo_test() {
+  namespace ex = mystl::execution;
+
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[------------ Run algorithm test : parallel algorithm ----------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  const size_t n = 100000;
+  mystl::ThreadPool pool(2);
+  mystl::Vector<int> v(n);
+  mystl::Vector<int> w(n);
+  mystl::Deque<int> d(n);
+  mystl::iota(v.begin(), v.end(), 0);
+  FUN_VALUE(mystl::accumulate(ex::par.on(pool), v.begin(), v.end(), 0L));
+  FUN_VALUE(mystl::accumulate(ex::seq, v.begin(), v.end(), 0L));
+  FUN_VALUE(mystl::inner_product(ex::par.on(pool), v.begin(), v.begin() + 1000, v.begin(), 0L));
+  FUN_VALUE(mystl::count_if(ex::par.on(pool), v.begin(), v.end(), [](int x) { return x % 3; }));
+  FUN_VALUE(*mystl::find(ex::par_unseq.on(pool), v.begin(), v.end(), 77777));
+  FUN_VALUE(mystl::find_if(ex::par.on(pool), v.begin(), v.end(), [](int x) { return x < 0; }) -
+            v.begin());
+  std::cout << std::boolalpha;
+  FUN_VALUE(mystl::all_of(ex::par.on(pool), v.begin(), v.end(), [](int x) { return x >= 0; }));
+  FUN_VALUE(mystl::any_of(ex::par.on(pool), v.begin(), v.end(), [](int x) { return x < 0; }));
+  FUN_VALUE(mystl::none_of(ex::par.on(pool), v.begin(), v.end(), [](int x) { return x < 0; }));
+  std::cout << std::noboolalpha;
+  mystl::transform(ex::par.on(pool), v.begin(), v.end(), w.begin(), [](int x) { return x % 10; });
+  mystl::partial_sum(ex::par.on(pool), w.begin(), w.end(), d.begin());
+  FUN_VALUE(d.back());
+  mystl::fill(ex::par.on(pool), d.begin(), d.end(), 1);
+  mystl::copy(ex::par.on(pool), d.begin(), d.end(), w.begin());
+  mystl::for_each(ex::par.on(pool), w.begin(), w.end(), [](int& x) { x *= 2; });
+  FUN_VALUE(mystl::accumulate(ex::par.on(pool), w.begin(), w.end(), 0));
+  mystl::Vector<float> f(1000, 0.5f);
+  FUN_VALUE(mystl::accumulate(ex::unseq, f.begin(), f.end(), 0.0f));
+  FUN_VALUE(mystl::inner_product(ex::par_unseq.on(pool), f.begin(), f.end(), f.begin(), 0.0f));
+  FUN_VALUE(mystl::transform_reduce(ex::unseq, v.begin(), v.begin() + 10, v.begin(), 0));
+  FUN_VALUE(mystl::transform_reduce(ex::par.on(pool), v.begin(), v.end(), 0L, mystl::Plus<long>(),
+                                    [](int x) { return x % 2; }));
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  std::cout << "|     operation       |     seq     |     par     |" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  const size_t len = SCALE_LL(LEN2);
+  const size_t rounds = 5;
+  mystl::Vector<long> a(len);
+  mystl::Vector<long> b(len);
+  mystl::iota(a.begin(), a.end(), 0L);
+  volatile long sink = 0;
+  print_row("for_each", rounds, [&](const ex::ParallelPolicy& p) {
+    mystl::for_each(p, a.begin(), a.end(), [](long& x) { x = x * 3 + 1; });
+  });
+  print_row("transform", rounds, [&](const ex::ParallelPolicy& p) {
+    mystl::transform(p, a.begin(), a.end(), b.begin(), [](long x) { return x >> 1; });
+  });
+  print_row("count_if", rounds, [&](const ex::ParallelPolicy& p) {
+    sink += mystl::count_if(p, a.begin(), a.end(), [](long x) { return (x & 7) == 0; });
+  });
+  print_row("find_if", rounds, [&](const ex::ParallelPolicy& p) {
+    sink += mystl::find_if(p, a.begin(), a.end(), [](long x) { return x < 0; }) - a.begin();
+  });
+  print_row("accumulate", rounds, [&](const ex::ParallelPolicy& p) {
+    sink += mystl::accumulate(p, a.begin(), a.end(), 0L);
+  });
+  print_row("inner_product", rounds, [&](const ex::ParallelPolicy& p) {
+    sink += mystl::inner_product(p, a.begin(), a.end(), b.begin(), 0L);
+  });
+  print_row("partial_sum", rounds, [&](const ex::ParallelPolicy& p) {
+    mystl::partial_sum(p, b.begin(), b.end(), a.begin());
+  });
+  print_row("fill", rounds, [&](const ex::ParallelPolicy& p) {
+    mystl::fill(p, b.begin(), b.end(), 7L);
+  });
+  print_row("copy", rounds, [&](const ex::ParallelPolicy& p) {
+    mystl::copy(p, b.begin(), b.end(), a.begin());
+  });
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|-------------|"
+            << std::endl;
+  std::cout << "|     operation       |    loop     |     seq     |    unseq    |  par_unseq  |"
+            << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|-------------|"
+            << std::endl;
+  const size_t reduce_len = LEN1;
+  const size_t reduce_rounds = 2000;
+  mystl::Vector<int> ia(reduce_len, 3);
+  mystl::Vector<float> fa(reduce_len, 0.5f);
+  mystl::Vector<float> fb(reduce_len, 2.0f);
+  mystl::Vector<double> da(reduce_len, 0.5);
+  print_reduce_row("accumulate<int>", reduce_rounds, Sum<int>{ia.data(), reduce_len});
+  print_reduce_row("accumulate<float>", reduce_rounds, Sum<float>{fa.data(), reduce_len});
+  print_reduce_row("accumulate<double>", reduce_rounds, Sum<double>{da.data(), reduce_len});
+  print_reduce_row("inner_product<int>", reduce_rounds,
+                   Dot<int>{ia.data(), ia.data(), reduce_len});
+  print_reduce_row("inner_product<float>", reduce_rounds,
+                   Dot<float>{fa.data(), fb.data(), reduce_len});
+  std::cout << "|---------------------|-------------|-------------|-------------|-------------|"
+            << std::endl;
+  PASSED;
+#endif
+  std::cout << "[------------ End algorithm test : parallel algorithm ----------]" << std::endl;
+}
+
+}  // namespace parallel_algo_test
+}  // namespace test
+}  // namespace mystl
+#endif  // !MYTINYSTL_PARALLEL_ALGO_TEST_H_
@@ -0,0 +1,104 @@
+#ifndef MYTINYSTL_PERSISTENT_MAP_TEST_H_
+#define MYTINYSTL_PERSISTENT_MAP_TEST_H_
+
+// persistent map test : 测试 persistent map 的接口，并比较取快照与复制 map 的耗时
+
+#include "../MyTinySTL/map.h"
+#include "../MyTinySTL/persistent_map.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace persistent_map_test {
+
+// persistent map 的遍历输出
+template <typename PMap>
+void print_map(const char* name, const PMap& m) {
+  std::cout << " " << name << " :";
+  for (auto it = m.begin(); it != m.end(); ++it) {
+    std::cout << " <" << it->first << "," << it->second << ">";
+  }
+  std::cout << std::endl;
+}
+
+#define PMAP_COUT(m) print_map(#m, m)
+
+#define PMAP_FUN_AFTER(con, fun)                        \
+  do {                                                  \
+    std::string str = #fun;                             \
+    std::cout << " After " << str << " :" << std::endl; \
+    fun;                                                \
+    PMAP_COUT(con);                                     \
+  } while (0)
+
+// 比较复制 map 与取快照的耗时，count为元素个数
+void snapshot_performance(size_t count) {
+  mystl::Map<int, int> m;
+  mystl::PersistentMap<int, int> pm;
+  for (size_t i = 0; i < count; ++i) {
+    m.emplace_hint(m.end(), static_cast<int>(i), static_cast<int>(i));
+    pm.insert(mystl::make_pair(static_cast<int>(i), static_cast<int>(i)));
+  }
+  clock_t start = clock();
+  {
+    mystl::Map<int, int> copy(m);
+  }
+  clock_t mid = clock();
+  size_t total = 0;
+  for (int i = 0; i < 1000; ++i) {
+    auto snap = pm.snapshot();
+    total += snap.size();
+  }
+  clock_t end = clock();
+  std::cout << "|" << std::setw(20) << count << " |" << std::setw(11)
+            << (mid - start) * 1000 / CLOCKS_PER_SEC << "ms|" << std::setw(11)
+            << (end - mid) * 1000 / CLOCKS_PER_SEC << "ms|" << std::endl;
+  if (total != count * 1000) {
+    std::cout << red << " snapshot size mismatch" << std::endl;
+  }
+}
+
+void persistent_map_test() {
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[------------- Run container test : persistent map -------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  mystl::PersistentMap<int, int> m1{{1, 1}, {3, 3}, {5, 5}};
+  auto v1 = m1.snapshot();
+  PMAP_FUN_AFTER(m1, m1.insert(mystl::make_pair(2, 2)));
+  PMAP_FUN_AFTER(m1, m1.insert_or_assign(3, 30));
+  PMAP_FUN_AFTER(m1, m1.erase(1));
+  PMAP_COUT(v1);
+  auto v2 = m1;
+  std::cout << std::boolalpha;
+  FUN_VALUE(v2.same_version(m1));
+  FUN_VALUE((v2 == m1));
+  PMAP_FUN_AFTER(m1, m1.erase(5));
+  FUN_VALUE(v2.same_version(m1));
+  std::cout << std::noboolalpha;
+  PMAP_COUT(v2);
+  FUN_VALUE(m1.at(3));
+  FUN_VALUE(m1.count(5));
+  FUN_VALUE(v2.lower_bound(4)->first);
+  FUN_VALUE(v2.upper_bound(3)->first);
+  FUN_VALUE(m1.size());
+  FUN_VALUE(v1.size());
+  PMAP_FUN_AFTER(m1, m1.clear());
+  PMAP_COUT(v2);
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  std::cout << "|     elements        |  Map copy   | 1000 snaps  |" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  snapshot_performance(LEN1);
+  snapshot_performance(LEN2);
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[------------- End container test : persistent map -------------]" << std::endl;
+}
+
+}  // namespace persistent_map_test
+}  // namespace test
+}  // namespace mystl
+#endif  // !MYTINYSTL_PERSISTENT_MAP_TEST_H_
@@ -1,8 +1,11 @@
 #ifndef MYTINYSTL_QUEUE_TEST_H_
 #define MYTINYSTL_QUEUE_TEST_H_
 
-// queue test : 测试 queue, priority_queue 的接口和它们 push 的性能
+// queue test : 测试 queue, priority_queue 的接口和它们 push 的性能，
+// 以及 priority_queue 使用二叉堆、4 叉堆、8 叉堆时 push、pop、push_range 的耗时，
+// addressable_priority_queue 的接口，和它与 priority_queue 在最短路径（Dijkstra）上的耗时
 
+#include <chrono>
 #include <queue>
 
 #include "../MyTinySTL/queue.h"
@@ -20,7 +23,8 @@ void queue_print(mystl::Queue<int> q) {
   std::cout << std::endl;
 }
 
-void p_queue_print(mystl::PriorityQueue<int> q) {
+template <typename PriorityQueue>
+void p_queue_print(PriorityQueue q) {
   while (!q.empty()) {
     std::cout << " " << q.top();
     q.pop();
@@ -116,6 +120,57 @@ void queue_test() {
   std::cout << "[----------------- End container test : queue ------------------]" << std::endl;
 }
 
+// 依次为 push、pop、push_range 的耗时（毫秒）
+struct HeapTimes {
+  long push;
+  long pop;
+  long push_range;
+};
+
+template <typename Clock>
+long elapsed_ms(typename Clock::time_point start) {
+  return static_cast<long>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+}
+
+// 以堆的策略HeapPolicy，逐个push count个随机整数、再全部pop，最后用push_range一次加入
+template <typename HeapPolicy>
+HeapTimes heap_time(size_t count) {
+  mystl::Vector<int> v(count);
+  srand(static_cast<unsigned>(count));
+  for (auto& x : v) {
+    x = rand();
+  }
+  mystl::PriorityQueue<int, mystl::Vector<int>, mystl::Less<int>, HeapPolicy> q;
+  HeapTimes t;
+  using clock = std::chrono::steady_clock;
+  auto start = clock::now();
+  for (auto x : v) {
+    q.push(x);
+  }
+  t.push = elapsed_ms<clock>(start);
+  int prev = q.top();
+  start = clock::now();
+  while (!q.empty()) {
+    if (q.top() > prev) {
+      std::cout << red << " heap order mismatch" << std::endl;
+    }
+    prev = q.top();
+    q.pop();
+  }
+  t.pop = elapsed_ms<clock>(start);
+  start = clock::now();
+  q.push_range(v.begin(), v.end());
+  t.push_range = elapsed_ms<clock>(start);
+  return t;
+}
+
+// 输出一行，依次为二叉堆、4 叉堆、8 叉堆的耗时
+void print_heap_row(const char* name, long t2, long t4, long t8) {
+  std::cout << "|" << std::setw(20) << name << " |" << std::setw(11) << t2 << "ms|"
+            << std::setw(11) << t4 << "ms|" << std::setw(11) << t8 << "ms|" << std::endl;
+}
+
 void priority_test() {
   std::cout << "[===============================================================]" << std::endl;
   std::cout << "[------------- Run container test : priority_queue -------------]" << std::endl;
@@ -137,6 +192,7 @@ void priority_test() {
   mystl::PriorityQueue<int> p11{1, 2, 3, 4, 5};
   mystl::PriorityQueue<int> p12;
   p12 = {1, 2, 3, 4, 5};
+  mystl::PriorityQueue<int, mystl::Vector<int>, mystl::Less<int>, mystl::DaryHeap<4>> p13(a, a + 5);
 
   P_QUEUE_FUN_AFTER(p1, p1.push(1));
   P_QUEUE_FUN_AFTER(p1, p1.push(5));
@@ -155,6 +211,10 @@ void priority_test() {
   }
   P_QUEUE_FUN_AFTER(p1, p1.swap(p4));
   P_QUEUE_FUN_AFTER(p1, p1.clear());
+  P_QUEUE_FUN_AFTER(p13, p13.push(6));
+  P_QUEUE_FUN_AFTER(p13, p13.push_range(a, a + 3));
+  P_QUEUE_FUN_AFTER(p13, p13.pop());
+  P_QUEUE_FUN_AFTER(p12, p12.push_range(a, a + 5));
   PASSED;
 #if PERFORMANCE_TEST_ON
   std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -181,11 +241,174 @@ void priority_test() {
 #endif
   std::cout << std::endl;
   std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|     operation       |   2-ary     |   4-ary     |   8-ary     |" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  const size_t count = SCALE_L(LEN2);
+  const HeapTimes t2 = heap_time<mystl::BinaryHeap>(count);
+  const HeapTimes t4 = heap_time<mystl::DaryHeap<4>>(count);
+  const HeapTimes t8 = heap_time<mystl::DaryHeap<8>>(count);
+  print_heap_row("push", t2.push, t4.push, t8.push);
+  print_heap_row("pop", t2.pop, t4.pop, t8.pop);
+  print_heap_row("push_range", t2.push_range, t4.push_range, t8.push_range);
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
   PASSED;
 #endif
   std::cout << "[------------- End container test : priority_queue -------------]" << std::endl;
 }
 
+// 有向图，邻接表以 CSR 形式存放：结点 u 的出边为 [offset[u], offset[u + 1])
+struct Graph {
+  size_t n;
+  mystl::Vector<size_t> offset;
+  mystl::Vector<int> to;
+  mystl::Vector<long> weight;
+};
+
+// n 个结点、每个结点 degree 条随机出边的图，边权在 [1, 1000] 中
+Graph random_graph(size_t n, size_t degree) {
+  Graph g;
+  g.n = n;
+  g.offset.reserve(n + 1);
+  srand(static_cast<unsigned>(n + degree));
+  for (size_t u = 0; u < n; ++u) {
+    g.offset.push_back(g.to.size());
+    for (size_t i = 0; i < degree; ++i) {
+      g.to.push_back(static_cast<int>(rand() % n));
+      g.weight.push_back(rand() % 1000 + 1);
+    }
+  }
+  g.offset.push_back(g.to.size());
+  return g;
+}
+
+const long kUnreached = -1;
+
+// 使用 PriorityQueue：距离变小时重复插入，出队时跳过过期的元素（lazy deletion），返回入队次数
+template <typename HeapPolicy>
+size_t dijkstra_lazy(const Graph& g, mystl::Vector<long>& dist) {
+  using entry = mystl::pair<long, int>;
+  mystl::PriorityQueue<entry, mystl::Vector<entry>, mystl::Greater<entry>, HeapPolicy> q;
+  dist.assign(g.n, kUnreached);
+  dist[0] = 0;
+  q.push(entry(0, 0));
+  size_t pushes = 1;
+  while (!q.empty()) {
+    const entry e = q.top();
+    q.pop();
+    const int u = e.second;
+    if (e.first != dist[u]) {
+      continue;
+    }
+    for (size_t i = g.offset[u]; i < g.offset[u + 1]; ++i) {
+      const int v = g.to[i];
+      const long d = e.first + g.weight[i];
+      if (dist[v] == kUnreached || d < dist[v]) {
+        dist[v] = d;
+        q.push(entry(d, v));
+        ++pushes;
+      }
+    }
+  }
+  return pushes;
+}
+
+// 使用 AddressablePriorityQueue：每个结点至多入队一次，距离变小时 decrease_key，返回入队次数
+size_t dijkstra_addressable(const Graph& g, mystl::Vector<long>& dist) {
+  using entry = mystl::pair<long, int>;
+  using queue_type = mystl::AddressablePriorityQueue<entry, mystl::Greater<entry>>;
+  queue_type q;
+  mystl::Vector<size_t> handle(g.n, queue_type::kInvalidHandle);
+  dist.assign(g.n, kUnreached);
+  dist[0] = 0;
+  handle[0] = q.push(entry(0, 0));
+  size_t pushes = 1;
+  while (!q.empty()) {
+    const entry e = q.top();
+    q.pop();
+    const int u = e.second;
+    for (size_t i = g.offset[u]; i < g.offset[u + 1]; ++i) {
+      const int v = g.to[i];
+      const long d = e.first + g.weight[i];
+      if (dist[v] == kUnreached) {
+        dist[v] = d;
+        handle[v] = q.push(entry(d, v));
+        ++pushes;
+      } else if (d < dist[v]) {
+        dist[v] = d;
+        q.decrease_key(handle[v], entry(d, v));
+      }
+    }
+  }
+  return pushes;
+}
+
+// 在 n 个结点、每个结点 degree 条出边的随机图上分别计算最短路径，输出一行耗时
+void print_dijkstra_row(size_t n, size_t degree) {
+  const Graph g = random_graph(n, degree);
+  mystl::Vector<long> d1, d2, d3;
+  using clock = std::chrono::steady_clock;
+  auto start = clock::now();
+  dijkstra_lazy<mystl::BinaryHeap>(g, d1);
+  const long t1 = elapsed_ms<clock>(start);
+  start = clock::now();
+  dijkstra_lazy<mystl::DaryHeap<4>>(g, d2);
+  const long t2 = elapsed_ms<clock>(start);
+  start = clock::now();
+  dijkstra_addressable(g, d3);
+  const long t3 = elapsed_ms<clock>(start);
+  if (d1 != d2 || d1 != d3) {
+    std::cout << red << " dijkstra result mismatch" << std::endl;
+  }
+  std::cout << "|" << std::setw(12) << n << " x" << std::setw(5) << degree << "  |" << std::setw(11)
+            << t1 << "ms|" << std::setw(11) << t2 << "ms|" << std::setw(11) << t3 << "ms|"
+            << std::endl;
+}
+
+void addressable_priority_test() {
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[-------- Run container test : addressable_priority_queue ------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  // 定时器：值为到期时间，最早到期的在堆顶
+  mystl::AddressablePriorityQueue<int, mystl::Greater<int>> timers;
+  const size_t t1 = timers.push(30);
+  const size_t t2 = timers.push(10);
+  const size_t t3 = timers.push(20);
+  const size_t t4 = timers.emplace(40);
+  FUN_VALUE(timers.size());
+  FUN_VALUE(timers.top());
+  FUN_VALUE(timers.top_handle());
+  FUN_VALUE(t2);
+  timers.update(t2, 50);
+  FUN_VALUE(timers.top());
+  timers.decrease_key(t4, 5);
+  FUN_VALUE(timers.top());
+  FUN_VALUE(timers.value(t1));
+  timers.erase(t3);
+  std::cout << std::boolalpha;
+  FUN_VALUE(timers.contains(t3));
+  FUN_VALUE(timers.contains(t1));
+  std::cout << std::noboolalpha;
+  std::cout << " pop order :";
+  while (!timers.empty()) {
+    std::cout << " " << timers.top();
+    timers.pop();
+  }
+  std::cout << std::endl;
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|  dijkstra  n x deg  | lazy 2-ary  | lazy 4-ary  | addressable |" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  print_dijkstra_row(LEN2, 4);
+  print_dijkstra_row(LEN1, 16);
+  print_dijkstra_row(LEN1, 64);
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[-------- End container test : addressable_priority_queue ------]" << std::endl;
+}
+
 }  // namespace queue_test
 }  // namespace test
 }  // namespace mystl
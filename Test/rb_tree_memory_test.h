@@ -0,0 +1,119 @@
+#ifndef MYTINYSTL_RB_TREE_MEMORY_TEST_H_
+#define MYTINYSTL_RB_TREE_MEMORY_TEST_H_
+
+// rb tree memory test : 比较默认布局与紧凑布局的 set / map 在大量元素下的内存占用与插入、查找耗时
+// glibc 2.33 及以上的版本通过 mallinfo2 统计实际占用的堆内存（包含 malloc 的对齐与簿记开销），
+// 其余平台只输出结点本身的大小
+
+#include <cstdlib>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define MYSTL_TEST_HAS_MALLINFO2 1
+#endif
+
+#include "../MyTinySTL/map.h"
+#include "../MyTinySTL/set.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace rb_tree_memory_test {
+
+// 当前已分配的堆内存字节数，无法统计时返回0
+size_t heap_in_use() {
+#ifdef MYSTL_TEST_HAS_MALLINFO2
+  return mallinfo2().uordblks;
+#else
+  return 0;
+#endif
+}
+
+// 把上一个容器释放的内存归还给系统，否则新结点会以释放时的顺序散落在旧的空闲块中，
+// 插入耗时可能成倍增加，排在后面的容器测得的时间会明显偏大
+void trim_heap() {
+#ifdef MYSTL_TEST_HAS_MALLINFO2
+  malloc_trim(0);
+#endif
+}
+
+template <typename Container>
+void insert_key(Container& c, size_t key, mystl::m_false_type) {
+  c.emplace(static_cast<typename Container::key_type>(key));
+}
+
+template <typename Container>
+void insert_key(Container& c, size_t key, mystl::m_true_type) {
+  c.emplace(static_cast<typename Container::key_type>(key), typename Container::mapped_type());
+}
+
+// 以打乱的顺序插入len个不同的键值再逐个查找，输出一行统计信息
+template <typename Container>
+void measure(const char* name, size_t node_size, size_t len) {
+  using is_map = mystl::IsPair<typename Container::value_type>;
+  trim_heap();
+  const size_t before = heap_in_use();
+  Container c;
+  clock_t start = clock();
+  for (size_t i = 0; i < len; ++i) {
+    // 7919为质数，与len互质时(i * 7919) % len为0到len-1的一个排列
+    insert_key(c, i * 7919 % len, m_bool_constant<is_map::kValue>());
+  }
+  clock_t mid = clock();
+  size_t hit = 0;
+  for (size_t i = 0; i < len; ++i) {
+    hit += c.count(static_cast<typename Container::key_type>(i));
+  }
+  clock_t end = clock();
+  const size_t used = heap_in_use() - before;
+
+  std::cout << "| " << std::setw(30) << std::left << name << std::right << "|" << std::setw(7)
+            << node_size << "|";
+  if (used != 0) {
+    std::cout << std::setw(8) << std::setprecision(1) << std::fixed
+              << static_cast<double>(used) / len << "|" << std::setw(8) << used / (1024 * 1024)
+              << "|";
+    std::cout.unsetf(std::ios_base::floatfield);
+  } else {
+    std::cout << std::setw(8) << "-" << "|" << std::setw(8) << "-" << "|";
+  }
+  std::cout << std::setw(6) << (mid - start) * 1000 / CLOCKS_PER_SEC << "ms|" << std::setw(6)
+            << (end - mid) * 1000 / CLOCKS_PER_SEC << "ms|" << std::endl;
+  if (hit != len) {
+    std::cout << red << " lookup failed : " << hit << " / " << len << std::endl;
+  }
+}
+
+void rb_tree_memory_test() {
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[----------------- Run rb tree memory test ---------------------]" << std::endl;
+  const size_t len = LEN3;
+  std::cout << " elements : " << len << std::endl;
+  std::cout << "|          container            | node B | B/elem |   MB   | insert | find   |"
+            << std::endl;
+  measure<mystl::Set<int>>("Set<int>", sizeof(mystl::RbTreeNode<int>), len);
+  measure<mystl::CompactSet<int>>(
+      "CompactSet<int>", sizeof(mystl::RbTreeNode<int, mystl::RbTreeCompactNodeTag>), len);
+  measure<mystl::Map<int, int>>(
+      "Map<int, int>", sizeof(mystl::RbTreeNode<mystl::pair<const int, int>>), len);
+  measure<mystl::CompactMap<int, int>>(
+      "CompactMap<int, int>",
+      sizeof(mystl::RbTreeNode<mystl::pair<const int, int>, mystl::RbTreeCompactNodeTag>), len);
+  // 结点大小跨过malloc的16字节分配粒度时，紧凑布局才会减少实际占用的堆内存
+  measure<mystl::Map<long long, long long>>(
+      "Map<i64, i64>", sizeof(mystl::RbTreeNode<mystl::pair<const long long, long long>>), len);
+  measure<mystl::CompactMap<long long, long long>>(
+      "CompactMap<i64, i64>",
+      sizeof(mystl::RbTreeNode<mystl::pair<const long long, long long>,
+                               mystl::RbTreeCompactNodeTag>),
+      len);
+  std::cout << "|-------------------------------|--------|--------|--------|--------|--------|"
+            << std::endl;
+  PASSED;
+  std::cout << "[----------------- End rb tree memory test ---------------------]" << std::endl;
+}
+
+}  // namespace rb_tree_memory_test
+}  // namespace test
+}  // namespace mystl
+#endif  // !MYTINYSTL_RB_TREE_MEMORY_TEST_H_
@@ -64,6 +64,21 @@ void set_test() {
   std::cout << std::noboolalpha;
   FUN_VALUE(s1.size());
   FUN_VALUE(s1.max_size());
+  int b[] = {1, 3, 5, 7, 9};
+  mystl::Set<int> s11(mystl::kSortedUnique, b, b + 5);
+  FUN_AFTER(s11, s11.merge(s9));
+  FUN_VALUE(s9.size());
+  mystl::OrderStatisticSet<int> s12(a, a + 5);
+  FUN_VALUE(*s12.select(1));
+  FUN_VALUE(s12.rank(4));
+  FUN_AFTER(s12, s12.erase(2));
+  FUN_VALUE(*s12.select(1));
+  auto s13 = s11.split(5);
+  COUT(s13);
+  FUN_AFTER(s11, s11.join(s13));
+  auto s14 = s11.extract_range(s11.find(3), s11.find(7));
+  COUT(s14);
+  COUT(s11);
   PASSED;
 #if PERFORMANCE_TEST_ON
   std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -133,6 +148,17 @@ void multiset_test() {
   std::cout << std::noboolalpha;
   FUN_VALUE(s1.size());
   FUN_VALUE(s1.max_size());
+  int b[] = {1, 1, 3, 5, 5};
+  mystl::MultiSet<int> s11(mystl::kSortedEquivalent, b, b + 5);
+  FUN_AFTER(s11, s11.merge(s9));
+  FUN_VALUE(s9.size());
+  mystl::OrderStatisticMultiSet<int> s12(b, b + 5);
+  FUN_VALUE(*s12.select(2));
+  FUN_VALUE(s12.rank(5));
+  auto s13 = s11.split(5);
+  COUT(s13);
+  FUN_AFTER(s11, s11.join(s13));
+  FUN_AFTER(s11, s11.erase(s11.find(3), s11.end()));
   PASSED;
 #if PERFORMANCE_TEST_ON
   std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
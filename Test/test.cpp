@@ -10,15 +10,26 @@
 
 #include "algorithm_performance_test.h"
 // #include "algorithm_test.h"
+// #include "circular_buffer_test.h"
+// #include "concurrent_queue_test.h"
 // #include "deque_test.h"
+// #include "forward_list_test.h"
+// #include "hashtable_stats_test.h"
+// #include "interval_map_test.h"
+// #include "intrusive_test.h"
 // #include "list_test.h"
 // #include "map_test.h"
+// #include "parallel_algo_test.h"
+// #include "persistent_map_test.h"
 // #include "queue_test.h"
+// #include "rb_tree_memory_test.h"
 // #include "set_test.h"
 // #include "stack_test.h"
 // #include "string_test.h"
+// #include "thread_pool_test.h"
 // #include "unordered_map_test.h"
 // #include "unordered_set_test.h"
+// #include "unrolled_list_test.h"
 // #include "vector_test.h"
 
 int main() {
@@ -28,20 +39,33 @@ int main() {
 
   RUN_ALL_TESTS();
   algorithm_performance_test::algorithm_performance_test();
+  // parallel_algo_test::parallel_algo_test();
   // vector_test::vector_test();
   // list_test::list_test();
+  // forward_list_test::forward_list_test();
+  // unrolled_list_test::unrolled_list_test();
+  // intrusive_test::intrusive_test();
   // deque_test::deque_test();
+  // circular_buffer_test::circular_buffer_test();
   // queue_test::queue_test();
   // queue_test::priority_test();
+  // queue_test::addressable_priority_test();
+  // concurrent_queue_test::spsc_queue_test();
+  // concurrent_queue_test::mpmc_queue_test();
+  // thread_pool_test::thread_pool_test();
   // stack_test::stack_test();
   // map_test::map_test();
   // map_test::multimap_test();
+  // persistent_map_test::persistent_map_test();
+  // interval_map_test::interval_map_test();
   // set_test::set_test();
   // set_test::multiset_test();
   // unordered_map_test::unordered_map_test();
   // unordered_map_test::unordered_multimap_test();
   // unordered_set_test::unordered_set_test();
   // unordered_set_test::unordered_multiset_test();
+  // hashtable_stats_test::hashtable_stats_test();
+  // rb_tree_memory_test::rb_tree_memory_test();
   // string_test::string_test();
 
 #if defined(_MSC_VER) && defined(_DEBUG)
@@ -0,0 +1,184 @@
+#ifndef MYTINYSTL_THREAD_POOL_TEST_H_
+#define MYTINYSTL_THREAD_POOL_TEST_H_
+
+// thread pool test : 测试 thread pool、task group、parallel_for 的接口，
+// 并比较分治递归（并行排序）与细粒度 parallel_for 相对串行版本的耗时
+
+#include <chrono>
+#include <stdexcept>
+
+#include "../MyTinySTL/algo.h"
+#include "../MyTinySTL/thread_pool.h"
+#include "../MyTinySTL/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace thread_pool_test {
+
+// 元素个数不超过 cutoff 时直接调用 mystl::sort，否则划分后派生左半部分、当前线程继续处理右半部分
+template <typename RandomIter>
+void parallel_sort(TaskGroup& group, RandomIter first, RandomIter last, ptrdiff_t cutoff) {
+  while (last - first > cutoff) {
+    auto pivot = mystl::median(*first, *(first + (last - first) / 2), *(last - 1));
+    RandomIter mid = mystl::unchecked_partition(first, last, pivot);
+    group.spawn([&group, first, mid, cutoff] { parallel_sort(group, first, mid, cutoff); });
+    first = mid;
+  }
+  mystl::sort(first, last);
+}
+
+// 分治递归计算斐波那契数，n 较小时串行计算
+long fib(ThreadPool* pool, int n) {
+  if (n < 2) {
+    return n;
+  }
+  if (pool == nullptr || n < 16) {
+    return fib(nullptr, n - 1) + fib(nullptr, n - 2);
+  }
+  long x = 0;
+  TaskGroup group(*pool);
+  group.spawn([pool, n, &x] { x = fib(pool, n - 1); });
+  const long y = fib(pool, n - 2);
+  group.wait();
+  return x + y;
+}
+
+template <typename Clock>
+long elapsed_ms(typename Clock::time_point start) {
+  return static_cast<long>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+}
+
+// 串行排序与并行排序count个随机整数，返回耗时（毫秒）
+long sort_time(ThreadPool* pool, size_t count) {
+  mystl::Vector<int> v(count);
+  srand(static_cast<unsigned>(count));
+  for (auto& x : v) {
+    x = rand();
+  }
+  using clock = std::chrono::steady_clock;
+  auto start = clock::now();
+  if (pool == nullptr) {
+    mystl::sort(v.begin(), v.end());
+  } else {
+    TaskGroup group(*pool);
+    parallel_sort(group, v.begin(), v.end(), 4096);
+    group.wait();
+  }
+  const long t = elapsed_ms<clock>(start);
+  if (!mystl::is_sorted(v.begin(), v.end())) {
+    std::cout << red << " sort result mismatch" << std::endl;
+  }
+  return t;
+}
+
+long fib_time(ThreadPool* pool, int n) {
+  using clock = std::chrono::steady_clock;
+  auto start = clock::now();
+  const long r = fib(pool, n);
+  const long t = elapsed_ms<clock>(start);
+  if (pool != nullptr && r != fib(nullptr, n)) {
+    std::cout << red << " fib result mismatch" << std::endl;
+  }
+  return t;
+}
+
+// 对count个下标各做一次很小的计算，每grain个下标构成一个任务，返回平均每个任务的耗时（纳秒）
+// pool 为nullptr时串行执行，此时为平均每grain个下标的耗时
+long parallel_for_time(ThreadPool* pool, size_t count, size_t grain) {
+  mystl::Vector<long> v(count, 0);
+  auto body = [&v](size_t i) { v[i] += static_cast<long>(i) * 3 + 1; };
+  using clock = std::chrono::steady_clock;
+  auto start = clock::now();
+  if (pool == nullptr) {
+    for (size_t i = 0; i < count; ++i) {
+      body(i);
+    }
+  } else {
+    mystl::parallel_for(*pool, size_t(0), count, grain, body);
+  }
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+  for (size_t i = 0; i < count; ++i) {
+    if (v[i] != static_cast<long>(i) * 3 + 1) {
+      std::cout << red << " parallel_for result mismatch" << std::endl;
+      break;
+    }
+  }
+  return static_cast<long>(ns.count() / static_cast<long>((count + grain - 1) / grain));
+}
+
+// 输出一行，依次为串行、线程池的耗时
+void print_row(const char* name, long t1, long t2, const char* unit) {
+  std::cout << "|" << std::setw(20) << name << " |" << std::setw(11) << t1 << unit << "|"
+            << std::setw(11) << t2 << unit << "|" << std::endl;
+}
+
+void thread_pool_test() {
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[-------------- Run container test : ThreadPool ----------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  mystl::ThreadPool pool(2);
+  mystl::ThreadPool inline_pool(0);
+  int a[16] = {0};
+  long x = 0;
+  bool caught = false;
+  FUN_VALUE(pool.size());
+  FUN_VALUE(inline_pool.size());
+  FUN_VALUE(fib(&pool, 20));
+  FUN_VALUE(fib(&inline_pool, 20));
+  {
+    mystl::TaskGroup group(pool);
+    group.spawn([&x] { x = 42; });
+    group.wait();
+  }
+  FUN_VALUE(x);
+  mystl::parallel_for(pool, 0, 16, 3, [&a](int i) { a[i] = i * i; });
+  FUN_VALUE(a[3]);
+  FUN_VALUE(a[15]);
+  mystl::parallel_for(inline_pool, 0, 16, 1, [&a](int i) { a[i] = -i; });
+  FUN_VALUE(a[15]);
+  {
+    mystl::TaskGroup group(pool);
+    group.spawn([] { throw std::runtime_error("task failed"); });
+    try {
+      group.wait();
+    } catch (const std::runtime_error&) {
+      caught = true;
+    }
+  }
+  std::cout << std::boolalpha;
+  FUN_VALUE(caught);
+  std::cout << std::noboolalpha;
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  std::cout << "|     operation       |   serial    | ThreadPool  |" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  mystl::ThreadPool& workers = mystl::default_thread_pool();
+  const size_t count = SCALE_L(LEN2);
+  print_row("sort", sort_time(nullptr, count), sort_time(&workers, count), "ms");
+  print_row("fork-join fib(30)", fib_time(nullptr, 30), fib_time(&workers, 30), "ms");
+  print_row("parallel_for g=1",
+            parallel_for_time(nullptr, count, 1),
+            parallel_for_time(&workers, count, 1),
+            "ns");
+  print_row("parallel_for g=64",
+            parallel_for_time(nullptr, count, 64),
+            parallel_for_time(&workers, count, 64),
+            "ns");
+  print_row("parallel_for g=4096",
+            parallel_for_time(nullptr, count, 4096),
+            parallel_for_time(&workers, count, 4096),
+            "ns");
+  std::cout << "|---------------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[-------------- End container test : ThreadPool ----------------]" << std::endl;
+}
+
+}  // namespace thread_pool_test
+}  // namespace test
+}  // namespace mystl
+#endif  // !MYTINYSTL_THREAD_POOL_TEST_H_
@@ -86,6 +86,24 @@ void unordered_map_test() {
   FUN_VALUE(um1.max_load_factor());
   MAP_FUN_AFTER(um1, um1.max_load_factor(1.5f));
   FUN_VALUE(um1.max_load_factor());
+  // 透明哈希与比较器：直接用字面量查找，不构造临时的 string
+  mystl::UnorderedMap<mystl::string, int, mystl::StringHash<char>, mystl::EqualTo<>> um15;
+  um15["hello"] = 1;
+  um15["world"] = 2;
+  FUN_VALUE(um15.count("hello"));
+  FUN_VALUE(um15.find("world")->second);
+  FUN_VALUE(um15.equal_range("hello").first->second);
+  mystl::UnorderedMap<int, int> um16{PAIR(1, 1), PAIR(2, 2)};
+  mystl::UnorderedMap<int, int> um17{PAIR(2, 20), PAIR(3, 30)};
+  MAP_FUN_AFTER(um16, um16.try_emplace(1, 100));
+  // try_emplace 用剩余的参数在结点中原地构造 mapped_type
+  mystl::UnorderedMap<int, mystl::string> um18;
+  um18.try_emplace(1, 3, 'a');
+  FUN_VALUE(um18[1]);
+  MAP_FUN_AFTER(um16, um16.insert_or_assign(1, 100));
+  MAP_FUN_AFTER(um17, um17.insert(um16.extract(1)));
+  MAP_FUN_AFTER(um16, um16.merge(um17));
+  FUN_VALUE(um17.size());
   PASSED;
 #if PERFORMANCE_TEST_ON
   std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
@@ -0,0 +1,159 @@
+#ifndef MYTINYSTL_UNROLLED_LIST_TEST_H_
+#define MYTINYSTL_UNROLLED_LIST_TEST_H_
+
+// unrolled list test : 测试 unrolled list 的接口，并与 list、deque 比较遍历、在中间插入与删除的性能
+
+#include "../MyTinySTL/deque.h"
+#include "../MyTinySTL/list.h"
+#include "../MyTinySTL/unrolled_list.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace unrolled_list_test {
+
+// 对count个元素的容器遍历10次，返回耗时（毫秒）
+template <typename Container>
+long traverse_time(size_t count) {
+  Container c;
+  for (size_t i = 0; i < count; ++i) {
+    c.push_back(static_cast<int>(i));
+  }
+  long long sum = 0;
+  clock_t start = clock();
+  for (int pass = 0; pass < 10; ++pass) {
+    for (auto it = c.begin(); it != c.end(); ++it) {
+      sum += *it;
+    }
+  }
+  clock_t end = clock();
+  if (sum != static_cast<long long>(count) * (count - 1) / 2 * 10) {
+    std::cout << red << " traverse result mismatch" << std::endl;
+  }
+  return static_cast<long>((end - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+// 在count个元素的容器中间持续插入count个元素（每次在上一次插入的位置之前），返回耗时
+template <typename Container>
+long insert_mid_time(size_t count) {
+  Container c;
+  for (size_t i = 0; i < count; ++i) {
+    c.push_back(static_cast<int>(i));
+  }
+  auto it = c.begin();
+  mystl::advance(it, count / 2);
+  clock_t start = clock();
+  for (size_t i = 0; i < count; ++i) {
+    it = c.insert(it, static_cast<int>(i));
+  }
+  clock_t end = clock();
+  if (c.size() != count * 2) {
+    std::cout << red << " insert result mismatch" << std::endl;
+  }
+  return static_cast<long>((end - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+// 从count个元素的容器中间连续删除一半元素，返回耗时
+template <typename Container>
+long erase_mid_time(size_t count) {
+  Container c;
+  for (size_t i = 0; i < count; ++i) {
+    c.push_back(static_cast<int>(i));
+  }
+  auto it = c.begin();
+  mystl::advance(it, count / 4);
+  clock_t start = clock();
+  for (size_t i = 0; i < count / 2; ++i) {
+    it = c.erase(it);
+  }
+  clock_t end = clock();
+  if (c.size() != count - count / 2) {
+    std::cout << red << " erase result mismatch" << std::endl;
+  }
+  return static_cast<long>((end - start) * 1000 / CLOCKS_PER_SEC);
+}
+
+// 输出一行，依次为 list、deque、unrolled list 的耗时
+void print_row(const char* name, long t1, long t2, long t3) {
+  std::cout << "|" << std::setw(20) << name << " |" << std::setw(11) << t1 << "ms|"
+            << std::setw(11) << t2 << "ms|" << std::setw(11) << t3 << "ms|" << std::endl;
+}
+
+void unrolled_list_test() {
+  std::cout << "[===============================================================]" << std::endl;
+  std::cout << "[------------- Run container test : UnrolledList ---------------]" << std::endl;
+  std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+  int a[] = {1, 2, 3, 4, 5};
+  mystl::UnrolledList<int, 64> l1;
+  mystl::UnrolledList<int, 64> l2(5);
+  mystl::UnrolledList<int, 64> l3(5, 1);
+  mystl::UnrolledList<int, 64> l4(a, a + 5);
+  mystl::UnrolledList<int, 64> l5(l2);
+  mystl::UnrolledList<int, 64> l6(std::move(l2));
+  mystl::UnrolledList<int, 64> l7;
+  l7 = l3;
+  mystl::UnrolledList<int, 64> l8;
+  l8 = std::move(l3);
+  mystl::UnrolledList<int, 64> l9{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  mystl::UnrolledList<int, 64> l10;
+  l10 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  FUN_AFTER(l1, l1.insert(l1.end(), 6));
+  FUN_AFTER(l1, l1.insert(l1.begin(), 1));
+  FUN_AFTER(l1, for (int i = 2; i < 6; ++i) l1.insert(--l1.end(), i));
+  FUN_AFTER(l1, l1.emplace_back(7));
+  FUN_AFTER(l1, l1.emplace_front(0));
+  FUN_AFTER(l1, l1.emplace(++l1.begin(), 9));
+  FUN_AFTER(l1, l1.erase(++l1.begin()));
+  FUN_AFTER(l1, l1.push_front(-1));
+  FUN_AFTER(l1, l1.push_back(8));
+  FUN_AFTER(l1, l1.pop_front());
+  FUN_AFTER(l1, l1.pop_back());
+  FUN_VALUE(l1.block_count());
+  FUN_AFTER(l1, l1.splice(l1.end(), l9));
+  FUN_AFTER(l1, l1.splice(++l1.begin(), l10));
+  FUN_VALUE(l1.block_count());
+  FUN_AFTER(l1, l1.erase(l1.begin(), ++(++(++l1.begin()))));
+  FUN_AFTER(l1, l1.swap(l4));
+  FUN_VALUE(*l1.begin());
+  FUN_VALUE(*l1.rbegin());
+  FUN_VALUE(l1.front());
+  FUN_VALUE(l1.back());
+  std::cout << std::boolalpha;
+  FUN_VALUE(l1.empty());
+  FUN_VALUE((l1 == l4));
+  std::cout << std::noboolalpha;
+  FUN_VALUE(l1.size());
+  FUN_VALUE(l4.size());
+  FUN_VALUE((mystl::UnrolledList<int, 64>::kBlockSize));
+  FUN_AFTER(l1, l1.clear());
+  PASSED;
+#if PERFORMANCE_TEST_ON
+  std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  std::cout << "|     operation       |    List     |    Deque    | UnrolledList|" << std::endl;
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  const size_t n1 = LEN2;
+  const size_t n2 = SCALE_S(LEN1);
+  print_row("traverse x10",
+            traverse_time<mystl::List<int>>(n1),
+            traverse_time<mystl::Deque<int>>(n1),
+            traverse_time<mystl::UnrolledList<int>>(n1));
+  print_row("insert in middle",
+            insert_mid_time<mystl::List<int>>(n2),
+            insert_mid_time<mystl::Deque<int>>(n2),
+            insert_mid_time<mystl::UnrolledList<int>>(n2));
+  print_row("erase in middle",
+            erase_mid_time<mystl::List<int>>(n2),
+            erase_mid_time<mystl::Deque<int>>(n2),
+            erase_mid_time<mystl::UnrolledList<int>>(n2));
+  std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+  PASSED;
+#endif
+  std::cout << "[------------- End container test : UnrolledList ---------------]" << std::endl;
+}
+
+}  // namespace unrolled_list_test
+}  // namespace test
+}  // namespace mystl
+#endif  // !MYTINYSTL_UNROLLED_LIST_TEST_H_
@@ -90,6 +90,16 @@ void vector_test() {
   FUN_AFTER(v1, v1.shrink_to_fit());
   FUN_VALUE(v1.size());
   FUN_VALUE(v1.capacity());
+  const size_t n = v5.capacity() + 5;
+  FUN_AFTER(v5, v5.assign(n, 7));
+  FUN_VALUE(v5.size());
+  bool all_assigned = v5.size() == n;
+  for (auto x : v5) {
+    all_assigned = all_assigned && x == 7;
+  }
+  if (!all_assigned) {
+    std::cout << red << " v5.assign(n, value) mismatch\n";
+  }
   PASSED;
 #if PERFORMANCE_TEST_ON
   std::cout << "[--------------------- Performance Testing ---------------------]\n";